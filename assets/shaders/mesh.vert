@@ -5,18 +5,20 @@ layout(set = 0, binding = 0) uniform CameraUBO
   mat4 viewProj;
 } ubo;
 
-layout(push_constant) uniform Push
-{
-  mat4 model;
-} pc;
-
 layout(location = 0) in vec3 inPos;
 layout(location = 1) in vec3 inColor;
 
+// Per-instance model matrix (binding 1, one column per location).
+layout(location = 3) in vec4 inModel0;
+layout(location = 4) in vec4 inModel1;
+layout(location = 5) in vec4 inModel2;
+layout(location = 6) in vec4 inModel3;
+
 layout(location = 0) out vec3 vColor;
 
 void main()
 {
-  gl_Position = ubo.viewProj * pc.model * vec4(inPos, 1.0);
+  mat4 model = mat4(inModel0, inModel1, inModel2, inModel3);
+  gl_Position = ubo.viewProj * model * vec4(inPos, 1.0);
   vColor = inColor;
 }
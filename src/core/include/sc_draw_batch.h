@@ -0,0 +1,53 @@
+#pragma once
+#include "sc_ecs.h"
+#include "sc_radix_sort.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace sc
+{
+  struct DrawBatch
+  {
+    uint32_t meshId = 0;
+    uint32_t materialId = 0;
+    uint32_t firstInstance = 0;
+    uint32_t instanceCount = 0;
+  };
+
+  struct DrawBatchStats
+  {
+    uint32_t rawDraws = 0;
+    uint32_t batches = 0;
+    uint32_t largestBatch = 0;
+    // Filled in by the backend: ring allocations the instance data took (more
+    // than one when it had to be split) and batches skipped because even their
+    // piece did not fit.
+    uint32_t instanceUploads = 0;
+    uint32_t droppedBatches = 0;
+  };
+
+  // Collapses runs of consecutive draws that share mesh and material into
+  // instanced batches. Model matrices are packed in batch order, so a batch
+  // covers instances()[firstInstance, firstInstance + instanceCount).
+  // Pure CPU: the backend only copies instances() and walks batches().
+  class DrawBatchBuilder
+  {
+  public:
+    // order (optional) gives the walk order as indices into draws.
+    void build(const std::vector<DrawItem>& draws, const SortKeyIndex* order = nullptr);
+    void clear();
+
+    void setMaxInstancesPerBatch(uint32_t maxInstances) { m_maxInstancesPerBatch = maxInstances; }
+
+    const std::vector<DrawBatch>& batches() const { return m_batches; }
+    const std::vector<Mat4>& instances() const { return m_instances; }
+    const DrawBatchStats& stats() const { return m_stats; }
+
+  private:
+    std::vector<DrawBatch> m_batches;
+    std::vector<Mat4> m_instances;
+    DrawBatchStats m_stats{};
+    uint32_t m_maxInstancesPerBatch = 0; // 0 = unlimited
+  };
+}
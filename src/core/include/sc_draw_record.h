@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace sc
+{
+  static constexpr uint32_t kMaxDrawRecordRanges = 16u;
+
+  // Contiguous slice of the sorted batch list, recorded as one unit.
+  struct DrawRange
+  {
+    uint32_t firstBatch = 0;
+    uint32_t batchCount = 0;
+  };
+
+  struct DrawRecordStats
+  {
+    uint32_t ranges = 0;
+    uint32_t batches = 0;
+    uint32_t issued = 0;
+    bool parallel = false;
+  };
+
+  // Records one range; implementations must only touch state owned by
+  // rangeIndex since ranges run concurrently. Returns the draws issued.
+  class IDrawRangeRecorder
+  {
+  public:
+    virtual ~IDrawRangeRecorder() = default;
+    virtual uint32_t recordRange(uint32_t rangeIndex, const DrawRange& range) = 0;
+  };
+
+  // Splits [0, batchCount) into at most maxRanges (capped at
+  // kMaxDrawRecordRanges) contiguous, evenly sized ranges of at least
+  // minBatchesPerRange batches. Returns the number of ranges written.
+  uint32_t partitionDrawRanges(uint32_t batchCount,
+                               uint32_t maxRanges,
+                               uint32_t minBatchesPerRange,
+                               std::vector<DrawRange>& out);
+
+  // Runs the recorder over every range, on sc::jobs() when there is more
+  // than one. issuedPerRange is filled in range order, which is also the
+  // order the results must be replayed in to preserve the sort. The caller
+  // helps record while it waits but never picks up DispatchAsync work.
+  DrawRecordStats recordDrawRanges(const std::vector<DrawRange>& ranges,
+                                   IDrawRangeRecorder& recorder,
+                                   std::vector<uint32_t>& issuedPerRange);
+}
@@ -2,6 +2,7 @@
 #include <cstdint>
 #include <vector>
 #include <atomic>
+#include <cmath>
 #include <type_traits>
 
 #include "sc_math.h"
@@ -104,12 +105,61 @@ namespace sc
     bool active = false;
   };
 
+  // --------------------
+  // Mesh LOD
+  // --------------------
+  static constexpr uint32_t kMaxMeshLods = 4;
+  static constexpr uint32_t kInvalidMeshLodSet = 0xFFFFFFFFu;
+
+  // LOD i is used while the projected bounding-sphere diameter, as a fraction
+  // of viewport height, stays at or above screenSizes[i] (screenSizes[0] is
+  // ignored; the rest must decrease).
+  struct MeshLodSet
+  {
+    uint32_t meshIds[kMaxMeshLods]{};
+    float screenSizes[kMaxMeshLods] = { 1.0f, 0.25f, 0.1f, 0.04f };
+    uint32_t lodCount = 0;
+  };
+
   struct RenderMesh
   {
     uint32_t meshId = 0;
     uint32_t materialId = 0;
+    uint32_t lodSetId = kInvalidMeshLodSet; // overrides meshId when set
+    uint32_t lod = 0;                       // last selected LOD, for hysteresis
   };
 
+  // Coarsening needs the size to fall hysteresis below a threshold; refining
+  // needs it to rise the same fraction above, so objects near a boundary do
+  // not flip every frame.
+  [[nodiscard]] inline uint32_t selectMeshLod(const MeshLodSet& set,
+                                              float screenSize,
+                                              uint32_t currentLod,
+                                              float hysteresis) noexcept
+  {
+    if (set.lodCount <= 1)
+      return 0;
+    const uint32_t last = (set.lodCount < kMaxMeshLods ? set.lodCount : kMaxMeshLods) - 1u;
+    if (currentLod > last)
+      currentLod = last;
+
+    auto lodFor = [&](float scale)
+    {
+      uint32_t lod = 0;
+      while (lod < last && screenSize < set.screenSizes[lod + 1] * scale)
+        ++lod;
+      return lod;
+    };
+
+    const uint32_t coarser = lodFor(1.0f - hysteresis);
+    if (coarser > currentLod)
+      return coarser;
+    const uint32_t finer = lodFor(1.0f + hysteresis);
+    if (finer < currentLod)
+      return finer;
+    return currentLod;
+  }
+
   struct VehicleComponent
   {
     float mass = 1200.0f;
@@ -162,13 +212,70 @@ namespace sc
     uint32_t meshId = 0;
     uint32_t materialId = 0;
     Mat4 model = Mat4::identity();
+    uint64_t sortKey = 0;
   };
 
+  // Packed draw sort key, most significant bits first:
+  //   opaque:      [63]=0 | pipeline:7 | material:20 | mesh:20 | unused:16
+  //   transparent: [63]=1 | pipeline:7 | depth:16 (far first) | material:20 | mesh:20
+  static constexpr float kDrawSortMaxDepth = 2048.0f;
+  // Pipeline key for draws whose material cannot be resolved.
+  static constexpr uint32_t kFallbackDrawPipeline = 0u;
+
+  [[nodiscard]] inline uint64_t makeDrawSortKey(uint32_t pipeline,
+                                                uint32_t materialId,
+                                                uint32_t meshId,
+                                                bool transparent,
+                                                float viewDepth) noexcept
+  {
+    const uint64_t pipe = static_cast<uint64_t>(pipeline & 0x7Fu);
+    const uint64_t mat = static_cast<uint64_t>(materialId & 0xFFFFFu);
+    const uint64_t mesh = static_cast<uint64_t>(meshId & 0xFFFFFu);
+    if (!transparent)
+      return (pipe << 56) | (mat << 36) | (mesh << 16);
+
+    float t = viewDepth / kDrawSortMaxDepth;
+    if (!(t > 0.0f)) t = 0.0f;
+    if (t > 1.0f) t = 1.0f;
+    const uint64_t depth = 0xFFFFu - static_cast<uint64_t>(t * 65535.0f);
+    return (1ull << 63) | (pipe << 56) | (depth << 40) | (mat << 20) | mesh;
+  }
+
+  // View-space depth of the model origin (clip w for a column-major viewProj).
+  [[nodiscard]] inline float drawViewDepth(const Mat4& viewProj, const Mat4& model) noexcept
+  {
+    return viewProj.m[3] * model.m[12] + viewProj.m[7] * model.m[13] + viewProj.m[11] * model.m[14] + viewProj.m[15];
+  }
+
+  // Vertical projection scale (|proj[1][1]|) recovered from viewProj: the clip-y
+  // row is the view's unit up axis scaled by it. Compute once per frame.
+  [[nodiscard]] inline float projectedSizeScale(const Mat4& viewProj) noexcept
+  {
+    const float x = viewProj.m[1];
+    const float y = viewProj.m[5];
+    const float z = viewProj.m[9];
+    return std::sqrt(x * x + y * y + z * z);
+  }
+
+  // Bounding-sphere diameter as a fraction of viewport height. Spheres that
+  // reach the camera plane report a large size so they keep LOD 0.
+  [[nodiscard]] inline float projectedSphereSize(const Mat4& viewProj,
+                                                 float sizeScale,
+                                                 const float center[3],
+                                                 float radius) noexcept
+  {
+    const float w = viewProj.m[3] * center[0] + viewProj.m[7] * center[1] + viewProj.m[11] * center[2] + viewProj.m[15];
+    if (w <= radius)
+      return 1.0e6f;
+    return radius * sizeScale / w;
+  }
+
   struct RenderFrameData
   {
     Mat4 viewProj = Mat4::identity();
     std::vector<DrawItem> draws;
-    void clear() { draws.clear(); }
+    bool sorted = false; // draws are already ordered by sortKey
+    void clear() { draws.clear(); sorted = false; }
     void reserve(uint32_t count) { draws.reserve(count); }
   };
 
@@ -214,6 +321,8 @@ namespace sc
       m_denseEntities.push_back(e);
       m_data.emplace_back(T{});
       m_sparse[idx] = denseIndex + 1u;
+      if (m_trackAdds)
+        m_added.push_back(e);
       return m_data.back();
     }
 
@@ -270,10 +379,25 @@ namespace sc
 
     const std::vector<Entity>& denseEntities() const { return m_denseEntities; }
 
+    void setTrackAdds(bool enabled)
+    {
+      m_trackAdds = enabled;
+      if (!enabled)
+        m_added.clear();
+    }
+
+    void drainAdded(std::vector<Entity>& out)
+    {
+      out.insert(out.end(), m_added.begin(), m_added.end());
+      m_added.clear();
+    }
+
   private:
     std::vector<Entity> m_denseEntities;
     std::vector<T> m_data;
     std::vector<uint32_t> m_sparse;
+    std::vector<Entity> m_added;
+    bool m_trackAdds = false;
   };
 
   // --------------------
@@ -319,6 +443,20 @@ namespace sc
       if (pool) pool->remove(e);
     }
 
+    // Add journal: once enabled, every entity that gains a T is recorded until
+    // drained. Entries may since have lost T or died; consumers re-check.
+    template<typename T>
+    void trackAdds(bool enabled = true)
+    {
+      getPool<T>()->setTrackAdds(enabled);
+    }
+
+    template<typename T>
+    void drainAdded(std::vector<Entity>& out)
+    {
+      getPool<T>()->drainAdded(out);
+    }
+
     template<typename T>
     uint32_t componentCount() const
     {
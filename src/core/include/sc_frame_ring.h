@@ -0,0 +1,52 @@
+#pragma once
+#include <cstdint>
+
+namespace sc
+{
+  struct FrameRingStats
+  {
+    uint64_t capacity = 0;
+    uint64_t frameBytes = 0;     // bytes handed out this frame (incl. padding)
+    uint64_t inFlightBytes = 0;  // bytes not yet reclaimed
+    uint64_t peakFrameBytes = 0;
+    uint32_t frameAllocations = 0;
+    uint32_t frameOverflows = 0;
+    uint64_t frameOverflowBytes = 0;
+    uint64_t totalOverflows = 0;
+  };
+
+  // CPU side of a persistently mapped per-frame upload ring. Offsets only; the
+  // owner maps them onto a GPU buffer. Each frame slot remembers where its
+  // allocations ended; beginFrame(slot) is called once that slot's fence has
+  // signaled and releases everything up to that point.
+  class FrameRing
+  {
+  public:
+    static constexpr uint32_t kMaxFrames = 4;
+    static constexpr uint64_t kInvalidOffset = ~0ull;
+
+    bool init(uint64_t capacity, uint32_t framesInFlight);
+    void shutdown();
+
+    void beginFrame(uint32_t frameSlot);
+
+    // Returns kInvalidOffset on overflow. align must be a power of two.
+    uint64_t allocate(uint64_t size, uint64_t align);
+
+    uint64_t capacity() const { return m_capacity; }
+    const FrameRingStats& stats() const { return m_stats; }
+
+  private:
+    uint64_t m_capacity = 0;
+    uint32_t m_framesInFlight = 0;
+    uint32_t m_slot = 0;
+
+    // Monotonic byte positions; buffer offset is position % capacity.
+    uint64_t m_head = 0;
+    uint64_t m_tail = 0;
+    uint64_t m_frameStart = 0;
+    uint64_t m_slotEnd[kMaxFrames]{};
+
+    FrameRingStats m_stats{};
+  };
+}
@@ -63,8 +63,11 @@ namespace sc
     void beginFrame();
     void publishFrameTelemetry();
     JobsTelemetrySnapshot getTelemetrySnapshot() const { return m_lastSnapshot; }
+    uint32_t workerCount() const { return m_numWorkers; }
 
     void Kick(JobHandle handle);
+    // Helps with frame jobs while waiting; never picks up DispatchAsync work, so a
+    // render-thread join is not held up by a texture decode.
     void Wait(JobHandle handle);
 
     template<typename F>
@@ -133,6 +136,8 @@ namespace sc
       return handle;
     }
 
+    // Fire-and-forget background work (streaming, decodes). Runs on workers only,
+    // after any queued frame jobs.
     template<typename F>
     void DispatchAsync(F&& f, uint32_t scopeId = 0xFFFFFFFFu)
     {
@@ -179,7 +184,7 @@ namespace sc
       job.user = payload;
       job.scopeId = scope;
 
-      enqueue(job);
+      enqueueAsync(job);
     }
 
   private:
@@ -188,7 +193,9 @@ namespace sc
     void releaseFence(JobHandle handle);
 
     void enqueue(const JobItem& job);
+    void enqueueAsync(const JobItem& job);
     bool runOne(uint32_t workerIndex);
+    void execute(JobItem& job, uint32_t workerIndex);
     void workerMain(uint32_t workerIndex);
 
   private:
@@ -209,7 +216,9 @@ namespace sc
     std::mutex m_wakeMutex;
 
     struct Worker;
+    struct AsyncQueue;
     Worker* m_workers = nullptr;
+    AsyncQueue* m_async = nullptr;
     LinearFrameAllocator m_payloadAlloc{};
 
     // Fences
@@ -1,6 +1,7 @@
 #pragma once
 #include "sc_memtrack.h"
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 
@@ -43,6 +44,8 @@ namespace sc
     MemTag m_tag = MemTag::Core;
   };
 
+  // Bump allocator reset once per frame. allocate() may be called from several
+  // threads at once (jobs dispatch nested jobs); reset() may not.
   class LinearFrameAllocator
   {
   public:
@@ -54,12 +57,12 @@ namespace sc
     void reset();
 
     size_t capacity() const { return m_size; }
-    size_t used() const { return m_offset; }
+    size_t used() const { return m_offset.load(std::memory_order_relaxed); }
 
   private:
     uint8_t* m_base = nullptr;
     size_t m_size = 0;
-    size_t m_offset = 0;
+    std::atomic<size_t> m_offset{ 0 };
     MemTag m_tag = MemTag::Core;
   };
 
@@ -0,0 +1,28 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace sc
+{
+  struct SortKeyIndex
+  {
+    uint64_t key = 0;
+    uint32_t index = 0;
+  };
+
+  struct RadixSortStats
+  {
+    uint32_t count = 0;
+    uint32_t passes = 0;
+    uint32_t passesSkipped = 0;
+    uint32_t blocks = 0;
+  };
+
+  // Stable LSD radix sort over 8-bit digits of the 64-bit key. Digits that are
+  // identical for every key are skipped. Counts at or above parallelThreshold
+  // are split into blocks and histogram/scatter passes run on sc::jobs().
+  // The result is left in `items`; `scratch` is resized as needed.
+  RadixSortStats radixSort(std::vector<SortKeyIndex>& items,
+                           std::vector<SortKeyIndex>& scratch,
+                           uint32_t parallelThreshold = 4096u);
+}
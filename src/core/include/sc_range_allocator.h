@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+
+namespace sc
+{
+  struct RangeAllocatorStats
+  {
+    uint64_t capacity = 0;
+    uint64_t usedBytes = 0;
+    uint64_t largestFreeRange = 0;
+    uint32_t allocations = 0;
+    uint32_t freeRanges = 0;
+    uint32_t failedAllocations = 0;
+  };
+
+  // Best-fit free-list sub-allocator over an abstract [0, capacity) range.
+  // Adjacent free ranges are coalesced on free. Offsets only, no GPU calls, so
+  // it backs device buffers but runs headless.
+  class RangeAllocator
+  {
+  public:
+    static constexpr uint64_t kInvalidOffset = ~0ull;
+
+    void init(uint64_t capacity);
+    void reset();
+
+    // align must be a power of two. Returns kInvalidOffset when nothing fits.
+    uint64_t allocate(uint64_t size, uint64_t align);
+    void free(uint64_t offset);
+
+    // Cached; only rescans the free list after the largest range was split.
+    uint64_t largestFreeRange() const;
+    RangeAllocatorStats stats() const;
+
+  private:
+    void insertFree(uint64_t offset, uint64_t size);
+
+  private:
+    uint64_t m_capacity = 0;
+    uint64_t m_used = 0;
+    uint32_t m_failed = 0;
+    mutable uint64_t m_largestFree = 0;
+    mutable bool m_largestFreeDirty = false;
+    std::map<uint64_t, uint64_t> m_free;                // offset -> size
+    std::unordered_map<uint64_t, uint64_t> m_allocated; // offset -> size
+  };
+}
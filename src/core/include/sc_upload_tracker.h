@@ -0,0 +1,122 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+namespace sc
+{
+  // Submission side of an upload stream. Work recorded for a batch is tagged
+  // with a ticket; tickets are submitted in increasing order and must complete
+  // in that order. Implemented over a Vulkan queue + fences in the engine and
+  // by a plain counter in tests.
+  class IUploadQueue
+  {
+  public:
+    virtual ~IUploadQueue() = default;
+
+    // Submits everything recorded for `ticket`. False drops the batch.
+    virtual bool submit(uint64_t ticket) = 0;
+    // Highest ticket whose work has finished executing (0 = none).
+    virtual uint64_t completedTicket() = 0;
+  };
+
+  struct UploadTrackerStats
+  {
+    uint64_t stagingCapacity = 0;
+    uint64_t stagingInFlight = 0;     // bytes reserved by open or submitted batches
+    uint64_t peakStagingInFlight = 0;
+    uint32_t pendingUploads = 0;      // tracked resources not yet completed
+    uint32_t batchesInFlight = 0;
+    uint64_t submittedBatches = 0;
+    uint64_t completedUploads = 0;
+    uint64_t failedUploads = 0;
+    uint64_t stagingFull = 0;         // reserve() calls that did not fit
+  };
+
+  // CPU bookkeeping for a persistent staging ring shared by asynchronous
+  // uploads. reserve() hands out ring offsets for the open batch and track()
+  // attaches resources to it; flush() submits the batch under its ticket and
+  // update() releases the staging space of every batch the queue reports as
+  // finished, reporting each tracked resource exactly once.
+  class UploadTracker
+  {
+  public:
+    static constexpr uint64_t kInvalidOffset = ~0ull;
+
+    bool init(uint64_t stagingCapacity);
+    void shutdown();
+
+    // Returns kInvalidOffset when the ring cannot fit the request until older
+    // batches complete. align must be a power of two.
+    uint64_t reserve(uint64_t size, uint64_t align);
+    // True when reserve() would succeed right now.
+    bool fits(uint64_t size, uint64_t align) const;
+    void track(uint32_t resourceId);
+
+    bool hasOpenBatch() const { return m_openBytes || !m_openResources.empty(); }
+    uint64_t openTicket() const { return m_nextTicket; }
+    uint64_t capacity() const { return m_capacity; }
+
+    // Submits the open batch. On failure its resources are reported as failed
+    // by the next update().
+    bool flush(IUploadQueue& queue);
+
+    // onComplete(resourceId, ok) for every resource whose batch finished.
+    template<typename F>
+    uint32_t update(IUploadQueue& queue, F&& onComplete)
+    {
+      const uint64_t completed = queue.completedTicket();
+      uint32_t finished = 0;
+      while (!m_batches.empty() && (m_batches.front().failed || m_batches.front().ticket <= completed))
+      {
+        Batch& batch = m_batches.front();
+        for (uint32_t id : batch.resources)
+          onComplete(id, !batch.failed);
+        finished += static_cast<uint32_t>(batch.resources.size());
+        if (batch.failed)
+          m_stats.failedUploads += batch.resources.size();
+        else
+          m_stats.completedUploads += batch.resources.size();
+
+        // A batch without staging bytes can end before a tail that already skipped a wrap.
+        if (batch.stagingEnd > m_tail)
+          m_tail = batch.stagingEnd;
+        m_pending -= static_cast<uint32_t>(batch.resources.size());
+        batch.resources.clear();
+        m_freeLists.push_back(std::move(batch.resources));
+        m_batches.pop_front();
+      }
+      refreshStats();
+      return finished;
+    }
+
+    const UploadTrackerStats& stats() const { return m_stats; }
+
+  private:
+    struct Batch
+    {
+      uint64_t ticket = 0;
+      uint64_t stagingEnd = 0;
+      std::vector<uint32_t> resources;
+      bool failed = false;
+    };
+
+    bool place(uint64_t size, uint64_t align, uint64_t& outHead, uint64_t& outOffset) const;
+    void refreshStats();
+
+    uint64_t m_capacity = 0;
+
+    // Monotonic byte positions; ring offset is position % capacity.
+    uint64_t m_head = 0;
+    uint64_t m_tail = 0;
+    uint64_t m_openBytes = 0;
+
+    uint64_t m_nextTicket = 1;
+    uint32_t m_pending = 0;
+    std::vector<uint32_t> m_openResources;
+    std::deque<Batch> m_batches;
+    std::vector<std::vector<uint32_t>> m_freeLists;
+
+    UploadTrackerStats m_stats{};
+  };
+}
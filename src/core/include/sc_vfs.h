@@ -0,0 +1,152 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sc
+{
+  static constexpr uint32_t kPackMagic = 0x4B415053; // "SPAK"
+  static constexpr uint32_t kPackVersion = 1;
+  static constexpr uint32_t kPackDefaultAlignment = 64u * 1024u;
+
+  enum class PackCompression : uint32_t
+  {
+    None = 0,
+    Lz = 1     // LZ77 with LZ4-style sequence tokens, see lzCompress()
+  };
+
+  struct PackHeader
+  {
+    uint32_t magic = kPackMagic;
+    uint32_t version = kPackVersion;
+    uint32_t entryCount = 0;
+    uint32_t alignment = kPackDefaultAlignment;
+    uint64_t dataOffset = 0;  // first byte after the TOC, aligned
+    uint64_t fileSize = 0;
+  };
+
+  // TOC entries follow the header, sorted by id. Entries whose contents hash
+  // equal share one stored blob.
+  struct PackEntry
+  {
+    uint64_t id = 0;            // fnv1a64(normalizePathForId(relative path))
+    uint64_t contentHash = 0;   // fnv1a64 of the uncompressed bytes
+    uint64_t offset = 0;        // from the start of the pack
+    uint64_t storedSize = 0;
+    uint64_t size = 0;          // uncompressed
+    uint32_t compression = 0;   // PackCompression
+    uint32_t reserved = 0;
+  };
+
+  // Bytes of one asset. Either a view into a mapped pack (storage empty) or
+  // owned storage for loose files and compressed entries.
+  struct AssetBlob
+  {
+    std::span<const std::byte> bytes;
+    std::vector<std::byte> storage;
+
+    const uint8_t* data() const { return reinterpret_cast<const uint8_t*>(bytes.data()); }
+    size_t size() const { return bytes.size(); }
+    bool mapped() const { return !bytes.empty() && storage.empty(); }
+  };
+
+  // Read-only memory-mapped pack file.
+  class PackFile
+  {
+  public:
+    PackFile() = default;
+    ~PackFile();
+    PackFile(const PackFile&) = delete;
+    PackFile& operator=(const PackFile&) = delete;
+
+    bool open(const std::filesystem::path& path);
+    void close();
+
+    const PackEntry* find(uint64_t id) const;
+    // Stored bytes of an entry; compressed entries still need lzDecompress().
+    std::span<const std::byte> stored(const PackEntry& entry) const;
+    bool read(const PackEntry& entry, AssetBlob& out) const;
+
+    std::span<const PackEntry> entries() const { return m_entries; }
+    const std::filesystem::path& path() const { return m_path; }
+
+  private:
+    std::filesystem::path m_path;
+    const std::byte* m_base = nullptr;
+    size_t m_size = 0;
+    std::span<const PackEntry> m_entries;
+#if defined(_WIN32)
+    void* m_file = nullptr;
+    void* m_mapping = nullptr;
+#else
+    int m_fd = -1;
+#endif
+  };
+
+  struct PackSource
+  {
+    std::string relativePath;     // key, as loaders will ask for it
+    std::filesystem::path sourcePath;
+  };
+
+  struct PackBuildOptions
+  {
+    uint32_t alignment = kPackDefaultAlignment;
+    bool compress = false;
+    // Keep a compressed entry only if it saves at least this fraction.
+    float minCompressionSavings = 0.1f;
+  };
+
+  struct PackBuildStats
+  {
+    uint32_t entries = 0;
+    uint32_t uniqueBlobs = 0;
+    uint32_t compressedBlobs = 0;
+    uint64_t sourceBytes = 0;
+    uint64_t storedBytes = 0;
+    uint64_t fileBytes = 0;
+  };
+
+  bool buildPack(const std::filesystem::path& outPath,
+                 const std::vector<PackSource>& sources,
+                 const PackBuildOptions& options,
+                 PackBuildStats* outStats,
+                 std::string* outError);
+
+  // Worst-case output size of lzCompress() for srcSize input bytes.
+  size_t lzCompressBound(size_t srcSize);
+  // Returns the compressed size; dst must hold lzCompressBound(srcSize) bytes.
+  size_t lzCompress(const uint8_t* src, size_t srcSize, uint8_t* dst);
+  // False when the stream is malformed or does not decode to exactly dstSize bytes.
+  bool lzDecompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize);
+
+  // Packs mounted later shadow earlier ones; relative paths missing from every
+  // pack fall back to loose files under resolveAssetPath(). Mount before
+  // worker threads start reading; reads are const and thread-safe.
+  class Vfs
+  {
+  public:
+    bool mountPack(const std::filesystem::path& path);
+    void unmountAll();
+    size_t packCount() const { return m_packs.size(); }
+
+    bool read(std::string_view relativePath, AssetBlob& out) const;
+    bool readPacked(uint64_t id, AssetBlob& out) const;
+    bool exists(std::string_view relativePath) const;
+
+  private:
+    const PackEntry* findPacked(uint64_t id, const PackFile** outPack) const;
+
+    std::vector<std::unique_ptr<PackFile>> m_packs;
+  };
+
+  Vfs& vfs();
+
+  uint64_t assetPathId(std::string_view relativePath);
+  bool readLooseFile(const std::filesystem::path& path, std::vector<std::byte>& out);
+}
@@ -0,0 +1,44 @@
+#include "sc_draw_batch.h"
+
+namespace sc
+{
+  void DrawBatchBuilder::clear()
+  {
+    m_batches.clear();
+    m_instances.clear();
+    m_stats = DrawBatchStats{};
+  }
+
+  void DrawBatchBuilder::build(const std::vector<DrawItem>& draws, const SortKeyIndex* order)
+  {
+    clear();
+
+    const uint32_t count = static_cast<uint32_t>(draws.size());
+    m_instances.reserve(count);
+    m_stats.rawDraws = count;
+
+    DrawBatch* current = nullptr;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      const DrawItem& draw = order ? draws[order[i].index] : draws[i];
+
+      const bool full = current && m_maxInstancesPerBatch > 0 && current->instanceCount >= m_maxInstancesPerBatch;
+      if (!current || full || current->meshId != draw.meshId || current->materialId != draw.materialId)
+      {
+        DrawBatch batch{};
+        batch.meshId = draw.meshId;
+        batch.materialId = draw.materialId;
+        batch.firstInstance = static_cast<uint32_t>(m_instances.size());
+        m_batches.push_back(batch);
+        current = &m_batches.back();
+      }
+
+      m_instances.push_back(draw.model);
+      current->instanceCount++;
+      if (current->instanceCount > m_stats.largestBatch)
+        m_stats.largestBatch = current->instanceCount;
+    }
+
+    m_stats.batches = static_cast<uint32_t>(m_batches.size());
+  }
+}
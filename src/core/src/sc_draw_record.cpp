@@ -0,0 +1,75 @@
+#include "sc_draw_record.h"
+#include "sc_jobs.h"
+
+#include <algorithm>
+
+namespace sc
+{
+  uint32_t partitionDrawRanges(uint32_t batchCount,
+                               uint32_t maxRanges,
+                               uint32_t minBatchesPerRange,
+                               std::vector<DrawRange>& out)
+  {
+    out.clear();
+    if (batchCount == 0)
+      return 0;
+
+    const uint32_t minPerRange = std::max(1u, minBatchesPerRange);
+    uint32_t rangeCount = std::min(std::max(1u, maxRanges), kMaxDrawRecordRanges);
+    rangeCount = std::min(rangeCount, std::max(1u, batchCount / minPerRange));
+
+    // Spread the remainder one batch at a time over the leading ranges.
+    const uint32_t base = batchCount / rangeCount;
+    const uint32_t extra = batchCount % rangeCount;
+    uint32_t first = 0;
+    for (uint32_t r = 0; r < rangeCount; ++r)
+    {
+      DrawRange range{};
+      range.firstBatch = first;
+      range.batchCount = base + (r < extra ? 1u : 0u);
+      out.push_back(range);
+      first += range.batchCount;
+    }
+    return rangeCount;
+  }
+
+  DrawRecordStats recordDrawRanges(const std::vector<DrawRange>& ranges,
+                                   IDrawRangeRecorder& recorder,
+                                   std::vector<uint32_t>& issuedPerRange)
+  {
+    DrawRecordStats stats{};
+    const uint32_t count = static_cast<uint32_t>(ranges.size());
+    stats.ranges = count;
+    issuedPerRange.assign(count, 0u);
+    if (count == 0)
+      return stats;
+
+    JobHandle handle{};
+    if (count > 1u)
+    {
+      handle = jobs().Dispatch(count, 1u, [&](const JobContext& ctx)
+      {
+        for (uint32_t r = ctx.start; r < ctx.end; ++r)
+          issuedPerRange[r] = recorder.recordRange(r, ranges[r]);
+      });
+    }
+
+    if (handle.fence)
+    {
+      jobs().Wait(handle);
+      stats.parallel = true;
+    }
+    else
+    {
+      for (uint32_t r = 0; r < count; ++r)
+        issuedPerRange[r] = recorder.recordRange(r, ranges[r]);
+    }
+
+    for (uint32_t r = 0; r < count; ++r)
+    {
+      stats.batches += ranges[r].batchCount;
+      stats.issued += issuedPerRange[r];
+    }
+    return stats;
+  }
+}
@@ -0,0 +1,88 @@
+#include "sc_frame_ring.h"
+
+namespace sc
+{
+  bool FrameRing::init(uint64_t capacity, uint32_t framesInFlight)
+  {
+    if (capacity == 0 || framesInFlight == 0 || framesInFlight > kMaxFrames)
+      return false;
+
+    *this = FrameRing{};
+    m_capacity = capacity;
+    m_framesInFlight = framesInFlight;
+    m_stats.capacity = capacity;
+    return true;
+  }
+
+  void FrameRing::shutdown()
+  {
+    *this = FrameRing{};
+  }
+
+  void FrameRing::beginFrame(uint32_t frameSlot)
+  {
+    if (m_capacity == 0)
+      return;
+
+    m_slot = frameSlot % m_framesInFlight;
+
+    // The GPU retires frames in order, so this slot's end covers all older frames.
+    if (m_slotEnd[m_slot] > m_tail)
+      m_tail = m_slotEnd[m_slot];
+    m_slotEnd[m_slot] = m_head;
+    m_frameStart = m_head;
+
+    m_stats.frameBytes = 0;
+    m_stats.frameAllocations = 0;
+    m_stats.frameOverflows = 0;
+    m_stats.frameOverflowBytes = 0;
+    m_stats.inFlightBytes = m_head - m_tail;
+  }
+
+  uint64_t FrameRing::allocate(uint64_t size, uint64_t align)
+  {
+    if (m_capacity == 0 || size == 0)
+      return kInvalidOffset;
+    if (align == 0)
+      align = 1;
+
+    // With nothing in flight, restart at offset 0 so the whole ring is usable
+    // instead of only the bytes left before the wrap point.
+    if (m_head == m_tail && m_head % m_capacity != 0)
+    {
+      m_head += m_capacity - m_head % m_capacity;
+      m_tail = m_head;
+      m_frameStart = m_head;
+      m_slotEnd[m_slot] = m_head;
+    }
+
+    const uint64_t headOffset = m_head % m_capacity;
+    uint64_t offset = (headOffset + align - 1) & ~(align - 1);
+    uint64_t newHead = m_head + (offset - headOffset);
+
+    // Never split an allocation across the wrap point; skip to the start.
+    if (offset + size > m_capacity)
+    {
+      newHead = m_head + (m_capacity - headOffset);
+      offset = 0;
+    }
+
+    if (size > m_capacity || newHead + size - m_tail > m_capacity)
+    {
+      m_stats.frameOverflows++;
+      m_stats.frameOverflowBytes += size;
+      m_stats.totalOverflows++;
+      return kInvalidOffset;
+    }
+
+    m_head = newHead + size;
+    m_slotEnd[m_slot] = m_head;
+
+    m_stats.frameAllocations++;
+    m_stats.frameBytes = m_head - m_frameStart;
+    m_stats.inFlightBytes = m_head - m_tail;
+    if (m_stats.frameBytes > m_stats.peakFrameBytes)
+      m_stats.peakFrameBytes = m_stats.frameBytes;
+    return offset;
+  }
+}
@@ -110,6 +110,12 @@ namespace sc
     uint32_t index = 0;
   };
 
+  // Shared by all workers and drained only when no frame job is queued.
+  struct JobSystem::AsyncQueue
+  {
+    MPMCQueue queue;
+  };
+
   static JobSystem g_jobs;
 
   JobSystem& jobs()
@@ -138,6 +144,10 @@ namespace sc
         return false;
     }
 
+    m_async = new AsyncQueue;
+    if (!m_async->queue.init(kQueueSize))
+      return false;
+
     for (uint32_t i = 0; i < m_numWorkers; ++i)
     {
       m_workers[i].thread = std::thread([this, i]() { workerMain(i); });
@@ -163,6 +173,20 @@ namespace sc
     for (uint32_t i = 0; i < m_numWorkers; ++i)
       m_workers[i].queue.shutdown();
 
+    // Async jobs still queued were never started; release their payloads.
+    if (m_async)
+    {
+      JobItem job{};
+      while (m_async->queue.buffer && m_async->queue.dequeue(job))
+      {
+        m_jobsQueued.fetch_sub(1, std::memory_order_relaxed);
+        if (job.destroy) job.destroy(job.user);
+      }
+      m_async->queue.shutdown();
+      delete m_async;
+      m_async = nullptr;
+    }
+
     delete[] m_workers;
     m_workers = nullptr;
     m_numWorkers = 0;
@@ -271,20 +295,22 @@ namespace sc
 
     // If all queues full, execute on caller thread to avoid loss
     JobItem local = job;
-    local.ctx.workerIndex = m_numWorkers;
-    { ScopedTimer t(&m_frameJobTicks); local.fn(local.ctx, local.user); }
-    if (local.destroy) local.destroy(local.user);
-    if (local.fence)
+    execute(local, m_numWorkers);
+  }
+
+  void JobSystem::enqueueAsync(const JobItem& job)
+  {
+    if (m_async && m_async->queue.enqueue(job))
     {
-      const int32_t remaining = local.fence->count.fetch_sub(1, std::memory_order_acq_rel) - 1;
-      if (remaining == 0)
-      {
-        std::lock_guard<std::mutex> lk(local.fence->m);
-        local.fence->cv.notify_all();
-      }
+      m_jobsQueued.fetch_add(1, std::memory_order_relaxed);
+      m_jobsEnqueued.fetch_add(1, std::memory_order_relaxed);
+      m_frameJobsEnqueued.fetch_add(1, std::memory_order_relaxed);
+      m_wakeCv.notify_one();
+      return;
     }
-    m_jobsCompleted.fetch_add(1, std::memory_order_relaxed);
-    m_frameJobsCompleted.fetch_add(1, std::memory_order_relaxed);
+
+    // Async queue full: frame queues still keep the work off the caller when they can.
+    enqueue(job);
   }
 
   bool JobSystem::runOne(uint32_t workerIndex)
@@ -310,13 +336,16 @@ namespace sc
             break;
           }
         }
+        // Frame work first; async jobs only when nothing else is queued.
+        if (!job.fn && m_async && m_async->queue.dequeue(job))
+          m_jobsQueued.fetch_sub(1, std::memory_order_relaxed);
         if (!job.fn)
           return false;
       }
     }
     else
     {
-      // main thread help: steal from any queue
+      // main thread help: steal frame jobs from any queue, never async ones
       bool found = false;
       for (uint32_t i = 0; i < m_numWorkers; ++i)
       {
@@ -331,6 +360,12 @@ namespace sc
         return false;
     }
 
+    execute(job, workerIndex);
+    return true;
+  }
+
+  void JobSystem::execute(JobItem& job, uint32_t workerIndex)
+  {
     job.ctx.workerIndex = workerIndex;
     {
       ScopedTimer frameTimer(&m_frameJobTicks);
@@ -352,7 +387,6 @@ namespace sc
 
     m_jobsCompleted.fetch_add(1, std::memory_order_relaxed);
     m_frameJobsCompleted.fetch_add(1, std::memory_order_relaxed);
-    return true;
   }
 
   void JobSystem::workerMain(uint32_t workerIndex)
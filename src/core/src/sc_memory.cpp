@@ -79,7 +79,7 @@ namespace sc
     m_base = (uint8_t*)_aligned_malloc(size, 64);
     if (!m_base) return false;
     m_size = size;
-    m_offset = 0;
+    m_offset.store(0, std::memory_order_relaxed);
     m_tag = tag;
     return true;
   }
@@ -92,26 +92,27 @@ namespace sc
       m_base = nullptr;
     }
     m_size = 0;
-    m_offset = 0;
+    m_offset.store(0, std::memory_order_relaxed);
   }
 
   void* LinearFrameAllocator::allocate(size_t size, size_t align, MemTag tag, const char* file, uint32_t line)
   {
     (void)tag;
-    const size_t aligned = detail::alignUp(m_offset, align);
-    if (aligned + size > m_size) return nullptr;
-    void* p = m_base + aligned;
-    m_offset = aligned + size;
+    size_t offset = m_offset.load(std::memory_order_relaxed);
+    size_t aligned = 0;
+    do
+    {
+      aligned = detail::alignUp(offset, align);
+      if (aligned + size > m_size) return nullptr;
+    } while (!m_offset.compare_exchange_weak(offset, aligned + size, std::memory_order_relaxed));
     memtrack_alloc(m_tag, (uint64_t)size, file, line);
-    return p;
+    return m_base + aligned;
   }
 
   void LinearFrameAllocator::reset()
   {
-    if (m_offset)
-    {
-      memtrack_free(m_tag, (uint64_t)m_offset);
-      m_offset = 0;
-    }
+    const size_t used = m_offset.exchange(0, std::memory_order_relaxed);
+    if (used)
+      memtrack_free(m_tag, (uint64_t)used);
   }
 }
@@ -0,0 +1,167 @@
+#include "sc_radix_sort.h"
+#include "sc_jobs.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace sc
+{
+  namespace
+  {
+    static constexpr uint32_t kDigitBits = 8u;
+    static constexpr uint32_t kBuckets = 1u << kDigitBits;
+    static constexpr uint32_t kPasses = 64u / kDigitBits;
+    static constexpr uint32_t kBlockSize = 4096u;
+    static constexpr uint32_t kMaxBlocks = 64u;
+
+    static inline uint32_t digitOf(uint64_t key, uint32_t pass)
+    {
+      return static_cast<uint32_t>(key >> (pass * kDigitBits)) & (kBuckets - 1u);
+    }
+
+    template<typename F>
+    static void runBlocks(uint32_t blocks, F&& fn)
+    {
+      if (blocks <= 1u)
+      {
+        fn(0u);
+        return;
+      }
+
+      JobHandle handle = jobs().Dispatch(blocks, 1u, [&](const JobContext& ctx)
+      {
+        for (uint32_t b = ctx.start; b < ctx.end; ++b)
+          fn(b);
+      });
+
+      if (!handle.fence)
+      {
+        for (uint32_t b = 0; b < blocks; ++b)
+          fn(b);
+        return;
+      }
+      jobs().Wait(handle);
+    }
+  }
+
+  RadixSortStats radixSort(std::vector<SortKeyIndex>& items,
+                           std::vector<SortKeyIndex>& scratch,
+                           uint32_t parallelThreshold)
+  {
+    RadixSortStats stats{};
+    const uint32_t count = static_cast<uint32_t>(items.size());
+    stats.count = count;
+    if (count < 2u)
+      return stats;
+
+    uint32_t blocks = 1u;
+    if (count >= parallelThreshold)
+      blocks = std::min(kMaxBlocks, (count + kBlockSize - 1u) / kBlockSize);
+    if (blocks < 1u)
+      blocks = 1u;
+    const uint32_t blockSize = (count + blocks - 1u) / blocks;
+    blocks = (count + blockSize - 1u) / blockSize;
+    stats.blocks = blocks;
+
+    scratch.resize(count);
+
+    // Reused across frames; each calling thread keeps its own tables.
+    thread_local std::vector<uint32_t> blockDigitCounts;
+    thread_local std::vector<uint32_t> blockOffsets;
+    blockDigitCounts.assign(static_cast<size_t>(blocks) * kPasses * kBuckets, 0u);
+    blockOffsets.assign(static_cast<size_t>(blocks) * kBuckets, 0u);
+
+    uint32_t* digitCounts = blockDigitCounts.data();
+    uint32_t* offsets = blockOffsets.data();
+
+    // One read of the keys yields every digit histogram. Totals decide which
+    // passes can be skipped; the per-block tables seed the first real pass.
+    runBlocks(blocks, [&](uint32_t b)
+    {
+      const uint32_t begin = b * blockSize;
+      const uint32_t end = std::min(count, begin + blockSize);
+      uint32_t* local = digitCounts + static_cast<size_t>(b) * kPasses * kBuckets;
+      for (uint32_t i = begin; i < end; ++i)
+      {
+        const uint64_t key = items[i].key;
+        for (uint32_t pass = 0; pass < kPasses; ++pass)
+          local[pass * kBuckets + digitOf(key, pass)]++;
+      }
+    });
+
+    bool passActive[kPasses]{};
+    for (uint32_t pass = 0; pass < kPasses; ++pass)
+    {
+      const uint32_t firstDigit = digitOf(items[0].key, pass);
+      uint32_t sameDigit = 0;
+      for (uint32_t b = 0; b < blocks; ++b)
+        sameDigit += digitCounts[static_cast<size_t>(b) * kPasses * kBuckets + pass * kBuckets + firstDigit];
+      passActive[pass] = (sameDigit != count);
+      if (!passActive[pass])
+        stats.passesSkipped++;
+    }
+
+    SortKeyIndex* src = items.data();
+    SortKeyIndex* dst = scratch.data();
+    bool firstPass = true;
+
+    for (uint32_t pass = 0; pass < kPasses; ++pass)
+    {
+      if (!passActive[pass])
+        continue;
+
+      if (firstPass)
+      {
+        for (uint32_t b = 0; b < blocks; ++b)
+        {
+          std::memcpy(offsets + static_cast<size_t>(b) * kBuckets,
+                      digitCounts + static_cast<size_t>(b) * kPasses * kBuckets + pass * kBuckets,
+                      sizeof(uint32_t) * kBuckets);
+        }
+      }
+      else
+      {
+        runBlocks(blocks, [&](uint32_t b)
+        {
+          const uint32_t begin = b * blockSize;
+          const uint32_t end = std::min(count, begin + blockSize);
+          uint32_t* local = offsets + static_cast<size_t>(b) * kBuckets;
+          std::memset(local, 0, sizeof(uint32_t) * kBuckets);
+          for (uint32_t i = begin; i < end; ++i)
+            local[digitOf(src[i].key, pass)]++;
+        });
+      }
+      firstPass = false;
+
+      // Digit-major, block-minor prefix sum keeps the sort stable.
+      uint32_t running = 0;
+      for (uint32_t d = 0; d < kBuckets; ++d)
+      {
+        for (uint32_t b = 0; b < blocks; ++b)
+        {
+          uint32_t& slot = offsets[static_cast<size_t>(b) * kBuckets + d];
+          const uint32_t c = slot;
+          slot = running;
+          running += c;
+        }
+      }
+
+      runBlocks(blocks, [&](uint32_t b)
+      {
+        const uint32_t begin = b * blockSize;
+        const uint32_t end = std::min(count, begin + blockSize);
+        uint32_t* local = offsets + static_cast<size_t>(b) * kBuckets;
+        for (uint32_t i = begin; i < end; ++i)
+          dst[local[digitOf(src[i].key, pass)]++] = src[i];
+      });
+
+      std::swap(src, dst);
+      stats.passes++;
+    }
+
+    if (src != items.data())
+      items.swap(scratch);
+    return stats;
+  }
+}
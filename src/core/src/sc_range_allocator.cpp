@@ -0,0 +1,139 @@
+#include "sc_range_allocator.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace sc
+{
+  void RangeAllocator::init(uint64_t capacity)
+  {
+    m_capacity = capacity;
+    reset();
+  }
+
+  void RangeAllocator::reset()
+  {
+    m_used = 0;
+    m_failed = 0;
+    m_largestFree = m_capacity;
+    m_largestFreeDirty = false;
+    m_free.clear();
+    m_allocated.clear();
+    if (m_capacity > 0)
+      m_free.emplace(0ull, m_capacity);
+  }
+
+  uint64_t RangeAllocator::allocate(uint64_t size, uint64_t align)
+  {
+    if (size == 0)
+      return kInvalidOffset;
+    if (align == 0)
+      align = 1;
+    if (size > largestFreeRange())
+    {
+      m_failed++;
+      return kInvalidOffset;
+    }
+
+    auto best = m_free.end();
+    uint64_t bestAligned = 0;
+    uint64_t bestWaste = ~0ull;
+    for (auto it = m_free.begin(); it != m_free.end(); ++it)
+    {
+      const uint64_t aligned = (it->first + align - 1) & ~(align - 1);
+      const uint64_t pad = aligned - it->first;
+      if (pad + size > it->second)
+        continue;
+      const uint64_t waste = it->second - size;
+      if (waste < bestWaste)
+      {
+        best = it;
+        bestAligned = aligned;
+        bestWaste = waste;
+        if (waste == pad)
+          break;
+      }
+    }
+
+    if (best == m_free.end())
+    {
+      m_failed++;
+      return kInvalidOffset;
+    }
+
+    const uint64_t rangeOffset = best->first;
+    const uint64_t rangeSize = best->second;
+    m_free.erase(best);
+    if (rangeSize == m_largestFree)
+      m_largestFreeDirty = true;
+
+    // Alignment padding in front and the tail both stay on the free list.
+    if (bestAligned > rangeOffset)
+      m_free.emplace(rangeOffset, bestAligned - rangeOffset);
+    const uint64_t end = bestAligned + size;
+    const uint64_t rangeEnd = rangeOffset + rangeSize;
+    if (rangeEnd > end)
+      m_free.emplace(end, rangeEnd - end);
+
+    m_allocated.emplace(bestAligned, size);
+    m_used += size;
+    return bestAligned;
+  }
+
+  void RangeAllocator::free(uint64_t offset)
+  {
+    auto it = m_allocated.find(offset);
+    if (it == m_allocated.end())
+      return;
+    const uint64_t size = it->second;
+    m_allocated.erase(it);
+    m_used -= size;
+    insertFree(offset, size);
+  }
+
+  void RangeAllocator::insertFree(uint64_t offset, uint64_t size)
+  {
+    auto next = m_free.lower_bound(offset);
+    if (next != m_free.end() && offset + size == next->first)
+    {
+      size += next->second;
+      next = m_free.erase(next);
+    }
+    if (next != m_free.begin())
+    {
+      auto prev = std::prev(next);
+      if (prev->first + prev->second == offset)
+      {
+        prev->second += size;
+        m_largestFree = std::max(m_largestFree, prev->second);
+        return;
+      }
+    }
+    m_free.emplace_hint(next, offset, size);
+    m_largestFree = std::max(m_largestFree, size);
+  }
+
+  uint64_t RangeAllocator::largestFreeRange() const
+  {
+    if (m_largestFreeDirty)
+    {
+      m_largestFree = 0;
+      for (const auto& r : m_free)
+        m_largestFree = std::max(m_largestFree, r.second);
+      m_largestFreeDirty = false;
+    }
+    return m_largestFree;
+  }
+
+  RangeAllocatorStats RangeAllocator::stats() const
+  {
+    RangeAllocatorStats s{};
+    s.capacity = m_capacity;
+    s.usedBytes = m_used;
+    s.allocations = static_cast<uint32_t>(m_allocated.size());
+    s.freeRanges = static_cast<uint32_t>(m_free.size());
+    s.failedAllocations = m_failed;
+    s.largestFreeRange = largestFreeRange();
+    return s;
+  }
+}
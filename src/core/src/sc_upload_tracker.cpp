@@ -0,0 +1,115 @@
+#include "sc_upload_tracker.h"
+
+#include <utility>
+
+namespace sc
+{
+  bool UploadTracker::init(uint64_t stagingCapacity)
+  {
+    if (stagingCapacity == 0)
+      return false;
+
+    *this = UploadTracker{};
+    m_capacity = stagingCapacity;
+    m_stats.stagingCapacity = stagingCapacity;
+    return true;
+  }
+
+  void UploadTracker::shutdown()
+  {
+    *this = UploadTracker{};
+  }
+
+  bool UploadTracker::place(uint64_t size, uint64_t align, uint64_t& outHead, uint64_t& outOffset) const
+  {
+    if (m_capacity == 0 || size == 0 || size > m_capacity)
+      return false;
+    if (align == 0)
+      align = 1;
+
+    const uint64_t headOffset = m_head % m_capacity;
+    uint64_t offset = (headOffset + align - 1) & ~(align - 1);
+    uint64_t newHead = m_head + (offset - headOffset);
+
+    // Never split an upload across the wrap point; skip to the start.
+    if (offset + size > m_capacity)
+    {
+      newHead = m_head + (m_capacity - headOffset);
+      offset = 0;
+    }
+
+    // With nothing reserved the bytes skipped at the wrap are free too.
+    const uint64_t tail = (m_head == m_tail) ? newHead : m_tail;
+    if (newHead + size - tail > m_capacity)
+      return false;
+
+    outHead = newHead;
+    outOffset = offset;
+    return true;
+  }
+
+  bool UploadTracker::fits(uint64_t size, uint64_t align) const
+  {
+    uint64_t head = 0;
+    uint64_t offset = 0;
+    return place(size, align, head, offset);
+  }
+
+  uint64_t UploadTracker::reserve(uint64_t size, uint64_t align)
+  {
+    uint64_t newHead = 0;
+    uint64_t offset = 0;
+    if (!place(size, align, newHead, offset))
+    {
+      if (m_capacity != 0 && size != 0)
+        m_stats.stagingFull++;
+      return kInvalidOffset;
+    }
+
+    if (m_head == m_tail)
+      m_tail = newHead;
+    m_openBytes += newHead + size - m_head;
+    m_head = newHead + size;
+    refreshStats();
+    return offset;
+  }
+
+  void UploadTracker::track(uint32_t resourceId)
+  {
+    m_openResources.push_back(resourceId);
+    m_pending++;
+    refreshStats();
+  }
+
+  bool UploadTracker::flush(IUploadQueue& queue)
+  {
+    if (!hasOpenBatch())
+      return true;
+
+    Batch batch{};
+    batch.ticket = m_nextTicket++;
+    batch.stagingEnd = m_head;
+    if (!m_freeLists.empty())
+    {
+      batch.resources = std::move(m_freeLists.back());
+      m_freeLists.pop_back();
+    }
+    batch.resources.swap(m_openResources);
+    batch.failed = !queue.submit(batch.ticket);
+    m_batches.push_back(std::move(batch));
+
+    m_openBytes = 0;
+    m_stats.submittedBatches++;
+    refreshStats();
+    return !m_batches.back().failed;
+  }
+
+  void UploadTracker::refreshStats()
+  {
+    m_stats.stagingInFlight = m_head - m_tail;
+    if (m_stats.stagingInFlight > m_stats.peakStagingInFlight)
+      m_stats.peakStagingInFlight = m_stats.stagingInFlight;
+    m_stats.pendingUploads = m_pending;
+    m_stats.batchesInFlight = static_cast<uint32_t>(m_batches.size());
+  }
+}
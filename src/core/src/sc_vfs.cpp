@@ -0,0 +1,593 @@
+#include "sc_vfs.h"
+#include "sc_log.h"
+#include "sc_paths.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace sc
+{
+  namespace
+  {
+    static constexpr size_t kLzMinMatch = 4;
+    static constexpr size_t kLzLastLiterals = 5;   // a match never covers the tail
+    static constexpr size_t kLzMatchSafety = 12;   // no match starts this close to the end
+    static constexpr uint32_t kLzHashBits = 14;
+    static constexpr size_t kLzMaxOffset = 65535;
+
+    static uint32_t read32(const uint8_t* p)
+    {
+      uint32_t v = 0;
+      std::memcpy(&v, p, sizeof(v));
+      return v;
+    }
+
+    static uint32_t lzHash(uint32_t v)
+    {
+      return (v * 2654435761u) >> (32 - kLzHashBits);
+    }
+
+    static uint8_t* writeLength(uint8_t* op, size_t length)
+    {
+      while (length >= 255)
+      {
+        *op++ = 255;
+        length -= 255;
+      }
+      *op++ = static_cast<uint8_t>(length);
+      return op;
+    }
+
+    static uint8_t* writeSequence(uint8_t* op, const uint8_t* literals, size_t literalCount, size_t offset, size_t matchLength)
+    {
+      uint8_t* token = op++;
+      const size_t matchCode = (matchLength >= kLzMinMatch) ? matchLength - kLzMinMatch : 0;
+      *token = static_cast<uint8_t>((std::min<size_t>(literalCount, 15) << 4) | std::min<size_t>(matchCode, 15));
+      if (literalCount >= 15)
+        op = writeLength(op, literalCount - 15);
+      std::memcpy(op, literals, literalCount);
+      op += literalCount;
+      if (matchLength == 0)
+        return op;
+
+      *op++ = static_cast<uint8_t>(offset & 0xFF);
+      *op++ = static_cast<uint8_t>((offset >> 8) & 0xFF);
+      if (matchCode >= 15)
+        op = writeLength(op, matchCode - 15);
+      return op;
+    }
+
+    static bool readLength(const uint8_t*& ip, const uint8_t* end, size_t& length)
+    {
+      for (;;)
+      {
+        if (ip >= end)
+          return false;
+        const uint8_t b = *ip++;
+        length += b;
+        if (b != 255)
+          return true;
+      }
+    }
+
+    static uint64_t hashBytes(const std::vector<std::byte>& bytes)
+    {
+      return fnv1a64(std::string_view(reinterpret_cast<const char*>(bytes.data()), bytes.size()));
+    }
+
+    static uint64_t alignUp(uint64_t value, uint64_t alignment)
+    {
+      return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    static void setError(std::string* outError, const std::string& message)
+    {
+      if (outError)
+        *outError = message;
+    }
+  }
+
+  size_t lzCompressBound(size_t srcSize)
+  {
+    return srcSize + srcSize / 255 + 16;
+  }
+
+  size_t lzCompress(const uint8_t* src, size_t srcSize, uint8_t* dst)
+  {
+    uint8_t* op = dst;
+    size_t anchor = 0;
+
+    if (srcSize > kLzMatchSafety)
+    {
+      std::vector<uint32_t> table(size_t(1) << kLzHashBits, UINT32_MAX);
+      const size_t matchLimit = srcSize - kLzMatchSafety;
+      const size_t extendLimit = srcSize - kLzLastLiterals;
+
+      size_t ip = 0;
+      while (ip < matchLimit)
+      {
+        const uint32_t seq = read32(src + ip);
+        const uint32_t h = lzHash(seq);
+        const uint32_t ref = table[h];
+        table[h] = static_cast<uint32_t>(ip);
+
+        if (ref == UINT32_MAX || ip - ref > kLzMaxOffset || read32(src + ref) != seq)
+        {
+          ++ip;
+          continue;
+        }
+
+        size_t length = kLzMinMatch;
+        while (ip + length < extendLimit && src[ref + length] == src[ip + length])
+          ++length;
+
+        op = writeSequence(op, src + anchor, ip - anchor, ip - ref, length);
+        ip += length;
+        anchor = ip;
+      }
+    }
+
+    return static_cast<size_t>(writeSequence(op, src + anchor, srcSize - anchor, 0, 0) - dst);
+  }
+
+  bool lzDecompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize)
+  {
+    const uint8_t* ip = src;
+    const uint8_t* const ipEnd = src + srcSize;
+    uint8_t* op = dst;
+    uint8_t* const opEnd = dst + dstSize;
+
+    while (ip < ipEnd)
+    {
+      const uint8_t token = *ip++;
+      size_t literals = token >> 4;
+      if (literals == 15 && !readLength(ip, ipEnd, literals))
+        return false;
+      if (literals > static_cast<size_t>(ipEnd - ip) || literals > static_cast<size_t>(opEnd - op))
+        return false;
+      std::memcpy(op, ip, literals);
+      ip += literals;
+      op += literals;
+
+      // The final sequence carries literals only.
+      if (ip == ipEnd)
+        break;
+
+      if (ipEnd - ip < 2)
+        return false;
+      const size_t offset = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8);
+      ip += 2;
+      size_t length = token & 0x0F;
+      if (length == 15 && !readLength(ip, ipEnd, length))
+        return false;
+      length += kLzMinMatch;
+
+      if (offset == 0 || offset > static_cast<size_t>(op - dst) || length > static_cast<size_t>(opEnd - op))
+        return false;
+      // Byte copy: matches may overlap their own output.
+      const uint8_t* match = op - offset;
+      for (size_t i = 0; i < length; ++i)
+        op[i] = match[i];
+      op += length;
+    }
+
+    return op == opEnd;
+  }
+
+  PackFile::~PackFile()
+  {
+    close();
+  }
+
+  bool PackFile::open(const std::filesystem::path& path)
+  {
+    close();
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+      return false;
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0)
+    {
+      CloseHandle(file);
+      return false;
+    }
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping)
+    {
+      CloseHandle(file);
+      return false;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view)
+    {
+      CloseHandle(mapping);
+      CloseHandle(file);
+      return false;
+    }
+    m_file = file;
+    m_mapping = mapping;
+    m_base = static_cast<const std::byte*>(view);
+    m_size = static_cast<size_t>(size.QuadPart);
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      return false;
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+      ::close(fd);
+      return false;
+    }
+    void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    if (view == MAP_FAILED)
+    {
+      ::close(fd);
+      return false;
+    }
+    m_fd = fd;
+    m_base = static_cast<const std::byte*>(view);
+    m_size = static_cast<size_t>(st.st_size);
+#endif
+    m_path = path;
+
+    PackHeader header{};
+    if (m_size < sizeof(header))
+    {
+      close();
+      return false;
+    }
+    std::memcpy(&header, m_base, sizeof(header));
+    const uint64_t tocEnd = sizeof(PackHeader) + static_cast<uint64_t>(header.entryCount) * sizeof(PackEntry);
+    if (header.magic != kPackMagic || header.version != kPackVersion ||
+        header.fileSize != m_size || tocEnd > header.dataOffset || header.dataOffset > m_size)
+    {
+      close();
+      return false;
+    }
+
+    // The TOC sits right after the 32-byte header in a page-aligned mapping.
+    m_entries = std::span<const PackEntry>(reinterpret_cast<const PackEntry*>(m_base + sizeof(PackHeader)), header.entryCount);
+    for (const PackEntry& entry : m_entries)
+    {
+      if (entry.offset < header.dataOffset || entry.offset > m_size || entry.storedSize > m_size - entry.offset)
+      {
+        close();
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void PackFile::close()
+  {
+#if defined(_WIN32)
+    if (m_base)
+      UnmapViewOfFile(m_base);
+    if (m_mapping)
+      CloseHandle(static_cast<HANDLE>(m_mapping));
+    if (m_file)
+      CloseHandle(static_cast<HANDLE>(m_file));
+    m_file = nullptr;
+    m_mapping = nullptr;
+#else
+    if (m_base)
+      munmap(const_cast<std::byte*>(m_base), m_size);
+    if (m_fd >= 0)
+      ::close(m_fd);
+    m_fd = -1;
+#endif
+    m_base = nullptr;
+    m_size = 0;
+    m_entries = {};
+    m_path.clear();
+  }
+
+  const PackEntry* PackFile::find(uint64_t id) const
+  {
+    const auto it = std::lower_bound(m_entries.begin(), m_entries.end(), id,
+                                     [](const PackEntry& e, uint64_t key) { return e.id < key; });
+    if (it == m_entries.end() || it->id != id)
+      return nullptr;
+    return &*it;
+  }
+
+  std::span<const std::byte> PackFile::stored(const PackEntry& entry) const
+  {
+    return std::span<const std::byte>(m_base + entry.offset, static_cast<size_t>(entry.storedSize));
+  }
+
+  bool PackFile::read(const PackEntry& entry, AssetBlob& out) const
+  {
+    const std::span<const std::byte> bytes = stored(entry);
+    const PackCompression compression = static_cast<PackCompression>(entry.compression);
+    if (compression == PackCompression::None)
+    {
+      out.storage.clear();
+      out.bytes = bytes;
+      return true;
+    }
+    if (compression != PackCompression::Lz)
+      return false;
+
+    out.storage.resize(static_cast<size_t>(entry.size));
+    if (!lzDecompress(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size(),
+                      reinterpret_cast<uint8_t*>(out.storage.data()), out.storage.size()))
+    {
+      out.storage.clear();
+      out.bytes = {};
+      return false;
+    }
+    out.bytes = std::span<const std::byte>(out.storage.data(), out.storage.size());
+    return true;
+  }
+
+  bool buildPack(const std::filesystem::path& outPath,
+                 const std::vector<PackSource>& sources,
+                 const PackBuildOptions& options,
+                 PackBuildStats* outStats,
+                 std::string* outError)
+  {
+    const uint64_t alignment = options.alignment ? options.alignment : 1u;
+    if ((alignment & (alignment - 1)) != 0)
+    {
+      setError(outError, "alignment must be a power of two");
+      return false;
+    }
+
+    struct Blob
+    {
+      std::vector<std::byte> stored;
+      uint64_t size = 0;
+      uint64_t offset = 0;
+      size_t source = 0;
+      PackCompression compression = PackCompression::None;
+    };
+
+    PackBuildStats stats{};
+    std::vector<PackEntry> entries;
+    std::vector<Blob> blobs;
+    std::unordered_multimap<uint64_t, size_t> blobsByHash;
+    entries.reserve(sources.size());
+
+    std::vector<std::byte> bytes;
+    std::vector<std::byte> candidate;
+    for (size_t sourceIndex = 0; sourceIndex < sources.size(); ++sourceIndex)
+    {
+      const PackSource& source = sources[sourceIndex];
+      if (!readLooseFile(source.sourcePath, bytes))
+      {
+        setError(outError, "failed to read " + source.sourcePath.string());
+        return false;
+      }
+
+      PackEntry entry{};
+      entry.id = assetPathId(source.relativePath);
+      entry.contentHash = hashBytes(bytes);
+      entry.size = static_cast<uint64_t>(bytes.size());
+      stats.sourceBytes += entry.size;
+
+      size_t blobIndex = blobs.size();
+      const auto range = blobsByHash.equal_range(entry.contentHash);
+      for (auto it = range.first; it != range.second; ++it)
+      {
+        // Hash hits are rare enough to confirm against the source on disk.
+        const Blob& existing = blobs[it->second];
+        if (existing.size != entry.size)
+          continue;
+        if (readLooseFile(sources[existing.source].sourcePath, candidate) && candidate == bytes)
+        {
+          blobIndex = it->second;
+          break;
+        }
+      }
+
+      if (blobIndex == blobs.size())
+      {
+        Blob blob{};
+        blob.size = entry.size;
+        blob.source = sourceIndex;
+        if (options.compress && !bytes.empty())
+        {
+          std::vector<std::byte> packed(lzCompressBound(bytes.size()));
+          const size_t packedSize = lzCompress(reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size(),
+                                               reinterpret_cast<uint8_t*>(packed.data()));
+          const double savings = 1.0 - static_cast<double>(packedSize) / static_cast<double>(bytes.size());
+          if (savings >= static_cast<double>(options.minCompressionSavings))
+          {
+            packed.resize(packedSize);
+            blob.stored = std::move(packed);
+            blob.compression = PackCompression::Lz;
+            stats.compressedBlobs++;
+          }
+        }
+        if (blob.compression == PackCompression::None)
+          blob.stored = bytes;
+
+        blobs.push_back(std::move(blob));
+        blobsByHash.emplace(entry.contentHash, blobIndex);
+      }
+
+      entry.compression = static_cast<uint32_t>(blobs[blobIndex].compression);
+      entry.storedSize = static_cast<uint64_t>(blobs[blobIndex].stored.size());
+      entry.reserved = static_cast<uint32_t>(blobIndex);   // temporary, cleared below
+      entries.push_back(entry);
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const PackEntry& a, const PackEntry& b) { return a.id < b.id; });
+    for (size_t i = 1; i < entries.size(); ++i)
+    {
+      if (entries[i].id == entries[i - 1].id)
+      {
+        setError(outError, "two sources map to the same asset id");
+        return false;
+      }
+    }
+
+    PackHeader header{};
+    header.entryCount = static_cast<uint32_t>(entries.size());
+    header.alignment = static_cast<uint32_t>(alignment);
+    header.dataOffset = alignUp(sizeof(PackHeader) + entries.size() * sizeof(PackEntry), alignment);
+
+    uint64_t cursor = header.dataOffset;
+    for (Blob& blob : blobs)
+    {
+      blob.offset = cursor;
+      cursor = alignUp(cursor + blob.stored.size(), alignment);
+      stats.storedBytes += blob.stored.size();
+    }
+    // The last blob need not be padded out.
+    if (!blobs.empty())
+      cursor = blobs.back().offset + blobs.back().stored.size();
+    header.fileSize = std::max<uint64_t>(cursor, header.dataOffset);
+
+    for (PackEntry& entry : entries)
+    {
+      entry.offset = blobs[entry.reserved].offset;
+      entry.reserved = 0;
+    }
+
+    std::ofstream out(outPath, std::ios::binary | std::ios::trunc);
+    if (!out.is_open())
+    {
+      setError(outError, "failed to open " + outPath.string());
+      return false;
+    }
+
+    std::vector<char> padding;
+    auto padTo = [&](uint64_t offset)
+    {
+      const uint64_t at = static_cast<uint64_t>(out.tellp());
+      if (offset <= at)
+        return;
+      padding.assign(static_cast<size_t>(offset - at), 0);
+      out.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+    };
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(PackEntry)));
+    padTo(header.dataOffset);
+    for (const Blob& blob : blobs)
+    {
+      padTo(blob.offset);
+      out.write(reinterpret_cast<const char*>(blob.stored.data()), static_cast<std::streamsize>(blob.stored.size()));
+    }
+    padTo(header.fileSize);
+    if (!out.good())
+    {
+      setError(outError, "failed to write " + outPath.string());
+      return false;
+    }
+
+    stats.entries = header.entryCount;
+    stats.uniqueBlobs = static_cast<uint32_t>(blobs.size());
+    stats.fileBytes = header.fileSize;
+    if (outStats)
+      *outStats = stats;
+    return true;
+  }
+
+  bool Vfs::mountPack(const std::filesystem::path& path)
+  {
+    auto pack = std::make_unique<PackFile>();
+    if (!pack->open(path))
+    {
+      sc::log(LogLevel::Warn, "VFS: failed to mount '%s'.", path.string().c_str());
+      return false;
+    }
+    sc::log(LogLevel::Info, "VFS: mounted '%s' (%u entries).", path.string().c_str(),
+            static_cast<uint32_t>(pack->entries().size()));
+    m_packs.push_back(std::move(pack));
+    return true;
+  }
+
+  void Vfs::unmountAll()
+  {
+    m_packs.clear();
+  }
+
+  const PackEntry* Vfs::findPacked(uint64_t id, const PackFile** outPack) const
+  {
+    for (auto it = m_packs.rbegin(); it != m_packs.rend(); ++it)
+    {
+      if (const PackEntry* entry = (*it)->find(id))
+      {
+        *outPack = it->get();
+        return entry;
+      }
+    }
+    return nullptr;
+  }
+
+  bool Vfs::readPacked(uint64_t id, AssetBlob& out) const
+  {
+    const PackFile* pack = nullptr;
+    const PackEntry* entry = findPacked(id, &pack);
+    return entry && pack->read(*entry, out);
+  }
+
+  bool Vfs::read(std::string_view relativePath, AssetBlob& out) const
+  {
+    const std::filesystem::path path(relativePath);
+    if (!path.is_absolute() && !m_packs.empty() && readPacked(assetPathId(relativePath), out))
+      return true;
+
+    if (!readLooseFile(resolveAssetPath(path), out.storage))
+    {
+      out.bytes = {};
+      return false;
+    }
+    out.bytes = std::span<const std::byte>(out.storage.data(), out.storage.size());
+    return true;
+  }
+
+  bool Vfs::exists(std::string_view relativePath) const
+  {
+    const std::filesystem::path path(relativePath);
+    const PackFile* pack = nullptr;
+    if (!path.is_absolute() && findPacked(assetPathId(relativePath), &pack))
+      return true;
+    std::error_code ec;
+    return std::filesystem::exists(resolveAssetPath(path), ec);
+  }
+
+  static Vfs g_vfs;
+
+  Vfs& vfs()
+  {
+    return g_vfs;
+  }
+
+  uint64_t assetPathId(std::string_view relativePath)
+  {
+    return fnv1a64(normalizePathForId(std::filesystem::path(relativePath)));
+  }
+
+  bool readLooseFile(const std::filesystem::path& path, std::vector<std::byte>& out)
+  {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+      return false;
+    const std::streamoff size = file.tellg();
+    if (size < 0)
+      return false;
+    out.resize(static_cast<size_t>(size));
+    file.seekg(0, std::ios::beg);
+    file.read(reinterpret_cast<char*>(out.data()), static_cast<std::streamsize>(out.size()));
+    return static_cast<size_t>(file.gcount()) == out.size();
+  }
+}
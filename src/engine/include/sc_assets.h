@@ -2,12 +2,24 @@
 
 #include <vulkan/vulkan.h>
 
+#include <cstddef>
 #include <cstdint>
 #include <deque>
+#include <mutex>
+#include <span>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
+#include "sc_ecs.h"
+#include "sc_upload_tracker.h"
+
+namespace sc_import
+{
+  struct MeshData;
+}
+
 namespace sc
 {
   using AssetId = uint64_t;
@@ -19,6 +31,9 @@ namespace sc
   static constexpr MeshHandle kInvalidMeshHandle = UINT32_MAX;
   static constexpr MaterialHandle kInvalidMaterialHandle = UINT32_MAX;
 
+  // The renderer owns the mesh arena, so cooked meshes are uploaded through it.
+  using MeshUploadFn = MeshHandle(*)(const sc_import::MeshData& mesh, void* user);
+
   enum class PipelineId : uint32_t
   {
     UnlitColor = 0,
@@ -29,7 +44,24 @@ namespace sc
   {
     Unknown = 0,
     RGBA8_SRGB = 1,
-    RGBA8_UNORM = 2
+    RGBA8_UNORM = 2,
+    BC1_SRGB = 3,
+    BC1_UNORM = 4,
+    BC3_SRGB = 5,
+    BC3_UNORM = 6,
+    BC7_SRGB = 7,
+    BC7_UNORM = 8
+  };
+
+  static constexpr uint32_t kMaxTextureMips = 16;
+
+  // One level inside a texture's packed data blob.
+  struct TextureMipLevel
+  {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint64_t offset = 0;
+    uint64_t size = 0;
   };
 
   struct MaterialDesc
@@ -61,7 +93,16 @@ namespace sc
     bool resident = false;
     bool pinned = false;
     uint64_t lastUsedFrame = 0;
+    float importance = 0.0f;    // largest screen size it was drawn at in lastUsedFrame
+    uint32_t loadSerial = 0;    // bumped per load; decodes for an older serial are dropped
     bool loading = false;
+    bool uploading = false;     // copy submitted, waiting on its fence
+    bool acquirePending = false;  // copied on the transfer queue, graphics has not acquired it yet
+
+    // Intrusive LRU links; only resident, evictable textures are linked.
+    TextureHandle lruPrev = kInvalidTextureHandle;
+    TextureHandle lruNext = kInvalidTextureHandle;
+    bool inLru = false;
 
     VkImage image = VK_NULL_HANDLE;
     VkDeviceMemory memory = VK_NULL_HANDLE;
@@ -74,6 +115,7 @@ namespace sc
     uint32_t textureCount = 0;
     uint32_t meshCount = 0;
     uint32_t materialCount = 0;
+    uint32_t meshLodSetCount = 0;
     uint64_t cpuBytes = 0;
     uint64_t gpuBytes = 0;
     uint64_t textureCacheHits = 0;
@@ -83,11 +125,22 @@ namespace sc
     uint64_t materialCacheHits = 0;
     uint64_t materialCacheMisses = 0;
     uint32_t residentTextures = 0;
-    uint32_t queuedTextureLoads = 0;
+    uint32_t compressedTextures = 0;   // resident with a BCn format
+    uint32_t queuedTextureLoads = 0;        // requested, waiting for a decode slot
+    uint32_t texturesDecoding = 0;
+    uint32_t texturesAwaitingUpload = 0;
+    uint32_t texturesDecodedThisFrame = 0;
+    float decodeLatencyAvgMs = 0.0f;        // request -> decoded, over this frame's uploads
+    float decodeLatencyMaxMs = 0.0f;
     uint32_t evictions = 0;
     uint64_t gpuBudgetBytes = 0;
     uint64_t gpuResidentBytes = 0;
     float evictionMs = 0.0f;
+    uint32_t pendingTextureUploads = 0;
+    uint64_t stagingCapacity = 0;
+    uint64_t stagingInFlight = 0;
+    uint64_t stagingFull = 0;
+    bool dedicatedTransferQueue = false;
     bool samplerAnisotropyEnabled = false;
     float samplerMaxAnisotropy = 1.0f;
   };
@@ -106,18 +159,64 @@ namespace sc
     VkDevice device = VK_NULL_HANDLE;
     VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
     VkQueue graphicsQueue = VK_NULL_HANDLE;
+    uint32_t graphicsFamily = 0;
+    // Same as the graphics queue/family when the device has no dedicated transfer queue.
+    VkQueue transferQueue = VK_NULL_HANDLE;
+    uint32_t transferFamily = 0;
     VkCommandPool commandPool = VK_NULL_HANDLE;
     VkDescriptorPool materialDescriptorPool = VK_NULL_HANDLE;
     VkDescriptorSetLayout materialSetLayout = VK_NULL_HANDLE;
     bool samplerAnisotropyEnabled = false;
     float samplerMaxAnisotropy = 1.0f;
+    bool textureCompressionBC = false;
+    // Upload submits signal a timeline semaphore the frame submit can wait on.
+    bool timelineSemaphore = false;
+    uint64_t stagingBytes = 64ull * 1024ull * 1024ull;
+  };
+
+  // Upload queue over a VkQueue: one pooled command buffer + fence per ticket.
+  // With timeline semaphores each submit also signals the semaphore to its ticket.
+  class VkTransferQueue final : public IUploadQueue
+  {
+  public:
+    bool init(VkDevice device, VkQueue queue, uint32_t family, bool timelineSemaphore);
+    void shutdown();
+
+    // Command buffer recording the open ticket; begun on first use.
+    VkCommandBuffer commandBuffer();
+    bool submit(uint64_t ticket) override;
+    uint64_t completedTicket() override;
+    // Blocks on the oldest submitted batch only. False when nothing is in flight.
+    bool waitOldest();
+    void waitIdle();
+    VkSemaphore timelineSemaphore() const { return m_timeline; }
+
+  private:
+    struct Slot
+    {
+      VkCommandBuffer cmd = VK_NULL_HANDLE;
+      VkFence fence = VK_NULL_HANDLE;
+      uint64_t ticket = 0;
+    };
+
+    VkDevice m_device = VK_NULL_HANDLE;
+    VkQueue m_queue = VK_NULL_HANDLE;
+    VkCommandPool m_pool = VK_NULL_HANDLE;
+    VkSemaphore m_timeline = VK_NULL_HANDLE;
+    std::vector<Slot> m_slots;
+    std::deque<uint32_t> m_inFlight;  // slot indices in submission order
+    std::vector<uint32_t> m_freeSlots;
+    uint32_t m_recording = UINT32_MAX;
+    uint64_t m_completed = 0;
   };
 
   struct AssetResidencyConfig
   {
     uint64_t gpuBudgetBytes = 256ull * 1024ull * 1024ull;
     uint32_t maxResidentTextures = 512u;
-    uint32_t maxTextureLoadsPerFrame = 2u;
+    // Decoded textures handed to the staging ring per frame.
+    uint32_t maxTextureLoadsPerFrame = 8u;
+    uint32_t maxTextureDecodesInFlight = 8u;
     bool freezeEviction = false;
   };
 
@@ -130,9 +229,17 @@ namespace sc
     void setCommandContext(VkCommandPool commandPool, VkQueue graphicsQueue);
 
     TextureHandle loadTexture2D(const std::string& path, bool srgb = true);
+    // Aliases resolve first; otherwise path (or path + ".scmesh") is read as a
+    // cooked mesh and every LOD is uploaded. Failed paths are not retried.
     MeshHandle loadMesh(const std::string& path);
     void registerMeshAlias(const std::string& path, MeshHandle handle);
+    void setMeshUploader(MeshUploadFn fn, void* user);
     MaterialHandle createMaterial(const MaterialDesc& desc);
+    // Returns an id for RenderMesh::lodSetId, or kInvalidMeshLodSet if the set is empty.
+    uint32_t createMeshLodSet(const MeshLodSet& set);
+    const MeshLodSet* getMeshLodSet(uint32_t id) const;
+    // LOD set registered for a cooked mesh's LOD 0 handle, or kInvalidMeshLodSet.
+    uint32_t meshLodSetFor(MeshHandle handle) const;
 
     const Material* getMaterial(MaterialHandle handle) const;
     const TextureAsset* getTexture(TextureHandle handle) const;
@@ -147,13 +254,60 @@ namespace sc
     void setFreezeEviction(bool freeze) { m_residency.freezeEviction = freeze; }
 
     void beginFrame(uint64_t frameIndex);
-    void touchMaterial(MaterialHandle handle);
+    // screenSize feeds the decode priority of the material's texture.
+    void touchMaterial(MaterialHandle handle, float screenSize = 0.0f);
     void touchMesh(MeshHandle /*handle*/) {}
     void requestTextureResident(TextureHandle handle);
     void pumpTextureLoads(uint32_t maxLoadsPerFrame);
+    // Blocks until every decode job has returned. Call before the job system shuts down.
+    void drainTextureDecodes();
+    // Retires finished texture uploads, starts deferred ones and submits everything recorded since the last call.
+    void pumpUploads();
+    // Copies bytes into dst through the staging ring on the upload queue; dst must be
+    // usable from uploadQueueFamily(). Returns the ticket the copy completes with
+    // (see completedUploadTicket()), or 0 on failure.
+    uint64_t uploadBufferData(VkBuffer dst, VkDeviceSize dstOffset, const void* data, VkDeviceSize bytes);
+    uint64_t completedUploadTicket() { return m_transfer.completedTicket(); }
+    uint32_t uploadQueueFamily() const { return m_transferFamily; }
+    // Signalled to each upload ticket as it completes; null without timeline semaphore support.
+    VkSemaphore uploadTimelineSemaphore() const { return m_transfer.timelineSemaphore(); }
+    // Records the graphics-queue acquire for textures copied on a dedicated transfer
+    // queue; they turn resident here. Call before the render pass begins, and have
+    // the submit wait on uploadTimelineSemaphore() for the completed ticket.
+    void recordTextureAcquires(VkCommandBuffer cmd);
     void evictIfNeeded();
 
   private:
+    struct TextureDecodeResult
+    {
+      TextureHandle handle = kInvalidTextureHandle;
+      uint32_t serial = 0;
+      uint32_t width = 0;
+      uint32_t height = 0;
+      TextureFormat format = TextureFormat::RGBA8_SRGB;  // cooked files override it
+      uint32_t mipCount = 0;
+      TextureMipLevel mips[kMaxTextureMips]{};
+      std::vector<unsigned char> pixels;
+      uint64_t requestTicks = 0;
+      uint64_t decodedTicks = 0;
+      bool ok = false;
+      bool fromDisk = true;
+    };
+
+    // Runs on job workers. path is asset-relative and read through sc::vfs(),
+    // so it may come from a mounted pack or a loose file.
+    static bool decodeTextureAsset(const std::string& path, TextureDecodeResult& result);
+    // Accepts a cooked .sctex image or anything stb_image decodes.
+    static bool decodeTextureBytes(std::span<const std::byte> bytes, TextureDecodeResult& result);
+    void dispatchTextureDecodes();
+    void collectTextureDecodes();
+    // Uploads decoded or deferred textures while the per-frame budget and the ring allow.
+    void uploadReadyTextures(uint32_t maxUploadsPerFrame);
+    bool uploadDecodedTexture(TextureDecodeResult& result);
+    void releasePixelBuffer(std::vector<unsigned char>&& pixels);
+    // True when the copy has to wait for ring space or the texture's previous copy;
+    // such uploads are queued with the decoded textures instead of blocking.
+    bool mustDeferUpload(const TextureAsset& tex, uint64_t bytes) const;
     bool createTextureFromPixels(const std::string& debugPath,
                                  AssetId assetId,
                                  const unsigned char* rgbaPixels,
@@ -162,13 +316,22 @@ namespace sc
                                  bool fromDisk,
                                  bool srgb,
                                  TextureHandle& outHandle);
-    void destroyTextureGpu(TextureAsset& texture);
+    void destroyTextureGpu(TextureHandle handle);
+    void setResident(TextureHandle handle, bool resident);
+    void touchTexture(TextureHandle handle);
+    void lruLink(TextureHandle handle);
+    void lruUnlink(TextureHandle handle);
     void refreshMaterialsForTexture(TextureHandle handle);
-    bool uploadTexturePixels(const unsigned char* rgbaPixels,
+    bool uploadTexturePixels(const unsigned char* data,
                              uint32_t width,
                              uint32_t height,
                              TextureFormat format,
-                             TextureAsset& outTexture);
+                             const TextureMipLevel* mips,
+                             uint32_t mipCount,
+                             TextureHandle handle);
+    void retireUploads();
+    void finishUploads();
+    MeshHandle loadCookedMesh(const std::string& path, AssetId id);
     bool writeMaterialDescriptor(Material& material);
     TextureHandle createFallbackTexture(const std::string& debugPath, AssetId id);
 
@@ -177,19 +340,27 @@ namespace sc
     VkPhysicalDevice m_phys = VK_NULL_HANDLE;
     VkQueue m_graphicsQueue = VK_NULL_HANDLE;
     VkCommandPool m_commandPool = VK_NULL_HANDLE;
+    uint32_t m_graphicsFamily = 0;
+    uint32_t m_transferFamily = 0;
     VkDescriptorPool m_materialDescriptorPool = VK_NULL_HANDLE;
     VkDescriptorSetLayout m_materialSetLayout = VK_NULL_HANDLE;
     bool m_samplerAnisotropyEnabled = false;
     float m_samplerMaxAnisotropy = 1.0f;
+    bool m_textureCompressionBC = false;
 
     TextureHandle m_defaultWhiteTexture = kInvalidTextureHandle;
     TextureHandle m_placeholderTexture = kInvalidTextureHandle;
+    MeshUploadFn m_meshUploader = nullptr;
+    void* m_meshUploaderUser = nullptr;
 
     std::vector<TextureAsset> m_textures;
     std::vector<Material> m_materials;
+    std::vector<MeshLodSet> m_meshLodSets;
 
     std::unordered_map<AssetId, TextureHandle> m_textureCache;
     std::unordered_map<AssetId, MeshHandle> m_meshCache;
+    std::unordered_set<AssetId> m_missingMeshes;
+    std::unordered_map<MeshHandle, uint32_t> m_meshLodSetByMesh;
     std::unordered_map<uint64_t, MaterialHandle> m_materialCache;
 
     uint64_t m_textureCacheHits = 0;
@@ -204,6 +375,30 @@ namespace sc
     uint64_t m_evictionsThisFrame = 0;
     uint64_t m_queuedLoadsThisFrame = 0;
     uint64_t m_evictionTicks = 0;
-    std::deque<TextureHandle> m_textureLoadQueue;
+    std::vector<TextureHandle> m_textureLoadQueue;
+
+    // Head is most recently used; eviction pops from the tail.
+    TextureHandle m_lruHead = kInvalidTextureHandle;
+    TextureHandle m_lruTail = kInvalidTextureHandle;
+    uint64_t m_residentBytes = 0;
+    uint32_t m_residentCount = 0;
+
+    // Decode jobs push into m_decodedTextures; everything else is main-thread only.
+    std::mutex m_decodeMutex;
+    std::vector<TextureDecodeResult> m_decodedTextures;
+    std::deque<TextureDecodeResult> m_readyTextures;
+    std::vector<TextureHandle> m_pendingAcquires;
+    std::vector<std::vector<unsigned char>> m_pixelBufferPool;
+    uint32_t m_texturesDecoding = 0;
+    uint32_t m_decodedThisFrame = 0;
+    uint32_t m_uploadsThisFrame = 0;
+    double m_decodeLatencyTotalMs = 0.0;
+    float m_decodeLatencyMaxMs = 0.0f;
+
+    VkTransferQueue m_transfer{};
+    UploadTracker m_uploads{};
+    VkBuffer m_stagingBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory m_stagingMemory = VK_NULL_HANDLE;
+    unsigned char* m_stagingMapped = nullptr;
   };
 }
@@ -125,6 +125,8 @@ typedef struct ScRenderStats
   uint32_t texture_count;
   float gpu_ms;
   float cpu_ms;
+  uint32_t raw_draws;         // draw items submitted this frame
+  uint32_t instanced_batches; // instanced draw calls they collapsed into
 } ScRenderStats;
 
 SC_RENDER_API uint32_t scRenderGetApiVersion();
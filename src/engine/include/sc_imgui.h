@@ -10,6 +10,10 @@
 #include "sc_debug_draw.h"
 #include "sc_scheduler.h"
 #include "sc_assets.h"
+#include "sc_draw_batch.h"
+#include "sc_draw_record.h"
+#include "sc_frame_ring.h"
+#include "sc_range_allocator.h"
 
 struct SDL_Window;
 union SDL_Event;
@@ -46,6 +50,14 @@ namespace sc
     void setFrameStats(uint32_t frameIndex, uint32_t imageIndex, VkExtent2D extent);
     void setTelemetry(const JobsTelemetrySnapshot& jobs, const MemStats& mem);
     void setEcsStats(const EcsStatsSnapshot& ecs, const SchedulerStatsSnapshot& sched);
+    void setDrawBatchStats(const DrawBatchStats& stats) { m_batchStats = stats; }
+    void setDrawRecordStats(const DrawRecordStats& stats) { m_recordStats = stats; }
+    void setUploadRingStats(const FrameRingStats& stats) { m_uploadRingStats = stats; }
+    void setMeshArenaStats(const RangeAllocatorStats& vertices, const RangeAllocatorStats& indices)
+    {
+      m_meshVertexArenaStats = vertices;
+      m_meshIndexArenaStats = indices;
+    }
     bool isTrianglePaused() const { return m_pauseTriangle; }
     void setWorldContext(World* world, Entity camera, Entity triangle, Entity cube, Entity root);
     void setWorldStreamingContext(WorldStreamingState* streaming,
@@ -96,6 +108,11 @@ namespace sc
     MemStats m_memSnap{};
     EcsStatsSnapshot m_ecsSnap{};
     SchedulerStatsSnapshot m_schedSnap{};
+    DrawBatchStats m_batchStats{};
+    DrawRecordStats m_recordStats{};
+    FrameRingStats m_uploadRingStats{};
+    RangeAllocatorStats m_meshVertexArenaStats{};
+    RangeAllocatorStats m_meshIndexArenaStats{};
 
     World* m_world = nullptr;
     Entity m_cameraEntity = kInvalidEntity;
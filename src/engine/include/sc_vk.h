@@ -8,6 +8,11 @@
 
 #include "sc_imgui.h"
 #include "sc_assets.h"
+#include "sc_radix_sort.h"
+#include "sc_draw_batch.h"
+#include "sc_frame_ring.h"
+#include "sc_range_allocator.h"
+#include "sc_draw_record.h"
 
 struct SDL_Window;
 union SDL_Event;
@@ -31,13 +36,15 @@ namespace sc
     float uv[2]{};
   };
 
+  // Ranges inside one block of the mesh arena (see VkRenderer::m_meshArenaBlocks).
   struct GpuMesh
   {
-    VkBuffer vertexBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory vertexMemory = VK_NULL_HANDLE;
-    VkBuffer indexBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory indexMemory = VK_NULL_HANDLE;
+    uint32_t firstIndex = 0;
     uint32_t indexCount = 0;
+    int32_t vertexOffset = 0;
+    uint32_t vertexCount = 0;
+    uint32_t arenaBlock = 0;
+    uint64_t uploadTicket = 0;  // not drawn until the upload queue completes this ticket
   };
 
   struct MeshBounds
@@ -50,6 +57,25 @@ namespace sc
   {
     bool enableValidation = true;
     bool enableDebugUI = true;
+    uint64_t uploadRingBytes = 32ull * 1024ull * 1024ull;
+    // Size of each mesh arena block; another block is chained on when one fills up.
+    uint64_t meshVertexArenaBytes = 64ull * 1024ull * 1024ull;
+    uint64_t meshIndexArenaBytes = 32ull * 1024ull * 1024ull;
+    // Batches are recorded into up to maxRecordRanges secondary command buffers
+    // on the job system once there are enough to give each range this many.
+    uint32_t maxRecordRanges = 8;
+    uint32_t minBatchesPerRecordRange = 256;
+    // Texture uploads go through this staging ring, on a transfer-only queue
+    // family when the device exposes one.
+    uint64_t textureStagingBytes = 64ull * 1024ull * 1024ull;
+    bool useTransferQueue = true;
+  };
+
+  struct UploadAllocation
+  {
+    void* ptr = nullptr;
+    VkBuffer buffer = VK_NULL_HANDLE;
+    VkDeviceSize offset = 0;
   };
 
   class VkRenderer
@@ -85,6 +111,7 @@ namespace sc
     const AssetManager& assets() const { return m_assets; }
 
     float swapchainAspect() const;
+    uint32_t swapchainHeight() const { return m_swapchainExtent.height; }
 
     bool initExternalImGui();
     void shutdownExternalImGui();
@@ -101,6 +128,16 @@ namespace sc
     void destroyMesh(MeshHandle handle);
     bool getMeshBounds(MeshHandle handle, float out_min[3], float out_max[3]) const;
     uint32_t meshCount() const { return static_cast<uint32_t>(m_meshes.size()); }
+    const DrawBatchStats& drawBatchStats() const { return m_batchStats; }
+    const DrawRecordStats& drawRecordStats() const { return m_recordStats; }
+
+    // Per-frame transient data (instances, debug vertices, ...). Valid until this
+    // frame slot comes around again; returns a null ptr on ring overflow.
+    UploadAllocation allocateUpload(VkDeviceSize size, VkDeviceSize align);
+    const FrameRingStats& uploadRingStats() const { return m_uploadRing.stats(); }
+    // Summed over every arena block.
+    RangeAllocatorStats meshVertexArenaStats() const;
+    RangeAllocatorStats meshIndexArenaStats() const;
 
   private:
     bool createInstance(SDL_Window* window);
@@ -115,11 +152,40 @@ namespace sc
     bool createDepthResources();
     bool createFramebuffers();
     bool createCommands();
+    bool createRecordPools();
+    void destroyRecordPools();
     bool createSync();
     bool createMeshes();
     void destroyMeshes();
-    bool createDebugDrawBuffers(size_t vertexCapacity);
-    void destroyDebugDrawBuffers();
+    bool createMeshArena();
+    void destroyMeshArena();
+    bool addMeshArenaBlock(uint64_t vertexBytes, uint64_t indexBytes);
+    bool allocateGpuMesh(const MeshVertex* verts,
+                         uint32_t vertCount,
+                         const uint32_t* indices,
+                         uint32_t indexCount,
+                         GpuMesh& out);
+    void releaseGpuMesh(GpuMesh& mesh);
+    void processMeshReleases();
+    bool createUploadRing(uint64_t bytes);
+    void destroyUploadRing();
+
+    struct BatchRecordState
+    {
+      VkViewport viewport{};
+      VkRect2D scissor{};
+    };
+    void uploadDrawInstances();
+    uint32_t recordBatchRange(VkCommandBuffer cmd, uint32_t rangeIndex) const;
+    void recordOverlay(VkCommandBuffer cmd);
+
+    // Records each range into this frame's secondary buffer for that range.
+    struct SecondaryRangeRecorder : IDrawRangeRecorder
+    {
+      VkRenderer* renderer = nullptr;
+      const BatchRecordState* state = nullptr;
+      uint32_t recordRange(uint32_t rangeIndex, const DrawRange& range) override;
+    };
 
     bool recreateSwapchain();
     void destroySwapchainObjects();
@@ -149,6 +215,8 @@ namespace sc
 
     uint32_t m_gfxFamily = UINT32_MAX;
     VkQueue  m_gfxQueue = VK_NULL_HANDLE;
+    uint32_t m_transferFamily = UINT32_MAX;  // UINT32_MAX = no dedicated transfer queue
+    VkQueue  m_transferQueue = VK_NULL_HANDLE;
 
     // Swapchain + views
     VkSwapchainKHR m_swapchain = VK_NULL_HANDLE;
@@ -183,6 +251,18 @@ namespace sc
     VkCommandPool m_cmdPool = VK_NULL_HANDLE;
     std::vector<VkCommandBuffer> m_cmdBuffers;
 
+    // Secondary recording: one pool per range so workers never share a pool.
+    VkCommandPool m_recordPools[MAX_FRAMES][kMaxDrawRecordRanges]{};
+    VkCommandBuffer m_recordCmds[MAX_FRAMES][kMaxDrawRecordRanges]{};
+    bool m_recordCmdValid[kMaxDrawRecordRanges]{};
+    VkCommandBuffer m_overlayCmds[MAX_FRAMES]{};
+    std::vector<DrawRange> m_drawRanges;
+    std::vector<UploadAllocation> m_rangeInstances;  // starts at each range's first instance
+    bool m_instanceUploadSplit = false;
+    std::vector<uint32_t> m_rangeIssued;
+    std::vector<VkCommandBuffer> m_executeCmds;
+    DrawRecordStats m_recordStats{};
+
     // Sync per-frame (frames-in-flight)
     VkSemaphore m_imageAvailable[MAX_FRAMES] = { VK_NULL_HANDLE, VK_NULL_HANDLE };
     VkSemaphore m_renderFinished[MAX_FRAMES] = { VK_NULL_HANDLE, VK_NULL_HANDLE };
@@ -205,12 +285,38 @@ namespace sc
 
     std::vector<GpuMesh> m_meshes;
     std::vector<MeshBounds> m_meshBounds;
+
+    struct PendingMeshRelease
+    {
+      uint32_t arenaBlock = 0;
+      uint64_t vertexByteOffset = 0;
+      uint64_t indexByteOffset = 0;
+      uint64_t retireFrame = 0;
+      uint64_t uploadTicket = 0;
+    };
+    struct MeshArenaBlock
+    {
+      VkBuffer vertexBuffer = VK_NULL_HANDLE;
+      VkDeviceMemory vertexMemory = VK_NULL_HANDLE;
+      VkBuffer indexBuffer = VK_NULL_HANDLE;
+      VkDeviceMemory indexMemory = VK_NULL_HANDLE;
+      RangeAllocator vertexRanges{};
+      RangeAllocator indexRanges{};
+    };
+    std::vector<MeshArenaBlock> m_meshArenaBlocks;
+    std::vector<PendingMeshRelease> m_pendingMeshReleases;
+    uint64_t m_uploadsCompleted = 0;  // upload ticket completed as of beginFrame
+    uint64_t m_frameSerial = 0;
+    std::vector<SortKeyIndex> m_drawSortItems;
+    std::vector<SortKeyIndex> m_drawSortScratch;
     AssetManager m_assets{};
     std::vector<std::string> m_textureOptionLabels;
     std::vector<MaterialHandle> m_textureOptionMaterials;
     uint32_t m_sceneTextureSelection = 0;
     bool m_samplerAnisotropyEnabled = false;
     float m_samplerMaxAnisotropy = 1.0f;
+    bool m_textureCompressionBC = false;
+    bool m_timelineSemaphore = false;
 
     VkDescriptorPool m_externalImGuiPool = VK_NULL_HANDLE;
     bool m_externalImGuiInitialized = false;
@@ -223,9 +329,11 @@ namespace sc
     };
     std::unordered_map<TextureHandle, ImGuiTextureCacheEntry> m_imguiTextureCache;
 
-    VkBuffer m_debugVertexBuffers[MAX_FRAMES] = { VK_NULL_HANDLE, VK_NULL_HANDLE };
-    VkDeviceMemory m_debugVertexMemory[MAX_FRAMES] = { VK_NULL_HANDLE, VK_NULL_HANDLE };
-    void* m_debugVertexMapped[MAX_FRAMES] = { nullptr, nullptr };
-    size_t m_debugVertexCapacity = 0;
+    VkBuffer m_uploadBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory m_uploadMemory = VK_NULL_HANDLE;
+    uint8_t* m_uploadMapped = nullptr;
+    FrameRing m_uploadRing{};
+    DrawBatchBuilder m_batchBuilder{};
+    DrawBatchStats m_batchStats{};
   };
 }
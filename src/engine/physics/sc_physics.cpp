@@ -7,8 +7,24 @@
 #include <btBulletDynamicsCommon.h>
 #include <BulletDynamics/Vehicle/btRaycastVehicle.h>
 
+#if BT_THREADSAFE
+#include "sc_jobs.h"
+
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
+#include <LinearMath/btThreads.h>
+
+#include <atomic>
+#include <mutex>
+#endif
+
 #include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <memory>
+#include <tuple>
+#include <unordered_map>
 
 namespace sc
 {
@@ -87,6 +103,227 @@ namespace sc
       int m_debugMode = DBG_DrawWireframe;
     };
 
+#if BT_THREADSAFE
+    // Splits [begin, end) into grain-sized chunks claimed from a shared counter
+    // by the caller and up to maxThreads - 1 jobs. The caller keeps claiming
+    // until none are left, so nested loops and a busy queue cannot stall it.
+    template<typename F>
+    static void parallelChunks(int begin, int end, int grain, int maxThreads, const F& fn)
+    {
+      grain = std::max(1, grain);
+      const int chunkCount = (end - begin + grain - 1) / grain;
+      const int helpers = std::min(chunkCount, maxThreads) - 1;
+      if (helpers <= 0)
+      {
+        if (end > begin)
+          fn(begin, end);
+        return;
+      }
+
+      std::atomic<int> next{ begin };
+      auto drain = [&]()
+      {
+        for (;;)
+        {
+          const int chunkBegin = next.fetch_add(grain, std::memory_order_relaxed);
+          if (chunkBegin >= end)
+            return;
+          fn(chunkBegin, std::min(chunkBegin + grain, end));
+        }
+      };
+
+      JobSystem& js = jobs();
+      JobHandle handle = js.Dispatch(static_cast<uint32_t>(helpers), 1u, [&drain](const JobContext&) { drain(); });
+      drain();
+      js.Wait(handle);
+    }
+
+    // Runs Bullet's parallel loops on sc::jobs() so physics shares the engine
+    // workers instead of starting a second pool.
+    class JobTaskScheduler final : public btITaskScheduler
+    {
+    public:
+      JobTaskScheduler() : btITaskScheduler("sc::jobs") {}
+
+      int getMaxNumThreads() const override { return BT_MAX_THREAD_COUNT; }
+      int getNumThreads() const override { return m_numThreads; }
+      void setNumThreads(int numThreads) override
+      {
+        m_numThreads = std::max(1, std::min(numThreads, static_cast<int>(BT_MAX_THREAD_COUNT)));
+      }
+
+      void parallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body) override
+      {
+        parallelChunks(iBegin, iEnd, grainSize, m_numThreads, [&body](int begin, int end) { body.forLoop(begin, end); });
+      }
+
+      btScalar parallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body) override
+      {
+        std::mutex sumMutex;
+        btScalar sum = btScalar(0);
+        parallelChunks(iBegin, iEnd, grainSize, m_numThreads, [&](int begin, int end)
+        {
+          const btScalar partial = body.sumLoop(begin, end);
+          std::lock_guard<std::mutex> lock(sumMutex);
+          sum += partial;
+        });
+        return sum;
+      }
+
+    private:
+      int m_numThreads = 1;
+    };
+#endif
+
+    // Hash-consed collision shapes: colliders with the same type and scaled
+    // dimensions share one btCollisionShape. Shapes are refcounted, never
+    // modified once built, and remember their slot in their user index.
+    class ShapeCache
+    {
+    public:
+      ~ShapeCache() { clear(); }
+
+      btCollisionShape* acquire(const Collider& collider, const Transform& transform)
+      {
+        const Key key = makeKey(collider, transform);
+        auto it = m_lookup.find(key);
+        if (it != m_lookup.end())
+        {
+          m_entries[it->second].refs++;
+          return m_entries[it->second].shape;
+        }
+
+        uint32_t slot = 0;
+        if (!m_free.empty())
+        {
+          slot = m_free.back();
+          m_free.pop_back();
+        }
+        else
+        {
+          slot = static_cast<uint32_t>(m_entries.size());
+          m_entries.emplace_back();
+        }
+
+        Entry& entry = m_entries[slot];
+        entry.key = key;
+        entry.shape = buildShape(key);
+        entry.shape->setUserIndex(static_cast<int>(slot));
+        entry.refs = 1;
+        m_lookup.emplace(key, slot);
+        m_live++;
+        return entry.shape;
+      }
+
+      void release(btCollisionShape* shape)
+      {
+        if (!shape)
+          return;
+        const uint32_t slot = static_cast<uint32_t>(shape->getUserIndex());
+        if (slot >= m_entries.size() || m_entries[slot].shape != shape)
+          return;
+
+        Entry& entry = m_entries[slot];
+        if (--entry.refs > 0)
+          return;
+        m_lookup.erase(entry.key);
+        delete entry.shape;
+        entry = Entry{};
+        m_free.push_back(slot);
+        m_live--;
+      }
+
+      void clear()
+      {
+        for (Entry& entry : m_entries)
+          delete entry.shape;
+        m_entries.clear();
+        m_free.clear();
+        m_lookup.clear();
+        m_live = 0;
+      }
+
+      uint32_t size() const { return m_live; }
+
+    private:
+      struct Key
+      {
+        ColliderType type = ColliderType::Box;
+        float dims[3] = { 0.0f, 0.0f, 0.0f };
+
+        bool operator==(const Key& o) const
+        {
+          return type == o.type && dims[0] == o.dims[0] && dims[1] == o.dims[1] && dims[2] == o.dims[2];
+        }
+      };
+
+      struct KeyHash
+      {
+        size_t operator()(const Key& k) const noexcept
+        {
+          uint64_t h = static_cast<uint64_t>(k.type) + 0x9E3779B97F4A7C15ull;
+          for (float d : k.dims)
+          {
+            uint32_t bits = 0;
+            std::memcpy(&bits, &d, sizeof(bits));
+            h ^= bits + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+          }
+          return static_cast<size_t>(h);
+        }
+      };
+
+      struct Entry
+      {
+        Key key{};
+        btCollisionShape* shape = nullptr;
+        uint32_t refs = 0;
+      };
+
+      static Key makeKey(const Collider& collider, const Transform& transform)
+      {
+        float scale[3]{ 1.0f, 1.0f, 1.0f };
+        extractScale(transform, scale);
+
+        Key key{};
+        key.type = collider.type;
+        switch (collider.type)
+        {
+          case ColliderType::Box:
+            key.dims[0] = collider.halfExtents[0] * scale[0];
+            key.dims[1] = collider.halfExtents[1] * scale[1];
+            key.dims[2] = collider.halfExtents[2] * scale[2];
+            break;
+          case ColliderType::Sphere:
+            key.dims[0] = collider.radius * std::max(scale[0], std::max(scale[1], scale[2]));
+            break;
+          case ColliderType::Capsule:
+            key.dims[0] = collider.radius * std::max(scale[0], scale[2]);
+            key.dims[1] = std::max(0.0f, collider.halfHeight * 2.0f * scale[1]);
+            break;
+          default:
+            key.type = ColliderType::Box;
+            key.dims[0] = key.dims[1] = key.dims[2] = 0.5f;
+            break;
+        }
+        return key;
+      }
+
+      static btCollisionShape* buildShape(const Key& key)
+      {
+        switch (key.type)
+        {
+          case ColliderType::Sphere: return new btSphereShape(key.dims[0]);
+          case ColliderType::Capsule: return new btCapsuleShape(key.dims[0], key.dims[1]);
+          default: return new btBoxShape(btVector3(key.dims[0], key.dims[1], key.dims[2]));
+        }
+      }
+
+      std::unordered_map<Key, uint32_t, KeyHash> m_lookup;
+      std::vector<Entry> m_entries;
+      std::vector<uint32_t> m_free;
+      uint32_t m_live = 0;
+    };
+
     struct BodyRecord
     {
       bool active = false;
@@ -98,9 +335,81 @@ namespace sc
       btMotionState* motion = nullptr;
       uint32_t layer = 0;
       uint32_t mask = 0;
+      // Static compounds: entity of each child, in compound child order. The
+      // compound shape's user pointer points here so query hits can resolve it.
+      std::vector<Entity>* compoundChildren = nullptr;
+      // Put to sleep by physics LOD; velocities are restored when it thaws.
+      bool frozen = false;
+      btVector3 frozenLinearVelocity{ 0, 0, 0 };
+      btVector3 frozenAngularVelocity{ 0, 0, 0 };
+    };
+
+    // Queries report the compound child they hit through m_triangleIndex.
+    struct ClosestRayChildCallback final : public btCollisionWorld::ClosestRayResultCallback
+    {
+      using btCollisionWorld::ClosestRayResultCallback::ClosestRayResultCallback;
+
+      btScalar addSingleResult(btCollisionWorld::LocalRayResult& rayResult, bool normalInWorldSpace) override
+      {
+        childIndex = rayResult.m_localShapeInfo ? rayResult.m_localShapeInfo->m_triangleIndex : -1;
+        return ClosestRayResultCallback::addSingleResult(rayResult, normalInWorldSpace);
+      }
+
+      int childIndex = -1;
+    };
+
+    struct ClosestConvexChildCallback final : public btCollisionWorld::ClosestConvexResultCallback
+    {
+      using btCollisionWorld::ClosestConvexResultCallback::ClosestConvexResultCallback;
+
+      btScalar addSingleResult(btCollisionWorld::LocalConvexResult& convexResult, bool normalInWorldSpace) override
+      {
+        childIndex = convexResult.m_localShapeInfo ? convexResult.m_localShapeInfo->m_triangleIndex : -1;
+        return ClosestConvexResultCallback::addSingleResult(convexResult, normalInWorldSpace);
+      }
+
+      int childIndex = -1;
     };
+
+    static Entity hitEntity(const btCollisionObject* object, int childIndex)
+    {
+      const btCollisionShape* shape = object->getCollisionShape();
+      if (shape && shape->isCompound() && shape->getUserPointer() && childIndex >= 0)
+      {
+        const auto* children = static_cast<const std::vector<Entity>*>(shape->getUserPointer());
+        if (static_cast<size_t>(childIndex) < children->size())
+          return (*children)[static_cast<size_t>(childIndex)];
+      }
+      return entityFromUserPointer(object->getUserPointer());
+    }
+
+    static void destroyBody(btDiscreteDynamicsWorld* world, ShapeCache& shapes, BodyRecord& rec)
+    {
+      if (world && rec.body)
+        world->removeRigidBody(rec.body);
+      delete rec.motion;
+      delete rec.body;
+      if (rec.compoundChildren)
+      {
+        btCompoundShape* compound = static_cast<btCompoundShape*>(rec.shape);
+        for (int i = 0; i < compound->getNumChildShapes(); ++i)
+          shapes.release(compound->getChildShape(i));
+        delete compound;
+        delete rec.compoundChildren;
+      }
+      else
+      {
+        if (rec.shape != rec.childShape)
+          delete rec.shape;
+        shapes.release(rec.childShape);
+      }
+      rec = BodyRecord{};
+    }
   }
 
+  // Batches at least this large defer their broadphase pair search.
+  static constexpr size_t kDeferredPairMinBodies = 32;
+
   struct PhysicsWorld::Impl
   {
     btBroadphaseInterface* broadphase = nullptr;
@@ -109,6 +418,11 @@ namespace sc
     btSequentialImpulseConstraintSolver* solver = nullptr;
     btDiscreteDynamicsWorld* world = nullptr;
     BulletDebugDrawer debugDrawer{};
+    ShapeCache shapes;
+#if BT_THREADSAFE
+    btConstraintSolverPoolMt* solverPool = nullptr;
+    std::unique_ptr<JobTaskScheduler> taskScheduler;
+#endif
 
     std::vector<BodyRecord> bodies;
     std::vector<uint32_t> freeList;
@@ -131,46 +445,91 @@ namespace sc
     uint32_t dynamicCount = 0;
     uint32_t kinematicCount = 0;
     uint32_t staticCount = 0;
+
+    PhysicsLodConfig lod{};
+    float lodCenter[3] = { 0.0f, 0.0f, 0.0f };
+    bool hasLodCenter = false;
+    uint32_t lodStepCounter = 0;
+    uint32_t frozenCount = 0;
+    uint32_t lodFreezes = 0;
+    uint32_t lodThaws = 0;
+
+    void updateLod();
   };
 
-  static btCollisionShape* createShape(const Collider& collider, const Transform& transform)
+  void PhysicsWorld::Impl::updateLod()
   {
-    float scale[3]{ 1.0f, 1.0f, 1.0f };
-    extractScale(transform, scale);
+    if (!lod.enabled || !hasLodCenter)
+      return;
+    if (++lodStepCounter < std::max(lod.updateInterval, 1u))
+      return;
+    lodStepCounter = 0;
+
+    const float freezeSq = lod.freezeRadius * lod.freezeRadius;
+    const float thawRadius = std::max(0.0f, lod.freezeRadius - lod.hysteresis);
+    const float thawSq = thawRadius * thawRadius;
 
-    switch (collider.type)
+    for (BodyRecord& rec : bodies)
     {
-      case ColliderType::Box:
+      if (!rec.active || rec.type != RigidBodyType::Dynamic || !rec.body)
+        continue;
+
+      // Vehicle chassis opt out of deactivation; leave them be.
+      if (rec.body->getActivationState() == DISABLE_DEACTIVATION)
       {
-        const float hx = collider.halfExtents[0] * scale[0];
-        const float hy = collider.halfExtents[1] * scale[1];
-        const float hz = collider.halfExtents[2] * scale[2];
-        return new btBoxShape(btVector3(hx, hy, hz));
+        if (rec.frozen)
+        {
+          rec.frozen = false;
+          frozenCount--;
+        }
+        continue;
       }
-      case ColliderType::Sphere:
+
+      const btVector3& p = rec.body->getWorldTransform().getOrigin();
+      const float dx = static_cast<float>(p.x()) - lodCenter[0];
+      const float dz = static_cast<float>(p.z()) - lodCenter[2];
+      const float distSq = dx * dx + dz * dz;
+
+      if (rec.frozen && distSq < thawSq)
       {
-        const float r = collider.radius * std::max(scale[0], std::max(scale[1], scale[2]));
-        return new btSphereShape(r);
+        // Wake first: the velocities must be the last thing written.
+        rec.body->forceActivationState(ACTIVE_TAG);
+        rec.body->activate(true);
+        rec.body->setLinearVelocity(rec.frozenLinearVelocity);
+        rec.body->setAngularVelocity(rec.frozenAngularVelocity);
+        rec.frozen = false;
+        frozenCount--;
+        lodThaws++;
+        continue;
       }
-      case ColliderType::Capsule:
+
+      // A frozen body that something woke up goes back to sleep with
+      // whatever velocity the contact gave it.
+      const bool woken = rec.frozen && rec.body->isActive();
+      if ((!rec.frozen && distSq > freezeSq) || woken)
       {
-        const float r = collider.radius * std::max(scale[0], scale[2]);
-        const float h = std::max(0.0f, collider.halfHeight * 2.0f * scale[1]);
-        return new btCapsuleShape(r, h);
+        rec.frozenLinearVelocity = rec.body->getLinearVelocity();
+        rec.frozenAngularVelocity = rec.body->getAngularVelocity();
+        rec.body->setLinearVelocity(btVector3(0, 0, 0));
+        rec.body->setAngularVelocity(btVector3(0, 0, 0));
+        rec.body->forceActivationState(ISLAND_SLEEPING);
+        if (!rec.frozen)
+        {
+          rec.frozen = true;
+          frozenCount++;
+          lodFreezes++;
+        }
       }
-      default:
-        break;
     }
-
-    return new btBoxShape(btVector3(0.5f, 0.5f, 0.5f));
   }
 
-  static btCollisionShape* createShapeWithComOffset(const Collider& collider,
+  static btCollisionShape* createShapeWithComOffset(ShapeCache& shapes,
+                                                    const Collider& collider,
                                                     const Transform& transform,
                                                     const float comOffset[3],
                                                     btCollisionShape*& outChildShape)
   {
-    outChildShape = createShape(collider, transform);
+    outChildShape = shapes.acquire(collider, transform);
     if (!outChildShape)
       return nullptr;
 
@@ -207,7 +566,7 @@ namespace sc
     shutdown();
   }
 
-  bool PhysicsWorld::init()
+  bool PhysicsWorld::init(const PhysicsWorldConfig& config)
   {
     if (!m_impl)
       m_impl = std::make_unique<Impl>();
@@ -217,12 +576,62 @@ namespace sc
 
     m_impl->broadphase = new btDbvtBroadphase();
     m_impl->collisionConfig = new btDefaultCollisionConfiguration();
-    m_impl->dispatcher = new btCollisionDispatcher(m_impl->collisionConfig);
-    m_impl->solver = new btSequentialImpulseConstraintSolver();
-    m_impl->world = new btDiscreteDynamicsWorld(m_impl->dispatcher,
-                                                m_impl->broadphase,
-                                                m_impl->solver,
-                                                m_impl->collisionConfig);
+
+#if BT_THREADSAFE
+    if (config.multithreaded)
+    {
+      // The stepping thread plus every job worker can end up inside a
+      // parallel loop, and Bullet sizes its per-thread pools from this count.
+      const uint32_t threads = jobs().workerCount() + 1u;
+      if (threads < 2u)
+      {
+        sc::log(sc::LogLevel::Warn, "Physics: no job workers; stepping single-threaded.");
+      }
+      else if (threads > static_cast<uint32_t>(BT_MAX_THREAD_COUNT))
+      {
+        sc::log(sc::LogLevel::Warn, "Physics: %u threads exceed Bullet's limit of %d; stepping single-threaded.",
+                threads, static_cast<int>(BT_MAX_THREAD_COUNT));
+      }
+      else
+      {
+        m_impl->taskScheduler = std::make_unique<JobTaskScheduler>();
+        m_impl->taskScheduler->setNumThreads(static_cast<int>(threads));
+        btSetTaskScheduler(m_impl->taskScheduler.get());
+        if (btGetTaskScheduler() != m_impl->taskScheduler.get())
+        {
+          sc::log(sc::LogLevel::Warn, "Physics: task scheduler must be installed from the main thread; stepping single-threaded.");
+          m_impl->taskScheduler.reset();
+        }
+        else
+        {
+          m_impl->dispatcher = new btCollisionDispatcherMt(m_impl->collisionConfig);
+          m_impl->solverPool = new btConstraintSolverPoolMt(static_cast<int>(threads));
+          m_impl->solver = new btSequentialImpulseConstraintSolverMt();
+          m_impl->world = new btDiscreteDynamicsWorldMt(m_impl->dispatcher,
+                                                        m_impl->broadphase,
+                                                        m_impl->solverPool,
+                                                        m_impl->solver,
+                                                        m_impl->collisionConfig);
+          m_impl->stats.threads = threads;
+        }
+      }
+    }
+#else
+    if (config.multithreaded)
+      sc::log(sc::LogLevel::Warn, "Physics: built without SC_PHYSICS_MULTITHREADING; stepping single-threaded.");
+#endif
+
+    if (!m_impl->world)
+    {
+      m_impl->dispatcher = new btCollisionDispatcher(m_impl->collisionConfig);
+      m_impl->solver = new btSequentialImpulseConstraintSolver();
+      m_impl->world = new btDiscreteDynamicsWorld(m_impl->dispatcher,
+                                                  m_impl->broadphase,
+                                                  m_impl->solver,
+                                                  m_impl->collisionConfig);
+      m_impl->stats.threads = 1;
+    }
+    m_impl->lod = config.lod;
     m_impl->world->setGravity(btVector3(0.0f, -9.81f, 0.0f));
     m_impl->world->setDebugDrawer(&m_impl->debugDrawer);
     return true;
@@ -252,20 +661,21 @@ namespace sc
       BodyRecord& rec = m_impl->bodies[i];
       if (!rec.active || !rec.body)
         continue;
-      m_impl->world->removeRigidBody(rec.body);
-      delete rec.motion;
-      delete rec.body;
-      if (rec.shape != rec.childShape)
-        delete rec.shape;
-      delete rec.childShape;
-      rec = BodyRecord{};
+      destroyBody(m_impl->world, m_impl->shapes, rec);
     }
+    m_impl->shapes.clear();
 
     m_impl->bodies.clear();
     m_impl->freeList.clear();
     m_impl->dynamicCount = 0;
     m_impl->kinematicCount = 0;
     m_impl->staticCount = 0;
+    m_impl->frozenCount = 0;
+    m_impl->lodFreezes = 0;
+    m_impl->lodThaws = 0;
+    m_impl->lodStepCounter = 0;
+    m_impl->hasLodCenter = false;
+    m_impl->stats = PhysicsStats{};
 
     delete m_impl->world;
     delete m_impl->solver;
@@ -278,6 +688,17 @@ namespace sc
     m_impl->dispatcher = nullptr;
     m_impl->collisionConfig = nullptr;
     m_impl->broadphase = nullptr;
+
+#if BT_THREADSAFE
+    delete m_impl->solverPool;
+    m_impl->solverPool = nullptr;
+    if (m_impl->taskScheduler)
+    {
+      if (btGetTaskScheduler() == m_impl->taskScheduler.get())
+        btSetTaskScheduler(btGetSequentialTaskScheduler());
+      m_impl->taskScheduler.reset();
+    }
+#endif
   }
 
   void PhysicsWorld::step(float fixedDt)
@@ -286,12 +707,17 @@ namespace sc
       return;
 
     const Tick start = nowTicks();
+    m_impl->updateLod();
     m_impl->world->stepSimulation(fixedDt, 0, fixedDt);
     const Tick end = nowTicks();
 
     m_impl->stats.dynamicBodies = m_impl->dynamicCount;
     m_impl->stats.kinematicBodies = m_impl->kinematicCount;
     m_impl->stats.staticColliders = m_impl->staticCount;
+    m_impl->stats.cachedShapes = m_impl->shapes.size();
+    m_impl->stats.frozenBodies = m_impl->frozenCount;
+    m_impl->stats.lodFreezes = m_impl->lodFreezes;
+    m_impl->stats.lodThaws = m_impl->lodThaws;
 
     if (m_impl->world->getBroadphase() && m_impl->world->getBroadphase()->getOverlappingPairCache())
       m_impl->stats.broadphaseProxies = (uint32_t)m_impl->world->getBroadphase()->getOverlappingPairCache()->getNumOverlappingPairs();
@@ -301,6 +727,16 @@ namespace sc
     m_impl->stats.stepMs = (float)(ticksToSeconds(end - start) * 1000.0);
   }
 
+  void PhysicsWorld::setLodCenter(const float pos[3])
+  {
+    if (!m_impl || !pos)
+      return;
+    m_impl->lodCenter[0] = pos[0];
+    m_impl->lodCenter[1] = pos[1];
+    m_impl->lodCenter[2] = pos[2];
+    m_impl->hasLodCenter = true;
+  }
+
   void PhysicsWorld::debugDraw(DebugDraw& draw)
   {
     if (!m_impl || !m_impl->world)
@@ -311,18 +747,28 @@ namespace sc
     m_impl->debugDrawer.setDraw(nullptr);
   }
 
-  PhysicsBodyHandle PhysicsWorld::addRigidBody(Entity entity,
-                                               const Transform& transform,
-                                               const RigidBody& rb,
-                                               const Collider& collider)
+  static uint32_t allocBodyIndex(std::vector<BodyRecord>& bodies, std::vector<uint32_t>& freeList)
   {
-    if (!m_impl || !m_impl->world)
-      return {};
-
-    btCollisionShape* shape = createShape(collider, transform);
-    if (!shape)
-      return {};
+    if (!freeList.empty())
+    {
+      const uint32_t index = freeList.back();
+      freeList.pop_back();
+      return index;
+    }
+    bodies.emplace_back();
+    return static_cast<uint32_t>(bodies.size() - 1u);
+  }
 
+  // Fills rec with a body that is not yet in the world.
+  static void buildBody(BodyRecord& rec,
+                        ShapeCache& shapes,
+                        PhysicsBodyHandle handle,
+                        Entity entity,
+                        const Transform& transform,
+                        const RigidBody& rb,
+                        const Collider& collider)
+  {
+    btCollisionShape* shape = shapes.acquire(collider, transform);
     btTransform startTransform = makeTransform(transform);
 
     btVector3 localInertia(0, 0, 0);
@@ -346,19 +792,6 @@ namespace sc
     if (collider.isTrigger)
       body->setCollisionFlags(body->getCollisionFlags() | btCollisionObject::CF_NO_CONTACT_RESPONSE);
 
-    uint32_t index = 0;
-    if (!m_impl->freeList.empty())
-    {
-      index = m_impl->freeList.back();
-      m_impl->freeList.pop_back();
-    }
-    else
-    {
-      index = static_cast<uint32_t>(m_impl->bodies.size());
-      m_impl->bodies.emplace_back();
-    }
-
-    BodyRecord& rec = m_impl->bodies[index];
     rec.active = true;
     rec.entity = entity;
     rec.type = rb.type;
@@ -378,11 +811,24 @@ namespace sc
       rec.mask = 1u;
     }
 
-    const PhysicsBodyHandle handle{ index + 1u };
     body->setUserPointer(reinterpret_cast<void*>(static_cast<uintptr_t>(entity.value + 1u)));
     body->setUserIndex(static_cast<int>(handle.id));
+  }
 
-    m_impl->world->addRigidBody(body, (int)rec.layer, (int)rec.mask);
+  PhysicsBodyHandle PhysicsWorld::addRigidBody(Entity entity,
+                                               const Transform& transform,
+                                               const RigidBody& rb,
+                                               const Collider& collider)
+  {
+    if (!m_impl || !m_impl->world)
+      return {};
+
+    const uint32_t index = allocBodyIndex(m_impl->bodies, m_impl->freeList);
+    const PhysicsBodyHandle handle{ index + 1u };
+    BodyRecord& rec = m_impl->bodies[index];
+    buildBody(rec, m_impl->shapes, handle, entity, transform, rb, collider);
+
+    m_impl->world->addRigidBody(rec.body, (int)rec.layer, (int)rec.mask);
 
     if (rb.type == RigidBodyType::Dynamic) m_impl->dynamicCount++;
     else if (rb.type == RigidBodyType::Kinematic) m_impl->kinematicCount++;
@@ -391,6 +837,55 @@ namespace sc
     return handle;
   }
 
+  void PhysicsWorld::addBodies(std::span<const PhysicsBodyDesc> descs, std::span<PhysicsBodyHandle> outHandles)
+  {
+    if (!m_impl || !m_impl->world || descs.empty() || outHandles.size() != descs.size())
+      return;
+
+    // Grow the record array once so the records stay put while we fill them.
+    const size_t reused = std::min(descs.size(), m_impl->freeList.size());
+    m_impl->bodies.reserve(m_impl->bodies.size() + (descs.size() - reused));
+
+    for (size_t i = 0; i < descs.size(); ++i)
+    {
+      const PhysicsBodyDesc& desc = descs[i];
+      const uint32_t index = allocBodyIndex(m_impl->bodies, m_impl->freeList);
+      outHandles[i] = PhysicsBodyHandle{ index + 1u };
+      buildBody(m_impl->bodies[index], m_impl->shapes, outHandles[i], desc.entity, desc.transform, desc.rb, desc.collider);
+
+      if (desc.rb.type == RigidBodyType::Dynamic) m_impl->dynamicCount++;
+      else if (desc.rb.type == RigidBodyType::Kinematic) m_impl->kinematicCount++;
+      else m_impl->staticCount++;
+    }
+
+    // Each proxy insert normally queries both Dbvt trees for new pairs. For a
+    // streamed-in sector, insert everything first and then find the pairs of
+    // the new proxies with one tree-vs-tree pass over the dynamic set.
+    btDbvtBroadphase* dbvt = descs.size() >= kDeferredPairMinBodies
+                           ? static_cast<btDbvtBroadphase*>(m_impl->broadphase)
+                           : nullptr;
+    if (dbvt)
+      dbvt->m_deferedcollide = true;
+
+    for (const PhysicsBodyHandle handle : outHandles)
+    {
+      const BodyRecord& rec = m_impl->bodies[handle.id - 1u];
+      m_impl->world->addRigidBody(rec.body, (int)rec.layer, (int)rec.mask);
+    }
+
+    if (dbvt)
+    {
+      dbvt->collide(m_impl->world->getDispatcher());
+      dbvt->m_deferedcollide = false;
+    }
+  }
+
+  void PhysicsWorld::removeBodies(std::span<const PhysicsBodyHandle> handles)
+  {
+    for (const PhysicsBodyHandle handle : handles)
+      removeRigidBody(handle);
+  }
+
   PhysicsBodyHandle PhysicsWorld::addStaticCollider(Entity entity,
                                                     const Transform& transform,
                                                     const Collider& collider)
@@ -411,7 +906,7 @@ namespace sc
       return {};
 
     btCollisionShape* childShape = nullptr;
-    btCollisionShape* shape = createShapeWithComOffset(collider, transform, comOffset, childShape);
+    btCollisionShape* shape = createShapeWithComOffset(m_impl->shapes, collider, transform, comOffset, childShape);
     if (!shape)
       return {};
 
@@ -506,18 +1001,13 @@ namespace sc
     if (!rec.active || !rec.body)
       return;
 
-    m_impl->world->removeRigidBody(rec.body);
-    delete rec.motion;
-    delete rec.body;
-    if (rec.shape != rec.childShape)
-      delete rec.shape;
-    delete rec.childShape;
-
+    if (rec.frozen && m_impl->frozenCount > 0)
+      m_impl->frozenCount--;
     if (rec.type == RigidBodyType::Dynamic && m_impl->dynamicCount > 0) m_impl->dynamicCount--;
     else if (rec.type == RigidBodyType::Kinematic && m_impl->kinematicCount > 0) m_impl->kinematicCount--;
     else if (m_impl->staticCount > 0) m_impl->staticCount--;
 
-    rec = BodyRecord{};
+    destroyBody(m_impl->world, m_impl->shapes, rec);
     m_impl->freeList.push_back(idx);
   }
 
@@ -526,6 +1016,118 @@ namespace sc
     removeRigidBody(handle);
   }
 
+  PhysicsBodyHandle PhysicsWorld::addStaticCompound(std::span<const StaticColliderDesc> children, const RigidBody& material)
+  {
+    if (!m_impl || !m_impl->world || children.empty())
+      return {};
+
+    // The compound keeps its own AABB tree over the children, so the
+    // broadphase sees one proxy for the whole set.
+    btCompoundShape* compound = new btCompoundShape(true, static_cast<int>(children.size()));
+    std::vector<Entity>* childEntities = new std::vector<Entity>();
+    childEntities->reserve(children.size());
+    for (const StaticColliderDesc& child : children)
+    {
+      compound->addChildShape(makeTransform(child.transform), m_impl->shapes.acquire(child.collider, child.transform));
+      childEntities->push_back(child.entity);
+    }
+    compound->setUserPointer(childEntities);
+
+    btRigidBody::btRigidBodyConstructionInfo info(btScalar(0.0f), nullptr, compound, btVector3(0, 0, 0));
+    info.m_friction = material.friction;
+    info.m_restitution = material.restitution;
+    btRigidBody* body = new btRigidBody(info);
+
+    const Collider& filter = children[0].collider;
+    if (filter.isTrigger)
+      body->setCollisionFlags(body->getCollisionFlags() | btCollisionObject::CF_NO_CONTACT_RESPONSE);
+
+    uint32_t index = 0;
+    if (!m_impl->freeList.empty())
+    {
+      index = m_impl->freeList.back();
+      m_impl->freeList.pop_back();
+    }
+    else
+    {
+      index = static_cast<uint32_t>(m_impl->bodies.size());
+      m_impl->bodies.emplace_back();
+    }
+
+    BodyRecord& rec = m_impl->bodies[index];
+    rec.active = true;
+    rec.entity = kInvalidEntity;
+    rec.type = RigidBodyType::Static;
+    rec.body = body;
+    rec.shape = compound;
+    rec.childShape = nullptr;
+    rec.motion = nullptr;
+    rec.layer = filter.layer;
+    rec.mask = filter.mask;
+    rec.compoundChildren = childEntities;
+
+    if (rec.layer == 1u && rec.mask == 0xFFFFFFFFu)
+    {
+      rec.layer = 2u;
+      rec.mask = 1u;
+    }
+
+    const PhysicsBodyHandle handle{ index + 1u };
+    body->setUserIndex(static_cast<int>(handle.id));
+
+    m_impl->world->addRigidBody(body, (int)rec.layer, (int)rec.mask);
+    m_impl->staticCount++;
+    return handle;
+  }
+
+  void PhysicsWorld::removeStaticCompoundChildren(PhysicsBodyHandle handle, std::span<const Entity> entities)
+  {
+    if (!m_impl || !m_impl->world || !handle.valid() || entities.empty())
+      return;
+
+    const uint32_t idx = handle.id - 1u;
+    if (idx >= m_impl->bodies.size())
+      return;
+
+    BodyRecord& rec = m_impl->bodies[idx];
+    if (!rec.active || !rec.compoundChildren)
+      return;
+
+    std::vector<Entity>& childEntities = *rec.compoundChildren;
+    btCompoundShape* compound = static_cast<btCompoundShape*>(rec.shape);
+    bool removedAny = false;
+    for (Entity entity : entities)
+    {
+      auto it = std::find(childEntities.begin(), childEntities.end(), entity);
+      if (it == childEntities.end())
+        continue;
+
+      if (childEntities.size() == 1)
+      {
+        if (m_impl->staticCount > 0)
+          m_impl->staticCount--;
+        destroyBody(m_impl->world, m_impl->shapes, rec);
+        m_impl->freeList.push_back(idx);
+        return;
+      }
+
+      // removeChildShapeByIndex moves the last child into the hole; mirror that.
+      const int childIndex = static_cast<int>(it - childEntities.begin());
+      btCollisionShape* childShape = compound->getChildShape(childIndex);
+      compound->removeChildShapeByIndex(childIndex);
+      m_impl->shapes.release(childShape);
+      *it = childEntities.back();
+      childEntities.pop_back();
+      removedAny = true;
+    }
+
+    if (!removedAny)
+      return;
+    compound->recalculateLocalAabb();
+    m_impl->world->updateSingleAabb(rec.body);
+  }
+
+
   bool PhysicsWorld::setKinematicTarget(PhysicsBodyHandle handle, const Transform& transform)
   {
     if (!m_impl)
@@ -737,12 +1339,9 @@ namespace sc
     return rec.wheelCount;
   }
 
-  RaycastHit PhysicsWorld::raycast(const float origin[3], const float dir[3], float maxDist, uint32_t mask) const
+  static RaycastHit closestRayHit(const btCollisionWorld& world, const float origin[3], const float dir[3], float maxDist, uint32_t mask)
   {
     RaycastHit out{};
-    if (!m_impl || !m_impl->world)
-      return out;
-
     const float lenSq = dir[0] * dir[0] + dir[1] * dir[1] + dir[2] * dir[2];
     if (lenSq <= 1e-6f)
       return out;
@@ -755,10 +1354,10 @@ namespace sc
                        origin[1] + ndir[1] * maxDist,
                        origin[2] + ndir[2] * maxDist);
 
-    btCollisionWorld::ClosestRayResultCallback cb(from, to);
+    ClosestRayChildCallback cb(from, to);
     cb.m_collisionFilterGroup = 0xFFFF;
     cb.m_collisionFilterMask = (int)mask;
-    m_impl->world->rayTest(from, to, cb);
+    world.rayTest(from, to, cb);
 
     if (cb.hasHit())
     {
@@ -768,7 +1367,7 @@ namespace sc
       const btVector3 hn = cb.m_hitNormalWorld;
       out.position[0] = hp.x(); out.position[1] = hp.y(); out.position[2] = hp.z();
       out.normal[0] = hn.x(); out.normal[1] = hn.y(); out.normal[2] = hn.z();
-      out.entity = entityFromUserPointer(cb.m_collisionObject->getUserPointer());
+      out.entity = hitEntity(cb.m_collisionObject, cb.childIndex);
       if (cb.m_collisionObject->getBroadphaseHandle())
         out.layer = (uint32_t)cb.m_collisionObject->getBroadphaseHandle()->m_collisionFilterGroup;
     }
@@ -776,12 +1375,9 @@ namespace sc
     return out;
   }
 
-  SweepHit PhysicsWorld::sweepCapsule(const float start[3], const float end[3], float radius, float halfHeight, uint32_t mask) const
+  static SweepHit closestCapsuleSweep(const btCollisionWorld& world, const float start[3], const float end[3], float radius, float halfHeight, uint32_t mask)
   {
     SweepHit out{};
-    if (!m_impl || !m_impl->world)
-      return out;
-
     btCapsuleShape capsule(radius, std::max(0.0f, halfHeight * 2.0f));
     btTransform from;
     btTransform to;
@@ -790,10 +1386,10 @@ namespace sc
     from.setOrigin(toBt(start));
     to.setOrigin(toBt(end));
 
-    btCollisionWorld::ClosestConvexResultCallback cb(from.getOrigin(), to.getOrigin());
+    ClosestConvexChildCallback cb(from.getOrigin(), to.getOrigin());
     cb.m_collisionFilterGroup = 0xFFFF;
     cb.m_collisionFilterMask = (int)mask;
-    m_impl->world->convexSweepTest(&capsule, from, to, cb);
+    world.convexSweepTest(&capsule, from, to, cb);
 
     if (cb.hasHit())
     {
@@ -803,12 +1399,86 @@ namespace sc
       const btVector3 hn = cb.m_hitNormalWorld;
       out.position[0] = hp.x(); out.position[1] = hp.y(); out.position[2] = hp.z();
       out.normal[0] = hn.x(); out.normal[1] = hn.y(); out.normal[2] = hn.z();
-      out.entity = entityFromUserPointer(cb.m_hitCollisionObject->getUserPointer());
+      out.entity = hitEntity(cb.m_hitCollisionObject, cb.childIndex);
     }
 
     return out;
   }
 
+  // Queries only read the world, but btDbvtBroadphase shares one traversal
+  // stack between callers unless Bullet is built thread-safe, so batches run
+  // serially without BT_THREADSAFE.
+  template<typename F>
+  static void forEachQueryChunk(size_t count, const F& fn)
+  {
+    static constexpr int kQueriesPerChunk = 16;
+#if BT_THREADSAFE
+    const int maxThreads = static_cast<int>(jobs().workerCount()) + 1;
+    parallelChunks(0, static_cast<int>(count), kQueriesPerChunk, maxThreads, [&fn](int begin, int end)
+    {
+      fn(static_cast<size_t>(begin), static_cast<size_t>(end));
+    });
+#else
+    (void)kQueriesPerChunk;
+    if (count > 0)
+      fn(size_t(0), count);
+#endif
+  }
+
+  RaycastHit PhysicsWorld::raycast(const float origin[3], const float dir[3], float maxDist, uint32_t mask) const
+  {
+    if (!m_impl || !m_impl->world)
+      return {};
+    return closestRayHit(*m_impl->world, origin, dir, maxDist, mask);
+  }
+
+  SweepHit PhysicsWorld::sweepCapsule(const float start[3], const float end[3], float radius, float halfHeight, uint32_t mask) const
+  {
+    if (!m_impl || !m_impl->world)
+      return {};
+    return closestCapsuleSweep(*m_impl->world, start, end, radius, halfHeight, mask);
+  }
+
+  void PhysicsWorld::raycastBatch(std::span<const RayQuery> queries, std::span<RaycastHit> outHits) const
+  {
+    const size_t count = std::min(queries.size(), outHits.size());
+    if (!m_impl || !m_impl->world)
+    {
+      std::fill(outHits.begin(), outHits.begin() + count, RaycastHit{});
+      return;
+    }
+
+    const btCollisionWorld& world = *m_impl->world;
+    forEachQueryChunk(count, [&](size_t begin, size_t end)
+    {
+      for (size_t i = begin; i < end; ++i)
+      {
+        const RayQuery& q = queries[i];
+        outHits[i] = closestRayHit(world, q.origin, q.dir, q.maxDist, q.mask);
+      }
+    });
+  }
+
+  void PhysicsWorld::sweepBatch(std::span<const SweepQuery> queries, std::span<SweepHit> outHits) const
+  {
+    const size_t count = std::min(queries.size(), outHits.size());
+    if (!m_impl || !m_impl->world)
+    {
+      std::fill(outHits.begin(), outHits.begin() + count, SweepHit{});
+      return;
+    }
+
+    const btCollisionWorld& world = *m_impl->world;
+    forEachQueryChunk(count, [&](size_t begin, size_t end)
+    {
+      for (size_t i = begin; i < end; ++i)
+      {
+        const SweepQuery& q = queries[i];
+        outHits[i] = closestCapsuleSweep(world, q.start, q.end, q.radius, q.halfHeight, q.mask);
+      }
+    });
+  }
+
   VehicleHandle PhysicsWorld::createRaycastVehicle(PhysicsBodyHandle chassis,
                                                    const VehicleComponent& vehicle,
                                                    const VehicleWheelConfig* wheels,
@@ -1127,9 +1797,18 @@ namespace sc
 
       if (remove)
       {
-        physics.removeRigidBody(tb.handle);
+        if (tb.compoundChild)
+          state->compoundRemovals.push_back({ tb.handle, tb.entity });
+        else
+          state->handleScratch.push_back(tb.handle);
         if (alive)
+        {
           world.remove<PhysicsBodyHandle>(tb.entity);
+          // Type changes and dropped handles add no component; rebuild the
+          // body through discovery if the entity still qualifies.
+          if (has)
+            state->rediscover.push_back(tb.entity);
+        }
         state->tracked[i] = state->tracked.back();
         state->tracked.pop_back();
         continue;
@@ -1137,21 +1816,134 @@ namespace sc
       ++i;
     }
 
-    world.ForEach<RigidBody, Collider, Transform>([&](Entity e, RigidBody& rb, Collider& col, Transform& tr)
+    if (!state->handleScratch.empty())
     {
-      if (world.has<PhysicsBodyHandle>(e))
-        return;
+      physics.removeBodies(state->handleScratch);
+      state->handleScratch.clear();
+    }
 
-      PhysicsBodyHandle handle = (rb.type == RigidBodyType::Static)
-                               ? physics.addStaticCollider(e, tr, col)
-                               : physics.addRigidBody(e, tr, rb, col);
-      if (!handle.valid())
-        return;
+    if (!state->compoundRemovals.empty())
+    {
+      // A sector unloading drops all of its children in the same frame; group
+      // them so each compound rebuilds its bounds once (or is just destroyed).
+      auto& removals = state->compoundRemovals;
+      std::sort(removals.begin(), removals.end(), [](const auto& a, const auto& b) { return a.first.id < b.first.id; });
+      for (size_t begin = 0; begin < removals.size();)
+      {
+        size_t end = begin;
+        state->entityScratch.clear();
+        while (end < removals.size() && removals[end].first.id == removals[begin].first.id)
+          state->entityScratch.push_back(removals[end++].second);
+        physics.removeStaticCompoundChildren(removals[begin].first, state->entityScratch);
+        begin = end;
+      }
+      removals.clear();
+    }
 
-      PhysicsBodyHandle& hb = world.add<PhysicsBodyHandle>(e);
-      hb = handle;
-      state->tracked.push_back({ e, handle, rb.type });
-    });
+    auto& discovered = state->discovered;
+    if (!state->discoveryInitialized)
+    {
+      world.trackAdds<RigidBody>();
+      world.trackAdds<Collider>();
+      world.trackAdds<Transform>();
+      world.ForEach<RigidBody, Collider, Transform>([&](Entity e, RigidBody&, Collider&, Transform&)
+      {
+        discovered.push_back(e);
+      });
+      state->discoveryInitialized = true;
+    }
+    else
+    {
+      world.drainAdded<RigidBody>(discovered);
+      world.drainAdded<Collider>(discovered);
+      world.drainAdded<Transform>(discovered);
+    }
+
+    discovered.insert(discovered.end(), state->rediscover.begin(), state->rediscover.end());
+    state->rediscover.clear();
+    std::sort(discovered.begin(), discovered.end(), [](Entity a, Entity b) { return a.value < b.value; });
+    discovered.erase(std::unique(discovered.begin(), discovered.end()), discovered.end());
+
+    RigidBody staticMaterial{};
+    staticMaterial.type = RigidBodyType::Static;
+    staticMaterial.mass = 0.0f;
+
+    for (const Entity e : discovered)
+    {
+      if (!world.isAlive(e) || world.has<PhysicsBodyHandle>(e))
+        continue;
+
+      // Whichever of the three components arrives last journals the entity.
+      const RigidBody* rb = world.get<RigidBody>(e);
+      const Collider* col = world.get<Collider>(e);
+      const Transform* tr = world.get<Transform>(e);
+      if (!rb || !col || !tr)
+        continue;
+
+      if (rb->type == RigidBodyType::Static)
+      {
+        if (const WorldSector* ws = state->mergeSectorStatics ? world.get<WorldSector>(e) : nullptr)
+        {
+          state->pendingStatics.push_back({ ws->coord.x, ws->coord.z, { e, *tr, *col } });
+          continue;
+        }
+      }
+
+      state->pendingBodies.push_back({ e, *tr, (rb->type == RigidBodyType::Static) ? staticMaterial : *rb, *col });
+    }
+    discovered.clear();
+
+    if (!state->pendingBodies.empty())
+    {
+      auto& pending = state->pendingBodies;
+      state->handleScratch.resize(pending.size());
+      physics.addBodies(pending, state->handleScratch);
+      for (size_t i = 0; i < pending.size(); ++i)
+      {
+        const PhysicsBodyHandle handle = state->handleScratch[i];
+        if (!handle.valid())
+          continue;
+        PhysicsBodyHandle& hb = world.add<PhysicsBodyHandle>(pending[i].entity);
+        hb = handle;
+        state->tracked.push_back({ pending[i].entity, handle, pending[i].rb.type });
+      }
+      pending.clear();
+      state->handleScratch.clear();
+    }
+
+    if (!state->pendingStatics.empty())
+    {
+      auto& pending = state->pendingStatics;
+      auto groupKey = [](const PhysicsPendingStatic& p)
+      {
+        return std::make_tuple(p.sectorX, p.sectorZ, p.desc.collider.layer, p.desc.collider.mask, p.desc.collider.isTrigger);
+      };
+      std::sort(pending.begin(), pending.end(), [&](const PhysicsPendingStatic& a, const PhysicsPendingStatic& b)
+      {
+        return groupKey(a) < groupKey(b);
+      });
+
+      for (size_t begin = 0; begin < pending.size();)
+      {
+        size_t end = begin;
+        state->compoundScratch.clear();
+        while (end < pending.size() && groupKey(pending[end]) == groupKey(pending[begin]))
+          state->compoundScratch.push_back(pending[end++].desc);
+
+        const PhysicsBodyHandle handle = physics.addStaticCompound(state->compoundScratch, staticMaterial);
+        if (handle.valid())
+        {
+          for (const StaticColliderDesc& child : state->compoundScratch)
+          {
+            PhysicsBodyHandle& hb = world.add<PhysicsBodyHandle>(child.entity);
+            hb = handle;
+            state->tracked.push_back({ child.entity, handle, RigidBodyType::Static, true });
+          }
+        }
+        begin = end;
+      }
+      pending.clear();
+    }
 
     world.ForEach<RigidBody, Transform, PhysicsBodyHandle>([&](Entity, RigidBody& rb, Transform& tr, PhysicsBodyHandle& h)
     {
@@ -1161,6 +1953,10 @@ namespace sc
         physics.setKinematicTarget(h, tr);
     });
 
+    Transform* camT = nullptr;
+    if (isValidEntity(pickActiveCamera(world, camT)) && camT)
+      physics.setLodCenter(camT->localPos);
+
     const bool paused = debug ? debug->pausePhysics : false;
     physics.step(paused ? 0.0f : dt);
 
@@ -1317,4 +2113,108 @@ namespace sc
 
     state->initialized = true;
   }
+
+  static bool samePose(const Transform& tr, const float pos[3], const float rot[3])
+  {
+    return tr.localPos[0] == pos[0] && tr.localPos[1] == pos[1] && tr.localPos[2] == pos[2] &&
+           tr.localRot[0] == rot[0] && tr.localRot[1] == rot[1] && tr.localRot[2] == rot[2];
+  }
+
+  static void copy3(float dst[3], const float src[3])
+  {
+    dst[0] = src[0];
+    dst[1] = src[1];
+    dst[2] = src[2];
+  }
+
+  void PhysicsInterpolationCaptureSystem(World& world, float dt, void* user)
+  {
+    (void)dt;
+    PhysicsInterpolationState* state = static_cast<PhysicsInterpolationState*>(user);
+    if (!state)
+      return;
+
+    state->scratch.clear();
+    world.ForEach<RigidBody, PhysicsBodyHandle>([&](Entity e, RigidBody& rb, PhysicsBodyHandle&)
+    {
+      if (rb.type != RigidBodyType::Static && !world.has<InterpolatedPose>(e))
+        state->scratch.push_back(e);
+    });
+    for (const Entity e : state->scratch)
+      world.add<InterpolatedPose>(e);
+
+    const float snapSq = state->snapDistance * state->snapDistance;
+    world.ForEach<InterpolatedPose, Transform>([&](Entity, InterpolatedPose& pose, Transform& tr)
+    {
+      copy3(pose.prevPos, pose.currPos);
+      copy3(pose.prevRot, pose.currRot);
+      copy3(pose.currPos, tr.localPos);
+      copy3(pose.currRot, tr.localRot);
+
+      const float dx = pose.currPos[0] - pose.prevPos[0];
+      const float dy = pose.currPos[1] - pose.prevPos[1];
+      const float dz = pose.currPos[2] - pose.prevPos[2];
+      if (!pose.captured || dx * dx + dy * dy + dz * dz > snapSq)
+      {
+        copy3(pose.prevPos, pose.currPos);
+        copy3(pose.prevRot, pose.currRot);
+      }
+      pose.captured = true;
+    });
+  }
+
+  void PhysicsInterpolationSystem(World& world, float dt, void* user)
+  {
+    (void)dt;
+    PhysicsInterpolationState* state = static_cast<PhysicsInterpolationState*>(user);
+    if (!state || !state->enabled)
+      return;
+
+    const float alpha = std::clamp(state->alpha, 0.0f, 1.0f);
+    world.ForEach<InterpolatedPose, Transform>([&](Entity, InterpolatedPose& pose, Transform& tr)
+    {
+      if (!pose.captured)
+        return;
+
+      // Anything that moved the entity outside a fixed step (teleports,
+      // editor tweaks) wins; the next capture starts again from there.
+      if (!samePose(tr, pose.currPos, pose.currRot))
+      {
+        pose.captured = false;
+        return;
+      }
+
+      copy3(pose.simPos, tr.localPos);
+      copy3(pose.simRot, tr.localRot);
+      for (int i = 0; i < 3; ++i)
+        tr.localPos[i] = pose.prevPos[i] + (pose.currPos[i] - pose.prevPos[i]) * alpha;
+      // Blending Euler angles per axis tumbles through unrelated orientations
+      // once more than one axis turns; slerp takes the shortest arc instead.
+      const btQuaternion rot = quatFromEuler(pose.prevRot).slerp(quatFromEuler(pose.currRot), btScalar(alpha));
+      eulerFromQuat(rot, tr.localRot);
+      tr.dirty = true;
+      pose.applied = true;
+    });
+  }
+
+  void PhysicsInterpolationRestoreSystem(World& world, float dt, void* user)
+  {
+    (void)user;
+    bool restored = false;
+    world.ForEach<InterpolatedPose, Transform>([&](Entity, InterpolatedPose& pose, Transform& tr)
+    {
+      if (!pose.applied)
+        return;
+      copy3(tr.localPos, pose.simPos);
+      copy3(tr.localRot, pose.simRot);
+      tr.dirty = true;
+      pose.applied = false;
+      restored = true;
+    });
+
+    // worldMatrix still holds the blended pose (and so do the children of
+    // blended entities); rebuild it so FixedUpdate never reads a render pose.
+    if (restored)
+      TransformSystem(world, dt, nullptr);
+  }
 }
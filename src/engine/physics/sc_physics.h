@@ -2,6 +2,8 @@
 #include <cstdint>
 #include <vector>
 #include <memory>
+#include <span>
+#include <utility>
 
 #include "sc_ecs.h"
 
@@ -100,9 +102,53 @@ namespace sc
     uint32_t kinematicBodies = 0;
     uint32_t staticColliders = 0;
     uint32_t broadphaseProxies = 0;
+    uint32_t threads = 1;
+    uint32_t cachedShapes = 0;
+    uint32_t frozenBodies = 0;
+    uint32_t lodFreezes = 0; // since init
+    uint32_t lodThaws = 0;   // since init
     float stepMs = 0.0f;
   };
 
+  struct PhysicsLodConfig
+  {
+    // Dynamic bodies farther than freezeRadius (XZ) from the LOD center are
+    // put to sleep with their velocities saved, and resume once back inside
+    // freezeRadius - hysteresis. Sleeping bodies cost no narrowphase, solver
+    // or integration time; a collision with an awake body still wakes them.
+    bool enabled = false;
+    float freezeRadius = 150.0f;
+    float hysteresis = 20.0f;
+    // Fixed steps between tier passes over the bodies.
+    uint32_t updateInterval = 8u;
+  };
+
+  struct PhysicsWorldConfig
+  {
+    // Steps a Bullet Mt world (parallel narrowphase, island solving and
+    // integration) on sc::jobs(). Needs the job system initialized first and
+    // SC_PHYSICS_MULTITHREADING at build time; otherwise the world is sequential.
+    bool multithreaded = false;
+    PhysicsLodConfig lod{};
+  };
+
+  // One child of a static compound body; transform is in world space.
+  struct StaticColliderDesc
+  {
+    Entity entity = kInvalidEntity;
+    Transform transform{};
+    Collider collider{};
+  };
+
+  // Same parameters as PhysicsWorld::addRigidBody.
+  struct PhysicsBodyDesc
+  {
+    Entity entity = kInvalidEntity;
+    Transform transform{};
+    RigidBody rb{};
+    Collider collider{};
+  };
+
   struct RaycastHit
   {
     bool hit = false;
@@ -122,6 +168,25 @@ namespace sc
     float distance = 0.0f;
   };
 
+  // Same parameters as PhysicsWorld::raycast.
+  struct RayQuery
+  {
+    float origin[3] = { 0.0f, 0.0f, 0.0f };
+    float dir[3] = { 0.0f, 0.0f, 1.0f };
+    float maxDist = 0.0f;
+    uint32_t mask = 0xFFFFFFFFu;
+  };
+
+  // Same parameters as PhysicsWorld::sweepCapsule.
+  struct SweepQuery
+  {
+    float start[3] = { 0.0f, 0.0f, 0.0f };
+    float end[3] = { 0.0f, 0.0f, 0.0f };
+    float radius = 0.5f;
+    float halfHeight = 0.5f;
+    uint32_t mask = 0xFFFFFFFFu;
+  };
+
   struct PhysicsDebugState
   {
     bool showPhysicsDebug = false;
@@ -141,12 +206,17 @@ namespace sc
     PhysicsWorld();
     ~PhysicsWorld();
 
-    bool init();
+    // Call from the main thread: Bullet numbers the thread that installs the
+    // task scheduler as its thread 0.
+    bool init(const PhysicsWorldConfig& config = {});
     void shutdown();
 
     void step(float fixedDt);
     void debugDraw(DebugDraw& draw);
 
+    // Position the physics LOD tiers are measured from (usually the camera).
+    void setLodCenter(const float pos[3]);
+
     PhysicsBodyHandle addRigidBody(Entity entity,
                                    const Transform& transform,
                                    const RigidBody& rb,
@@ -162,6 +232,18 @@ namespace sc
     void removeRigidBody(PhysicsBodyHandle handle);
     void removeStaticCollider(PhysicsBodyHandle handle);
 
+    // outHandles[i] receives the body built for descs[i]. Large batches defer
+    // the broadphase pair search to a single tree-vs-tree pass.
+    void addBodies(std::span<const PhysicsBodyDesc> descs, std::span<PhysicsBodyHandle> outHandles);
+    void removeBodies(std::span<const PhysicsBodyHandle> handles);
+
+    // Merges static colliders into a single body with one broadphase proxy.
+    // Filtering comes from children[0].collider, friction/restitution from
+    // material. Query hits report the child's entity.
+    PhysicsBodyHandle addStaticCompound(std::span<const StaticColliderDesc> children, const RigidBody& material);
+    // Drops children by entity; the body is destroyed with its last child.
+    void removeStaticCompoundChildren(PhysicsBodyHandle handle, std::span<const Entity> entities);
+
     bool setKinematicTarget(PhysicsBodyHandle handle, const Transform& transform);
     bool getBodyTransform(PhysicsBodyHandle handle, float outPos[3], float outRot[3]) const;
     bool isBodyActive(PhysicsBodyHandle handle) const;
@@ -178,6 +260,11 @@ namespace sc
     RaycastHit raycast(const float origin[3], const float dir[3], float maxDist, uint32_t mask) const;
     SweepHit sweepCapsule(const float start[3], const float end[3], float radius, float halfHeight, uint32_t mask) const;
 
+    // outHits[i] is exactly what the single-query call returns for queries[i].
+    // Large batches are spread over sc::jobs(); do not call during step().
+    void raycastBatch(std::span<const RayQuery> queries, std::span<RaycastHit> outHits) const;
+    void sweepBatch(std::span<const SweepQuery> queries, std::span<SweepHit> outHits) const;
+
     VehicleHandle createRaycastVehicle(PhysicsBodyHandle chassis,
                                        const VehicleComponent& vehicle,
                                        const VehicleWheelConfig* wheels,
@@ -199,6 +286,15 @@ namespace sc
     Entity entity = kInvalidEntity;
     PhysicsBodyHandle handle{};
     RigidBodyType type = RigidBodyType::Static;
+    bool compoundChild = false;
+  };
+
+  // Static collider waiting to be merged into its sector's compound body.
+  struct PhysicsPendingStatic
+  {
+    int32_t sectorX = 0;
+    int32_t sectorZ = 0;
+    StaticColliderDesc desc{};
   };
 
   struct PhysicsSyncState
@@ -206,6 +302,26 @@ namespace sc
     PhysicsWorld* world = nullptr;
     PhysicsDebugState* debug = nullptr;
     std::vector<PhysicsTrackedBody> tracked;
+
+    // Static bodies of entities with a WorldSector are merged per sector (and
+    // per collision filter) into one compound body as they stream in.
+    bool mergeSectorStatics = false;
+
+    // New bodies are found through the RigidBody/Collider/Transform add
+    // journals (whichever arrives last reports the entity); the
+    // first step scans once for anything created before tracking started.
+    bool discoveryInitialized = false;
+    std::vector<Entity> discovered;
+    // Entities whose body was dropped while they still qualify (type change,
+    // handle removed elsewhere); looked at once on the next step.
+    std::vector<Entity> rediscover;
+    std::vector<PhysicsBodyDesc> pendingBodies;
+    std::vector<PhysicsBodyHandle> handleScratch;
+
+    std::vector<PhysicsPendingStatic> pendingStatics;
+    std::vector<StaticColliderDesc> compoundScratch;
+    std::vector<std::pair<PhysicsBodyHandle, Entity>> compoundRemovals;
+    std::vector<Entity> entityScratch;
   };
 
   struct PhysicsDebugDrawState
@@ -215,6 +331,32 @@ namespace sc
     DebugDraw* draw = nullptr;
   };
 
+  // Poses captured after the last two fixed steps. Rendering shows the
+  // blend of the two, so motion stays smooth at any display rate. Added
+  // automatically to dynamic and kinematic bodies; add it by hand to other
+  // entities moved in FixedUpdate.
+  struct InterpolatedPose
+  {
+    float prevPos[3] = { 0.0f, 0.0f, 0.0f };
+    float prevRot[3] = { 0.0f, 0.0f, 0.0f };
+    float currPos[3] = { 0.0f, 0.0f, 0.0f };
+    float currRot[3] = { 0.0f, 0.0f, 0.0f };
+    float simPos[3] = { 0.0f, 0.0f, 0.0f };
+    float simRot[3] = { 0.0f, 0.0f, 0.0f };
+    bool captured = false;
+    bool applied = false;
+  };
+
+  struct PhysicsInterpolationState
+  {
+    bool enabled = true;
+    // Fraction of a fixed step left in the accumulator; set every frame.
+    float alpha = 1.0f;
+    // Moves longer than this in one step are treated as teleports.
+    float snapDistance = 5.0f;
+    std::vector<Entity> scratch;
+  };
+
   struct PhysicsDemoState
   {
     bool initialized = false;
@@ -229,4 +371,10 @@ namespace sc
   void PhysicsSyncSystem(World& world, float dt, void* user);
   void PhysicsDebugDrawSystem(World& world, float dt, void* user);
   void PhysicsDemoSystem(World& world, float dt, void* user);
+  // FixedUpdate, after everything that moves bodies.
+  void PhysicsInterpolationCaptureSystem(World& world, float dt, void* user);
+  // RenderPrep, before anything reads Transform for drawing.
+  void PhysicsInterpolationSystem(World& world, float dt, void* user);
+  // Render, last: puts the simulated poses back and rebuilds world matrices.
+  void PhysicsInterpolationRestoreSystem(World& world, float dt, void* user);
 }
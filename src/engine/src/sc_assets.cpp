@@ -1,13 +1,19 @@
 #include "sc_assets.h"
 
+#include "sc_jobs.h"
 #include "sc_log.h"
 #include "sc_paths.h"
 #include "sc_time.h"
+#include "sc_vfs.h"
+#include "mesh_format.h"
+#include "texture_format.h"
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <cstring>
 #include <filesystem>
+#include <thread>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
@@ -65,6 +71,8 @@ namespace sc
                           uint32_t mipLevels,
                           VkFormat format,
                           VkImageUsageFlags usage,
+                          const uint32_t* queueFamilies,
+                          uint32_t queueFamilyCount,
                           VkImage& image,
                           VkDeviceMemory& memory)
   {
@@ -81,6 +89,13 @@ namespace sc
     ici.usage = usage;
     ici.samples = VK_SAMPLE_COUNT_1_BIT;
     ici.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    if (queueFamilyCount > 1)
+    {
+      // Written on the transfer queue, sampled on graphics; avoids ownership transfers.
+      ici.sharingMode = VK_SHARING_MODE_CONCURRENT;
+      ici.queueFamilyIndexCount = queueFamilyCount;
+      ici.pQueueFamilyIndices = queueFamilies;
+    }
 
     if (vkCreateImage(device, &ici, nullptr, &image) != VK_SUCCESS)
       return false;
@@ -101,58 +116,22 @@ namespace sc
     return true;
   }
 
-  static VkCommandBuffer beginOneShot(VkDevice device, VkCommandPool cmdPool)
-  {
-    VkCommandBufferAllocateInfo ai{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
-    ai.commandPool = cmdPool;
-    ai.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    ai.commandBufferCount = 1;
-
-    VkCommandBuffer cmd = VK_NULL_HANDLE;
-    if (vkAllocateCommandBuffers(device, &ai, &cmd) != VK_SUCCESS)
-      return VK_NULL_HANDLE;
-
-    VkCommandBufferBeginInfo bi{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
-    bi.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-    if (vkBeginCommandBuffer(cmd, &bi) != VK_SUCCESS)
-    {
-      vkFreeCommandBuffers(device, cmdPool, 1, &cmd);
-      return VK_NULL_HANDLE;
-    }
-
-    return cmd;
-  }
-
-  static bool endOneShot(VkDevice device, VkQueue queue, VkCommandPool cmdPool, VkCommandBuffer cmd)
-  {
-    if (!cmd)
-      return false;
-    if (vkEndCommandBuffer(cmd) != VK_SUCCESS)
-      return false;
-
-    VkSubmitInfo si{ VK_STRUCTURE_TYPE_SUBMIT_INFO };
-    si.commandBufferCount = 1;
-    si.pCommandBuffers = &cmd;
-
-    if (vkQueueSubmit(queue, 1, &si, VK_NULL_HANDLE) != VK_SUCCESS)
-      return false;
-    vkQueueWaitIdle(queue);
-
-    vkFreeCommandBuffers(device, cmdPool, 1, &cmd);
-    return true;
-  }
-
+  // srcFamily != dstFamily records the release half of an ownership transfer
+  // (see acquireTextureImage for the other half).
   static void transitionImageLayout(VkCommandBuffer cmd,
                                     VkImage image,
                                     VkImageLayout oldLayout,
                                     VkImageLayout newLayout,
-                                    uint32_t mipLevels)
+                                    uint32_t mipLevels,
+                                    uint32_t srcFamily = VK_QUEUE_FAMILY_IGNORED,
+                                    uint32_t dstFamily = VK_QUEUE_FAMILY_IGNORED)
   {
+    const bool release = srcFamily != dstFamily;
     VkImageMemoryBarrier barrier{ VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER };
     barrier.oldLayout = oldLayout;
     barrier.newLayout = newLayout;
-    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.srcQueueFamilyIndex = release ? srcFamily : VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = release ? dstFamily : VK_QUEUE_FAMILY_IGNORED;
     barrier.image = image;
     barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
     barrier.subresourceRange.baseMipLevel = 0;
@@ -173,14 +152,51 @@ namespace sc
     else if (oldLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL && newLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
     {
       barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-      barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
       srcStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-      dstStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+      if (release)
+      {
+        // A transfer-only queue has no shader stages; the destination scope of a
+        // release is ignored and the graphics-side acquire supplies it.
+        barrier.dstAccessMask = 0;
+        dstStage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+      }
+      else
+      {
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        dstStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+      }
     }
 
     vkCmdPipelineBarrier(cmd, srcStage, dstStage, 0, 0, nullptr, 0, nullptr, 1, &barrier);
   }
 
+  // Graphics-queue half of the transfer released in transitionImageLayout. The
+  // submit waits on the upload timeline at the fragment stage, which this
+  // barrier's source scope chains to.
+  static void acquireTextureImage(VkCommandBuffer cmd,
+                                  VkImage image,
+                                  uint32_t mipLevels,
+                                  uint32_t srcFamily,
+                                  uint32_t dstFamily)
+  {
+    VkImageMemoryBarrier barrier{ VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER };
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    barrier.srcQueueFamilyIndex = srcFamily;
+    barrier.dstQueueFamilyIndex = dstFamily;
+    barrier.image = image;
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.baseMipLevel = 0;
+    barrier.subresourceRange.levelCount = mipLevels;
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount = 1;
+    barrier.srcAccessMask = 0;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                         0, 0, nullptr, 0, nullptr, 1, &barrier);
+  }
+
   static uint64_t materialCacheKey(const MaterialDesc& desc)
   {
     uint64_t key = static_cast<uint64_t>(desc.albedo);
@@ -195,10 +211,201 @@ namespace sc
     {
       case TextureFormat::RGBA8_UNORM: return VK_FORMAT_R8G8B8A8_UNORM;
       case TextureFormat::RGBA8_SRGB: return VK_FORMAT_R8G8B8A8_SRGB;
+      case TextureFormat::BC1_SRGB: return VK_FORMAT_BC1_RGB_SRGB_BLOCK;
+      case TextureFormat::BC1_UNORM: return VK_FORMAT_BC1_RGB_UNORM_BLOCK;
+      case TextureFormat::BC3_SRGB: return VK_FORMAT_BC3_SRGB_BLOCK;
+      case TextureFormat::BC3_UNORM: return VK_FORMAT_BC3_UNORM_BLOCK;
+      case TextureFormat::BC7_SRGB: return VK_FORMAT_BC7_SRGB_BLOCK;
+      case TextureFormat::BC7_UNORM: return VK_FORMAT_BC7_UNORM_BLOCK;
       default: return VK_FORMAT_R8G8B8A8_SRGB;
     }
   }
 
+  static bool isBlockCompressed(TextureFormat format)
+  {
+    return format != TextureFormat::RGBA8_SRGB &&
+           format != TextureFormat::RGBA8_UNORM &&
+           format != TextureFormat::Unknown;
+  }
+
+  static TextureFormat fromCookedFormat(sc_world::CookedTextureFormat format, bool srgb)
+  {
+    switch (format)
+    {
+      case sc_world::CookedTextureFormat::BC1: return srgb ? TextureFormat::BC1_SRGB : TextureFormat::BC1_UNORM;
+      case sc_world::CookedTextureFormat::BC3: return srgb ? TextureFormat::BC3_SRGB : TextureFormat::BC3_UNORM;
+      case sc_world::CookedTextureFormat::BC7: return srgb ? TextureFormat::BC7_SRGB : TextureFormat::BC7_UNORM;
+      default: return srgb ? TextureFormat::RGBA8_SRGB : TextureFormat::RGBA8_UNORM;
+    }
+  }
+
+  bool VkTransferQueue::init(VkDevice device, VkQueue queue, uint32_t family, bool timelineSemaphore)
+  {
+    m_device = device;
+    m_queue = queue;
+
+    VkCommandPoolCreateInfo pci{ VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
+    pci.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT | VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    pci.queueFamilyIndex = family;
+    if (vkCreateCommandPool(m_device, &pci, nullptr, &m_pool) != VK_SUCCESS)
+      return false;
+
+    if (timelineSemaphore)
+    {
+      VkSemaphoreTypeCreateInfo tci{ VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO };
+      tci.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+      tci.initialValue = 0;
+      VkSemaphoreCreateInfo sci{ VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO };
+      sci.pNext = &tci;
+      if (vkCreateSemaphore(m_device, &sci, nullptr, &m_timeline) != VK_SUCCESS)
+        return false;
+    }
+    return true;
+  }
+
+  void VkTransferQueue::shutdown()
+  {
+    if (!m_device)
+      return;
+
+    waitIdle();
+    for (Slot& slot : m_slots)
+    {
+      if (slot.fence)
+        vkDestroyFence(m_device, slot.fence, nullptr);
+    }
+    if (m_pool)
+      vkDestroyCommandPool(m_device, m_pool, nullptr);
+    if (m_timeline)
+      vkDestroySemaphore(m_device, m_timeline, nullptr);
+    *this = VkTransferQueue{};
+  }
+
+  VkCommandBuffer VkTransferQueue::commandBuffer()
+  {
+    if (m_recording != UINT32_MAX)
+      return m_slots[m_recording].cmd;
+
+    completedTicket();
+    uint32_t index = UINT32_MAX;
+    if (!m_freeSlots.empty())
+    {
+      index = m_freeSlots.back();
+      m_freeSlots.pop_back();
+    }
+    else
+    {
+      Slot slot{};
+      VkCommandBufferAllocateInfo ai{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+      ai.commandPool = m_pool;
+      ai.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+      ai.commandBufferCount = 1;
+      if (vkAllocateCommandBuffers(m_device, &ai, &slot.cmd) != VK_SUCCESS)
+        return VK_NULL_HANDLE;
+
+      VkFenceCreateInfo fci{ VK_STRUCTURE_TYPE_FENCE_CREATE_INFO };
+      if (vkCreateFence(m_device, &fci, nullptr, &slot.fence) != VK_SUCCESS)
+      {
+        vkFreeCommandBuffers(m_device, m_pool, 1, &slot.cmd);
+        return VK_NULL_HANDLE;
+      }
+      index = static_cast<uint32_t>(m_slots.size());
+      m_slots.push_back(slot);
+    }
+
+    VkCommandBufferBeginInfo bi{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+    bi.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    if (vkBeginCommandBuffer(m_slots[index].cmd, &bi) != VK_SUCCESS)
+    {
+      m_freeSlots.push_back(index);
+      return VK_NULL_HANDLE;
+    }
+
+    m_recording = index;
+    return m_slots[index].cmd;
+  }
+
+  bool VkTransferQueue::submit(uint64_t ticket)
+  {
+    // Tracked work with no commands still gets a fence so tickets stay ordered.
+    if (!commandBuffer())
+      return false;
+
+    const uint32_t index = m_recording;
+    m_recording = UINT32_MAX;
+    Slot& slot = m_slots[index];
+
+    bool ok = (vkEndCommandBuffer(slot.cmd) == VK_SUCCESS);
+    if (ok)
+      ok = (vkResetFences(m_device, 1, &slot.fence) == VK_SUCCESS);
+    if (ok)
+    {
+      VkSubmitInfo si{ VK_STRUCTURE_TYPE_SUBMIT_INFO };
+      si.commandBufferCount = 1;
+      si.pCommandBuffers = &slot.cmd;
+      // Tickets only grow, so they double as timeline values.
+      VkTimelineSemaphoreSubmitInfo tsi{ VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO };
+      if (m_timeline)
+      {
+        tsi.signalSemaphoreValueCount = 1;
+        tsi.pSignalSemaphoreValues = &ticket;
+        si.pNext = &tsi;
+        si.signalSemaphoreCount = 1;
+        si.pSignalSemaphores = &m_timeline;
+      }
+      ok = (vkQueueSubmit(m_queue, 1, &si, slot.fence) == VK_SUCCESS);
+    }
+
+    if (!ok)
+    {
+      sc::log(LogLevel::Error, "AssetManager: upload submit failed.");
+      m_freeSlots.push_back(index);
+      return false;
+    }
+
+    slot.ticket = ticket;
+    m_inFlight.push_back(index);
+    return true;
+  }
+
+  uint64_t VkTransferQueue::completedTicket()
+  {
+    while (!m_inFlight.empty())
+    {
+      const uint32_t index = m_inFlight.front();
+      if (vkGetFenceStatus(m_device, m_slots[index].fence) != VK_SUCCESS)
+        break;
+      m_completed = m_slots[index].ticket;
+      m_freeSlots.push_back(index);
+      m_inFlight.pop_front();
+    }
+    return m_completed;
+  }
+
+  bool VkTransferQueue::waitOldest()
+  {
+    completedTicket();
+    if (m_inFlight.empty())
+      return false;
+
+    vkWaitForFences(m_device, 1, &m_slots[m_inFlight.front()].fence, VK_TRUE, UINT64_MAX);
+    completedTicket();
+    return true;
+  }
+
+  void VkTransferQueue::waitIdle()
+  {
+    if (m_inFlight.empty())
+      return;
+
+    std::vector<VkFence> fences;
+    fences.reserve(m_inFlight.size());
+    for (uint32_t index : m_inFlight)
+      fences.push_back(m_slots[index].fence);
+    vkWaitForFences(m_device, static_cast<uint32_t>(fences.size()), fences.data(), VK_TRUE, UINT64_MAX);
+    completedTicket();
+  }
+
   bool AssetManager::init(const AssetManagerInit& init)
   {
     m_device = init.device;
@@ -209,6 +416,37 @@ namespace sc
     m_materialSetLayout = init.materialSetLayout;
     m_samplerAnisotropyEnabled = init.samplerAnisotropyEnabled;
     m_samplerMaxAnisotropy = std::max(1.0f, init.samplerMaxAnisotropy);
+    m_textureCompressionBC = init.textureCompressionBC;
+    m_graphicsFamily = init.graphicsFamily;
+
+    VkQueue transferQueue = init.transferQueue;
+    m_transferFamily = init.transferFamily;
+    if (!transferQueue)
+    {
+      transferQueue = init.graphicsQueue;
+      m_transferFamily = init.graphicsFamily;
+    }
+
+    if (!m_transfer.init(m_device, transferQueue, m_transferFamily, init.timelineSemaphore))
+    {
+      sc::log(LogLevel::Error, "AssetManager: failed to create upload command pool.");
+      return false;
+    }
+
+    if (!m_uploads.init(init.stagingBytes) ||
+        !createBuffer(m_device, m_phys, init.stagingBytes,
+                      VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                      m_stagingBuffer, m_stagingMemory))
+    {
+      sc::log(LogLevel::Error, "AssetManager: failed to create staging ring.");
+      return false;
+    }
+
+    void* mapped = nullptr;
+    if (vkMapMemory(m_device, m_stagingMemory, 0, VK_WHOLE_SIZE, 0, &mapped) != VK_SUCCESS)
+      return false;
+    m_stagingMapped = static_cast<unsigned char*>(mapped);
 
     const std::array<unsigned char, 4> white = { 255, 255, 255, 255 };
     TextureHandle whiteHandle = kInvalidTextureHandle;
@@ -225,25 +463,53 @@ namespace sc
       placeholder = m_defaultWhiteTexture;
     m_placeholderTexture = placeholder;
 
+    // Materials fall back to these, so they must be resident before first use.
+    finishUploads();
     return true;
   }
 
   void AssetManager::shutdown()
   {
-    for (TextureAsset& texture : m_textures)
-    {
-      destroyTextureGpu(texture);
-      texture = TextureAsset{};
-    }
+    // Without workers nothing is left to return; queued decodes were dropped.
+    if (jobs().workerCount() > 0)
+      drainTextureDecodes();
+    m_textureLoadQueue.clear();
+    m_readyTextures.clear();
+    m_pendingAcquires.clear();
+    m_decodedTextures.clear();
+    m_pixelBufferPool.clear();
+    m_texturesDecoding = 0;
+
+    m_transfer.shutdown();
+
+    for (TextureHandle i = 0; i < m_textures.size(); ++i)
+      destroyTextureGpu(i);
+    m_lruHead = kInvalidTextureHandle;
+    m_lruTail = kInvalidTextureHandle;
+    m_residentBytes = 0;
+    m_residentCount = 0;
 
     m_textures.clear();
     m_materials.clear();
+    m_meshLodSets.clear();
     m_textureCache.clear();
     m_meshCache.clear();
+    m_missingMeshes.clear();
+    m_meshLodSetByMesh.clear();
     m_materialCache.clear();
     m_defaultWhiteTexture = kInvalidTextureHandle;
     m_placeholderTexture = kInvalidTextureHandle;
-    m_textureLoadQueue.clear();
+
+    m_uploads.shutdown();
+    if (m_stagingMemory)
+      vkUnmapMemory(m_device, m_stagingMemory);
+    if (m_stagingBuffer)
+      vkDestroyBuffer(m_device, m_stagingBuffer, nullptr);
+    if (m_stagingMemory)
+      vkFreeMemory(m_device, m_stagingMemory, nullptr);
+    m_stagingBuffer = VK_NULL_HANDLE;
+    m_stagingMemory = VK_NULL_HANDLE;
+    m_stagingMapped = nullptr;
   }
 
   void AssetManager::setCommandContext(VkCommandPool commandPool, VkQueue graphicsQueue)
@@ -265,9 +531,8 @@ namespace sc
       const TextureHandle handle = it->second;
       if (handle < m_textures.size())
       {
-        TextureAsset& tex = m_textures[handle];
-        tex.lastUsedFrame = m_frameIndex;
-        if (!tex.resident)
+        touchTexture(handle);
+        if (!m_textures[handle].resident)
           requestTextureResident(handle);
       }
       return handle;
@@ -275,11 +540,9 @@ namespace sc
 
     ++m_textureCacheMisses;
 
-    int width = 0;
-    int height = 0;
-    int channels = 0;
-    stbi_uc* pixels = stbi_load(resolvedPath.string().c_str(), &width, &height, &channels, STBI_rgb_alpha);
-    if (!pixels || width <= 0 || height <= 0)
+    TextureDecodeResult decoded{};
+    decoded.format = srgb ? TextureFormat::RGBA8_SRGB : TextureFormat::RGBA8_UNORM;
+    if (!decodeTextureAsset(path, decoded))
     {
       sc::log(LogLevel::Warn, "AssetManager: failed to load texture '%s', creating fallback.", resolvedPath.string().c_str());
       const TextureHandle fallback = createFallbackTexture(path, id);
@@ -287,11 +550,30 @@ namespace sc
       return fallback;
     }
 
-    TextureHandle handle = kInvalidTextureHandle;
-    const bool ok = createTextureFromPixels(path, id, pixels, static_cast<uint32_t>(width), static_cast<uint32_t>(height), true, srgb, handle);
-    stbi_image_free(pixels);
-    if (!ok)
+    TextureAsset texture{};
+    texture.id = id;
+    texture.path = path;
+    texture.fromDisk = true;
+    texture.srgb = srgb;
+    texture.format = decoded.format;
+    texture.lastUsedFrame = m_frameIndex;
+    texture.loading = true;
+
+    const TextureHandle handle = static_cast<TextureHandle>(m_textures.size());
+    m_textures.push_back(std::move(texture));
+    decoded.handle = handle;
+    if (mustDeferUpload(m_textures[handle], decoded.pixels.size()))
+    {
+      decoded.serial = ++m_textures[handle].loadSerial;
+      m_readyTextures.push_back(std::move(decoded));
+      m_textureCache[id] = handle;
+      return handle;
+    }
+    if (!uploadDecodedTexture(decoded))
+    {
+      m_textures.pop_back();
       return kInvalidTextureHandle;
+    }
 
     m_textureCache[id] = handle;
     return handle;
@@ -309,13 +591,70 @@ namespace sc
     }
 
     ++m_meshCacheMisses;
-    return kInvalidMeshHandle;
+    if (!m_meshUploader || m_missingMeshes.count(id))
+      return kInvalidMeshHandle;
+
+    const MeshHandle handle = loadCookedMesh(normalized, id);
+    if (handle == kInvalidMeshHandle)
+      m_missingMeshes.insert(id);
+    return handle;
+  }
+
+  MeshHandle AssetManager::loadCookedMesh(const std::string& path, AssetId id)
+  {
+    // Registry entries name the source (.glb); the cooker writes <source>.scmesh.
+    const std::string cookedPath = sc_import::IsCookedMeshPath(path.c_str())
+                                     ? path
+                                     : path + sc_import::kCookedMeshExtension;
+    AssetBlob blob{};
+    if (!vfs().read(cookedPath, blob))
+      return kInvalidMeshHandle;
+
+    sc_import::CookedMesh cooked{};
+    if (!sc_import::ParseCookedMesh(blob.data(), blob.size(), &cooked) ||
+        cooked.lods.empty())
+    {
+      sc::log(LogLevel::Warn, "AssetManager: '%s' is not a valid cooked mesh.", cookedPath.c_str());
+      return kInvalidMeshHandle;
+    }
+
+    MeshLodSet set{};
+    const size_t lodCount = std::min<size_t>(cooked.lods.size(), kMaxMeshLods);
+    for (size_t lod = 0; lod < lodCount; ++lod)
+    {
+      const MeshHandle handle = m_meshUploader(cooked.lods[lod], m_meshUploaderUser);
+      if (handle == kInvalidMeshHandle)
+        break;
+      set.meshIds[lod] = handle;
+      if (lod < cooked.lodScreenSizes.size())
+        set.screenSizes[lod] = cooked.lodScreenSizes[lod];
+      ++set.lodCount;
+    }
+
+    if (set.lodCount == 0)
+    {
+      sc::log(LogLevel::Warn, "AssetManager: failed to upload cooked mesh '%s'.", cookedPath.c_str());
+      return kInvalidMeshHandle;
+    }
+
+    const MeshHandle handle = set.meshIds[0];
+    m_meshCache[id] = handle;
+    if (set.lodCount > 1)
+      m_meshLodSetByMesh[handle] = createMeshLodSet(set);
+    return handle;
   }
 
   void AssetManager::registerMeshAlias(const std::string& path, MeshHandle handle)
   {
     const AssetId id = fnv1a64(normalizePathForId(path));
     m_meshCache[id] = handle;
+    m_missingMeshes.erase(id);
+  }
+
+  void AssetManager::setMeshUploader(MeshUploadFn fn, void* user)
+  {
+    m_meshUploader = fn;
+    m_meshUploaderUser = user;
   }
 
   MaterialHandle AssetManager::createMaterial(const MaterialDesc& desc)
@@ -370,6 +709,27 @@ namespace sc
     return &m_materials[handle];
   }
 
+  uint32_t AssetManager::createMeshLodSet(const MeshLodSet& set)
+  {
+    if (set.lodCount == 0 || set.lodCount > kMaxMeshLods)
+      return kInvalidMeshLodSet;
+    m_meshLodSets.push_back(set);
+    return static_cast<uint32_t>(m_meshLodSets.size() - 1);
+  }
+
+  const MeshLodSet* AssetManager::getMeshLodSet(uint32_t id) const
+  {
+    if (id >= m_meshLodSets.size())
+      return nullptr;
+    return &m_meshLodSets[id];
+  }
+
+  uint32_t AssetManager::meshLodSetFor(MeshHandle handle) const
+  {
+    const auto it = m_meshLodSetByMesh.find(handle);
+    return (it != m_meshLodSetByMesh.end()) ? it->second : kInvalidMeshLodSet;
+  }
+
   const TextureAsset* AssetManager::getTexture(TextureHandle handle) const
   {
     if (handle >= m_textures.size())
@@ -383,6 +743,7 @@ namespace sc
     snap.textureCount = static_cast<uint32_t>(m_textures.size());
     snap.meshCount = static_cast<uint32_t>(m_meshCache.size());
     snap.materialCount = static_cast<uint32_t>(m_materials.size());
+    snap.meshLodSetCount = static_cast<uint32_t>(m_meshLodSets.size());
     snap.textureCacheHits = m_textureCacheHits;
     snap.textureCacheMisses = m_textureCacheMisses;
     snap.meshCacheHits = m_meshCacheHits;
@@ -396,18 +757,29 @@ namespace sc
     {
       snap.cpuBytes += texture.cpuBytes;
       snap.gpuBytes += texture.gpuBytes;
-      if (texture.resident)
-      {
-        snap.residentTextures++;
-        snap.gpuResidentBytes += texture.gpuBytes;
-      }
+      if (texture.resident && isBlockCompressed(texture.format))
+        snap.compressedTextures++;
     }
+    snap.residentTextures = m_residentCount;
+    snap.gpuResidentBytes = m_residentBytes;
 
     snap.queuedTextureLoads = static_cast<uint32_t>(m_textureLoadQueue.size());
+    snap.texturesDecoding = m_texturesDecoding;
+    snap.texturesAwaitingUpload = static_cast<uint32_t>(m_readyTextures.size());
+    snap.texturesDecodedThisFrame = m_decodedThisFrame;
+    snap.decodeLatencyAvgMs = (m_decodedThisFrame > 0) ? static_cast<float>(m_decodeLatencyTotalMs / m_decodedThisFrame) : 0.0f;
+    snap.decodeLatencyMaxMs = m_decodeLatencyMaxMs;
     snap.evictions = static_cast<uint32_t>(m_evictionsThisFrame);
     snap.gpuBudgetBytes = m_residency.gpuBudgetBytes;
     snap.evictionMs = static_cast<float>(ticksToSeconds(m_evictionTicks) * 1000.0);
 
+    const UploadTrackerStats& uploads = m_uploads.stats();
+    snap.pendingTextureUploads = uploads.pendingUploads;
+    snap.stagingCapacity = uploads.stagingCapacity;
+    snap.stagingInFlight = uploads.stagingInFlight;
+    snap.stagingFull = uploads.stagingFull;
+    snap.dedicatedTransferQueue = (m_transferFamily != m_graphicsFamily);
+
     return snap;
   }
 
@@ -436,9 +808,13 @@ namespace sc
     m_evictionsThisFrame = 0;
     m_queuedLoadsThisFrame = 0;
     m_evictionTicks = 0;
+    m_decodedThisFrame = 0;
+    m_uploadsThisFrame = 0;
+    m_decodeLatencyTotalMs = 0.0;
+    m_decodeLatencyMaxMs = 0.0f;
   }
 
-  void AssetManager::touchMaterial(MaterialHandle handle)
+  void AssetManager::touchMaterial(MaterialHandle handle, float screenSize)
   {
     if (handle >= m_materials.size())
       return;
@@ -449,11 +825,81 @@ namespace sc
       return;
 
     TextureAsset& tex = m_textures[texHandle];
-    tex.lastUsedFrame = m_frameIndex;
+    if (tex.lastUsedFrame != m_frameIndex)
+      tex.importance = screenSize;
+    else
+      tex.importance = std::max(tex.importance, screenSize);
+    touchTexture(texHandle);
     if (!tex.resident)
       requestTextureResident(texHandle);
   }
 
+  void AssetManager::touchTexture(TextureHandle handle)
+  {
+    TextureAsset& tex = m_textures[handle];
+    // Every draw of a texture stamps the same frame; only the first one relinks.
+    if (tex.lastUsedFrame == m_frameIndex)
+      return;
+    tex.lastUsedFrame = m_frameIndex;
+    if (tex.inLru && m_lruHead != handle)
+    {
+      lruUnlink(handle);
+      lruLink(handle);
+    }
+  }
+
+  void AssetManager::lruLink(TextureHandle handle)
+  {
+    TextureAsset& tex = m_textures[handle];
+    tex.lruPrev = kInvalidTextureHandle;
+    tex.lruNext = m_lruHead;
+    if (m_lruHead != kInvalidTextureHandle)
+      m_textures[m_lruHead].lruPrev = handle;
+    else
+      m_lruTail = handle;
+    m_lruHead = handle;
+    tex.inLru = true;
+  }
+
+  void AssetManager::lruUnlink(TextureHandle handle)
+  {
+    TextureAsset& tex = m_textures[handle];
+    if (tex.lruPrev != kInvalidTextureHandle)
+      m_textures[tex.lruPrev].lruNext = tex.lruNext;
+    else
+      m_lruHead = tex.lruNext;
+    if (tex.lruNext != kInvalidTextureHandle)
+      m_textures[tex.lruNext].lruPrev = tex.lruPrev;
+    else
+      m_lruTail = tex.lruPrev;
+    tex.lruPrev = kInvalidTextureHandle;
+    tex.lruNext = kInvalidTextureHandle;
+    tex.inLru = false;
+  }
+
+  void AssetManager::setResident(TextureHandle handle, bool resident)
+  {
+    TextureAsset& tex = m_textures[handle];
+    if (tex.resident == resident)
+      return;
+
+    tex.resident = resident;
+    if (resident)
+    {
+      m_residentBytes += tex.gpuBytes;
+      m_residentCount++;
+      if (tex.fromDisk && !tex.pinned)
+        lruLink(handle);
+      return;
+    }
+
+    m_residentBytes -= std::min(m_residentBytes, tex.gpuBytes);
+    if (m_residentCount > 0)
+      m_residentCount--;
+    if (tex.inLru)
+      lruUnlink(handle);
+  }
+
   void AssetManager::requestTextureResident(TextureHandle handle)
   {
     if (handle >= m_textures.size())
@@ -464,9 +910,11 @@ namespace sc
       return;
     if (!tex.fromDisk)
     {
-      tex.resident = true;
-      tex.loading = false;
+      if (!tex.view)
+        return;
       tex.pinned = true;
+      tex.loading = false;
+      setResident(handle, true);
       return;
     }
 
@@ -477,111 +925,292 @@ namespace sc
 
   void AssetManager::pumpTextureLoads(uint32_t maxLoadsPerFrame)
   {
-    const uint32_t limit = maxLoadsPerFrame == 0 ? 0 : maxLoadsPerFrame;
-    uint32_t loaded = 0;
+    collectTextureDecodes();
+    uploadReadyTextures(maxLoadsPerFrame);
+    dispatchTextureDecodes();
+
+    if (!m_uploads.flush(m_transfer))
+      retireUploads();
+  }
 
-    while (loaded < limit && !m_textureLoadQueue.empty())
+  void AssetManager::uploadReadyTextures(uint32_t maxUploadsPerFrame)
+  {
+    while (m_uploadsThisFrame < maxUploadsPerFrame && !m_readyTextures.empty())
     {
-      const TextureHandle handle = m_textureLoadQueue.front();
-      m_textureLoadQueue.pop_front();
+      TextureDecodeResult& result = m_readyTextures.front();
+      TextureAsset* tex = (result.handle < m_textures.size()) ? &m_textures[result.handle] : nullptr;
+      // A resident texture only has a current result when reloadTexture() deferred it.
+      const bool current = tex && tex->loading && tex->loadSerial == result.serial;
+      if (current && !result.ok)
+      {
+        sc::log(LogLevel::Warn, "AssetManager: failed to reload texture '%s'.", tex->path.c_str());
+        tex->loading = false;
+      }
+      else if (current)
+      {
+        // A full ring frees up as copies retire; wait a frame instead of stalling on them.
+        if (mustDeferUpload(*tex, result.pixels.size()))
+          break;
 
-      if (handle >= m_textures.size())
-        continue;
+        // Stays loading until retireUploads() sees the copy's fence.
+        uploadDecodedTexture(result);
+        m_uploadsThisFrame++;
+      }
+
+      releasePixelBuffer(std::move(result.pixels));
+      m_readyTextures.pop_front();
+    }
+  }
+
+  bool AssetManager::mustDeferUpload(const TextureAsset& tex, uint64_t bytes) const
+  {
+    // The previous image may still be copied into or waiting for its acquire.
+    if (tex.uploading || tex.acquirePending)
+      return true;
+    const bool ringBusy = m_uploads.hasOpenBatch() || m_uploads.stats().batchesInFlight > 0;
+    return ringBusy && !m_uploads.fits(bytes, 16);
+  }
+
+  void AssetManager::dispatchTextureDecodes()
+  {
+    m_textureLoadQueue.erase(std::remove_if(m_textureLoadQueue.begin(), m_textureLoadQueue.end(),
+      [&](TextureHandle handle)
+      {
+        if (handle >= m_textures.size())
+          return true;
+        const TextureAsset& tex = m_textures[handle];
+        return tex.resident || !tex.loading || tex.uploading;
+      }), m_textureLoadQueue.end());
+
+    const uint32_t maxInFlight = std::max(1u, m_residency.maxTextureDecodesInFlight);
+    if (m_texturesDecoding >= maxInFlight || m_textureLoadQueue.empty())
+      return;
+
+    const size_t slots = std::min<size_t>(maxInFlight - m_texturesDecoding, m_textureLoadQueue.size());
 
+    // Most recently used first, then largest on screen; the rest wait for a slot.
+    std::partial_sort(m_textureLoadQueue.begin(), m_textureLoadQueue.begin() + slots, m_textureLoadQueue.end(),
+      [&](TextureHandle a, TextureHandle b)
+      {
+        const TextureAsset& ta = m_textures[a];
+        const TextureAsset& tb = m_textures[b];
+        if (ta.lastUsedFrame != tb.lastUsedFrame) return ta.lastUsedFrame > tb.lastUsedFrame;
+        if (ta.importance != tb.importance) return ta.importance > tb.importance;
+        return a < b;
+      });
+
+    static const uint32_t scopeId = registerScope("Assets/TextureDecode");
+    const bool async = jobs().workerCount() > 0;
+    for (size_t i = 0; i < slots; ++i)
+    {
+      const TextureHandle handle = m_textureLoadQueue[i];
       TextureAsset& tex = m_textures[handle];
-      if (tex.resident)
+
+      TextureDecodeResult request{};
+      request.handle = handle;
+      request.serial = ++tex.loadSerial;
+      request.format = tex.srgb ? TextureFormat::RGBA8_SRGB : TextureFormat::RGBA8_UNORM;
+      request.requestTicks = nowTicks();
+      if (!m_pixelBufferPool.empty())
       {
-        tex.loading = false;
-        continue;
+        request.pixels = std::move(m_pixelBufferPool.back());
+        m_pixelBufferPool.pop_back();
       }
 
-      if (!reloadTexture(handle))
+      const std::string path = tex.path;
+      m_texturesDecoding++;
+
+      if (!async)
       {
-        tex.loading = false;
+        request.ok = decodeTextureAsset(path, request);
+        request.decodedTicks = nowTicks();
+        std::lock_guard<std::mutex> lock(m_decodeMutex);
+        m_decodedTextures.push_back(std::move(request));
         continue;
       }
 
-      tex.loading = false;
-      tex.lastUsedFrame = m_frameIndex;
-      refreshMaterialsForTexture(handle);
-      loaded++;
+      AssetManager* self = this;
+      jobs().DispatchAsync([self, path, request = std::move(request)](const JobContext&) mutable
+      {
+        request.ok = AssetManager::decodeTextureAsset(path, request);
+        request.decodedTicks = nowTicks();
+        std::lock_guard<std::mutex> lock(self->m_decodeMutex);
+        self->m_decodedTextures.push_back(std::move(request));
+      }, scopeId);
+    }
+
+    m_textureLoadQueue.erase(m_textureLoadQueue.begin(), m_textureLoadQueue.begin() + slots);
+  }
+
+  void AssetManager::collectTextureDecodes()
+  {
+    std::lock_guard<std::mutex> lock(m_decodeMutex);
+    for (TextureDecodeResult& result : m_decodedTextures)
+    {
+      if (m_texturesDecoding > 0)
+        m_texturesDecoding--;
+
+      const float latencyMs = static_cast<float>(ticksToSeconds(result.decodedTicks - result.requestTicks) * 1000.0);
+      m_decodeLatencyTotalMs += latencyMs;
+      m_decodeLatencyMaxMs = std::max(m_decodeLatencyMaxMs, latencyMs);
+      m_decodedThisFrame++;
+
+      m_readyTextures.push_back(std::move(result));
     }
+    m_decodedTextures.clear();
   }
 
-  void AssetManager::evictIfNeeded()
+  void AssetManager::drainTextureDecodes()
   {
-    if (m_residency.freezeEviction)
+    collectTextureDecodes();
+    while (m_texturesDecoding > 0)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      collectTextureDecodes();
+    }
+  }
+
+  void AssetManager::releasePixelBuffer(std::vector<unsigned char>&& pixels)
+  {
+    static constexpr size_t kMaxPooledPixelBuffers = 16;
+    if (pixels.capacity() == 0 || m_pixelBufferPool.size() >= kMaxPooledPixelBuffers)
       return;
+    pixels.clear();
+    m_pixelBufferPool.push_back(std::move(pixels));
+  }
 
-    const Tick start = nowTicks();
+  void AssetManager::pumpUploads()
+  {
+    retireUploads();
+    // Uploads deferred outside the streaming path still need a frame to go out in.
+    uploadReadyTextures(m_residency.maxTextureLoadsPerFrame);
+    if (!m_uploads.flush(m_transfer))
+      retireUploads();
+  }
 
-    uint64_t gpuUsed = 0;
-    uint32_t residentCount = 0;
-    for (const TextureAsset& tex : m_textures)
+  uint64_t AssetManager::uploadBufferData(VkBuffer dst, VkDeviceSize dstOffset, const void* data, VkDeviceSize bytes)
+  {
+    if (!dst || !data || bytes == 0 || !m_stagingMapped)
+      return 0;
+
+    // Large buffers go through in pieces so no single copy needs the whole ring.
+    const VkDeviceSize maxChunk = std::max<VkDeviceSize>(m_uploads.capacity() / 2, 16);
+    const unsigned char* src = static_cast<const unsigned char*>(data);
+    VkDeviceSize done = 0;
+    while (done < bytes)
     {
-      if (tex.resident)
+      const VkDeviceSize chunk = std::min(bytes - done, maxChunk);
+      uint64_t stagingOffset = m_uploads.reserve(chunk, 16);
+      while (stagingOffset == UploadTracker::kInvalidOffset)
       {
-        gpuUsed += tex.gpuBytes;
-        residentCount++;
+        // Ring is full: submit what is open and wait for the oldest batch, not the queue.
+        if (m_uploads.hasOpenBatch() && !m_uploads.flush(m_transfer))
+        {
+          retireUploads();
+          return 0;
+        }
+        if (!m_transfer.waitOldest())
+          return 0;
+        retireUploads();
+        stagingOffset = m_uploads.reserve(chunk, 16);
       }
-    }
 
-    const bool overBytes = (m_residency.gpuBudgetBytes > 0 && gpuUsed > m_residency.gpuBudgetBytes);
-    const bool overCount = (m_residency.maxResidentTextures > 0 && residentCount > m_residency.maxResidentTextures);
-    if (!overBytes && !overCount)
-    {
-      m_evictionTicks += nowTicks() - start;
-      return;
+      VkCommandBuffer cmd = m_transfer.commandBuffer();
+      if (!cmd)
+        return 0;
+
+      std::memcpy(m_stagingMapped + stagingOffset, src + done, static_cast<size_t>(chunk));
+      VkBufferCopy copy{};
+      copy.srcOffset = stagingOffset;
+      copy.dstOffset = dstOffset + done;
+      copy.size = chunk;
+      vkCmdCopyBuffer(cmd, m_stagingBuffer, dst, 1, &copy);
+      done += chunk;
     }
+    return m_uploads.openTicket();
+  }
 
-    struct Candidate
+  void AssetManager::retireUploads()
+  {
+    m_uploads.update(m_transfer, [&](uint32_t handle, bool ok)
     {
-      TextureHandle handle = kInvalidTextureHandle;
-      uint64_t lastUsed = 0;
-    };
+      if (handle >= m_textures.size())
+        return;
 
-    std::vector<Candidate> candidates;
-    candidates.reserve(m_textures.size());
-    for (TextureHandle i = 0; i < m_textures.size(); ++i)
+      TextureAsset& tex = m_textures[handle];
+      tex.uploading = false;
+      if (ok && m_transferFamily != m_graphicsFamily)
+      {
+        // Still owned by the transfer family until recordTextureAcquires().
+        tex.acquirePending = true;
+        m_pendingAcquires.push_back(handle);
+        return;
+      }
+
+      tex.loading = false;
+      if (ok)
+      {
+        tex.lastUsedFrame = m_frameIndex;
+        setResident(handle, true);
+      }
+      else
+      {
+        destroyTextureGpu(handle);
+      }
+      refreshMaterialsForTexture(handle);
+    });
+  }
+
+  void AssetManager::recordTextureAcquires(VkCommandBuffer cmd)
+  {
+    for (TextureHandle handle : m_pendingAcquires)
     {
-      const TextureAsset& tex = m_textures[i];
-      if (!tex.resident)
-        continue;
-      if (tex.pinned)
-        continue;
-      if (!tex.fromDisk)
+      // Reloaded or destroyed since its copy retired.
+      if (handle >= m_textures.size() || !m_textures[handle].acquirePending)
         continue;
-      candidates.push_back({ i, tex.lastUsedFrame });
+
+      TextureAsset& tex = m_textures[handle];
+      acquireTextureImage(cmd, tex.image, tex.mipLevels, m_transferFamily, m_graphicsFamily);
+      tex.acquirePending = false;
+      tex.loading = false;
+      tex.lastUsedFrame = m_frameIndex;
+      setResident(handle, true);
+      refreshMaterialsForTexture(handle);
     }
+    m_pendingAcquires.clear();
+  }
 
-    std::sort(candidates.begin(), candidates.end(),
-      [&](const Candidate& a, const Candidate& b)
-      {
-        if (a.lastUsed != b.lastUsed) return a.lastUsed < b.lastUsed;
-        return a.handle < b.handle;
-      });
+  void AssetManager::finishUploads()
+  {
+    m_uploads.flush(m_transfer);
+    m_transfer.waitIdle();
+    retireUploads();
+  }
+
+  void AssetManager::evictIfNeeded()
+  {
+    if (m_residency.freezeEviction)
+      return;
 
-    for (const Candidate& c : candidates)
+    const Tick start = nowTicks();
+
+    // Running totals and the LRU tail make this independent of texture count.
+    auto overBudget = [&]()
     {
-      const bool stillOverBytes = (m_residency.gpuBudgetBytes > 0 && gpuUsed > m_residency.gpuBudgetBytes);
-      const bool stillOverCount = (m_residency.maxResidentTextures > 0 && residentCount > m_residency.maxResidentTextures);
-      if (!stillOverBytes && !stillOverCount)
-        break;
+      const bool overBytes = (m_residency.gpuBudgetBytes > 0 && m_residentBytes > m_residency.gpuBudgetBytes);
+      const bool overCount = (m_residency.maxResidentTextures > 0 && m_residentCount > m_residency.maxResidentTextures);
+      return overBytes || overCount;
+    };
 
-      TextureAsset& tex = m_textures[c.handle];
-      const uint64_t bytes = tex.gpuBytes;
-      destroyTextureGpu(tex);
-      tex.resident = false;
+    while (overBudget() && m_lruTail != kInvalidTextureHandle)
+    {
+      const TextureHandle handle = m_lruTail;
+      destroyTextureGpu(handle);
+      TextureAsset& tex = m_textures[handle];
       tex.loading = false;
       tex.lastUsedFrame = 0;
-      if (residentCount > 0)
-        residentCount--;
-      if (gpuUsed > bytes)
-        gpuUsed -= bytes;
-      else
-        gpuUsed = 0;
 
-      refreshMaterialsForTexture(c.handle);
+      refreshMaterialsForTexture(handle);
       m_evictionsThisFrame++;
     }
 
@@ -609,16 +1238,39 @@ namespace sc
     texture.fromDisk = fromDisk;
     texture.srgb = srgb;
     texture.format = format;
-    texture.resident = true;
+    texture.resident = false;
     texture.pinned = !fromDisk;
     texture.lastUsedFrame = m_frameIndex;
-    texture.loading = false;
+    texture.loading = true;
 
-    if (!uploadTexturePixels(rgbaPixels, width, height, format, texture))
+    const TextureHandle handle = static_cast<TextureHandle>(m_textures.size());
+    m_textures.push_back(std::move(texture));
+    const TextureMipLevel level{ width, height, 0, m_textures.back().cpuBytes };
+    if (mustDeferUpload(m_textures[handle], level.size))
+    {
+      TextureDecodeResult deferred{};
+      deferred.handle = handle;
+      deferred.serial = ++m_textures[handle].loadSerial;
+      deferred.width = width;
+      deferred.height = height;
+      deferred.format = format;
+      deferred.mipCount = 1;
+      deferred.mips[0] = level;
+      deferred.pixels.assign(rgbaPixels, rgbaPixels + level.size);
+      deferred.ok = true;
+      deferred.fromDisk = fromDisk;
+      m_readyTextures.push_back(std::move(deferred));
+      outHandle = handle;
+      return true;
+    }
+    if (!uploadTexturePixels(rgbaPixels, width, height, format, &level, 1, handle))
+    {
+      destroyTextureGpu(handle);
+      m_textures.pop_back();
       return false;
+    }
 
-    outHandle = static_cast<TextureHandle>(m_textures.size());
-    m_textures.push_back(std::move(texture));
+    outHandle = handle;
     return true;
   }
 
@@ -631,43 +1283,120 @@ namespace sc
     if (texture.path.empty())
       return false;
 
-    const std::filesystem::path resolvedPath = resolveAssetPath(texture.path);
+    TextureDecodeResult result{};
+    result.handle = handle;
+    // Supersedes any decode of this texture still in flight.
+    result.serial = ++texture.loadSerial;
+    result.format = texture.srgb ? TextureFormat::RGBA8_SRGB : TextureFormat::RGBA8_UNORM;
+    if (!decodeTextureAsset(texture.path, result))
+    {
+      sc::log(LogLevel::Warn, "AssetManager: failed to reload texture '%s'.", texture.path.c_str());
+      return false;
+    }
+
+    if (mustDeferUpload(texture, result.pixels.size()))
+    {
+      // pumpTextureLoads() picks it up once the previous copy or ring space is done.
+      result.ok = true;
+      texture.loading = true;
+      m_readyTextures.push_back(std::move(result));
+      return true;
+    }
+    return uploadDecodedTexture(result);
+  }
+
+  bool AssetManager::decodeTextureAsset(const std::string& path, TextureDecodeResult& result)
+  {
+    AssetBlob blob{};
+    if (!vfs().read(path, blob))
+      return false;
+    return decodeTextureBytes(blob.bytes, result);
+  }
+
+  bool AssetManager::decodeTextureBytes(std::span<const std::byte> bytes, TextureDecodeResult& result)
+  {
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(bytes.data());
+    if (sc_world::IsCookedTextureData(data, bytes.size()))
+    {
+      // Cooked data is already in its GPU layout; the pooled buffer becomes the blob.
+      sc_world::CookedTexture cooked{};
+      cooked.data.swap(result.pixels);
+      const bool ok = sc_world::ParseCookedTexture(data, bytes.size(), &cooked);
+      result.pixels.swap(cooked.data);
+      if (!ok || cooked.mips.size() > kMaxTextureMips)
+        return false;
+
+      result.width = cooked.width;
+      result.height = cooked.height;
+      result.format = fromCookedFormat(cooked.format, cooked.srgb);
+      result.mipCount = static_cast<uint32_t>(cooked.mips.size());
+      for (uint32_t i = 0; i < result.mipCount; ++i)
+      {
+        result.mips[i].width = cooked.mips[i].width;
+        result.mips[i].height = cooked.mips[i].height;
+        result.mips[i].offset = cooked.mips[i].offset;
+        result.mips[i].size = cooked.mips[i].size;
+      }
+      return true;
+    }
+
     int width = 0;
     int height = 0;
     int channels = 0;
-    stbi_uc* pixels = stbi_load(resolvedPath.string().c_str(), &width, &height, &channels, STBI_rgb_alpha);
+    if (bytes.empty() || bytes.size() > static_cast<size_t>(INT32_MAX))
+      return false;
+    stbi_uc* pixels = stbi_load_from_memory(data, static_cast<int>(bytes.size()), &width, &height, &channels, STBI_rgb_alpha);
     if (!pixels || width <= 0 || height <= 0)
     {
-      sc::log(LogLevel::Warn, "AssetManager: failed to reload texture '%s'.", resolvedPath.string().c_str());
       if (pixels)
         stbi_image_free(pixels);
       return false;
     }
 
-    destroyTextureGpu(texture);
+    const size_t bytes = static_cast<size_t>(width) * static_cast<size_t>(height) * 4u;
+    result.pixels.resize(bytes);
+    std::memcpy(result.pixels.data(), pixels, bytes);
+    stbi_image_free(pixels);
 
-    texture.width = static_cast<uint32_t>(width);
-    texture.height = static_cast<uint32_t>(height);
-    texture.mipLevels = 1;
-    texture.cpuBytes = static_cast<uint64_t>(width) * static_cast<uint64_t>(height) * 4ull;
+    result.width = static_cast<uint32_t>(width);
+    result.height = static_cast<uint32_t>(height);
+    result.mipCount = 1;
+    result.mips[0] = { result.width, result.height, 0, bytes };
+    return true;
+  }
+
+  bool AssetManager::uploadDecodedTexture(TextureDecodeResult& result)
+  {
+    // Callers defer through mustDeferUpload(), so no copy is in flight for this image.
+    const TextureHandle handle = result.handle;
+    TextureAsset& texture = m_textures[handle];
+    destroyTextureGpu(handle);
+    refreshMaterialsForTexture(handle);
+
+    texture.width = result.width;
+    texture.height = result.height;
+    texture.format = result.format;
+    texture.mipLevels = result.mipCount;
+    texture.cpuBytes = static_cast<uint64_t>(result.pixels.size());
     texture.gpuBytes = texture.cpuBytes;
-    texture.fromDisk = true;
+    texture.fromDisk = result.fromDisk;
 
-    const bool ok = uploadTexturePixels(pixels,
-                                        static_cast<uint32_t>(width),
-                                        static_cast<uint32_t>(height),
-                                        texture.format,
-                                        texture);
-    stbi_image_free(pixels);
-    if (!ok)
+    if (!uploadTexturePixels(result.pixels.data(), result.width, result.height, result.format,
+                             result.mips, result.mipCount, handle))
+    {
+      destroyTextureGpu(handle);
+      texture.loading = false;
       return false;
+    }
 
-    texture.resident = true;
+    texture.loading = true;
     return true;
   }
 
-  void AssetManager::destroyTextureGpu(TextureAsset& texture)
+  void AssetManager::destroyTextureGpu(TextureHandle handle)
   {
+    setResident(handle, false);
+    TextureAsset& texture = m_textures[handle];
     if (texture.sampler) vkDestroySampler(m_device, texture.sampler, nullptr);
     if (texture.view) vkDestroyImageView(m_device, texture.view, nullptr);
     if (texture.image) vkDestroyImage(m_device, texture.image, nullptr);
@@ -677,7 +1406,7 @@ namespace sc
     texture.image = VK_NULL_HANDLE;
     texture.memory = VK_NULL_HANDLE;
     texture.gpuBytes = 0;
-    texture.resident = false;
+    texture.acquirePending = false;
   }
 
   void AssetManager::refreshMaterialsForTexture(TextureHandle handle)
@@ -689,70 +1418,56 @@ namespace sc
     }
   }
 
-  bool AssetManager::uploadTexturePixels(const unsigned char* rgbaPixels,
+  bool AssetManager::uploadTexturePixels(const unsigned char* data,
                                          uint32_t width,
                                          uint32_t height,
                                          TextureFormat format,
-                                         TextureAsset& outTexture)
+                                         const TextureMipLevel* mips,
+                                         uint32_t mipCount,
+                                         TextureHandle handle)
   {
-    const VkDeviceSize imageSize = static_cast<VkDeviceSize>(width) * static_cast<VkDeviceSize>(height) * 4ull;
-
-    VkBuffer stagingBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory stagingMemory = VK_NULL_HANDLE;
-    if (!createBuffer(m_device, m_phys, imageSize,
-                      VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                      stagingBuffer, stagingMemory))
+    TextureAsset& outTexture = m_textures[handle];
+    if (!mips || mipCount == 0 || mipCount > kMaxTextureMips)
+      return false;
+    if (isBlockCompressed(format) && !m_textureCompressionBC)
     {
+      sc::log(LogLevel::Error, "AssetManager: texture '%s' is BC compressed but the device lacks textureCompressionBC.",
+              outTexture.path.c_str());
       return false;
     }
 
-    void* mapped = nullptr;
-    if (vkMapMemory(m_device, stagingMemory, 0, imageSize, 0, &mapped) != VK_SUCCESS)
+    // Levels are packed back to back, each already aligned to its block size.
+    VkDeviceSize imageSize = 0;
+    for (uint32_t i = 0; i < mipCount; ++i)
+      imageSize = std::max<VkDeviceSize>(imageSize, mips[i].offset + mips[i].size);
+
+    // Callers defer while the ring is busy, so a miss here means it can never fit.
+    const uint64_t stagingOffset = m_uploads.reserve(imageSize, 16);
+    if (stagingOffset == UploadTracker::kInvalidOffset)
+    {
+      sc::log(LogLevel::Error, "AssetManager: texture '%s' (%llu bytes) does not fit the staging ring.",
+              outTexture.path.c_str(), static_cast<unsigned long long>(imageSize));
       return false;
-    std::memcpy(mapped, rgbaPixels, static_cast<size_t>(imageSize));
-    vkUnmapMemory(m_device, stagingMemory);
+    }
+    std::memcpy(m_stagingMapped + stagingOffset, data, static_cast<size_t>(imageSize));
 
+    // Exclusive: a dedicated transfer queue hands the image to graphics with a release/acquire pair.
     const VkFormat vkFormat = toVkFormat(format);
-    if (!createImage(m_device, m_phys, width, height, 1,
+    if (!createImage(m_device, m_phys, width, height, mipCount,
                      vkFormat,
                      VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                     &m_transferFamily, 1u,
                      outTexture.image, outTexture.memory))
     {
       return false;
     }
 
-    VkCommandBuffer cmd = beginOneShot(m_device, m_commandPool);
-    if (!cmd)
-      return false;
-
-    transitionImageLayout(cmd, outTexture.image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1);
-
-    VkBufferImageCopy copy{};
-    copy.bufferOffset = 0;
-    copy.bufferRowLength = 0;
-    copy.bufferImageHeight = 0;
-    copy.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    copy.imageSubresource.mipLevel = 0;
-    copy.imageSubresource.baseArrayLayer = 0;
-    copy.imageSubresource.layerCount = 1;
-    copy.imageOffset = { 0, 0, 0 };
-    copy.imageExtent = { width, height, 1 };
-    vkCmdCopyBufferToImage(cmd, stagingBuffer, outTexture.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copy);
-
-    transitionImageLayout(cmd, outTexture.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 1);
-    if (!endOneShot(m_device, m_graphicsQueue, m_commandPool, cmd))
-      return false;
-
-    vkDestroyBuffer(m_device, stagingBuffer, nullptr);
-    vkFreeMemory(m_device, stagingMemory, nullptr);
-
     VkImageViewCreateInfo ivci{ VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO };
     ivci.image = outTexture.image;
     ivci.viewType = VK_IMAGE_VIEW_TYPE_2D;
     ivci.format = vkFormat;
     ivci.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    ivci.subresourceRange.levelCount = 1;
+    ivci.subresourceRange.levelCount = mipCount;
     ivci.subresourceRange.layerCount = 1;
     if (vkCreateImageView(m_device, &ivci, nullptr, &outTexture.view) != VK_SUCCESS)
       return false;
@@ -770,10 +1485,39 @@ namespace sc
     sci.compareEnable = VK_FALSE;
     sci.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
     sci.minLod = 0.0f;
-    sci.maxLod = 0.0f;
+    sci.maxLod = static_cast<float>(mipCount - 1u);
     if (vkCreateSampler(m_device, &sci, nullptr, &outTexture.sampler) != VK_SUCCESS)
       return false;
 
+    VkCommandBuffer cmd = m_transfer.commandBuffer();
+    if (!cmd)
+      return false;
+
+    transitionImageLayout(cmd, outTexture.image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, mipCount);
+
+    VkBufferImageCopy copies[kMaxTextureMips]{};
+    for (uint32_t i = 0; i < mipCount; ++i)
+    {
+      VkBufferImageCopy& copy = copies[i];
+      copy.bufferOffset = stagingOffset + mips[i].offset;
+      copy.bufferRowLength = 0;
+      copy.bufferImageHeight = 0;
+      copy.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+      copy.imageSubresource.mipLevel = i;
+      copy.imageSubresource.baseArrayLayer = 0;
+      copy.imageSubresource.layerCount = 1;
+      copy.imageOffset = { 0, 0, 0 };
+      copy.imageExtent = { mips[i].width, mips[i].height, 1 };
+    }
+    vkCmdCopyBufferToImage(cmd, m_stagingBuffer, outTexture.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, mipCount, copies);
+
+    transitionImageLayout(cmd, outTexture.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, mipCount,
+                          m_transferFamily, m_graphicsFamily);
+
+    // From here the image belongs to the open batch; residency flips in retireUploads().
+    outTexture.uploading = true;
+    m_uploads.track(handle);
+
     return true;
   }
 
@@ -12,7 +12,7 @@
 
 namespace
 {
-  static const uint32_t kRenderApiVersion = 1;
+  static const uint32_t kRenderApiVersion = 2;
 
   enum HandleType : uint8_t
   {
@@ -160,6 +160,7 @@ void scRenderSubmit(ScRenderContext* ctx, const ScRenderDrawList* list)
   if (!ctx || !list || !list->items || list->count == 0)
     return;
 
+  ctx->frame.sorted = false;
   ctx->frame.draws.reserve(ctx->frame.draws.size() + list->count);
   for (uint32_t i = 0; i < list->count; ++i)
   {
@@ -376,12 +377,15 @@ void scRenderGetStats(ScRenderContext* ctx, ScRenderStats* out_stats)
     return;
 
   const sc::AssetStatsSnapshot stats = ctx->renderer.assets().stats();
-  out_stats->draw_calls = static_cast<uint32_t>(ctx->frame.draws.size());
+  const sc::DrawBatchStats& batches = ctx->renderer.drawBatchStats();
+  out_stats->draw_calls = batches.batches;
   out_stats->triangle_count = 0;
   out_stats->mesh_count = ctx->renderer.meshCount();
   out_stats->texture_count = stats.textureCount;
   out_stats->gpu_ms = 0.0f;
   out_stats->cpu_ms = 0.0f;
+  out_stats->raw_draws = batches.rawDraws;
+  out_stats->instanced_batches = batches.batches;
 }
 
 int scRenderImGuiInit(ScRenderContext* ctx)
@@ -188,6 +188,34 @@ namespace sc
     ImGui::Separator();
     ImGui::Text("Resolution: %ux%u", m_extent.width, m_extent.height);
     ImGui::Text("FrameIndex: %u  ImageIndex: %u", m_frameIndex, m_imageIndex);
+    ImGui::Text("Draws: raw %u  instanced batches %u  largest %u",
+                m_batchStats.rawDraws, m_batchStats.batches, m_batchStats.largestBatch);
+    if (m_batchStats.instanceUploads > 1 || m_batchStats.droppedBatches > 0)
+      ImGui::Text("Instance upload split into %u piece(s), %u batch(es) dropped",
+                  m_batchStats.instanceUploads, m_batchStats.droppedBatches);
+    ImGui::Text("Draw record: %u range(s)%s", m_recordStats.ranges,
+                m_recordStats.parallel ? "  (secondary, jobs)" : "");
+    ImGui::Text("Upload ring: %llu / %llu KB  peak %llu KB  allocs %u",
+                (unsigned long long)(m_uploadRingStats.frameBytes / 1024ull),
+                (unsigned long long)(m_uploadRingStats.capacity / 1024ull),
+                (unsigned long long)(m_uploadRingStats.peakFrameBytes / 1024ull),
+                m_uploadRingStats.frameAllocations);
+    if (m_uploadRingStats.totalOverflows > 0)
+      ImGui::Text("Upload ring overflows: %u this frame, %llu total",
+                  m_uploadRingStats.frameOverflows,
+                  (unsigned long long)m_uploadRingStats.totalOverflows);
+    ImGui::Text("Mesh arena: vtx %llu / %llu KB  idx %llu / %llu KB  meshes %u",
+                (unsigned long long)(m_meshVertexArenaStats.usedBytes / 1024ull),
+                (unsigned long long)(m_meshVertexArenaStats.capacity / 1024ull),
+                (unsigned long long)(m_meshIndexArenaStats.usedBytes / 1024ull),
+                (unsigned long long)(m_meshIndexArenaStats.capacity / 1024ull),
+                m_meshVertexArenaStats.allocations);
+    if (m_meshVertexArenaStats.failedAllocations > 0 || m_meshIndexArenaStats.failedAllocations > 0)
+      ImGui::Text("Mesh arena failures: vtx %u  idx %u  (largest free %llu / %llu KB)",
+                  m_meshVertexArenaStats.failedAllocations,
+                  m_meshIndexArenaStats.failedAllocations,
+                  (unsigned long long)(m_meshVertexArenaStats.largestFreeRange / 1024ull),
+                  (unsigned long long)(m_meshIndexArenaStats.largestFreeRange / 1024ull));
     ImGui::Checkbox("Pause Meshes", &m_pauseTriangle);
     ImGui::PlotLines("Frame Time (ms)", m_frameTimes, (int)m_frameCount, (int)m_frameOffset, nullptr, 0.0f, 50.0f, ImVec2(0, 60));
     ImGui::Separator();
@@ -421,10 +449,12 @@ namespace sc
 
       if (m_culling)
       {
-        ImGui::Text("Renderables: total %u  visible %u  culled %u",
+        ImGui::Text("Renderables: total %u  visible %u  culled %u  (too small %u)",
                     m_culling->stats.renderablesTotal,
                     m_culling->stats.visible,
-                    m_culling->stats.culled);
+                    m_culling->stats.culled,
+                    m_culling->stats.contributionCulled);
+        ImGui::SliderFloat("Min projected radius (px)", &m_culling->minProjectedRadiusPixels, 0.0f, 8.0f, "%.1f");
       }
 
       if (m_renderPrepStreaming)
@@ -432,6 +462,18 @@ namespace sc
         ImGui::Text("Draws: emitted %u  dropped by budget %u",
                     m_renderPrepStreaming->stats.drawsEmitted,
                     m_renderPrepStreaming->stats.drawsDroppedByBudget);
+        if (m_renderPrepStreaming->stats.minKeptScreenSize > 0.0f)
+          ImGui::Text("Kept screen size >= %.4f",
+                      m_renderPrepStreaming->stats.minKeptScreenSize);
+        ImGui::Text("Draw sort: %.3f ms  passes %u  blocks %u",
+                    m_renderPrepStreaming->stats.sortMs,
+                    m_renderPrepStreaming->stats.sortPasses,
+                    m_renderPrepStreaming->stats.sortBlocks);
+        const uint32_t* lods = m_renderPrepStreaming->stats.lodHistogram;
+        ImGui::Text("LOD draws: %u / %u / %u / %u  switches %u",
+                    lods[0], lods[1], lods[2], lods[3],
+                    m_renderPrepStreaming->stats.lodSwitches);
+        ImGui::SliderFloat("LOD hysteresis", &m_renderPrepStreaming->lodHysteresis, 0.0f, 0.5f, "%.2f");
       }
 
       const bool sectorBudgetExceeded = ws.rejectedBySectorBudget > 0;
@@ -467,8 +509,9 @@ namespace sc
       const PhysicsStats& ps = m_physics->stats;
       ImGui::Text("Bodies: dynamic %u  kinematic %u  static %u",
                   ps.dynamicBodies, ps.kinematicBodies, ps.staticColliders);
-      ImGui::Text("Broadphase proxies: %u", ps.broadphaseProxies);
-      ImGui::Text("Step: %.3f ms", ps.stepMs);
+      ImGui::Text("Broadphase proxies: %u  cached shapes: %u", ps.broadphaseProxies, ps.cachedShapes);
+      ImGui::Text("Step: %.3f ms (%u threads)", ps.stepMs, ps.threads);
+      ImGui::Text("LOD: frozen %u  freezes %u  thaws %u", ps.frozenBodies, ps.lodFreezes, ps.lodThaws);
 
       if (m_physics->lastRayHit.hit)
       {
@@ -686,10 +729,23 @@ namespace sc
     ImGui::Text("CPU bytes: %llu  GPU bytes(est): %llu",
                 static_cast<unsigned long long>(m_assetStats.cpuBytes),
                 static_cast<unsigned long long>(m_assetStats.gpuBytes));
-    ImGui::Text("Resident textures: %u  Queued loads: %u  Evictions: %u",
+    ImGui::Text("Resident textures: %u (BCn: %u)  Queued loads: %u  Evictions: %u",
                 m_assetStats.residentTextures,
+                m_assetStats.compressedTextures,
                 m_assetStats.queuedTextureLoads,
                 m_assetStats.evictions);
+    ImGui::Text("Decoding: %u  Awaiting upload: %u  Decoded: %u  Latency avg/max: %.2f / %.2f ms",
+                m_assetStats.texturesDecoding,
+                m_assetStats.texturesAwaitingUpload,
+                m_assetStats.texturesDecodedThisFrame,
+                m_assetStats.decodeLatencyAvgMs,
+                m_assetStats.decodeLatencyMaxMs);
+    ImGui::Text("Uploads pending: %u  Staging: %.1f / %.1f MB  Full: %llu  Queue: %s",
+                m_assetStats.pendingTextureUploads,
+                static_cast<double>(m_assetStats.stagingInFlight) / (1024.0 * 1024.0),
+                static_cast<double>(m_assetStats.stagingCapacity) / (1024.0 * 1024.0),
+                static_cast<unsigned long long>(m_assetStats.stagingFull),
+                m_assetStats.dedicatedTransferQueue ? "transfer" : "graphics");
     ImGui::Text("GPU budget: %llu  Used: %llu  Eviction: %.2f ms",
                 static_cast<unsigned long long>(m_assetStats.gpuBudgetBytes),
                 static_cast<unsigned long long>(m_assetStats.gpuResidentBytes),
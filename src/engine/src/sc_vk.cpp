@@ -2,6 +2,8 @@
 #include "sc_log.h"
 #include "sc_paths.h"
 #include "sc_physics.h"
+#include "sc_vfs.h"
+#include "mesh_importer.h"
 
 #include <SDL.h>
 #include <SDL_vulkan.h>
@@ -12,7 +14,6 @@
 #include <vector>
 #include <cstring>
 #include <algorithm>
-#include <fstream>
 #include <filesystem>
 
 namespace sc
@@ -36,7 +37,9 @@ namespace sc
                            VkBufferUsageFlags usage,
                            VkMemoryPropertyFlags properties,
                            VkBuffer& buffer,
-                           VkDeviceMemory& memory);
+                           VkDeviceMemory& memory,
+                           const uint32_t* families = nullptr,
+                           uint32_t familyCount = 0);
   static bool createImage(VkDevice device,
                           VkPhysicalDevice phys,
                           uint32_t width,
@@ -106,9 +109,10 @@ namespace sc
       if (!m_debugUI.init(m_window, m_instance, m_device, m_phys, m_gfxFamily, m_gfxQueue, m_renderPass, (uint32_t)m_swapchainImages.size())) return false;
     }
     if (!createPipeline()) return false;
-    if (!createMeshes()) return false;
+    // Meshes upload through the asset manager's staging ring, so it comes first.
     if (!createDefaultAssets()) return false;
-    if (!createDebugDrawBuffers(65536)) return false;
+    if (!createMeshes()) return false;
+    if (!createUploadRing(m_cfg.uploadRingBytes)) return false;
     if (!createFramebuffers()) return false;
     if (!createSync()) return false;
 
@@ -127,11 +131,12 @@ namespace sc
       if (m_imageAvailable[i]) vkDestroySemaphore(m_device, m_imageAvailable[i], nullptr);
     }
 
+    destroyRecordPools();
     if (m_cmdPool) vkDestroyCommandPool(m_device, m_cmdPool, nullptr);
 
     destroySwapchainObjects();
     destroyPipeline();
-    destroyDebugDrawBuffers();
+    destroyUploadRing();
     m_assets.shutdown();
     destroyMeshes();
     shutdownExternalImGui();
@@ -295,9 +300,26 @@ namespace sc
         m_phys = d;
         m_gfxFamily = i;
 
+        // A transfer-only family maps to the copy engines on discrete GPUs.
+        m_transferFamily = UINT32_MAX;
+        if (m_cfg.useTransferQueue)
+        {
+          for (uint32_t t = 0; t < qCount; ++t)
+          {
+            const VkQueueFlags flags = qs[t].queueFlags;
+            if ((flags & VK_QUEUE_TRANSFER_BIT) && !(flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)))
+            {
+              m_transferFamily = t;
+              break;
+            }
+          }
+        }
+
         VkPhysicalDeviceProperties p{};
         vkGetPhysicalDeviceProperties(d, &p);
         sc::log(sc::LogLevel::Info, "GPU: %s", p.deviceName);
+        if (m_transferFamily != UINT32_MAX)
+          sc::log(sc::LogLevel::Info, "Dedicated transfer queue family: %u", m_transferFamily);
         return true;
       }
     }
@@ -312,23 +334,46 @@ namespace sc
     vkGetPhysicalDeviceFeatures(m_phys, &supported);
 
     float prio = 1.0f;
-    VkDeviceQueueCreateInfo qci{ VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO };
-    qci.queueFamilyIndex = m_gfxFamily;
-    qci.queueCount = 1;
-    qci.pQueuePriorities = &prio;
+    VkDeviceQueueCreateInfo qci[2]{};
+    qci[0].sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+    qci[0].queueFamilyIndex = m_gfxFamily;
+    qci[0].queueCount = 1;
+    qci[0].pQueuePriorities = &prio;
+    uint32_t queueInfoCount = 1;
+    if (m_transferFamily != UINT32_MAX)
+    {
+      qci[1] = qci[0];
+      qci[1].queueFamilyIndex = m_transferFamily;
+      queueInfoCount = 2;
+    }
 
     const char* exts[] = { VK_KHR_SWAPCHAIN_EXTENSION_NAME };
 
     VkDeviceCreateInfo dci{ VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO };
-    dci.queueCreateInfoCount = 1;
-    dci.pQueueCreateInfos = &qci;
+    dci.queueCreateInfoCount = queueInfoCount;
+    dci.pQueueCreateInfos = qci;
     dci.enabledExtensionCount = 1;
     dci.ppEnabledExtensionNames = exts;
 
     VkPhysicalDeviceFeatures enabled{};
     enabled.samplerAnisotropy = supported.samplerAnisotropy ? VK_TRUE : VK_FALSE;
+    enabled.textureCompressionBC = supported.textureCompressionBC ? VK_TRUE : VK_FALSE;
     dci.pEnabledFeatures = &enabled;
 
+    // Timeline semaphores let frames wait on asset uploads on the GPU instead of host fences.
+    VkPhysicalDeviceProperties props{};
+    vkGetPhysicalDeviceProperties(m_phys, &props);
+    VkPhysicalDeviceVulkan12Features supported12{ VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES };
+    VkPhysicalDeviceVulkan12Features enabled12{ VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES };
+    if (props.apiVersion >= VK_API_VERSION_1_2)
+    {
+      VkPhysicalDeviceFeatures2 features2{ VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2 };
+      features2.pNext = &supported12;
+      vkGetPhysicalDeviceFeatures2(m_phys, &features2);
+      enabled12.timelineSemaphore = supported12.timelineSemaphore;
+      dci.pNext = &enabled12;
+    }
+
     VkResult r = vkCreateDevice(m_phys, &dci, nullptr, &m_device);
     if (r != VK_SUCCESS)
     {
@@ -337,10 +382,12 @@ namespace sc
     }
 
     vkGetDeviceQueue(m_device, m_gfxFamily, 0, &m_gfxQueue);
+    if (m_transferFamily != UINT32_MAX)
+      vkGetDeviceQueue(m_device, m_transferFamily, 0, &m_transferQueue);
 
     m_samplerAnisotropyEnabled = supported.samplerAnisotropy == VK_TRUE;
-    VkPhysicalDeviceProperties props{};
-    vkGetPhysicalDeviceProperties(m_phys, &props);
+    m_textureCompressionBC = supported.textureCompressionBC == VK_TRUE;
+    m_timelineSemaphore = enabled12.timelineSemaphore == VK_TRUE;
     m_samplerMaxAnisotropy = m_samplerAnisotropyEnabled ? props.limits.maxSamplerAnisotropy : 1.0f;
 
     return true;
@@ -551,20 +598,14 @@ namespace sc
 
   std::vector<uint8_t> VkRenderer::readFile(const char* path)
   {
-    const std::filesystem::path resolved = sc::resolveAssetPath(path);
-    std::ifstream file(resolved, std::ios::ate | std::ios::binary);
-    if (!file.is_open())
+    sc::AssetBlob blob{};
+    if (!sc::vfs().read(path, blob))
     {
-      sc::log(sc::LogLevel::Error, "Shader file not found: %s (%s)", path, resolved.string().c_str());
+      sc::log(sc::LogLevel::Error, "Shader file not found: %s (%s)", path, sc::resolveAssetPath(path).string().c_str());
       return {};
     }
 
-    const size_t size = (size_t)file.tellg();
-    std::vector<uint8_t> buffer(size);
-    file.seekg(0);
-    file.read(reinterpret_cast<char*>(buffer.data()), size);
-    file.close();
-    return buffer;
+    return std::vector<uint8_t>(blob.data(), blob.data() + blob.size());
   }
 
   VkShaderModule VkRenderer::createShaderModule(const std::vector<uint8_t>& code)
@@ -736,12 +777,17 @@ namespace sc
                            VkBufferUsageFlags usage,
                            VkMemoryPropertyFlags properties,
                            VkBuffer& buffer,
-                           VkDeviceMemory& memory)
+                           VkDeviceMemory& memory,
+                           const uint32_t* families,
+                           uint32_t familyCount)
   {
     VkBufferCreateInfo bci{ VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
     bci.size = size;
     bci.usage = usage;
-    bci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    // Shared between queue families without ownership transfers when more than one is given.
+    bci.sharingMode = (familyCount > 1) ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE;
+    bci.queueFamilyIndexCount = (familyCount > 1) ? familyCount : 0u;
+    bci.pQueueFamilyIndices = (familyCount > 1) ? families : nullptr;
 
     if (vkCreateBuffer(device, &bci, nullptr, &buffer) != VK_SUCCESS)
       return false;
@@ -890,33 +936,42 @@ namespace sc
     const char* unlitFsPath = "shaders/mesh.frag.spv";
     const char* texVsPath = "shaders/mesh_tex.vert.spv";
     const char* texFsPath = "shaders/mesh_tex.frag.spv";
+    const char* debugVsPath = "shaders/debug_line.vert.spv";
 
     auto unlitVsCode = readFile(unlitVsPath);
     auto unlitFsCode = readFile(unlitFsPath);
     auto texVsCode = readFile(texVsPath);
     auto texFsCode = readFile(texFsPath);
-    if (unlitVsCode.empty() || unlitFsCode.empty() || texVsCode.empty() || texFsCode.empty())
+    auto debugVsCode = readFile(debugVsPath);
+    if (unlitVsCode.empty() || unlitFsCode.empty() || texVsCode.empty() || texFsCode.empty() || debugVsCode.empty())
       return false;
 
     VkShaderModule unlitVs = createShaderModule(unlitVsCode);
     VkShaderModule unlitFs = createShaderModule(unlitFsCode);
     VkShaderModule texVs = createShaderModule(texVsCode);
     VkShaderModule texFs = createShaderModule(texFsCode);
-    if (unlitVs == VK_NULL_HANDLE || unlitFs == VK_NULL_HANDLE || texVs == VK_NULL_HANDLE || texFs == VK_NULL_HANDLE)
+    VkShaderModule debugVs = createShaderModule(debugVsCode);
+    if (unlitVs == VK_NULL_HANDLE || unlitFs == VK_NULL_HANDLE || texVs == VK_NULL_HANDLE || texFs == VK_NULL_HANDLE ||
+        debugVs == VK_NULL_HANDLE)
     {
       if (unlitVs) vkDestroyShaderModule(m_device, unlitVs, nullptr);
       if (unlitFs) vkDestroyShaderModule(m_device, unlitFs, nullptr);
       if (texVs) vkDestroyShaderModule(m_device, texVs, nullptr);
       if (texFs) vkDestroyShaderModule(m_device, texFs, nullptr);
+      if (debugVs) vkDestroyShaderModule(m_device, debugVs, nullptr);
       return false;
     }
 
-    VkVertexInputBindingDescription binding{};
-    binding.binding = 0;
-    binding.stride = sizeof(MeshVertex);
-    binding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+    // Binding 0: mesh vertices. Binding 1: per-instance model matrices.
+    VkVertexInputBindingDescription bindings[2]{};
+    bindings[0].binding = 0;
+    bindings[0].stride = sizeof(MeshVertex);
+    bindings[0].inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+    bindings[1].binding = 1;
+    bindings[1].stride = sizeof(Mat4);
+    bindings[1].inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
 
-    VkVertexInputAttributeDescription unlitAttrs[2]{};
+    VkVertexInputAttributeDescription unlitAttrs[6]{};
     unlitAttrs[0].binding = 0;
     unlitAttrs[0].location = 0;
     unlitAttrs[0].format = VK_FORMAT_R32G32B32_SFLOAT;
@@ -927,24 +982,32 @@ namespace sc
     unlitAttrs[1].format = VK_FORMAT_R32G32B32_SFLOAT;
     unlitAttrs[1].offset = sizeof(float) * 3;
 
+    for (uint32_t col = 0; col < 4; ++col)
+    {
+      unlitAttrs[2 + col].binding = 1;
+      unlitAttrs[2 + col].location = 3 + col;
+      unlitAttrs[2 + col].format = VK_FORMAT_R32G32B32A32_SFLOAT;
+      unlitAttrs[2 + col].offset = sizeof(float) * 4 * col;
+    }
+
     VkPipelineVertexInputStateCreateInfo unlitVi{ VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO };
-    unlitVi.vertexBindingDescriptionCount = 1;
-    unlitVi.pVertexBindingDescriptions = &binding;
-    unlitVi.vertexAttributeDescriptionCount = 2;
+    unlitVi.vertexBindingDescriptionCount = 2;
+    unlitVi.pVertexBindingDescriptions = bindings;
+    unlitVi.vertexAttributeDescriptionCount = 6;
     unlitVi.pVertexAttributeDescriptions = unlitAttrs;
 
-    VkVertexInputAttributeDescription texAttrs[3]{};
-    texAttrs[0] = unlitAttrs[0];
-    texAttrs[1] = unlitAttrs[1];
-    texAttrs[2].binding = 0;
-    texAttrs[2].location = 2;
-    texAttrs[2].format = VK_FORMAT_R32G32_SFLOAT;
-    texAttrs[2].offset = sizeof(float) * 6;
+    VkVertexInputAttributeDescription texAttrs[7]{};
+    for (uint32_t i = 0; i < 6; ++i)
+      texAttrs[i] = unlitAttrs[i];
+    texAttrs[6].binding = 0;
+    texAttrs[6].location = 2;
+    texAttrs[6].format = VK_FORMAT_R32G32_SFLOAT;
+    texAttrs[6].offset = sizeof(float) * 6;
 
     VkPipelineVertexInputStateCreateInfo texVi{ VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO };
-    texVi.vertexBindingDescriptionCount = 1;
-    texVi.pVertexBindingDescriptions = &binding;
-    texVi.vertexAttributeDescriptionCount = 3;
+    texVi.vertexBindingDescriptionCount = 2;
+    texVi.pVertexBindingDescriptions = bindings;
+    texVi.vertexAttributeDescriptionCount = 7;
     texVi.pVertexAttributeDescriptions = texAttrs;
 
     VkPipelineInputAssemblyStateCreateInfo ia{ VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO };
@@ -1008,6 +1071,7 @@ namespace sc
       vkDestroyShaderModule(m_device, unlitFs, nullptr);
       vkDestroyShaderModule(m_device, texVs, nullptr);
       vkDestroyShaderModule(m_device, texFs, nullptr);
+      vkDestroyShaderModule(m_device, debugVs, nullptr);
       return false;
     }
 
@@ -1044,6 +1108,7 @@ namespace sc
       vkDestroyShaderModule(m_device, unlitFs, nullptr);
       vkDestroyShaderModule(m_device, texVs, nullptr);
       vkDestroyShaderModule(m_device, texFs, nullptr);
+      vkDestroyShaderModule(m_device, debugVs, nullptr);
       return false;
     }
 
@@ -1067,6 +1132,7 @@ namespace sc
       vkDestroyShaderModule(m_device, unlitFs, nullptr);
       vkDestroyShaderModule(m_device, texVs, nullptr);
       vkDestroyShaderModule(m_device, texFs, nullptr);
+      vkDestroyShaderModule(m_device, debugVs, nullptr);
       return false;
     }
 
@@ -1096,7 +1162,12 @@ namespace sc
     dbgVi.vertexAttributeDescriptionCount = 2;
     dbgVi.pVertexAttributeDescriptions = dbgAttrs;
 
-    gpci.pStages = unlitStages;
+    VkPipelineShaderStageCreateInfo debugStages[2]{};
+    debugStages[0] = unlitStages[0];
+    debugStages[0].module = debugVs;
+    debugStages[1] = unlitStages[1];
+
+    gpci.pStages = debugStages;
     gpci.pInputAssemblyState = &iaLine;
     gpci.pDepthStencilState = &dsLine;
     gpci.pVertexInputState = &dbgVi;
@@ -1106,6 +1177,7 @@ namespace sc
     vkDestroyShaderModule(m_device, unlitFs, nullptr);
     vkDestroyShaderModule(m_device, texVs, nullptr);
     vkDestroyShaderModule(m_device, texFs, nullptr);
+    vkDestroyShaderModule(m_device, debugVs, nullptr);
 
     if (pr != VK_SUCCESS)
     {
@@ -1175,9 +1247,68 @@ namespace sc
       sc::log(sc::LogLevel::Error, "vkAllocateCommandBuffers failed (%d)", (int)r);
       return false;
     }
+    return createRecordPools();
+  }
+
+  bool VkRenderer::createRecordPools()
+  {
+    VkCommandPoolCreateInfo pci{ VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
+    pci.queueFamilyIndex = m_gfxFamily;
+    pci.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+
+    VkCommandBufferAllocateInfo ai{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+    ai.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+    ai.commandBufferCount = 1;
+
+    for (uint32_t f = 0; f < MAX_FRAMES; ++f)
+    {
+      for (uint32_t r = 0; r < kMaxDrawRecordRanges; ++r)
+      {
+        VkResult res = vkCreateCommandPool(m_device, &pci, nullptr, &m_recordPools[f][r]);
+        if (res != VK_SUCCESS)
+        {
+          sc::log(sc::LogLevel::Error, "vkCreateCommandPool (record) failed (%d)", (int)res);
+          return false;
+        }
+
+        ai.commandPool = m_recordPools[f][r];
+        res = vkAllocateCommandBuffers(m_device, &ai, &m_recordCmds[f][r]);
+        if (res != VK_SUCCESS)
+        {
+          sc::log(sc::LogLevel::Error, "vkAllocateCommandBuffers (record) failed (%d)", (int)res);
+          return false;
+        }
+      }
+    }
+
+    // Overlay (debug lines + ImGui) stays on the render thread, so it can use the main pool.
+    ai.commandPool = m_cmdPool;
+    ai.commandBufferCount = MAX_FRAMES;
+    VkResult res = vkAllocateCommandBuffers(m_device, &ai, m_overlayCmds);
+    if (res != VK_SUCCESS)
+    {
+      sc::log(sc::LogLevel::Error, "vkAllocateCommandBuffers (overlay) failed (%d)", (int)res);
+      return false;
+    }
     return true;
   }
 
+  void VkRenderer::destroyRecordPools()
+  {
+    for (uint32_t f = 0; f < MAX_FRAMES; ++f)
+    {
+      for (uint32_t r = 0; r < kMaxDrawRecordRanges; ++r)
+      {
+        if (m_recordPools[f][r])
+          vkDestroyCommandPool(m_device, m_recordPools[f][r], nullptr);
+        m_recordPools[f][r] = VK_NULL_HANDLE;
+        m_recordCmds[f][r] = VK_NULL_HANDLE;
+      }
+      // Freed together with m_cmdPool.
+      m_overlayCmds[f] = VK_NULL_HANDLE;
+    }
+  }
+
   bool VkRenderer::createSync()
   {
     VkSemaphoreCreateInfo sci{ VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO };
@@ -1195,6 +1326,9 @@ namespace sc
 
   bool VkRenderer::createMeshes()
   {
+    if (!createMeshArena())
+      return false;
+
     m_meshes.clear();
     m_meshes.resize(2);
     m_meshBounds.clear();
@@ -1284,55 +1418,11 @@ namespace sc
       return b;
     };
 
-    auto createGpuMesh = [&](const MeshVertex* verts,
-                             uint32_t vertCount,
-                             const uint32_t* indices,
-                             uint32_t indexCount,
-                             GpuMesh& mesh) -> bool
-    {
-      if (!verts || vertCount == 0 || !indices || indexCount == 0)
-        return false;
-      const VkDeviceSize vsize = sizeof(MeshVertex) * vertCount;
-      if (!createBuffer(m_device, m_phys, vsize,
-                        VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-                        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                        mesh.vertexBuffer, mesh.vertexMemory))
-      {
-        sc::log(sc::LogLevel::Error, "createBuffer (mesh vertex) failed.");
-        return false;
-      }
-
-      void* vdst = nullptr;
-      if (vkMapMemory(m_device, mesh.vertexMemory, 0, vsize, 0, &vdst) != VK_SUCCESS)
-        return false;
-      std::memcpy(vdst, verts, static_cast<size_t>(vsize));
-      vkUnmapMemory(m_device, mesh.vertexMemory);
-
-      const VkDeviceSize isize = sizeof(uint32_t) * indexCount;
-      if (!createBuffer(m_device, m_phys, isize,
-                        VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
-                        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                        mesh.indexBuffer, mesh.indexMemory))
-      {
-        sc::log(sc::LogLevel::Error, "createBuffer (mesh index) failed.");
-        return false;
-      }
-
-      void* idst = nullptr;
-      if (vkMapMemory(m_device, mesh.indexMemory, 0, isize, 0, &idst) != VK_SUCCESS)
-        return false;
-      std::memcpy(idst, indices, static_cast<size_t>(isize));
-      vkUnmapMemory(m_device, mesh.indexMemory);
-
-      mesh.indexCount = indexCount;
-      return true;
-    };
-
     for (size_t i = 0; i < m_meshes.size(); ++i)
     {
       const MeshSource& src = sources[i];
       GpuMesh& mesh = m_meshes[i];
-      if (!createGpuMesh(src.verts, src.vertCount, src.indices, src.indexCount, mesh))
+      if (!allocateGpuMesh(src.verts, src.vertCount, src.indices, src.indexCount, mesh))
         return false;
       m_meshBounds[i] = computeBounds(src.verts, src.vertCount);
     }
@@ -1341,17 +1431,48 @@ namespace sc
     return true;
   }
 
+  static MeshHandle uploadCookedMeshLod(const sc_import::MeshData& mesh, void* user)
+  {
+    VkRenderer* renderer = static_cast<VkRenderer*>(user);
+    std::vector<MeshVertex> verts(mesh.vertices.size());
+    for (size_t i = 0; i < mesh.vertices.size(); ++i)
+    {
+      const sc_import::MeshVertex& src = mesh.vertices[i];
+      MeshVertex& dst = verts[i];
+      dst.pos[0] = src.pos[0];
+      dst.pos[1] = src.pos[1];
+      dst.pos[2] = src.pos[2];
+      dst.color[0] = 1.0f;
+      dst.color[1] = 1.0f;
+      dst.color[2] = 1.0f;
+      dst.uv[0] = src.uv0[0];
+      dst.uv[1] = src.uv0[1];
+    }
+    return renderer->createMesh(verts.data(),
+                                static_cast<uint32_t>(verts.size()),
+                                mesh.indices.data(),
+                                static_cast<uint32_t>(mesh.indices.size()),
+                                mesh.bounds.min,
+                                mesh.bounds.max);
+  }
+
   bool VkRenderer::createDefaultAssets()
   {
     AssetManagerInit ai{};
     ai.device = m_device;
     ai.physicalDevice = m_phys;
     ai.graphicsQueue = m_gfxQueue;
+    ai.graphicsFamily = m_gfxFamily;
+    ai.transferQueue = m_transferQueue;
+    ai.transferFamily = (m_transferFamily != UINT32_MAX) ? m_transferFamily : m_gfxFamily;
     ai.commandPool = m_cmdPool;
     ai.materialDescriptorPool = m_globalDescriptorPool;
     ai.materialSetLayout = m_materialSetLayout;
     ai.samplerAnisotropyEnabled = m_samplerAnisotropyEnabled;
     ai.samplerMaxAnisotropy = m_samplerMaxAnisotropy;
+    ai.textureCompressionBC = m_textureCompressionBC;
+    ai.timelineSemaphore = m_timelineSemaphore;
+    ai.stagingBytes = m_cfg.textureStagingBytes;
 
     if (!m_assets.init(ai))
       return false;
@@ -1360,6 +1481,7 @@ namespace sc
     m_assets.registerMeshAlias("builtin/cube", 1);
     m_assets.registerMeshAlias("meshes/triangle", 0);
     m_assets.registerMeshAlias("meshes/cube", 1);
+    m_assets.setMeshUploader(&uploadCookedMeshLod, this);
 
     const TextureHandle checkerTex = m_assets.loadTexture2D("textures/checker.ppm");
     const TextureHandle testTex = m_assets.loadTexture2D("textures/test.ppm");
@@ -1411,60 +1533,232 @@ namespace sc
 
   void VkRenderer::destroyMeshes()
   {
-    for (GpuMesh& mesh : m_meshes)
-    {
-      if (mesh.vertexBuffer) vkDestroyBuffer(m_device, mesh.vertexBuffer, nullptr);
-      if (mesh.vertexMemory) vkFreeMemory(m_device, mesh.vertexMemory, nullptr);
-      if (mesh.indexBuffer) vkDestroyBuffer(m_device, mesh.indexBuffer, nullptr);
-      if (mesh.indexMemory) vkFreeMemory(m_device, mesh.indexMemory, nullptr);
-      mesh = GpuMesh{};
-    }
     m_meshes.clear();
     m_meshBounds.clear();
+    destroyMeshArena();
   }
 
-  MeshHandle VkRenderer::createMesh(const MeshVertex* verts,
-                                    uint32_t vertCount,
-                                    const uint32_t* indices,
-                                    uint32_t indexCount,
-                                    const float boundsMin[3],
-                                    const float boundsMax[3])
+  bool VkRenderer::createMeshArena()
   {
-    if (!verts || !indices || vertCount == 0 || indexCount == 0)
-      return kInvalidMeshHandle;
+    destroyMeshArena();
+    return addMeshArenaBlock(m_cfg.meshVertexArenaBytes, m_cfg.meshIndexArenaBytes);
+  }
 
-    GpuMesh mesh{};
-    const VkDeviceSize vsize = sizeof(MeshVertex) * vertCount;
-    if (!createBuffer(m_device, m_phys, vsize,
-                      VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-                      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                      mesh.vertexBuffer, mesh.vertexMemory))
+  bool VkRenderer::addMeshArenaBlock(uint64_t vertexBytes, uint64_t indexBytes)
+  {
+    // Copies run on the upload queue and draws on graphics; share instead of transferring ownership.
+    const uint32_t families[2] = { m_gfxFamily, m_assets.uploadQueueFamily() };
+    const uint32_t familyCount = (families[0] != families[1]) ? 2u : 1u;
+
+    MeshArenaBlock block{};
+    bool ok = createBuffer(m_device, m_phys, vertexBytes,
+                           VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                           VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                           block.vertexBuffer, block.vertexMemory, families, familyCount);
+    if (!ok)
+      sc::log(sc::LogLevel::Error, "createBuffer (mesh vertex arena) failed.");
+
+    if (ok)
+    {
+      ok = createBuffer(m_device, m_phys, indexBytes,
+                        VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                        block.indexBuffer, block.indexMemory, families, familyCount);
+      if (!ok)
+        sc::log(sc::LogLevel::Error, "createBuffer (mesh index arena) failed.");
+    }
+
+    if (!ok)
+    {
+      if (block.vertexBuffer) vkDestroyBuffer(m_device, block.vertexBuffer, nullptr);
+      if (block.vertexMemory) vkFreeMemory(m_device, block.vertexMemory, nullptr);
+      if (block.indexBuffer) vkDestroyBuffer(m_device, block.indexBuffer, nullptr);
+      if (block.indexMemory) vkFreeMemory(m_device, block.indexMemory, nullptr);
+      return false;
+    }
+
+    block.vertexRanges.init(vertexBytes);
+    block.indexRanges.init(indexBytes);
+    m_meshArenaBlocks.push_back(std::move(block));
+    if (m_meshArenaBlocks.size() > 1)
     {
-      return kInvalidMeshHandle;
+      sc::log(sc::LogLevel::Info, "Mesh arena block %zu added (%llu KB vertices, %llu KB indices).",
+              m_meshArenaBlocks.size() - 1,
+              static_cast<unsigned long long>(vertexBytes / 1024ull),
+              static_cast<unsigned long long>(indexBytes / 1024ull));
     }
+    return true;
+  }
 
-    void* vdst = nullptr;
-    if (vkMapMemory(m_device, mesh.vertexMemory, 0, vsize, 0, &vdst) != VK_SUCCESS)
-      return kInvalidMeshHandle;
-    std::memcpy(vdst, verts, static_cast<size_t>(vsize));
-    vkUnmapMemory(m_device, mesh.vertexMemory);
+  void VkRenderer::destroyMeshArena()
+  {
+    for (MeshArenaBlock& block : m_meshArenaBlocks)
+    {
+      if (block.vertexBuffer) vkDestroyBuffer(m_device, block.vertexBuffer, nullptr);
+      if (block.vertexMemory) vkFreeMemory(m_device, block.vertexMemory, nullptr);
+      if (block.indexBuffer) vkDestroyBuffer(m_device, block.indexBuffer, nullptr);
+      if (block.indexMemory) vkFreeMemory(m_device, block.indexMemory, nullptr);
+    }
+    m_meshArenaBlocks.clear();
+    m_pendingMeshReleases.clear();
+  }
+
+  RangeAllocatorStats VkRenderer::meshVertexArenaStats() const
+  {
+    RangeAllocatorStats total{};
+    for (const MeshArenaBlock& block : m_meshArenaBlocks)
+    {
+      const RangeAllocatorStats s = block.vertexRanges.stats();
+      total.capacity += s.capacity;
+      total.usedBytes += s.usedBytes;
+      total.largestFreeRange = std::max(total.largestFreeRange, s.largestFreeRange);
+      total.allocations += s.allocations;
+      total.freeRanges += s.freeRanges;
+      total.failedAllocations += s.failedAllocations;
+    }
+    return total;
+  }
+
+  RangeAllocatorStats VkRenderer::meshIndexArenaStats() const
+  {
+    RangeAllocatorStats total{};
+    for (const MeshArenaBlock& block : m_meshArenaBlocks)
+    {
+      const RangeAllocatorStats s = block.indexRanges.stats();
+      total.capacity += s.capacity;
+      total.usedBytes += s.usedBytes;
+      total.largestFreeRange = std::max(total.largestFreeRange, s.largestFreeRange);
+      total.allocations += s.allocations;
+      total.freeRanges += s.freeRanges;
+      total.failedAllocations += s.failedAllocations;
+    }
+    return total;
+  }
 
+  bool VkRenderer::allocateGpuMesh(const MeshVertex* verts,
+                                   uint32_t vertCount,
+                                   const uint32_t* indices,
+                                   uint32_t indexCount,
+                                   GpuMesh& out)
+  {
+    if (!verts || vertCount == 0 || !indices || indexCount == 0)
+      return false;
+
+    const VkDeviceSize vsize = sizeof(MeshVertex) * vertCount;
     const VkDeviceSize isize = sizeof(uint32_t) * indexCount;
-    if (!createBuffer(m_device, m_phys, isize,
-                      VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
-                      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                      mesh.indexBuffer, mesh.indexMemory))
+
+    // Both ranges come from the same block so one bind covers the draw. Blocks
+    // whose largest hole is too small are skipped without counting a failure.
+    uint32_t blockIndex = UINT32_MAX;
+    uint64_t vOffset = RangeAllocator::kInvalidOffset;
+    uint64_t iOffset = RangeAllocator::kInvalidOffset;
+    for (uint32_t b = 0; b < m_meshArenaBlocks.size() && blockIndex == UINT32_MAX; ++b)
+    {
+      MeshArenaBlock& block = m_meshArenaBlocks[b];
+      if (block.vertexRanges.largestFreeRange() < vsize ||
+          block.indexRanges.largestFreeRange() < isize)
+        continue;
+
+      // Stride-aligned vertex ranges let vertexOffset address them directly.
+      vOffset = block.vertexRanges.allocate(vsize, sizeof(MeshVertex));
+      if (vOffset == RangeAllocator::kInvalidOffset)
+        continue;
+      iOffset = block.indexRanges.allocate(isize, sizeof(uint32_t));
+      if (iOffset == RangeAllocator::kInvalidOffset)
+      {
+        block.vertexRanges.free(vOffset);
+        continue;
+      }
+      blockIndex = b;
+    }
+
+    if (blockIndex == UINT32_MAX)
     {
-      return kInvalidMeshHandle;
+      // Chain a new block rather than moving live meshes; oversized meshes get a block of their own size.
+      const uint64_t vertexBytes = std::max<uint64_t>(m_cfg.meshVertexArenaBytes, vsize);
+      const uint64_t indexBytes = std::max<uint64_t>(m_cfg.meshIndexArenaBytes, isize);
+      if (!addMeshArenaBlock(vertexBytes, indexBytes))
+      {
+        sc::log(sc::LogLevel::Error, "Mesh arena full (%u verts, %u indices requested).", vertCount, indexCount);
+        return false;
+      }
+      blockIndex = static_cast<uint32_t>(m_meshArenaBlocks.size() - 1);
+      MeshArenaBlock& block = m_meshArenaBlocks[blockIndex];
+      vOffset = block.vertexRanges.allocate(vsize, sizeof(MeshVertex));
+      iOffset = block.indexRanges.allocate(isize, sizeof(uint32_t));
+    }
+
+    MeshArenaBlock& block = m_meshArenaBlocks[blockIndex];
+    // Copies are batched on the upload queue; the mesh is drawn once its ticket completes.
+    const uint64_t vertexTicket = m_assets.uploadBufferData(block.vertexBuffer, vOffset, verts, vsize);
+    const uint64_t indexTicket = vertexTicket ? m_assets.uploadBufferData(block.indexBuffer, iOffset, indices, isize) : 0;
+    if (!vertexTicket || !indexTicket)
+    {
+      sc::log(sc::LogLevel::Error, "Mesh upload failed (%u verts).", vertCount);
+      block.vertexRanges.free(vOffset);
+      block.indexRanges.free(iOffset);
+      return false;
     }
 
-    void* idst = nullptr;
-    if (vkMapMemory(m_device, mesh.indexMemory, 0, isize, 0, &idst) != VK_SUCCESS)
+    out.vertexOffset = static_cast<int32_t>(vOffset / sizeof(MeshVertex));
+    out.vertexCount = vertCount;
+    out.firstIndex = static_cast<uint32_t>(iOffset / sizeof(uint32_t));
+    out.indexCount = indexCount;
+    out.arenaBlock = blockIndex;
+    out.uploadTicket = indexTicket;
+    return true;
+  }
+
+  void VkRenderer::releaseGpuMesh(GpuMesh& mesh)
+  {
+    if (mesh.indexCount == 0)
+      return;
+
+    // Frames in flight may still read these ranges and the copy may still be
+    // writing them; free them once both are done.
+    PendingMeshRelease release{};
+    release.arenaBlock = mesh.arenaBlock;
+    release.vertexByteOffset = static_cast<uint64_t>(mesh.vertexOffset) * sizeof(MeshVertex);
+    release.indexByteOffset = static_cast<uint64_t>(mesh.firstIndex) * sizeof(uint32_t);
+    release.retireFrame = m_frameSerial + MAX_FRAMES;
+    release.uploadTicket = mesh.uploadTicket;
+    m_pendingMeshReleases.push_back(release);
+    mesh = GpuMesh{};
+  }
+
+  void VkRenderer::processMeshReleases()
+  {
+    size_t keep = 0;
+    for (size_t i = 0; i < m_pendingMeshReleases.size(); ++i)
+    {
+      const PendingMeshRelease& release = m_pendingMeshReleases[i];
+      if (release.retireFrame <= m_frameSerial && release.uploadTicket <= m_uploadsCompleted)
+      {
+        MeshArenaBlock& block = m_meshArenaBlocks[release.arenaBlock];
+        block.vertexRanges.free(release.vertexByteOffset);
+        block.indexRanges.free(release.indexByteOffset);
+      }
+      else
+      {
+        m_pendingMeshReleases[keep++] = release;
+      }
+    }
+    m_pendingMeshReleases.resize(keep);
+  }
+
+  MeshHandle VkRenderer::createMesh(const MeshVertex* verts,
+                                    uint32_t vertCount,
+                                    const uint32_t* indices,
+                                    uint32_t indexCount,
+                                    const float boundsMin[3],
+                                    const float boundsMax[3])
+  {
+    if (!verts || !indices || vertCount == 0 || indexCount == 0)
       return kInvalidMeshHandle;
-    std::memcpy(idst, indices, static_cast<size_t>(isize));
-    vkUnmapMemory(m_device, mesh.indexMemory);
 
-    mesh.indexCount = indexCount;
+    GpuMesh mesh{};
+    if (!allocateGpuMesh(verts, vertCount, indices, indexCount, mesh))
+      return kInvalidMeshHandle;
 
     const MeshHandle handle = static_cast<MeshHandle>(m_meshes.size());
     m_meshes.push_back(mesh);
@@ -1488,12 +1782,7 @@ namespace sc
   {
     if (handle >= m_meshes.size())
       return;
-    GpuMesh& mesh = m_meshes[handle];
-    if (mesh.vertexBuffer) vkDestroyBuffer(m_device, mesh.vertexBuffer, nullptr);
-    if (mesh.vertexMemory) vkFreeMemory(m_device, mesh.vertexMemory, nullptr);
-    if (mesh.indexBuffer) vkDestroyBuffer(m_device, mesh.indexBuffer, nullptr);
-    if (mesh.indexMemory) vkFreeMemory(m_device, mesh.indexMemory, nullptr);
-    mesh = GpuMesh{};
+    releaseGpuMesh(m_meshes[handle]);
     if (handle < m_meshBounds.size())
       m_meshBounds[handle] = MeshBounds{};
   }
@@ -1512,48 +1801,61 @@ namespace sc
     return true;
   }
 
-  bool VkRenderer::createDebugDrawBuffers(size_t vertexCapacity)
+  bool VkRenderer::createUploadRing(uint64_t bytes)
   {
-    destroyDebugDrawBuffers();
+    destroyUploadRing();
 
-    m_debugVertexCapacity = vertexCapacity;
-    if (m_debugVertexCapacity == 0)
-      return true;
-
-    const VkDeviceSize size = sizeof(DebugVertex) * m_debugVertexCapacity;
-    for (uint32_t i = 0; i < MAX_FRAMES; ++i)
+    if (!createBuffer(m_device, m_phys, bytes,
+                      VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT |
+                      VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                      m_uploadBuffer, m_uploadMemory))
     {
-      if (!createBuffer(m_device, m_phys, size,
-                        VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-                        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                        m_debugVertexBuffers[i], m_debugVertexMemory[i]))
-      {
-        sc::log(sc::LogLevel::Error, "createBuffer (debug draw) failed.");
-        return false;
-      }
+      sc::log(sc::LogLevel::Error, "createBuffer (upload ring) failed.");
+      return false;
+    }
 
-      if (vkMapMemory(m_device, m_debugVertexMemory[i], 0, size, 0, &m_debugVertexMapped[i]) != VK_SUCCESS)
-      {
-        sc::log(sc::LogLevel::Error, "vkMapMemory (debug draw) failed.");
-        return false;
-      }
+    void* mapped = nullptr;
+    if (vkMapMemory(m_device, m_uploadMemory, 0, bytes, 0, &mapped) != VK_SUCCESS)
+    {
+      sc::log(sc::LogLevel::Error, "vkMapMemory (upload ring) failed.");
+      return false;
     }
+    m_uploadMapped = static_cast<uint8_t*>(mapped);
+
+    if (!m_uploadRing.init(bytes, MAX_FRAMES))
+      return false;
+
+    sc::log(sc::LogLevel::Info, "Upload ring: %llu KB", (unsigned long long)(bytes / 1024ull));
     return true;
   }
 
-  void VkRenderer::destroyDebugDrawBuffers()
+  void VkRenderer::destroyUploadRing()
   {
-    for (uint32_t i = 0; i < MAX_FRAMES; ++i)
+    if (m_uploadMapped)
     {
-      if (m_debugVertexMapped[i])
-      {
-        vkUnmapMemory(m_device, m_debugVertexMemory[i]);
-        m_debugVertexMapped[i] = nullptr;
-      }
-      if (m_debugVertexBuffers[i]) { vkDestroyBuffer(m_device, m_debugVertexBuffers[i], nullptr); m_debugVertexBuffers[i] = VK_NULL_HANDLE; }
-      if (m_debugVertexMemory[i]) { vkFreeMemory(m_device, m_debugVertexMemory[i], nullptr); m_debugVertexMemory[i] = VK_NULL_HANDLE; }
+      vkUnmapMemory(m_device, m_uploadMemory);
+      m_uploadMapped = nullptr;
     }
-    m_debugVertexCapacity = 0;
+    if (m_uploadBuffer) { vkDestroyBuffer(m_device, m_uploadBuffer, nullptr); m_uploadBuffer = VK_NULL_HANDLE; }
+    if (m_uploadMemory) { vkFreeMemory(m_device, m_uploadMemory, nullptr); m_uploadMemory = VK_NULL_HANDLE; }
+    m_uploadRing.shutdown();
+  }
+
+  UploadAllocation VkRenderer::allocateUpload(VkDeviceSize size, VkDeviceSize align)
+  {
+    UploadAllocation out{};
+    if (!m_uploadMapped)
+      return out;
+
+    const uint64_t offset = m_uploadRing.allocate(size, align);
+    if (offset == FrameRing::kInvalidOffset)
+      return out;
+
+    out.ptr = m_uploadMapped + offset;
+    out.buffer = m_uploadBuffer;
+    out.offset = offset;
+    return out;
   }
 
   void VkRenderer::onSDLEvent(const SDL_Event& e)
@@ -1661,6 +1963,7 @@ namespace sc
 
     if (m_swapchain) { vkDestroySwapchainKHR(m_device, m_swapchain, nullptr); m_swapchain = VK_NULL_HANDLE; }
 
+    destroyRecordPools();
     if (m_cmdPool) { vkDestroyCommandPool(m_device, m_cmdPool, nullptr); m_cmdPool = VK_NULL_HANDLE; }
 
     if (!createSwapchain()) return false;
@@ -1732,6 +2035,11 @@ namespace sc
     // 1) Espera el frame-in-flight actual
     vkWaitForFences(m_device, 1, &m_inFlight[m_frameIndex], VK_TRUE, UINT64_MAX);
     vkResetFences(m_device, 1, &m_inFlight[m_frameIndex]);
+    m_uploadRing.beginFrame(m_frameIndex);
+    m_frameSerial++;
+    m_assets.pumpUploads();
+    m_uploadsCompleted = m_assets.completedUploadTicket();
+    processMeshReleases();
 
     // 2) Acquire
     VkResult r = vkAcquireNextImageKHR(
@@ -1764,33 +2072,16 @@ namespace sc
     m_debugUI.setFrameStats(m_frameIndex, m_imageIndex, m_swapchainExtent);
     m_debugUI.setTelemetry(m_jobsSnap, m_memSnap);
     m_debugUI.setEcsStats(m_ecsSnap, m_schedSnap);
+    m_debugUI.setDrawBatchStats(m_batchStats);
+    m_debugUI.setDrawRecordStats(m_recordStats);
+    m_debugUI.setUploadRingStats(m_uploadRing.stats());
+    m_debugUI.setMeshArenaStats(meshVertexArenaStats(), meshIndexArenaStats());
     m_sceneTextureSelection = m_debugUI.assetPanelSelection();
     if (m_sceneTextureSelection >= m_textureOptionMaterials.size())
       m_sceneTextureSelection = 0;
     buildAssetUiSnapshot();
     m_debugUI.newFrame();
 
-    VkCommandBufferBeginInfo bi{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
-    vkBeginCommandBuffer(cmd, &bi);
-
-    VkClearValue clear[2]{};
-    clear[0].color.float32[0] = 0.02f;
-    clear[0].color.float32[1] = 0.02f;
-    clear[0].color.float32[2] = 0.05f;
-    clear[0].color.float32[3] = 1.0f;
-    clear[1].depthStencil.depth = 1.0f;
-    clear[1].depthStencil.stencil = 0;
-
-    VkRenderPassBeginInfo rpbi{ VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO };
-    rpbi.renderPass = m_renderPass;
-    rpbi.framebuffer = m_framebuffers[m_imageIndex];
-    rpbi.renderArea.offset = { 0, 0 };
-    rpbi.renderArea.extent = m_swapchainExtent;
-    rpbi.clearValueCount = 2;
-    rpbi.pClearValues = clear;
-
-    vkCmdBeginRenderPass(cmd, &rpbi, VK_SUBPASS_CONTENTS_INLINE);
-
     VkRect2D sceneRect{};
     if (m_hasSceneViewport)
     {
@@ -1817,19 +2108,15 @@ namespace sc
       sceneRect.extent = m_swapchainExtent;
     }
 
-    VkViewport viewport{};
-    viewport.x = static_cast<float>(sceneRect.offset.x);
-    viewport.y = static_cast<float>(sceneRect.offset.y);
-    viewport.width = static_cast<float>(sceneRect.extent.width);
-    viewport.height = static_cast<float>(sceneRect.extent.height);
-    viewport.minDepth = 0.0f;
-    viewport.maxDepth = 1.0f;
-    vkCmdSetViewport(cmd, 0, 1, &viewport);
-
-    VkRect2D scissor{};
-    scissor.offset = sceneRect.offset;
-    scissor.extent = sceneRect.extent;
-    vkCmdSetScissor(cmd, 0, 1, &scissor);
+    BatchRecordState recordState{};
+    recordState.viewport.x = static_cast<float>(sceneRect.offset.x);
+    recordState.viewport.y = static_cast<float>(sceneRect.offset.y);
+    recordState.viewport.width = static_cast<float>(sceneRect.extent.width);
+    recordState.viewport.height = static_cast<float>(sceneRect.extent.height);
+    recordState.viewport.minDepth = 0.0f;
+    recordState.viewport.maxDepth = 1.0f;
+    recordState.scissor.offset = sceneRect.offset;
+    recordState.scissor.extent = sceneRect.extent;
 
     if (m_renderFrame && m_cameraMapped[m_frameIndex])
     {
@@ -1838,96 +2125,295 @@ namespace sc
       std::memcpy(m_cameraMapped[m_frameIndex], &ubo, sizeof(ubo));
     }
 
+    m_drawRanges.clear();
     if (!m_debugUI.isTrianglePaused() && m_renderFrame && !m_renderFrame->draws.empty())
     {
-      std::vector<const DrawItem*> sorted;
-      sorted.reserve(m_renderFrame->draws.size());
-      for (const auto& draw : m_renderFrame->draws)
+      // RenderPrep hands over draws already ordered by sortKey; other producers
+      // (the C render API) get keyed and radix-sorted here.
+      const std::vector<DrawItem>& draws = m_renderFrame->draws;
+      const bool presorted = m_renderFrame->sorted;
+      if (!presorted)
       {
-        if (draw.meshId >= m_meshes.size())
-          continue;
-        if (!m_assets.getMaterial(draw.materialId))
-          continue;
-        sorted.push_back(&draw);
+        m_drawSortItems.resize(draws.size());
+        for (uint32_t i = 0; i < static_cast<uint32_t>(draws.size()); ++i)
+        {
+          const DrawItem& draw = draws[i];
+          const Material* material = m_assets.getMaterial(draw.materialId);
+          const uint32_t pipeline = material ? static_cast<uint32_t>(material->pipelineId) : kFallbackDrawPipeline;
+          const bool transparent = material && material->desc.transparent;
+          const float depth = transparent ? drawViewDepth(m_renderFrame->viewProj, draw.model) : 0.0f;
+          m_drawSortItems[i].key = makeDrawSortKey(pipeline, draw.materialId, draw.meshId, transparent, depth);
+          m_drawSortItems[i].index = i;
+        }
+        radixSort(m_drawSortItems, m_drawSortScratch);
       }
 
-      std::sort(sorted.begin(), sorted.end(),
-                [&](const DrawItem* a, const DrawItem* b)
+      m_batchBuilder.build(draws, presorted ? nullptr : m_drawSortItems.data());
+      m_batchStats = m_batchBuilder.stats();
+      if (!m_batchBuilder.instances().empty())
       {
-        const Material* ma = m_assets.getMaterial(a->materialId);
-        const Material* mb = m_assets.getMaterial(b->materialId);
-        const uint32_t pa = ma ? static_cast<uint32_t>(ma->pipelineId) : 0u;
-        const uint32_t pb = mb ? static_cast<uint32_t>(mb->pipelineId) : 0u;
-        if (pa != pb) return pa < pb;
-        if (a->materialId != b->materialId) return a->materialId < b->materialId;
-        return a->meshId < b->meshId;
-      });
-
-      const GpuMesh* boundMesh = nullptr;
-      VkPipeline boundPipeline = VK_NULL_HANDLE;
-      MaterialHandle boundMaterial = kInvalidMaterialHandle;
-
-      for (const DrawItem* draw : sorted)
+        partitionDrawRanges(static_cast<uint32_t>(m_batchBuilder.batches().size()),
+                            m_cfg.maxRecordRanges, m_cfg.minBatchesPerRecordRange, m_drawRanges);
+        uploadDrawInstances();
+      }
+      m_batchStats.batches = 0;
+    }
+    else
+    {
+      m_batchStats = DrawBatchStats{};
+    }
+
+    // A single range is cheaper inline; several go to secondaries on the job system.
+    const bool useSecondaries = m_drawRanges.size() > 1;
+
+    VkCommandBufferBeginInfo bi{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+    vkBeginCommandBuffer(cmd, &bi);
+    m_assets.recordTextureAcquires(cmd);
+
+    VkClearValue clear[2]{};
+    clear[0].color.float32[0] = 0.02f;
+    clear[0].color.float32[1] = 0.02f;
+    clear[0].color.float32[2] = 0.05f;
+    clear[0].color.float32[3] = 1.0f;
+    clear[1].depthStencil.depth = 1.0f;
+    clear[1].depthStencil.stencil = 0;
+
+    VkRenderPassBeginInfo rpbi{ VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO };
+    rpbi.renderPass = m_renderPass;
+    rpbi.framebuffer = m_framebuffers[m_imageIndex];
+    rpbi.renderArea.offset = { 0, 0 };
+    rpbi.renderArea.extent = m_swapchainExtent;
+    rpbi.clearValueCount = 2;
+    rpbi.pClearValues = clear;
+
+    vkCmdBeginRenderPass(cmd, &rpbi,
+                         useSecondaries ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS : VK_SUBPASS_CONTENTS_INLINE);
+
+    if (useSecondaries)
+    {
+      SecondaryRangeRecorder recorder{};
+      recorder.renderer = this;
+      recorder.state = &recordState;
+      m_recordStats = recordDrawRanges(m_drawRanges, recorder, m_rangeIssued);
+      m_batchStats.batches = m_recordStats.issued;
+
+      VkCommandBufferInheritanceInfo inherit{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO };
+      inherit.renderPass = m_renderPass;
+      inherit.subpass = 0;
+      inherit.framebuffer = m_framebuffers[m_imageIndex];
+
+      VkCommandBufferBeginInfo obi{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+      obi.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+      obi.pInheritanceInfo = &inherit;
+
+      VkCommandBuffer overlay = m_overlayCmds[m_frameIndex];
+      vkResetCommandBuffer(overlay, 0);
+      vkBeginCommandBuffer(overlay, &obi);
+      vkCmdSetViewport(overlay, 0, 1, &recordState.viewport);
+      vkCmdSetScissor(overlay, 0, 1, &recordState.scissor);
+      recordOverlay(overlay);
+      vkEndCommandBuffer(overlay);
+
+      // Replay in range order so the sorted draw order survives the split.
+      m_executeCmds.clear();
+      for (uint32_t r = 0; r < static_cast<uint32_t>(m_drawRanges.size()); ++r)
       {
-        const Material* material = m_assets.getMaterial(draw->materialId);
-        if (!material)
-          continue;
+        if (m_recordCmdValid[r])
+          m_executeCmds.push_back(m_recordCmds[m_frameIndex][r]);
+      }
+      m_executeCmds.push_back(overlay);
+      vkCmdExecuteCommands(cmd, static_cast<uint32_t>(m_executeCmds.size()), m_executeCmds.data());
+    }
+    else
+    {
+      vkCmdSetViewport(cmd, 0, 1, &recordState.viewport);
+      vkCmdSetScissor(cmd, 0, 1, &recordState.scissor);
 
-        VkPipeline targetPipeline = (material->pipelineId == PipelineId::UnlitColor) ? m_unlitPipeline : m_texturedPipeline;
-        if (!targetPipeline)
-          continue;
+      m_recordStats = DrawRecordStats{};
+      if (!m_drawRanges.empty())
+      {
+        m_batchStats.batches = recordBatchRange(cmd, 0);
+        m_recordStats.ranges = 1;
+        m_recordStats.batches = m_drawRanges[0].batchCount;
+        m_recordStats.issued = m_batchStats.batches;
+      }
+      recordOverlay(cmd);
+    }
 
-        if (boundPipeline != targetPipeline)
-        {
-          vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, targetPipeline);
-          vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipelineLayout, 0, 1,
-                                  &m_globalSets[m_frameIndex], 0, nullptr);
-          boundPipeline = targetPipeline;
-          boundMesh = nullptr;
-          boundMaterial = kInvalidMaterialHandle;
-        }
+    vkCmdEndRenderPass(cmd);
 
-        if (boundMaterial != draw->materialId)
-        {
-          vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipelineLayout, 1, 1,
-                                  &material->descriptorSet, 0, nullptr);
-          boundMaterial = draw->materialId;
-        }
+    vkEndCommandBuffer(cmd);
+    return true;
+  }
 
-        const GpuMesh& mesh = m_meshes[draw->meshId];
-        if (mesh.indexCount == 0)
-          continue;
+  uint32_t VkRenderer::SecondaryRangeRecorder::recordRange(uint32_t rangeIndex, const DrawRange&)
+  {
+    VkRenderer& r = *renderer;
+    r.m_recordCmdValid[rangeIndex] = false;
 
-        if (&mesh != boundMesh)
-        {
-          VkDeviceSize offset = 0;
-          vkCmdBindVertexBuffers(cmd, 0, 1, &mesh.vertexBuffer, &offset);
-          vkCmdBindIndexBuffer(cmd, mesh.indexBuffer, 0, VK_INDEX_TYPE_UINT32);
-          boundMesh = &mesh;
-        }
+    VkCommandPool pool = r.m_recordPools[r.m_frameIndex][rangeIndex];
+    VkCommandBuffer cmd = r.m_recordCmds[r.m_frameIndex][rangeIndex];
+    if (!pool || !cmd)
+      return 0;
+    vkResetCommandPool(r.m_device, pool, 0);
+
+    VkCommandBufferInheritanceInfo inherit{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO };
+    inherit.renderPass = r.m_renderPass;
+    inherit.subpass = 0;
+    inherit.framebuffer = r.m_framebuffers[r.m_imageIndex];
+
+    VkCommandBufferBeginInfo bi{ VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+    bi.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+    bi.pInheritanceInfo = &inherit;
+    if (vkBeginCommandBuffer(cmd, &bi) != VK_SUCCESS)
+      return 0;
+
+    // Secondaries inherit no dynamic state from the primary.
+    vkCmdSetViewport(cmd, 0, 1, &state->viewport);
+    vkCmdSetScissor(cmd, 0, 1, &state->scissor);
+    const uint32_t issued = r.recordBatchRange(cmd, rangeIndex);
+
+    if (vkEndCommandBuffer(cmd) != VK_SUCCESS)
+      return 0;
+    r.m_recordCmdValid[rangeIndex] = true;
+    return issued;
+  }
+
+  void VkRenderer::uploadDrawInstances()
+  {
+    const std::vector<Mat4>& instances = m_batchBuilder.instances();
+    const std::vector<DrawBatch>& batches = m_batchBuilder.batches();
+    m_rangeInstances.assign(m_drawRanges.size(), UploadAllocation{});
+
+    const UploadAllocation whole = allocateUpload(sizeof(Mat4) * instances.size(), alignof(Mat4));
+    if (whole.ptr)
+    {
+      std::memcpy(whole.ptr, instances.data(), sizeof(Mat4) * instances.size());
+      for (size_t r = 0; r < m_drawRanges.size(); ++r)
+      {
+        const VkDeviceSize skip = sizeof(Mat4) * batches[m_drawRanges[r].firstBatch].firstInstance;
+        m_rangeInstances[r] = whole;
+        m_rangeInstances[r].ptr += skip;
+        m_rangeInstances[r].offset += skip;
+      }
+      m_batchStats.instanceUploads = 1;
+      m_instanceUploadSplit = false;
+      return;
+    }
+
+    // The ring cannot take the frame in one piece. Split it into as many ranges
+    // as the recorder allows, so the pieces can use the space on both sides of
+    // the wrap point; only ranges whose own piece does not fit are skipped.
+    partitionDrawRanges(static_cast<uint32_t>(batches.size()), m_cfg.maxRecordRanges, 1, m_drawRanges);
+    m_rangeInstances.assign(m_drawRanges.size(), UploadAllocation{});
+    for (size_t r = 0; r < m_drawRanges.size(); ++r)
+    {
+      const DrawRange& range = m_drawRanges[r];
+      const DrawBatch& last = batches[range.firstBatch + range.batchCount - 1];
+      const uint32_t first = batches[range.firstBatch].firstInstance;
+      const size_t bytes = sizeof(Mat4) * (last.firstInstance + last.instanceCount - first);
+      const UploadAllocation piece = allocateUpload(bytes, alignof(Mat4));
+      if (!piece.ptr)
+      {
+        m_batchStats.droppedBatches += range.batchCount;
+        continue;
+      }
+      std::memcpy(piece.ptr, instances.data() + first, bytes);
+      m_rangeInstances[r] = piece;
+      m_batchStats.instanceUploads++;
+    }
+
+    if (!m_instanceUploadSplit)
+    {
+      sc::log(m_batchStats.droppedBatches > 0 ? sc::LogLevel::Error : sc::LogLevel::Warn,
+              "Instance data (%llu KB) did not fit the upload ring in one piece; split into %u, dropped %u of %u batches",
+              (unsigned long long)(sizeof(Mat4) * instances.size() / 1024ull),
+              m_batchStats.instanceUploads, m_batchStats.droppedBatches, (uint32_t)batches.size());
+    }
+    m_instanceUploadSplit = true;
+  }
 
-        vkCmdPushConstants(cmd, m_pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(Mat4), &draw->model);
-        vkCmdDrawIndexed(cmd, mesh.indexCount, 1, 0, 0, 0);
+  uint32_t VkRenderer::recordBatchRange(VkCommandBuffer cmd, uint32_t rangeIndex) const
+  {
+    const DrawRange& range = m_drawRanges[rangeIndex];
+    const UploadAllocation& instances = m_rangeInstances[rangeIndex];
+    if (!instances.ptr)
+      return 0;
+    vkCmdBindVertexBuffers(cmd, 1, 1, &instances.buffer, &instances.offset);
+    const uint32_t instanceBase = m_batchBuilder.batches()[range.firstBatch].firstInstance;
+
+    // Geometry is rebound only when consecutive batches live in different arena blocks.
+    uint32_t boundBlock = UINT32_MAX;
+
+    const std::vector<DrawBatch>& batches = m_batchBuilder.batches();
+    VkPipeline boundPipeline = VK_NULL_HANDLE;
+    MaterialHandle boundMaterial = kInvalidMaterialHandle;
+    uint32_t issued = 0;
+
+    const uint32_t end = range.firstBatch + range.batchCount;
+    for (uint32_t i = range.firstBatch; i < end; ++i)
+    {
+      const DrawBatch& batch = batches[i];
+      if (batch.meshId >= m_meshes.size())
+        continue;
+
+      const Material* material = m_assets.getMaterial(batch.materialId);
+      if (!material)
+        continue;
+
+      VkPipeline targetPipeline = (material->pipelineId == PipelineId::UnlitColor) ? m_unlitPipeline : m_texturedPipeline;
+      if (!targetPipeline)
+        continue;
+
+      if (boundPipeline != targetPipeline)
+      {
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, targetPipeline);
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipelineLayout, 0, 1,
+                                &m_globalSets[m_frameIndex], 0, nullptr);
+        boundPipeline = targetPipeline;
+        boundMaterial = kInvalidMaterialHandle;
       }
+
+      if (boundMaterial != batch.materialId)
+      {
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipelineLayout, 1, 1,
+                                &material->descriptorSet, 0, nullptr);
+        boundMaterial = batch.materialId;
+      }
+
+      const GpuMesh& mesh = m_meshes[batch.meshId];
+      if (mesh.indexCount == 0 || mesh.uploadTicket > m_uploadsCompleted)
+        continue;
+
+      if (boundBlock != mesh.arenaBlock)
+      {
+        const MeshArenaBlock& block = m_meshArenaBlocks[mesh.arenaBlock];
+        const VkDeviceSize arenaOffset = 0;
+        vkCmdBindVertexBuffers(cmd, 0, 1, &block.vertexBuffer, &arenaOffset);
+        vkCmdBindIndexBuffer(cmd, block.indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+        boundBlock = mesh.arenaBlock;
+      }
+
+      vkCmdDrawIndexed(cmd, mesh.indexCount, batch.instanceCount, mesh.firstIndex, mesh.vertexOffset,
+                       batch.firstInstance - instanceBase);
+      issued++;
     }
+    return issued;
+  }
 
+  void VkRenderer::recordOverlay(VkCommandBuffer cmd)
+  {
     if (m_debugDraw && m_debugPipeline)
     {
       const auto& verts = m_debugDraw->vertices();
       const uint32_t vtxCount = (uint32_t)verts.size();
       if (vtxCount > 0)
       {
-        if (vtxCount > m_debugVertexCapacity)
+        const size_t copyBytes = sizeof(DebugVertex) * vtxCount;
+        const UploadAllocation vtxAlloc = allocateUpload(copyBytes, alignof(DebugVertex));
+        if (vtxAlloc.ptr)
         {
-          const size_t newCap = (size_t)vtxCount * 2;
-          destroyDebugDrawBuffers();
-          if (!createDebugDrawBuffers(newCap))
-            sc::log(sc::LogLevel::Warn, "Debug draw buffer resize failed (capacity=%zu).", newCap);
-        }
-        if (m_debugVertexMapped[m_frameIndex])
-        {
-          const size_t copyBytes = sizeof(DebugVertex) * vtxCount;
-          std::memcpy(m_debugVertexMapped[m_frameIndex], verts.data(), copyBytes);
+          std::memcpy(vtxAlloc.ptr, verts.data(), copyBytes);
 
           vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, m_debugPipeline);
           vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipelineLayout, 0, 1,
@@ -1935,8 +2421,7 @@ namespace sc
           const Mat4 identity = Mat4::identity();
           vkCmdPushConstants(cmd, m_pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(Mat4), &identity);
 
-          VkDeviceSize offset = 0;
-          vkCmdBindVertexBuffers(cmd, 0, 1, &m_debugVertexBuffers[m_frameIndex], &offset);
+          vkCmdBindVertexBuffers(cmd, 0, 1, &vtxAlloc.buffer, &vtxAlloc.offset);
           vkCmdDraw(cmd, vtxCount, 1, 0, 0);
         }
       }
@@ -1950,24 +2435,36 @@ namespace sc
     }
 
     m_debugUI.draw(cmd);
-
-    vkCmdEndRenderPass(cmd);
-
-    vkEndCommandBuffer(cmd);
-    return true;
   }
 
 
   void VkRenderer::endFrame()
   {
-    VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-
     VkCommandBuffer cmd = m_cmdBuffers[m_imageIndex];
 
+    // Uploads completed by beginFrame are what this frame draws and acquires; the
+    // timeline wait makes their writes visible to the graphics queue.
+    const VkSemaphore uploadTimeline = m_assets.uploadTimelineSemaphore();
+    const VkSemaphore waitSemaphores[2] = { m_imageAvailable[m_frameIndex], uploadTimeline };
+    const VkPipelineStageFlags waitStages[2] =
+    {
+      VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+      VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT
+    };
+    const uint64_t waitValues[2] = { 0, m_uploadsCompleted };
+    const bool waitUploads = uploadTimeline && m_uploadsCompleted > 0;
+
     VkSubmitInfo si{ VK_STRUCTURE_TYPE_SUBMIT_INFO };
-    si.waitSemaphoreCount = 1;
-    si.pWaitSemaphores = &m_imageAvailable[m_frameIndex];
-    si.pWaitDstStageMask = &waitStage;
+    VkTimelineSemaphoreSubmitInfo tsi{ VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO };
+    if (waitUploads)
+    {
+      tsi.waitSemaphoreValueCount = 2;
+      tsi.pWaitSemaphoreValues = waitValues;
+      si.pNext = &tsi;
+    }
+    si.waitSemaphoreCount = waitUploads ? 2u : 1u;
+    si.pWaitSemaphores = waitSemaphores;
+    si.pWaitDstStageMask = waitStages;
     si.commandBufferCount = 1;
     si.pCommandBuffers = &cmd;
     si.signalSemaphoreCount = 1;
@@ -102,6 +102,50 @@ namespace sc
       return active;
     }
 
+    static bool agentSectorActive(World& world, WorldStreamingState* streaming, Entity e)
+    {
+      if (!streaming)
+        return true;
+      WorldSector* ws = world.get<WorldSector>(e);
+      if (!ws)
+        return true;
+      Sector* sector = streaming->partition.findSector(ws->coord);
+      return sector && sector->state == SectorLoadState::Active;
+    }
+
+    // Steering direction toward the agent's look-ahead point. False when the agent
+    // has no active lane or target, in which case the AI leaves it alone.
+    static bool agentTargetDir(const TrafficLaneGraph& lanes, const TrafficAgent& agent, const Transform& tr,
+                               float outTarget[3], float outDir[3])
+    {
+      const LaneSegment* seg = lanes.getLane(agent.laneId);
+      if (!seg || !seg->active)
+        return false;
+
+      if (!lanes.getLookAheadPoint(agent.laneId, agent.laneS, agent.lookAheadDist, outTarget))
+        return false;
+
+      outDir[0] = outTarget[0] - tr.localPos[0];
+      outDir[1] = 0.0f;
+      outDir[2] = outTarget[2] - tr.localPos[2];
+      if (length3(outDir) < 1e-4f)
+        return false;
+      normalize3(outDir);
+      return true;
+    }
+
+    static void assignNearestLane(const TrafficLaneGraph& lanes, TrafficAgent& agent, const Transform& tr)
+    {
+      if (agent.laneId != kInvalidLaneId)
+        return;
+      LaneQuery q = lanes.queryNearestLane(tr.localPos);
+      if (q.laneId != kInvalidLaneId)
+      {
+        agent.laneId = q.laneId;
+        agent.laneS = q.s;
+      }
+    }
+
     static void updateSectorForEntity(World& world,
                                       WorldStreamingState* streaming,
                                       Entity e,
@@ -159,6 +203,29 @@ namespace sc
     }
   }
 
+  bool buildTrafficSensorRay(const TrafficLaneGraph& lanes, TrafficAgent& agent, const Transform& tr,
+                              float rayLength, RayQuery& outRay)
+  {
+    assignNearestLane(lanes, agent, tr);
+    float target[3]{};
+    float toTarget[3]{};
+    if (!agentTargetDir(lanes, agent, tr, target, toTarget))
+      return false;
+
+    const float yaw = tr.localRot[1];
+    outRay = RayQuery{};
+    outRay.dir[0] = std::sin(yaw);
+    outRay.dir[1] = 0.0f;
+    outRay.dir[2] = std::cos(yaw);
+    normalize3(outRay.dir);
+    outRay.origin[0] = tr.localPos[0] + outRay.dir[0] * 1.7f;
+    outRay.origin[1] = tr.localPos[1] + 0.6f;
+    outRay.origin[2] = tr.localPos[2] + outRay.dir[2] * 1.7f;
+    outRay.maxDist = rayLength;
+    outRay.mask = 1u;
+    return true;
+  }
+
   void TrafficAISystem(World& world, float dt, void* user)
   {
     TrafficAIState* state = static_cast<TrafficAIState*>(user);
@@ -216,31 +283,49 @@ namespace sc
       dbg->nearestTrafficDesyncLogged = 0;
     }
 
-    float nearestDistSq = 1.0e30f;
-
-    world.ForEach<TrafficAgent, TrafficVehicle, Transform>([&](Entity e, TrafficAgent& agent, TrafficVehicle& tv, Transform& tr)
+    // Gather the front ray of every agent that will steer this step so they are
+    // cast as one batch. Agents the loop below drops (no lane or target) are
+    // skipped here too. Physics does not move during this system, so the hits
+    // match casting each ray in the agent loop.
+    state->sensorEntities.clear();
+    state->sensorRays.clear();
+    world.ForEach<TrafficAgent, TrafficVehicle, Transform>([&](Entity e, TrafficAgent& agent, TrafficVehicle&, Transform& tr)
     {
-      if (state->streaming)
-      {
-        if (WorldSector* ws = world.get<WorldSector>(e))
-        {
-          Sector* sector = state->streaming->partition.findSector(ws->coord);
-          if (!sector || sector->state != SectorLoadState::Active)
-            return;
-        }
-      }
+      if (!agentSectorActive(world, state->streaming, e))
+        return;
 
       if (dbg)
         agent.lookAheadDist = dbg->lookAheadDist;
-
-      if (TrafficSensors* sensors = world.get<TrafficSensors>(e))
+      TrafficSensors* sensors = world.get<TrafficSensors>(e);
+      if (sensors && dbg)
       {
-        if (dbg)
-        {
-          sensors->frontRayLength = dbg->frontRayLength;
-          sensors->safeDistance = dbg->safeDistance;
-        }
+        sensors->frontRayLength = dbg->frontRayLength;
+        sensors->safeDistance = dbg->safeDistance;
       }
+      if (!state->physics)
+        return;
+
+      RayQuery q{};
+      if (!buildTrafficSensorRay(lanes, agent, tr, sensors ? sensors->frontRayLength : 20.0f, q))
+        return;
+      state->sensorEntities.push_back(e);
+      state->sensorRays.push_back(q);
+    });
+    state->sensorHits.resize(state->sensorRays.size());
+    if (state->physics)
+      state->physics->raycastBatch(state->sensorRays, state->sensorHits);
+    size_t nextSensor = 0;
+
+    float nearestDistSq = 1.0e30f;
+
+    world.ForEach<TrafficAgent, TrafficVehicle, Transform>([&](Entity e, TrafficAgent& agent, TrafficVehicle& tv, Transform& tr)
+    {
+      if (!agentSectorActive(world, state->streaming, e))
+        return;
+
+      size_t sensorIndex = SIZE_MAX;
+      if (nextSensor < state->sensorEntities.size() && state->sensorEntities[nextSensor] == e)
+        sensorIndex = nextSensor++;
 
       if (tv.mode == TrafficSimMode::Physics)
       {
@@ -261,29 +346,12 @@ namespace sc
         tv.body = {};
       }
 
-      if (agent.laneId == kInvalidLaneId)
-      {
-        LaneQuery q = lanes.queryNearestLane(tr.localPos);
-        if (q.laneId != kInvalidLaneId)
-        {
-          agent.laneId = q.laneId;
-          agent.laneS = q.s;
-        }
-      }
-
-      const LaneSegment* seg = lanes.getLane(agent.laneId);
-      if (!seg || !seg->active)
-        return;
-
+      assignNearestLane(lanes, agent, tr);
       float target[3]{};
-      if (!lanes.getLookAheadPoint(agent.laneId, agent.laneS, agent.lookAheadDist, target))
+      float toTarget[3]{};
+      if (!agentTargetDir(lanes, agent, tr, target, toTarget))
         return;
 
-      float toTarget[3] = { target[0] - tr.localPos[0], 0.0f, target[2] - tr.localPos[2] };
-      if (length3(toTarget) < 1e-4f)
-        return;
-      normalize3(toTarget);
-
       const float desiredYaw = yawFromDir(toTarget);
       const float currentYaw = tr.localRot[1];
       const float deltaYaw = wrapAngle(desiredYaw - currentYaw);
@@ -316,7 +384,8 @@ namespace sc
 
         TrafficHitType hitType = TrafficHitType::None;
         float hitDistance = rayLen;
-        RaycastHit hit = state->physics->raycast(origin, forward, rayLen, 1u);
+        const RaycastHit hit = (sensorIndex != SIZE_MAX) ? state->sensorHits[sensorIndex]
+                                                          : state->physics->raycast(origin, forward, rayLen, 1u);
         if (hit.hit)
         {
           hitDistance = hit.distance;
@@ -600,6 +669,40 @@ namespace sc
     if (!dbg.showAgentTargets && !dbg.showSensorRays && !dbg.showTierColors)
       return;
 
+    // Draw the sensor of the agents the AI actually senses with: same sector and
+    // lane/target checks, so the batch holds no rays nobody looks at.
+    state->sensorEntities.clear();
+    state->sensorRays.clear();
+    if (dbg.showSensorRays && state->physics && state->lanes)
+    {
+      world.ForEach<TrafficAgent, TrafficVehicle, Transform>([&](Entity e, TrafficAgent& agent, TrafficVehicle&, Transform& tr)
+      {
+        if (!agentSectorActive(world, state->streaming, e))
+          return;
+        float target[3]{};
+        float toTarget[3]{};
+        if (!agentTargetDir(*state->lanes, agent, tr, target, toTarget))
+          return;
+
+        const float yaw = tr.localRot[1];
+        RayQuery q{};
+        q.dir[0] = std::sin(yaw);
+        q.dir[1] = 0.0f;
+        q.dir[2] = std::cos(yaw);
+        normalize3(q.dir);
+        q.origin[0] = tr.localPos[0] + q.dir[0] * 1.5f;
+        q.origin[1] = tr.localPos[1] + 0.4f;
+        q.origin[2] = tr.localPos[2] + q.dir[2] * 1.5f;
+        q.maxDist = world.has<TrafficSensors>(e) ? world.get<TrafficSensors>(e)->frontRayLength : dbg.frontRayLength;
+        state->sensorEntities.push_back(e);
+        state->sensorRays.push_back(q);
+      });
+    }
+    state->sensorHits.resize(state->sensorRays.size());
+    if (!state->sensorRays.empty())
+      state->physics->raycastBatch(state->sensorRays, state->sensorHits);
+    size_t nextSensor = 0;
+
     const float targetColor[3] = { 0.9f, 0.8f, 0.2f };
     const float rayHitColor[3] = { 1.0f, 0.2f, 0.2f };
     const float rayMissColor[3] = { 0.2f, 1.0f, 0.3f };
@@ -619,7 +722,8 @@ namespace sc
         }
       }
 
-      if (dbg.showSensorRays)
+      const bool sensed = nextSensor < state->sensorEntities.size() && state->sensorEntities[nextSensor] == e;
+      if (sensed)
       {
         const float yaw = tr.localRot[1];
         float forward[3] = { std::sin(yaw), 0.0f, std::cos(yaw) };
@@ -639,16 +743,13 @@ namespace sc
         };
 
         bool hit = false;
-        if (state->physics)
+        const RaycastHit& rh = state->sensorHits[nextSensor++];
+        if (rh.hit && rh.entity != e)
         {
-          RaycastHit rh = state->physics->raycast(origin, forward, rayLen, 0xFFFFFFFFu);
-          if (rh.hit && rh.entity != e)
-          {
-            hit = true;
-            end[0] = origin[0] + forward[0] * rh.distance;
-            end[1] = origin[1] + forward[1] * rh.distance;
-            end[2] = origin[2] + forward[2] * rh.distance;
-          }
+          hit = true;
+          end[0] = origin[0] + forward[0] * rh.distance;
+          end[1] = origin[1] + forward[1] * rh.distance;
+          end[2] = origin[2] + forward[2] * rh.distance;
         }
 
         state->draw->addLine(origin, end, hit ? rayHitColor : rayMissColor);
@@ -1,5 +1,6 @@
 #pragma once
 #include <cstdint>
+#include <vector>
 
 #include "sc_ecs.h"
 #include "sc_world_partition.h"
@@ -17,6 +18,11 @@ namespace sc
     TrafficDebugState* debug = nullptr;
     PhysicsWorld* physics = nullptr;
     WorldStreamingState* streaming = nullptr;
+
+    // Front sensor rays for every agent that steers this step, cast as one batch.
+    std::vector<Entity> sensorEntities;
+    std::vector<RayQuery> sensorRays;
+    std::vector<RaycastHit> sensorHits;
   };
 
   struct TrafficPhysicsSyncState
@@ -31,8 +37,19 @@ namespace sc
     TrafficDebugState* debug = nullptr;
     DebugDraw* draw = nullptr;
     PhysicsWorld* physics = nullptr;
+    WorldStreamingState* streaming = nullptr;
+
+    std::vector<Entity> sensorEntities;
+    std::vector<RayQuery> sensorRays;
+    std::vector<RaycastHit> sensorHits;
   };
 
+  // Front sensor ray of an agent about to steer. Assigns the nearest lane when
+  // the agent has none; false, with no ray, when it still has no active lane or
+  // look-ahead target, which is when TrafficAISystem leaves it alone.
+  bool buildTrafficSensorRay(const TrafficLaneGraph& lanes, TrafficAgent& agent, const Transform& tr,
+                             float rayLength, RayQuery& outRay);
+
   void TrafficAISystem(World& world, float dt, void* user);
   void TrafficPhysicsSyncSystem(World& world, float dt, void* user);
   void TrafficDebugDrawSystem(World& world, float dt, void* user);
@@ -44,7 +44,7 @@ namespace sc
       return active;
     }
 
-    static void ensureRenderMesh(World& world, Entity e, uint32_t meshId, uint32_t materialId)
+    static void ensureRenderMesh(World& world, Entity e, uint32_t meshId, uint32_t lodSetId, uint32_t materialId)
     {
       RenderMesh* rm = world.get<RenderMesh>(e);
       if (!rm)
@@ -52,10 +52,12 @@ namespace sc
         RenderMesh& added = world.add<RenderMesh>(e);
         added.meshId = meshId;
         added.materialId = materialId;
+        added.lodSetId = lodSetId;
         return;
       }
       rm->meshId = meshId;
       rm->materialId = materialId;
+      rm->lodSetId = lodSetId;
     }
 
     static void ensureBounds(World& world, Entity e)
@@ -195,9 +197,10 @@ namespace sc
                           TrafficVehicle& tv,
                           TrafficSimMode mode,
                           uint32_t meshId,
+                          uint32_t lodSetId,
                           uint32_t materialId)
     {
-      ensureRenderMesh(world, e, meshId, materialId);
+      ensureRenderMesh(world, e, meshId, lodSetId, materialId);
       ensureBounds(world, e);
 
       if (mode == TrafficSimMode::Physics)
@@ -492,7 +495,7 @@ namespace sc
       activeTotal++;
 
       if (entry.tv->mode != desired[i])
-        applyMode(world, entry.e, *entry.tv, desired[i], state->meshId, state->materialId);
+        applyMode(world, entry.e, *entry.tv, desired[i], state->meshId, state->lodSetId, state->materialId);
 
       if (desired[i] == TrafficSimMode::Physics) countPhys++;
       else if (desired[i] == TrafficSimMode::Kinematic) countKin++;
@@ -16,6 +16,7 @@ namespace sc
     TrafficDebugState* debug = nullptr;
     VehicleDebugState* vehicleDebug = nullptr;
     uint32_t meshId = 1u;
+    uint32_t lodSetId = kInvalidMeshLodSet;
     uint32_t materialId = 0u;
     uint32_t lastTotalVehicles = 0;
   };
@@ -302,6 +302,7 @@ namespace sc
 
         RenderMesh& rm = world.add<RenderMesh>(e);
         rm.meshId = state->meshId;
+        rm.lodSetId = state->lodSetId;
         rm.materialId = state->materialId;
 
         Bounds& b = world.add<Bounds>(e);
@@ -319,6 +320,8 @@ namespace sc
 
         TrafficVehicle& tv = world.add<TrafficVehicle>(e);
         tv.mode = TrafficSimMode::OnRails;
+        // On-rails agents advance in FixedUpdate like the physics tiers.
+        world.add<InterpolatedPose>(e);
 
         TrafficSensors& sensors = world.add<TrafficSensors>(e);
         sensors.frontRayLength = dbg.frontRayLength;
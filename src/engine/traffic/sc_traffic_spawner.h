@@ -16,6 +16,7 @@ namespace sc
     TrafficDebugState* debug = nullptr;
     VehicleDebugState* vehicleDebug = nullptr;
     uint32_t meshId = 1u;
+    uint32_t lodSetId = kInvalidMeshLodSet;
     uint32_t materialId = 0u;
     float vehicleScale[3] = { 1.8f, 0.7f, 3.5f };
     uint64_t lastLogTicks = 0;
@@ -3,11 +3,13 @@
 #include "sc_jobs.h"
 #include "sc_assets.h"
 #include "sc_paths.h"
+#include "sc_vfs.h"
 #include "world_format.h"
 #include "sc_physics.h"
 #include "sc_traffic_common.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstdio>
 #include <cstring>
@@ -198,15 +200,84 @@ namespace sc
       return fallback;
     }
 
-    static void pushDrawItem(RenderFrameData& frame, Entity e, const Transform& t, const RenderMesh& rm)
+    // Picks the mesh for rm's LOD set (if any) and remembers the choice on the
+    // component so the next frame's hysteresis starts from it.
+    static uint32_t selectLodMesh(RenderPrepStreamingState& state, RenderMesh& rm, float screenSize)
+    {
+      if (rm.lodSetId == kInvalidMeshLodSet || !state.assets)
+        return rm.meshId;
+      const MeshLodSet* set = state.assets->getMeshLodSet(rm.lodSetId);
+      if (!set || set->lodCount == 0)
+        return rm.meshId;
+
+      const uint32_t lod = selectMeshLod(*set, screenSize, rm.lod, state.lodHysteresis);
+      if (lod != rm.lod)
+      {
+        state.stats.lodSwitches++;
+        rm.lod = lod;
+      }
+      state.stats.lodHistogram[lod]++;
+      return set->meshIds[lod];
+    }
+
+    static void pushDrawItem(RenderFrameData& frame,
+                             const AssetManager* assets,
+                             Entity e,
+                             const Transform& t,
+                             const RenderMesh& rm,
+                             uint32_t meshId)
     {
       DrawItem cmd{};
       cmd.entity = e;
-      cmd.meshId = rm.meshId;
+      cmd.meshId = meshId;
       cmd.materialId = rm.materialId;
       cmd.model = t.worldMatrix;
+
+      uint32_t pipeline = kFallbackDrawPipeline;
+      bool transparent = false;
+      if (const Material* material = assets ? assets->getMaterial(rm.materialId) : nullptr)
+      {
+        pipeline = static_cast<uint32_t>(material->pipelineId);
+        transparent = material->desc.transparent;
+      }
+      const float depth = transparent ? drawViewDepth(frame.viewProj, cmd.model) : 0.0f;
+      cmd.sortKey = makeDrawSortKey(pipeline, cmd.materialId, cmd.meshId, transparent, depth);
       frame.draws.push_back(cmd);
     }
+
+    static void sortFrameDraws(RenderPrepStreamingState& state)
+    {
+      RenderFrameData& frame = *state.frame;
+      const uint32_t count = static_cast<uint32_t>(frame.draws.size());
+      state.stats.sortPasses = 0;
+      state.stats.sortBlocks = 0;
+      state.stats.sortMs = 0.0f;
+      if (count == 0)
+      {
+        frame.sorted = true;
+        return;
+      }
+
+      const Tick start = nowTicks();
+      state.sortItems.resize(count);
+      for (uint32_t i = 0; i < count; ++i)
+      {
+        state.sortItems[i].key = frame.draws[i].sortKey;
+        state.sortItems[i].index = i;
+      }
+
+      const RadixSortStats sortStats = radixSort(state.sortItems, state.sortScratch);
+
+      state.drawScratch.resize(count);
+      for (uint32_t i = 0; i < count; ++i)
+        state.drawScratch[i] = frame.draws[state.sortItems[i].index];
+      frame.draws.swap(state.drawScratch);
+      frame.sorted = true;
+
+      state.stats.sortPasses = sortStats.passes;
+      state.stats.sortBlocks = sortStats.blocks;
+      state.stats.sortMs = static_cast<float>(ticksToSeconds(nowTicks() - start) * 1000.0);
+    }
   }
 
   size_t SectorCoordHash::operator()(const SectorCoord& c) const noexcept
@@ -739,8 +810,30 @@ namespace sc
     if (m_assetRegistryPath.empty())
       return;
 
+    // A mounted pack carries the cooked registry under the same relative name.
+    const std::string cookedRelative = sc_world::CookedRegistryPathFor(m_assetRegistryPath);
+    sc::AssetBlob packed{};
+    if (sc::vfs().packCount() > 0 && sc::vfs().readPacked(sc::assetPathId(cookedRelative), packed) &&
+        m_assetRegistry.loadCookedMemory(packed.data(), packed.size()))
+      return;
+
     const std::filesystem::path resolved = sc::resolveAssetPath(m_assetRegistryPath);
-    sc_world::LoadAssetRegistry(resolved.string().c_str(), m_assetRegistry);
+    const std::string textPath = resolved.string();
+
+    // The editor keeps a cooked sibling current; use it unless the text is newer.
+    const std::string cookedPath = sc_world::CookedRegistryPathFor(textPath);
+    std::error_code ec;
+    const bool haveCooked = std::filesystem::exists(cookedPath, ec);
+    bool cookedFresh = haveCooked;
+    if (haveCooked && std::filesystem::exists(resolved, ec))
+    {
+      const auto textTime = std::filesystem::last_write_time(resolved, ec);
+      const auto cookedTime = std::filesystem::last_write_time(cookedPath, ec);
+      cookedFresh = !ec && cookedTime >= textTime;
+    }
+    if (cookedFresh && m_assetRegistry.loadCooked(cookedPath.c_str()))
+      return;
+    m_assetRegistry.loadText(textPath.c_str());
   }
 
   uint32_t WorldPartition::resolveMeshHandle(AssetId assetId)
@@ -753,7 +846,7 @@ namespace sc
       return it->second;
 
     ensureAssetRegistryLoaded();
-    const sc_world::AssetRegistryEntry* entry = sc_world::FindByMeshId(m_assetRegistry, assetId);
+    const sc_world::AssetRegistryEntry* entry = m_assetRegistry.findByMeshId(assetId);
     const char* meshPath = entry ? entry->mesh_path.c_str() : kMeshCubePath;
     const MeshHandle handle = m_assets->loadMesh(meshPath);
     const uint32_t resolved = (handle == kInvalidMeshHandle) ? 0u : handle;
@@ -771,7 +864,7 @@ namespace sc
       return it->second;
 
     ensureAssetRegistryLoaded();
-    const sc_world::AssetRegistryEntry* entry = sc_world::FindByMaterialId(m_assetRegistry, assetId);
+    const sc_world::AssetRegistryEntry* entry = m_assetRegistry.findByMaterialId(assetId);
     std::string path = entry ? entry->material_path : std::string(kMaterialUnlitPath);
 
     sc::MaterialDesc desc{};
@@ -929,6 +1022,7 @@ namespace sc
         RenderMesh& rm = world.add<RenderMesh>(e);
         rm.meshId = resolveMeshHandle(rec.meshAssetId);
         rm.materialId = resolveMaterialHandle(rec.materialAssetId);
+        rm.lodSetId = m_assets ? m_assets->meshLodSetFor(rm.meshId) : kInvalidMeshLodSet;
 
         WorldSector& ws = world.add<WorldSector>(e);
         ws.coord = coord;
@@ -1221,28 +1315,45 @@ namespace sc
     {
       state->stats.visible = 0;
       state->stats.culled = 0;
+      state->stats.contributionCulled = 0;
       return;
     }
 
+    state->visibleScreenSizes.clear();
+    state->visibleScreenSizes.reserve(total);
+
     if (state->freezeCulling)
     {
+      // No fresh bounds: treat everything as full size (LOD 0).
       state->visible.insert(state->visible.end(), state->candidates.begin(), state->candidates.end());
+      state->visibleScreenSizes.assign(state->visible.size(), 1.0f);
       state->stats.visible = static_cast<uint32_t>(state->visible.size());
       state->stats.culled = 0;
+      state->stats.contributionCulled = 0;
       return;
     }
 
     state->frustum = frustumFromViewProj(state->frame->viewProj);
     if (state->visibilityMask.size() < total)
       state->visibilityMask.resize(total);
+    if (state->screenSizes.size() < total)
+      state->screenSizes.resize(total);
 
     const Frustum frustum = state->frustum;
+    const Mat4 viewProj = state->frame->viewProj;
+    const float sizeScale = projectedSizeScale(viewProj);
+    // Screen size is a diameter in viewport heights; convert the pixel radius.
+    const float minScreenSize = (state->viewportHeightPixels > 0.0f)
+      ? (2.0f * state->minProjectedRadiusPixels / state->viewportHeightPixels)
+      : 0.0f;
+    std::atomic<uint32_t> contributionCulled{ 0 };
     auto handle = jobs().Dispatch(total, 128u, [&](const JobContext& ctx)
     {
       for (uint32_t i = ctx.start; i < ctx.end; ++i)
       {
         const Entity e = state->candidates[i];
         const Transform* t = world.get<Transform>(e);
+        state->screenSizes[i] = 1.0f;
         if (!t)
         {
           state->visibilityMask[i] = 0;
@@ -1266,6 +1377,12 @@ namespace sc
         float radius = 0.0f;
         computeWorldBoundsSphere(*t, *bounds, center, radius);
         state->visibilityMask[i] = sphereInFrustum(frustum, center, radius) ? 1u : 0u;
+        state->screenSizes[i] = projectedSphereSize(viewProj, sizeScale, center, radius);
+        if (state->visibilityMask[i] != 0 && state->screenSizes[i] < minScreenSize)
+        {
+          state->visibilityMask[i] = 0;
+          contributionCulled.fetch_add(1u, std::memory_order_relaxed);
+        }
       }
     });
     jobs().Wait(handle);
@@ -1274,13 +1391,17 @@ namespace sc
     {
       const Entity e = state->candidates[i];
       if (state->visibilityMask[i] != 0)
+      {
         state->visible.push_back(e);
+        state->visibleScreenSizes.push_back(state->screenSizes[i]);
+      }
       else
         state->culled.push_back(e);
     }
 
     state->stats.visible = static_cast<uint32_t>(state->visible.size());
     state->stats.culled = static_cast<uint32_t>(state->culled.size());
+    state->stats.contributionCulled = contributionCulled.load(std::memory_order_relaxed);
   }
 
   void RenderPrepStreamingSystem(World& world, float dt, void* user)
@@ -1303,26 +1424,60 @@ namespace sc
       state->assets->setFreezeEviction(state->streaming->freezeEviction);
     }
 
+    for (uint32_t& count : state->stats.lodHistogram)
+      count = 0;
+    state->stats.lodSwitches = 0;
+    state->stats.minKeptScreenSize = 0.0f;
+
     if (state->culling)
     {
-      for (const Entity e : state->culling->visible)
+      const std::vector<Entity>& visible = state->culling->visible;
+      const std::vector<float>& screenSizes = state->culling->visibleScreenSizes;
+      const uint32_t visibleCount = static_cast<uint32_t>(visible.size());
+      auto screenSizeAt = [&](uint32_t i)
       {
-        Transform* t = world.get<Transform>(e);
-        RenderMesh* rm = world.get<RenderMesh>(e);
-        if (!t || !rm)
-          continue;
-
-        if (maxDraws > 0 && emitted >= maxDraws)
+        return (i < screenSizes.size()) ? screenSizes[i] : 1.0f;
+      };
+
+      // Over budget: keep the largest projected areas. Area grows with screen
+      // size, so a partial selection on size is enough; order is restored by
+      // the sort-key pass afterwards. Entities that cannot draw are left out
+      // first so they never take a budget slot.
+      std::vector<uint32_t>& order = state->budgetOrder;
+      order.clear();
+      for (uint32_t i = 0; i < visibleCount; ++i)
+      {
+        if (world.has<Transform>(visible[i]) && world.has<RenderMesh>(visible[i]))
+          order.push_back(i);
+      }
+      const uint32_t drawable = static_cast<uint32_t>(order.size());
+      if (maxDraws > 0 && drawable > maxDraws)
+      {
+        std::nth_element(order.begin(), order.begin() + maxDraws, order.end(), [&](uint32_t a, uint32_t b)
         {
-          dropped++;
-          continue;
-        }
+          return screenSizeAt(a) > screenSizeAt(b);
+        });
+        order.resize(maxDraws);
+        dropped = drawable - maxDraws;
+
+        float minKept = screenSizeAt(order[0]);
+        for (const uint32_t i : order)
+          minKept = std::min(minKept, screenSizeAt(i));
+        state->stats.minKeptScreenSize = minKept;
+      }
 
-        pushDrawItem(frame, e, *t, *rm);
+      for (const uint32_t i : order)
+      {
+        const Entity e = visible[i];
+        Transform* t = world.get<Transform>(e);
+        RenderMesh* rm = world.get<RenderMesh>(e);
+        const float screenSize = screenSizeAt(i);
+        const uint32_t meshId = selectLodMesh(*state, *rm, screenSize);
+        pushDrawItem(frame, state->assets, e, *t, *rm, meshId);
         if (state->assets)
         {
-          state->assets->touchMaterial(rm->materialId);
-          state->assets->touchMesh(rm->meshId);
+          state->assets->touchMaterial(rm->materialId, screenSize);
+          state->assets->touchMesh(meshId);
         }
         emitted++;
       }
@@ -1336,16 +1491,19 @@ namespace sc
           dropped++;
           return;
         }
-        pushDrawItem(frame, e, t, rm);
+        const uint32_t meshId = selectLodMesh(*state, rm, 1.0f);
+        pushDrawItem(frame, state->assets, e, t, rm, meshId);
         if (state->assets)
         {
           state->assets->touchMaterial(rm.materialId);
-          state->assets->touchMesh(rm.meshId);
+          state->assets->touchMesh(meshId);
         }
         emitted++;
       });
     }
 
+    sortFrameDraws(*state);
+
     if (state->assets)
     {
       const uint32_t loadLimit = state->assets->residencyConfig().maxTextureLoadsPerFrame;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "sc_ecs.h"
+#include "sc_radix_sort.h"
 #include "asset_registry.h"
 
 #include <cstddef>
@@ -284,7 +285,7 @@ namespace sc
     AssetManager* m_assets = nullptr;
     std::string m_assetRegistryPath = "world/asset_registry.txt";
     bool m_assetRegistryLoaded = false;
-    std::vector<sc_world::AssetRegistryEntry> m_assetRegistry;
+    sc_world::AssetRegistry m_assetRegistry;
     std::unordered_map<AssetId, uint32_t> m_meshHandleCache;
     std::unordered_map<AssetId, uint32_t> m_materialHandleCache;
   };
@@ -336,24 +337,35 @@ namespace sc
     uint32_t renderablesTotal = 0;
     uint32_t visible = 0;
     uint32_t culled = 0;
+    uint32_t contributionCulled = 0; // in the frustum but below minProjectedRadiusPixels
   };
 
   struct CullingState
   {
     RenderFrameData* frame = nullptr;
     bool freezeCulling = false;
+    float viewportHeightPixels = 720.0f;
+    float minProjectedRadiusPixels = 1.0f; // 0 disables contribution culling
     Frustum frustum{};
     CullingStats stats{};
     std::vector<Entity> candidates;
     std::vector<Entity> visible;
     std::vector<Entity> culled;
     std::vector<uint8_t> visibilityMask;
+    std::vector<float> screenSizes;        // per candidate
+    std::vector<float> visibleScreenSizes; // parallel to visible
   };
 
   struct RenderPrepStats
   {
     uint32_t drawsEmitted = 0;
-    uint32_t drawsDroppedByBudget = 0;
+    uint32_t drawsDroppedByBudget = 0;     // culled path: the smallest projected areas
+    float minKeptScreenSize = 0.0f;        // smallest screen size that survived the budget
+    uint32_t sortPasses = 0;
+    uint32_t sortBlocks = 0;
+    float sortMs = 0.0f;
+    uint32_t lodHistogram[kMaxMeshLods]{}; // draws per selected LOD (LOD-set meshes only)
+    uint32_t lodSwitches = 0;
   };
 
   struct RenderPrepStreamingState
@@ -362,7 +374,12 @@ namespace sc
     CullingState* culling = nullptr;
     WorldStreamingState* streaming = nullptr;
     AssetManager* assets = nullptr;
+    float lodHysteresis = 0.15f;
     RenderPrepStats stats{};
+    std::vector<SortKeyIndex> sortItems;
+    std::vector<SortKeyIndex> sortScratch;
+    std::vector<DrawItem> drawScratch;
+    std::vector<uint32_t> budgetOrder;
   };
 
   struct DebugDrawSystemState
@@ -3,6 +3,8 @@
 #include "sc_vk.h"
 #include "sc_jobs.h"
 #include "sc_memtrack.h"
+#include "sc_paths.h"
+#include "sc_vfs.h"
 #include "sc_ecs.h"
 #include "sc_scheduler.h"
 #include "sc_debug_draw.h"
@@ -35,6 +37,12 @@ int main()
     return 1;
   }
 
+  // Packed assets shadow loose files; shaders and textures read through the VFS.
+  const std::filesystem::path packPath = sc::exeDir() / "assets.scpak";
+  std::error_code packError;
+  if (std::filesystem::exists(packPath, packError))
+    sc::vfs().mountPack(packPath);
+
   sc::VkRenderer vk;
   sc::VkConfig vkc;
   vkc.enableDebugUI = true;
@@ -123,7 +131,10 @@ int main()
   debugDrawState.culling = &culling;
 
   sc::PhysicsWorld physicsWorld{};
-  physicsWorld.init();
+  sc::PhysicsWorldConfig physicsCfg{};
+  physicsCfg.multithreaded = true;
+  physicsCfg.lod.enabled = true;
+  physicsWorld.init(physicsCfg);
 
   sc::PhysicsDebugState physicsDebug{};
 
@@ -131,6 +142,9 @@ int main()
   physicsSync.world = &physicsWorld;
   physicsSync.debug = &physicsDebug;
   physicsSync.tracked.reserve(4096);
+  physicsSync.mergeSectorStatics = true;
+
+  sc::PhysicsInterpolationState physicsInterp{};
 
   sc::VehicleDebugState vehicleDebug{};
   vehicleDebug.cameraEnabled = true;
@@ -207,6 +221,7 @@ int main()
   trafficDrawState.debug = &trafficDebug;
   trafficDrawState.draw = &debugDraw;
   trafficDrawState.physics = &physicsWorld;
+  trafficDrawState.streaming = &worldStreaming;
 
   sc::TrafficPinState trafficPins{};
   trafficPins.streaming = &worldStreaming;
@@ -231,6 +246,8 @@ int main()
   vehicleDemo.materialId = physicsDemo.materialId;
   trafficSpawner.materialId = vehicleDemo.materialId;
   trafficLod.materialId = vehicleDemo.materialId;
+  trafficSpawner.lodSetId = vk.assets().meshLodSetFor(trafficSpawner.meshId);
+  trafficLod.lodSetId = vk.assets().meshLodSetFor(trafficLod.meshId);
   vehicleDemo.spawnPos[0] = sectorSize * 0.5f;
   vehicleDemo.spawnPos[1] = 2.0f;
   vehicleDemo.spawnPos[2] = sectorSize * 0.5f;
@@ -252,7 +269,9 @@ int main()
   scheduler.addSystem("PhysicsSync", sc::SystemPhase::FixedUpdate, sc::PhysicsSyncSystem, &physicsSync, { "PhysicsDemo", "VehiclePreStep" });
   scheduler.addSystem("TrafficPhysicsSync", sc::SystemPhase::FixedUpdate, sc::TrafficPhysicsSyncSystem, &trafficPhysSync, { "PhysicsSync" });
   scheduler.addSystem("VehiclePostStep", sc::SystemPhase::FixedUpdate, sc::VehicleSystemPostStep, &vehicleSystem, { "TrafficPhysicsSync" });
-  scheduler.addSystem("VehicleCamera", sc::SystemPhase::RenderPrep, sc::VehicleCameraSystem, &vehicleCamera);
+  scheduler.addSystem("PhysicsInterpCapture", sc::SystemPhase::FixedUpdate, sc::PhysicsInterpolationCaptureSystem, &physicsInterp, { "VehiclePostStep" });
+  scheduler.addSystem("PhysicsInterp", sc::SystemPhase::RenderPrep, sc::PhysicsInterpolationSystem, &physicsInterp);
+  scheduler.addSystem("VehicleCamera", sc::SystemPhase::RenderPrep, sc::VehicleCameraSystem, &vehicleCamera, { "PhysicsInterp" });
   scheduler.addSystem("Transform", sc::SystemPhase::RenderPrep, sc::TransformSystem, nullptr, { "PhysicsDemo", "VehicleCamera" });
   scheduler.addSystem("Camera", sc::SystemPhase::RenderPrep, sc::CameraSystem, &cameraState, { "Transform" });
   scheduler.addSystem("Culling", sc::SystemPhase::RenderPrep, sc::CullingSystem, &culling, { "Camera" });
@@ -262,6 +281,7 @@ int main()
   scheduler.addSystem("VehicleDebugDraw", sc::SystemPhase::RenderPrep, sc::VehicleDebugDrawSystem, &vehicleDraw, { "TrafficDebugDraw" });
   scheduler.addSystem("PhysicsDebugDraw", sc::SystemPhase::RenderPrep, sc::PhysicsDebugDrawSystem, &physicsDraw, { "VehicleDebugDraw" });
   scheduler.addSystem("Debug", sc::SystemPhase::Render, sc::DebugSystem, nullptr, { "DebugDraw" });
+  scheduler.addSystem("PhysicsInterpRestore", sc::SystemPhase::Render, sc::PhysicsInterpolationRestoreSystem, &physicsInterp, { "Debug" });
   scheduler.finalize();
 
   sc::Tick lastTicks = sc::nowTicks();
@@ -284,6 +304,7 @@ int main()
     lastTicks = now;
 
     cameraState.aspect = vk.swapchainAspect();
+    culling.viewportHeightPixels = static_cast<float>(vk.swapchainHeight());
     float fixedStepDt = fixedDt;
     uint32_t fixedSteps = 0;
 
@@ -306,6 +327,7 @@ int main()
       fixedSteps = 1;
       fixedStepDt = 0.0f;
     }
+    physicsInterp.alpha = physicsDebug.pausePhysics ? 1.0f : fixedAccumulator / fixedDt;
 
     scheduler.tick(world, dt, fixedSteps, fixedStepDt);
     jobs.publishFrameTelemetry();
@@ -326,8 +348,10 @@ int main()
 
   worldStreaming.partition.shutdownStreaming();
   physicsWorld.shutdown();
+  vk.assets().drainTextureDecodes();
   jobs.shutdown();
   vk.shutdown();
+  sc::vfs().unmountAll();
   app.shutdown();
   return 0;
 }
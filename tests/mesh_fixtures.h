@@ -0,0 +1,56 @@
+#pragma once
+
+#include "mesh_importer.h"
+
+#include <cmath>
+#include <cstdint>
+
+namespace sc_test
+{
+  // UV sphere around an off-origin center so bounds are not symmetric about 0.
+  inline sc_import::MeshData makeSphere(uint32_t rings, uint32_t segments, float radius)
+  {
+    static constexpr float kPi = 3.14159265358979f;
+    static constexpr float kCenter[3] = { 12.5f, -3.0f, 40.0f };
+
+    sc_import::MeshData mesh{};
+    mesh.vertexLayoutFlags = sc_import::VertexLayout_Position | sc_import::VertexLayout_Normal | sc_import::VertexLayout_UV0;
+    for (uint32_t r = 0; r <= rings; ++r)
+    {
+      const float v = static_cast<float>(r) / static_cast<float>(rings);
+      const float theta = v * kPi;
+      for (uint32_t s = 0; s <= segments; ++s)
+      {
+        const float u = static_cast<float>(s) / static_cast<float>(segments);
+        const float phi = u * 2.0f * kPi;
+        sc_import::MeshVertex vtx{};
+        vtx.normal[0] = std::sin(theta) * std::cos(phi);
+        vtx.normal[1] = std::cos(theta);
+        vtx.normal[2] = std::sin(theta) * std::sin(phi);
+        for (int axis = 0; axis < 3; ++axis)
+          vtx.pos[axis] = kCenter[axis] + vtx.normal[axis] * radius;
+        vtx.uv0[0] = u;
+        vtx.uv0[1] = v;
+        mesh.vertices.push_back(vtx);
+      }
+    }
+
+    const uint32_t stride = segments + 1;
+    for (uint32_t r = 0; r < rings; ++r)
+    {
+      for (uint32_t s = 0; s < segments; ++s)
+      {
+        const uint32_t a = r * stride + s;
+        const uint32_t b = a + stride;
+        mesh.indices.insert(mesh.indices.end(), { a, b, a + 1, a + 1, b, b + 1 });
+      }
+    }
+
+    sc_import::Submesh submesh{};
+    submesh.indexCount = static_cast<uint32_t>(mesh.indices.size());
+    submesh.materialIndex = 0;
+    mesh.submeshes.push_back(submesh);
+    sc_import::ComputeMeshBounds(&mesh);
+    return mesh;
+  }
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdio>
+
+// Minimal checks for the test executables: failures are reported and counted
+// rather than aborting, and main() returns the count so ctest sees non-zero.
+namespace sc_test
+{
+  inline int& failures()
+  {
+    static int count = 0;
+    return count;
+  }
+}
+
+#define SC_CHECK(expr)                                                              \
+  do                                                                                \
+  {                                                                                 \
+    if (!(expr))                                                                    \
+    {                                                                               \
+      std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #expr); \
+      ++sc_test::failures();                                                        \
+    }                                                                               \
+  } while (0)
+
+#define SC_TEST_RESULT() (sc_test::failures() == 0 ? 0 : 1)
@@ -0,0 +1,177 @@
+#include "sc_draw_batch.h"
+#include "sc_radix_sort.h"
+#include "sc_test.h"
+
+#include <vector>
+
+using namespace sc;
+
+namespace
+{
+  // Stands in for the asset manager: material id -> pipeline, as pushDrawItem resolves it.
+  static constexpr uint32_t kMaterialPipeline[] = { 0u, 1u, 1u, 0u };
+
+  DrawItem makeDraw(uint32_t meshId, uint32_t materialId, float x, bool transparent = false, float depth = 0.0f)
+  {
+    DrawItem draw{};
+    draw.meshId = meshId;
+    draw.materialId = materialId;
+    draw.model = mat4_translation(x, 0.0f, 0.0f);
+    draw.sortKey = makeDrawSortKey(kMaterialPipeline[materialId], materialId, meshId, transparent, depth);
+    return draw;
+  }
+
+  std::vector<SortKeyIndex> sortDraws(const std::vector<DrawItem>& draws)
+  {
+    std::vector<SortKeyIndex> order(draws.size());
+    for (uint32_t i = 0; i < draws.size(); ++i)
+      order[i] = { draws[i].sortKey, i };
+    std::vector<SortKeyIndex> scratch;
+    radixSort(order, scratch);
+    return order;
+  }
+
+  // What a null backend does with the builder: one instanced call per batch.
+  struct NullBackend
+  {
+    uint32_t drawCalls = 0;
+    uint32_t instancesDrawn = 0;
+    uint32_t pipelineBinds = 0;
+    uint32_t boundPipeline = UINT32_MAX;
+
+    void submit(const DrawBatchBuilder& builder)
+    {
+      for (const DrawBatch& batch : builder.batches())
+      {
+        const uint32_t pipeline = kMaterialPipeline[batch.materialId];
+        if (pipeline != boundPipeline)
+        {
+          boundPipeline = pipeline;
+          ++pipelineBinds;
+        }
+        ++drawCalls;
+        instancesDrawn += batch.instanceCount;
+      }
+    }
+  };
+
+  void testSortKeyOrdering()
+  {
+    // Opaque: pipeline, then material, then mesh.
+    SC_CHECK(makeDrawSortKey(0, 9, 9, false, 0.0f) < makeDrawSortKey(1, 0, 0, false, 0.0f));
+    SC_CHECK(makeDrawSortKey(1, 2, 9, false, 0.0f) < makeDrawSortKey(1, 3, 0, false, 0.0f));
+    SC_CHECK(makeDrawSortKey(1, 2, 4, false, 0.0f) < makeDrawSortKey(1, 2, 5, false, 0.0f));
+    // Opaque draws ignore depth; transparent ones come after all opaque, far first.
+    SC_CHECK(makeDrawSortKey(1, 2, 4, false, 5.0f) == makeDrawSortKey(1, 2, 4, false, 500.0f));
+    SC_CHECK(makeDrawSortKey(127, 0xFFFFF, 0xFFFFF, false, 0.0f) < makeDrawSortKey(0, 0, 0, true, 0.0f));
+    SC_CHECK(makeDrawSortKey(0, 1, 1, true, 500.0f) < makeDrawSortKey(0, 1, 1, true, 5.0f));
+
+    std::vector<DrawItem> draws;
+    draws.push_back(makeDraw(1, 0, 0.0f, true, 10.0f)); // near transparent
+    draws.push_back(makeDraw(2, 1, 1.0f));
+    draws.push_back(makeDraw(1, 0, 2.0f, true, 90.0f)); // far transparent
+    draws.push_back(makeDraw(1, 3, 3.0f));
+    draws.push_back(makeDraw(2, 1, 4.0f));
+    draws.push_back(makeDraw(1, 0, 5.0f));
+
+    const std::vector<SortKeyIndex> order = sortDraws(draws);
+    const uint32_t expected[] = { 5, 3, 1, 4, 2, 0 };
+    SC_CHECK(order.size() == 6u);
+    for (uint32_t i = 0; i < order.size() && i < 6u; ++i)
+      SC_CHECK(order[i].index == expected[i]);
+    for (uint32_t i = 1; i < order.size(); ++i)
+      SC_CHECK(order[i - 1].key <= order[i].key);
+  }
+
+  void testInstanceRunsMerge()
+  {
+    std::vector<DrawItem> draws;
+    for (uint32_t i = 0; i < 5; ++i)
+      draws.push_back(makeDraw(7, 1, static_cast<float>(i)));
+    draws.push_back(makeDraw(8, 1, 10.0f));
+
+    DrawBatchBuilder builder;
+    builder.build(draws);
+    SC_CHECK(builder.batches().size() == 2u);
+    SC_CHECK(builder.stats().rawDraws == 6u);
+    SC_CHECK(builder.stats().batches == 2u);
+    SC_CHECK(builder.stats().largestBatch == 5u);
+    if (builder.batches().size() == 2u)
+    {
+      const DrawBatch& run = builder.batches()[0];
+      SC_CHECK(run.meshId == 7u && run.materialId == 1u);
+      SC_CHECK(run.firstInstance == 0u && run.instanceCount == 5u);
+      SC_CHECK(builder.batches()[1].firstInstance == 5u);
+    }
+    // Instances are packed in walk order.
+    SC_CHECK(builder.instances().size() == 6u);
+    for (uint32_t i = 0; i < builder.instances().size(); ++i)
+      SC_CHECK(builder.instances()[i].m[12] == draws[i].model.m[12]);
+
+    // A cap splits long runs without changing instance order.
+    builder.setMaxInstancesPerBatch(2);
+    builder.build(draws);
+    SC_CHECK(builder.batches().size() == 4u);
+    if (builder.batches().size() == 4u)
+    {
+      SC_CHECK(builder.batches()[0].instanceCount == 2u);
+      SC_CHECK(builder.batches()[1].instanceCount == 2u);
+      SC_CHECK(builder.batches()[2].instanceCount == 1u);
+      SC_CHECK(builder.batches()[2].firstInstance == 4u);
+      SC_CHECK(builder.batches()[3].meshId == 8u);
+    }
+    SC_CHECK(builder.stats().largestBatch == 2u);
+
+    builder.clear();
+    SC_CHECK(builder.batches().empty() && builder.instances().empty());
+    SC_CHECK(builder.stats().rawDraws == 0u);
+  }
+
+  void testMaterialAndPipelineBreaks()
+  {
+    // Same mesh throughout; materials 1 and 2 share pipeline 1, 0 and 3 use pipeline 0.
+    std::vector<DrawItem> draws;
+    draws.push_back(makeDraw(4, 1, 0.0f));
+    draws.push_back(makeDraw(4, 2, 1.0f));
+    draws.push_back(makeDraw(4, 1, 2.0f));
+    draws.push_back(makeDraw(4, 0, 3.0f));
+    draws.push_back(makeDraw(4, 3, 4.0f));
+    draws.push_back(makeDraw(4, 0, 5.0f));
+
+    // Unsorted, every material change breaks the run.
+    DrawBatchBuilder builder;
+    builder.build(draws);
+    SC_CHECK(builder.batches().size() == 6u);
+
+    // Sorted, each material is one batch and pipelines are contiguous.
+    const std::vector<SortKeyIndex> order = sortDraws(draws);
+    builder.build(draws, order.data());
+    SC_CHECK(builder.batches().size() == 4u);
+    SC_CHECK(builder.stats().rawDraws == 6u);
+
+    uint32_t previousPipeline = 0;
+    for (const DrawBatch& batch : builder.batches())
+    {
+      SC_CHECK(batch.meshId == 4u);
+      SC_CHECK(kMaterialPipeline[batch.materialId] >= previousPipeline);
+      previousPipeline = kMaterialPipeline[batch.materialId];
+    }
+    // Instances follow the sorted walk, not submission order.
+    for (uint32_t i = 0; i < order.size() && i < builder.instances().size(); ++i)
+      SC_CHECK(builder.instances()[i].m[12] == draws[order[i].index].model.m[12]);
+
+    NullBackend backend;
+    backend.submit(builder);
+    SC_CHECK(backend.drawCalls == 4u);
+    SC_CHECK(backend.instancesDrawn == 6u);
+    SC_CHECK(backend.pipelineBinds == 2u);
+  }
+}
+
+int main()
+{
+  testSortKeyOrdering();
+  testInstanceRunsMerge();
+  testMaterialAndPipelineBreaks();
+  return SC_TEST_RESULT();
+}
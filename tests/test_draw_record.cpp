@@ -0,0 +1,90 @@
+#include "sc_draw_record.h"
+#include "sc_jobs.h"
+#include "sc_test.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace sc;
+
+namespace
+{
+  void waitUntil(const std::atomic<bool>& flag)
+  {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!flag.load(std::memory_order_acquire) && std::chrono::steady_clock::now() < deadline)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  struct CountingRecorder : IDrawRangeRecorder
+  {
+    std::atomic<uint32_t> calls{ 0 };
+    uint32_t recordRange(uint32_t, const DrawRange& range) override
+    {
+      calls.fetch_add(1, std::memory_order_relaxed);
+      return range.batchCount;
+    }
+  };
+
+  void testPartition()
+  {
+    std::vector<DrawRange> ranges;
+    SC_CHECK(partitionDrawRanges(10, 4, 2, ranges) == 4u);
+    uint32_t next = 0;
+    for (const DrawRange& r : ranges)
+    {
+      SC_CHECK(r.firstBatch == next);
+      next += r.batchCount;
+    }
+    SC_CHECK(next == 10u);
+    SC_CHECK(ranges[0].batchCount == 3u && ranges[3].batchCount == 2u);
+
+    SC_CHECK(partitionDrawRanges(3, 8, 256, ranges) == 1u);
+    SC_CHECK(partitionDrawRanges(0, 8, 1, ranges) == 0u);
+  }
+
+  void testJoinSkipsAsyncWork()
+  {
+    // With the only worker stuck in a streaming job, the render thread has to
+    // record every range itself and must leave the queued decode alone.
+    std::atomic<bool> workerParked{ false };
+    std::atomic<bool> releaseWorker{ false };
+    jobs().DispatchAsync([&](const JobContext&)
+    {
+      workerParked.store(true, std::memory_order_release);
+      waitUntil(releaseWorker);
+    });
+    waitUntil(workerParked);
+
+    std::atomic<bool> decodeRan{ false };
+    jobs().DispatchAsync([&](const JobContext&)
+    {
+      decodeRan.store(true, std::memory_order_release);
+    });
+
+    std::vector<DrawRange> ranges;
+    partitionDrawRanges(12, 3, 1, ranges);
+    std::vector<uint32_t> issued;
+    CountingRecorder recorder;
+    const DrawRecordStats stats = recordDrawRanges(ranges, recorder, issued);
+    SC_CHECK(stats.parallel);
+    SC_CHECK(stats.issued == 12u);
+    SC_CHECK(recorder.calls.load() == 3u);
+    SC_CHECK(!decodeRan.load());
+
+    releaseWorker.store(true, std::memory_order_release);
+    waitUntil(decodeRan);
+    SC_CHECK(decodeRan.load());
+  }
+}
+
+int main()
+{
+  testPartition();
+  if (!jobs().init(1))
+    return 1;
+  testJoinSkipsAsyncWork();
+  jobs().shutdown();
+  return SC_TEST_RESULT();
+}
@@ -0,0 +1,82 @@
+#include "sc_frame_ring.h"
+#include "sc_test.h"
+
+using namespace sc;
+
+namespace
+{
+  void testWrapSkipsToStart()
+  {
+    FrameRing ring;
+    SC_CHECK(ring.init(256, 2));
+
+    ring.beginFrame(0);
+    SC_CHECK(ring.allocate(96, 16) == 0u);
+    ring.beginFrame(1);
+    SC_CHECK(ring.allocate(96, 16) == 96u);
+
+    // Frame 0 has retired; 112 bytes would cross the end, so it starts at 0.
+    ring.beginFrame(2);
+    SC_CHECK(ring.allocate(64, 16) == 192u);
+    SC_CHECK(ring.allocate(80, 16) == 0u);
+    SC_CHECK(ring.stats().frameOverflows == 0u);
+  }
+
+  void testEmptyRingUsesFullCapacity()
+  {
+    FrameRing ring;
+    SC_CHECK(ring.init(256, 2));
+
+    ring.beginFrame(0);
+    SC_CHECK(ring.allocate(96, 16) == 0u);
+    ring.beginFrame(1);
+    ring.beginFrame(2);
+    SC_CHECK(ring.stats().inFlightBytes == 0u);
+
+    SC_CHECK(ring.allocate(200, 16) == 0u);
+    SC_CHECK(ring.stats().frameOverflows == 0u);
+    SC_CHECK(ring.stats().frameBytes == 200u);
+  }
+
+  void testExactFit()
+  {
+    FrameRing ring;
+    SC_CHECK(ring.init(256, 2));
+
+    ring.beginFrame(0);
+    SC_CHECK(ring.allocate(256, 16) == 0u);
+    SC_CHECK(ring.allocate(1, 1) == FrameRing::kInvalidOffset);
+
+    ring.beginFrame(1);
+    ring.beginFrame(2);
+    SC_CHECK(ring.allocate(128, 16) == 0u);
+    SC_CHECK(ring.allocate(128, 16) == 128u);
+    SC_CHECK(ring.stats().inFlightBytes == 256u);
+  }
+
+  void testOverCapacityFails()
+  {
+    FrameRing ring;
+    SC_CHECK(ring.init(256, 2));
+
+    ring.beginFrame(0);
+    SC_CHECK(ring.allocate(257, 1) == FrameRing::kInvalidOffset);
+    SC_CHECK(ring.stats().frameOverflows == 1u);
+    SC_CHECK(ring.stats().frameOverflowBytes == 257u);
+
+    // Space still held by an in-flight frame is not handed out again.
+    SC_CHECK(ring.allocate(200, 16) == 0u);
+    ring.beginFrame(1);
+    SC_CHECK(ring.allocate(100, 16) == FrameRing::kInvalidOffset);
+    SC_CHECK(ring.stats().totalOverflows == 2u);
+  }
+}
+
+int main()
+{
+  testWrapSkipsToStart();
+  testEmptyRingUsesFullCapacity();
+  testExactFit();
+  testOverCapacityFails();
+  return SC_TEST_RESULT();
+}
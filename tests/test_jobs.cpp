@@ -0,0 +1,191 @@
+#include "sc_jobs.h"
+#include "sc_test.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace sc;
+
+namespace
+{
+  void waitUntil(const std::atomic<bool>& flag)
+  {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!flag.load(std::memory_order_acquire) && std::chrono::steady_clock::now() < deadline)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  void testWaitDoesNotRunAsyncJobs()
+  {
+    JobSystem js;
+    SC_CHECK(js.init(1));
+
+    // Park the only worker inside an async job.
+    std::atomic<bool> workerParked{ false };
+    std::atomic<bool> releaseWorker{ false };
+    js.DispatchAsync([&](const JobContext&)
+    {
+      workerParked.store(true, std::memory_order_release);
+      waitUntil(releaseWorker);
+    });
+    waitUntil(workerParked);
+    SC_CHECK(workerParked.load());
+
+    const std::thread::id mainThread = std::this_thread::get_id();
+    std::atomic<bool> asyncRan{ false };
+    std::atomic<bool> asyncOnMain{ false };
+    js.DispatchAsync([&](const JobContext&)
+    {
+      asyncOnMain.store(std::this_thread::get_id() == mainThread, std::memory_order_relaxed);
+      asyncRan.store(true, std::memory_order_release);
+    });
+
+    // The worker is busy, so the frame job can only finish by the main thread helping.
+    std::atomic<uint32_t> frameRuns{ 0 };
+    JobHandle handle = js.Dispatch(1, 1, [&](const JobContext&)
+    {
+      frameRuns.fetch_add(1, std::memory_order_relaxed);
+    });
+    js.Wait(handle);
+    SC_CHECK(frameRuns.load() == 1u);
+    SC_CHECK(!asyncRan.load());
+
+    releaseWorker.store(true, std::memory_order_release);
+    waitUntil(asyncRan);
+    SC_CHECK(asyncRan.load());
+    SC_CHECK(!asyncOnMain.load());
+
+    js.shutdown();
+  }
+
+  void testFrameJobsRunBeforeQueuedAsyncWork()
+  {
+    JobSystem js;
+    SC_CHECK(js.init(1));
+
+    std::atomic<bool> workerParked{ false };
+    std::atomic<bool> releaseWorker{ false };
+    js.DispatchAsync([&](const JobContext&)
+    {
+      workerParked.store(true, std::memory_order_release);
+      waitUntil(releaseWorker);
+    });
+    waitUntil(workerParked);
+
+    // Queued in the opposite order of how the worker should pick them up.
+    std::atomic<uint32_t> order{ 0 };
+    std::atomic<uint32_t> asyncSlot{ 0 };
+    std::atomic<uint32_t> frameSlot{ 0 };
+    std::atomic<bool> asyncDone{ false };
+    js.DispatchAsync([&](const JobContext&)
+    {
+      asyncSlot.store(++order, std::memory_order_relaxed);
+      asyncDone.store(true, std::memory_order_release);
+    });
+    JobHandle handle = js.Dispatch(1, 1, [&](const JobContext&)
+    {
+      frameSlot.store(++order, std::memory_order_relaxed);
+    });
+
+    // Poll instead of helping so the worker alone picks the order.
+    releaseWorker.store(true, std::memory_order_release);
+    waitUntil(asyncDone);
+    js.Wait(handle);
+    SC_CHECK(frameSlot.load() == 1u);
+    SC_CHECK(asyncSlot.load() == 2u);
+
+    js.shutdown();
+  }
+
+  // Job payloads come from one frame arena, and systems running on workers
+  // dispatch nested jobs, so allocation has to hold up under contention.
+  void testFrameArenaAllocatesConcurrently()
+  {
+    constexpr uint32_t kThreads = 8;
+    constexpr uint32_t kAllocs = 4000;
+    LinearFrameAllocator arena;
+    SC_CHECK(arena.init(kThreads * kAllocs * 16, MemTag::Jobs));
+
+    std::vector<uint32_t*> blocks(kThreads * kAllocs, nullptr);
+    std::vector<std::thread> threads;
+    std::atomic<uint32_t> ready{ 0 };
+    for (uint32_t t = 0; t < kThreads; ++t)
+    {
+      threads.emplace_back([&, t]()
+      {
+        // Start together so the allocations actually overlap.
+        ready.fetch_add(1, std::memory_order_acq_rel);
+        while (ready.load(std::memory_order_acquire) < kThreads)
+          std::this_thread::yield();
+        for (uint32_t i = 0; i < kAllocs; ++i)
+        {
+          auto* p = static_cast<uint32_t*>(arena.allocate(16, 16, MemTag::Jobs));
+          if (p)
+            p[0] = p[1] = p[2] = p[3] = t * kAllocs + i;
+          blocks[t * kAllocs + i] = p;
+        }
+      });
+    }
+    for (std::thread& thread : threads)
+      thread.join();
+
+    uint32_t intact = 0;
+    for (uint32_t i = 0; i < kThreads * kAllocs; ++i)
+    {
+      const uint32_t* p = blocks[i];
+      intact += (p && p[0] == i && p[1] == i && p[2] == i && p[3] == i) ? 1u : 0u;
+    }
+    SC_CHECK(intact == kThreads * kAllocs);
+    SC_CHECK(arena.used() == arena.capacity());
+    SC_CHECK(arena.allocate(16, 16, MemTag::Jobs) == nullptr);
+
+    arena.reset();
+    SC_CHECK(arena.used() == 0u);
+    arena.shutdown();
+  }
+
+  void testNestedDispatchFromWorkers()
+  {
+    JobSystem js;
+    SC_CHECK(js.init(4));
+
+    constexpr uint32_t kOuter = 32;
+    constexpr uint32_t kInner = 16;
+    constexpr uint32_t kRounds = 20;
+    std::vector<std::atomic<uint64_t>> sums(kOuter);
+    for (uint32_t round = 0; round < kRounds; ++round)
+    {
+      JobHandle outer = js.Dispatch(kOuter, 1, [&](const JobContext& octx)
+      {
+        // Captured by value, so a payload overwritten by another thread's
+        // dispatch shows up as a wrong sum.
+        const uint64_t tag = octx.groupIndex + 1;
+        JobHandle inner = js.Dispatch(kInner, 1, [&sums, tag](const JobContext& ictx)
+        {
+          sums[tag - 1].fetch_add(tag * (ictx.start + 1), std::memory_order_relaxed);
+        });
+        js.Wait(inner);
+      });
+      js.Wait(outer);
+      js.publishFrameTelemetry();
+    }
+
+    uint32_t correct = 0;
+    for (uint32_t i = 0; i < kOuter; ++i)
+      correct += sums[i].load() == uint64_t(kRounds) * (i + 1) * (kInner * (kInner + 1) / 2) ? 1u : 0u;
+    SC_CHECK(correct == kOuter);
+
+    js.shutdown();
+  }
+}
+
+int main()
+{
+  testWaitDoesNotRunAsyncJobs();
+  testFrameJobsRunBeforeQueuedAsyncWork();
+  testFrameArenaAllocatesConcurrently();
+  testNestedDispatchFromWorkers();
+  return SC_TEST_RESULT();
+}
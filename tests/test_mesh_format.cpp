@@ -0,0 +1,154 @@
+#include "mesh_fixtures.h"
+#include "mesh_format.h"
+#include "mesh_quantize.h"
+#include "sc_test.h"
+
+#include <cmath>
+#include <filesystem>
+#include <string>
+
+using namespace sc_import;
+
+namespace
+{
+  CookedMesh makeCookedMesh(bool packed)
+  {
+    CookedMesh mesh{};
+    mesh.key.sourceHash = 0x1234567890ABCDEFull;
+    mesh.key.sourceSize = 4096;
+    mesh.key.settingsHash = 42;
+    mesh.packedVertices = packed;
+    // The finest LOD needs 32-bit indices; the rest fit in 16 bits.
+    mesh.lods.push_back(sc_test::makeSphere(256, 320, 3.0f));
+    mesh.lods.push_back(sc_test::makeSphere(24, 48, 3.0f));
+    mesh.lods.push_back(sc_test::makeSphere(8, 16, 3.0f));
+    mesh.lodScreenSizes = { 1.0f, 0.25f, 0.05f };
+
+    ImportedMaterial material{};
+    material.name = "body";
+    material.baseColorTexture = "textures/body.png";
+    mesh.materials.push_back(material);
+    return mesh;
+  }
+
+  std::string tempPath(const char* name)
+  {
+    return (std::filesystem::temp_directory_path() / name).string();
+  }
+
+  void checkSameTopology(const CookedMesh& a, const CookedMesh& b)
+  {
+    SC_CHECK(a.key.sourceHash == b.key.sourceHash);
+    SC_CHECK(a.key.sourceSize == b.key.sourceSize);
+    SC_CHECK(a.key.settingsHash == b.key.settingsHash);
+    SC_CHECK(a.packedVertices == b.packedVertices);
+    SC_CHECK(a.lodScreenSizes == b.lodScreenSizes);
+    SC_CHECK(a.materials.size() == b.materials.size());
+    if (!a.materials.empty() && !b.materials.empty())
+    {
+      SC_CHECK(a.materials[0].name == b.materials[0].name);
+      SC_CHECK(a.materials[0].baseColorTexture == b.materials[0].baseColorTexture);
+    }
+
+    SC_CHECK(a.lods.size() == b.lods.size());
+    for (size_t i = 0; i < a.lods.size() && i < b.lods.size(); ++i)
+    {
+      const MeshData& x = a.lods[i];
+      const MeshData& y = b.lods[i];
+      SC_CHECK(x.vertices.size() == y.vertices.size());
+      SC_CHECK(x.indices == y.indices);
+      SC_CHECK(x.vertexLayoutFlags == y.vertexLayoutFlags);
+      SC_CHECK(x.submeshes.size() == y.submeshes.size());
+      for (int axis = 0; axis < 3; ++axis)
+      {
+        SC_CHECK(x.bounds.min[axis] == y.bounds.min[axis]);
+        SC_CHECK(x.bounds.max[axis] == y.bounds.max[axis]);
+      }
+    }
+  }
+
+  void testPackedRoundTrip()
+  {
+    const CookedMesh source = makeCookedMesh(true);
+    SC_CHECK(source.lods[0].vertices.size() > 65535u);
+
+    const std::string path = tempPath("sc_test_packed.scmesh");
+    SC_CHECK(WriteCookedMesh(path.c_str(), source));
+
+    CookedMesh loaded{};
+    SC_CHECK(ReadCookedMesh(path.c_str(), &loaded));
+    checkSameTopology(source, loaded);
+    SC_CHECK(loaded.packedVertices);
+
+    // Every decoded vertex stays within what packing against its LOD bounds allows.
+    for (size_t i = 0; i < source.lods.size() && i < loaded.lods.size(); ++i)
+    {
+      const MeshData& lod = source.lods[i];
+      const MeshQuantizationError bound = MeasureMeshQuantization(lod);
+      for (size_t v = 0; v < lod.vertices.size() && v < loaded.lods[i].vertices.size(); ++v)
+      {
+        const MeshVertex& a = lod.vertices[v];
+        const MeshVertex& b = loaded.lods[i].vertices[v];
+        for (int axis = 0; axis < 3; ++axis)
+          SC_CHECK(std::fabs(a.pos[axis] - b.pos[axis]) <= bound.position);
+        for (int k = 0; k < 2; ++k)
+          SC_CHECK(std::fabs(a.uv0[k] - b.uv0[k]) <= bound.uv);
+      }
+    }
+
+    // Packing saves exactly 16 bytes per vertex on disk; everything else is identical.
+    const std::string floatPath = tempPath("sc_test_float.scmesh");
+    SC_CHECK(WriteCookedMesh(floatPath.c_str(), makeCookedMesh(false)));
+    uint64_t vertexCount = 0;
+    for (const MeshData& lod : source.lods)
+      vertexCount += lod.vertices.size();
+    const uint64_t packedSize = std::filesystem::file_size(path);
+    const uint64_t floatSize = std::filesystem::file_size(floatPath);
+    SC_CHECK(floatSize - packedSize == vertexCount * (sizeof(MeshVertex) - sizeof(PackedMeshVertex)));
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(floatPath);
+  }
+
+  void testFloatRoundTripIsExact()
+  {
+    const CookedMesh source = makeCookedMesh(false);
+    const std::string path = tempPath("sc_test_exact.scmesh");
+    SC_CHECK(WriteCookedMesh(path.c_str(), source));
+
+    CookedMesh loaded{};
+    SC_CHECK(ReadCookedMesh(path.c_str(), &loaded));
+    checkSameTopology(source, loaded);
+    for (size_t i = 0; i < source.lods.size() && i < loaded.lods.size(); ++i)
+    {
+      for (size_t v = 0; v < source.lods[i].vertices.size() && v < loaded.lods[i].vertices.size(); ++v)
+      {
+        const MeshVertex& a = source.lods[i].vertices[v];
+        const MeshVertex& b = loaded.lods[i].vertices[v];
+        SC_CHECK(a.pos[0] == b.pos[0] && a.pos[1] == b.pos[1] && a.pos[2] == b.pos[2]);
+        SC_CHECK(a.uv0[0] == b.uv0[0] && a.uv0[1] == b.uv0[1]);
+      }
+    }
+    std::filesystem::remove(path);
+  }
+
+  void testRejectsTruncated()
+  {
+    const CookedMesh source = makeCookedMesh(true);
+    const std::string path = tempPath("sc_test_truncated.scmesh");
+    SC_CHECK(WriteCookedMesh(path.c_str(), source));
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 7);
+
+    CookedMesh loaded{};
+    SC_CHECK(!ReadCookedMesh(path.c_str(), &loaded));
+    std::filesystem::remove(path);
+  }
+}
+
+int main()
+{
+  testPackedRoundTrip();
+  testFloatRoundTripIsExact();
+  testRejectsTruncated();
+  return SC_TEST_RESULT();
+}
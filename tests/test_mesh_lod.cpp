@@ -0,0 +1,102 @@
+#include "sc_ecs.h"
+#include "sc_math.h"
+#include "sc_test.h"
+
+#include <cmath>
+
+using namespace sc;
+
+namespace
+{
+  // Camera at the origin looking down -Z; a unit sphere placed at distance d.
+  float screenSizeAt(const Mat4& viewProj, float distance)
+  {
+    const float center[3] = { 0.0f, 0.0f, -distance };
+    return projectedSphereSize(viewProj, projectedSizeScale(viewProj), center, 1.0f);
+  }
+
+  uint32_t settle(const MeshLodSet& set, float screenSize, uint32_t lod)
+  {
+    // A few frames at the same size must reach a fixed point.
+    for (int i = 0; i < 4; ++i)
+      lod = selectMeshLod(set, screenSize, lod, 0.1f);
+    return lod;
+  }
+
+  void testScreenSizeShrinksWithDistance(const Mat4& viewProj)
+  {
+    const float nearSize = screenSizeAt(viewProj, 5.0f);
+    const float farSize = screenSizeAt(viewProj, 50.0f);
+    SC_CHECK(nearSize > farSize);
+    SC_CHECK(farSize > 0.0f);
+    // Diameter over viewport height at 60 degrees: 2r / (2 d tan(30deg)).
+    SC_CHECK(std::fabs(farSize - 1.0f / (50.0f * std::tan(0.5236f))) < 1.0e-3f);
+    // Touching the camera plane keeps the finest LOD.
+    SC_CHECK(screenSizeAt(viewProj, 0.5f) >= 1.0f);
+  }
+
+  void testLodFollowsDistance(const Mat4& viewProj)
+  {
+    MeshLodSet set{};
+    set.lodCount = 4;
+    set.meshIds[0] = 10;
+    set.meshIds[1] = 11;
+    set.meshIds[2] = 12;
+    set.meshIds[3] = 13;
+
+    uint32_t lod = 0;
+    uint32_t previous = 0;
+    bool changed = false;
+    for (float d = 2.0f; d < 200.0f; d += 1.0f)
+    {
+      lod = settle(set, screenSizeAt(viewProj, d), lod);
+      SC_CHECK(lod >= previous);
+      changed |= lod != previous;
+      previous = lod;
+    }
+    SC_CHECK(changed);
+    SC_CHECK(lod == 3u);
+
+    // Walking back in returns to LOD 0.
+    for (float d = 200.0f; d >= 2.0f; d -= 1.0f)
+    {
+      lod = settle(set, screenSizeAt(viewProj, d), lod);
+      SC_CHECK(lod <= previous);
+      previous = lod;
+    }
+    SC_CHECK(lod == 0u);
+  }
+
+  void testHysteresis()
+  {
+    MeshLodSet set{};
+    set.lodCount = 2;
+
+    // 0.24 is below the 0.25 threshold but inside the 10% band: no switch.
+    SC_CHECK(selectMeshLod(set, 0.24f, 0, 0.1f) == 0u);
+    SC_CHECK(selectMeshLod(set, 0.20f, 0, 0.1f) == 1u);
+    // Going back needs the size to clear the band above the threshold.
+    SC_CHECK(selectMeshLod(set, 0.26f, 1, 0.1f) == 1u);
+    SC_CHECK(selectMeshLod(set, 0.30f, 1, 0.1f) == 0u);
+  }
+
+  void testSingleLod()
+  {
+    MeshLodSet set{};
+    set.lodCount = 1;
+    SC_CHECK(selectMeshLod(set, 0.001f, 0, 0.1f) == 0u);
+    // A stale index from a larger set is clamped.
+    set.lodCount = 2;
+    SC_CHECK(selectMeshLod(set, 0.001f, 3, 0.1f) == 1u);
+  }
+}
+
+int main()
+{
+  const Mat4 viewProj = mat4_perspective_rh_zo(1.0472f, 16.0f / 9.0f, 0.1f, 1000.0f, true);
+  testScreenSizeShrinksWithDistance(viewProj);
+  testLodFollowsDistance(viewProj);
+  testHysteresis();
+  testSingleLod();
+  return SC_TEST_RESULT();
+}
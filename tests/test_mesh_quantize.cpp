@@ -0,0 +1,114 @@
+#include "mesh_fixtures.h"
+#include "mesh_quantize.h"
+#include "sc_test.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace sc_import;
+
+namespace
+{
+  static constexpr float kMaxNormalDegrees = 0.02f;
+
+  // Half-step of unorm16 across the bounds on each axis, plus float slack.
+  float positionTolerance(const MeshBounds& bounds, int axis)
+  {
+    const float extent = bounds.max[axis] - bounds.min[axis];
+    return 0.5f * extent / 65535.0f + 1.0e-6f * std::max(1.0f, std::fabs(bounds.max[axis]));
+  }
+
+  // Half a half-float ulp: 11 significant bits.
+  float uvTolerance(float value)
+  {
+    return std::max(std::fabs(value), 6.1035e-5f) * (1.0f / 2048.0f);
+  }
+
+  // atan2 of |cross| and dot stays accurate for tiny angles, where acos does not.
+  float angleDegrees(const float a[3], const float b[3])
+  {
+    const double cx = double(a[1]) * b[2] - double(a[2]) * b[1];
+    const double cy = double(a[2]) * b[0] - double(a[0]) * b[2];
+    const double cz = double(a[0]) * b[1] - double(a[1]) * b[0];
+    const double dot = double(a[0]) * b[0] + double(a[1]) * b[1] + double(a[2]) * b[2];
+    return static_cast<float>(std::atan2(std::sqrt(cx * cx + cy * cy + cz * cz), dot) * (180.0 / 3.14159265358979));
+  }
+
+  void testVertexErrorBoundedByBounds()
+  {
+    const MeshData mesh = sc_test::makeSphere(48, 96, 7.25f);
+    for (const MeshVertex& src : mesh.vertices)
+    {
+      const MeshVertex decoded = UnpackMeshVertex(PackMeshVertex(src, mesh.bounds), mesh.bounds);
+      for (int axis = 0; axis < 3; ++axis)
+      {
+        SC_CHECK(decoded.pos[axis] >= mesh.bounds.min[axis] - positionTolerance(mesh.bounds, axis));
+        SC_CHECK(decoded.pos[axis] <= mesh.bounds.max[axis] + positionTolerance(mesh.bounds, axis));
+        SC_CHECK(std::fabs(decoded.pos[axis] - src.pos[axis]) <= positionTolerance(mesh.bounds, axis));
+      }
+      SC_CHECK(angleDegrees(decoded.normal, src.normal) <= kMaxNormalDegrees);
+      for (int k = 0; k < 2; ++k)
+        SC_CHECK(std::fabs(decoded.uv0[k] - src.uv0[k]) <= uvTolerance(src.uv0[k]));
+    }
+
+    const MeshQuantizationError error = MeasureMeshQuantization(mesh);
+    float maxPositionTolerance = 0.0f;
+    for (int axis = 0; axis < 3; ++axis)
+      maxPositionTolerance = std::max(maxPositionTolerance, positionTolerance(mesh.bounds, axis));
+    SC_CHECK(error.position <= maxPositionTolerance);
+    SC_CHECK(error.normalDegrees <= kMaxNormalDegrees);
+    SC_CHECK(error.uv <= uvTolerance(1.0f));
+  }
+
+  void testFlatAxis()
+  {
+    // A plane has zero extent on one axis; that axis must decode exactly.
+    MeshData mesh{};
+    for (int i = 0; i < 4; ++i)
+    {
+      MeshVertex v{};
+      v.pos[0] = (i & 1) ? 3.0f : -3.0f;
+      v.pos[1] = 2.5f;
+      v.pos[2] = (i & 2) ? 1.0f : -1.0f;
+      mesh.vertices.push_back(v);
+    }
+    ComputeMeshBounds(&mesh);
+    for (const MeshVertex& src : mesh.vertices)
+    {
+      const MeshVertex decoded = UnpackMeshVertex(PackMeshVertex(src, mesh.bounds), mesh.bounds);
+      SC_CHECK(decoded.pos[1] == 2.5f);
+      SC_CHECK(std::fabs(decoded.pos[0] - src.pos[0]) <= positionTolerance(mesh.bounds, 0));
+    }
+  }
+
+  void testHalfFloat()
+  {
+    const float exact[] = { 0.0f, 1.0f, -2.0f, 0.5f, 65504.0f, 6.1035156e-05f };
+    for (float value : exact)
+      SC_CHECK(HalfToFloat(FloatToHalf(value)) == value);
+    SC_CHECK(std::isinf(HalfToFloat(FloatToHalf(70000.0f))));
+    SC_CHECK(std::isnan(HalfToFloat(FloatToHalf(std::nanf("")))));
+  }
+
+  void testOctahedralAxes()
+  {
+    const float axes[6][3] = { { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 } };
+    for (const auto& axis : axes)
+    {
+      int16_t encoded[2]{};
+      float decoded[3]{};
+      EncodeOctahedralNormal(axis, encoded);
+      DecodeOctahedralNormal(encoded, decoded);
+      SC_CHECK(angleDegrees(axis, decoded) <= kMaxNormalDegrees);
+    }
+  }
+}
+
+int main()
+{
+  testVertexErrorBoundedByBounds();
+  testFlatAxis();
+  testHalfFloat();
+  testOctahedralAxes();
+  return SC_TEST_RESULT();
+}
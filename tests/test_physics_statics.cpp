@@ -0,0 +1,223 @@
+#include "sc_physics.h"
+#include "sc_test.h"
+#include "sc_world_partition.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace sc;
+
+namespace
+{
+  Entity makeEntity(uint32_t value)
+  {
+    Entity e{};
+    e.value = value;
+    return e;
+  }
+
+  Transform at(float x, float y, float z)
+  {
+    Transform tr{};
+    tr.localPos[0] = x;
+    tr.localPos[1] = y;
+    tr.localPos[2] = z;
+    return tr;
+  }
+
+  Collider box(float hx, float hy, float hz)
+  {
+    Collider col{};
+    col.type = ColliderType::Box;
+    col.halfExtents[0] = hx;
+    col.halfExtents[1] = hy;
+    col.halfExtents[2] = hz;
+    return col;
+  }
+
+  RaycastHit castDown(const PhysicsWorld& physics, float x, float z)
+  {
+    const float origin[3] = { x, 20.0f, z };
+    const float dir[3] = { 0.0f, -1.0f, 0.0f };
+    return physics.raycast(origin, dir, 40.0f, 0xFFFFFFFFu);
+  }
+
+  bool near(float a, float b)
+  {
+    return std::fabs(a - b) < 1e-3f;
+  }
+
+  void testShapeCacheSharesAndRefcounts()
+  {
+    PhysicsWorld physics;
+    SC_CHECK(physics.init());
+
+    // Ten identical boxes share one shape.
+    std::vector<PhysicsBodyHandle> same;
+    for (uint32_t i = 0; i < 10; ++i)
+      same.push_back(physics.addStaticCollider(makeEntity(i + 1), at(i * 4.0f, 0.0f, 0.0f), box(1.0f, 1.0f, 1.0f)));
+    physics.step(1.0f / 60.0f);
+    SC_CHECK(physics.stats().cachedShapes == 1u);
+    SC_CHECK(physics.stats().staticColliders == 10u);
+
+    // Different extents make a new shape; a scaled unit box with the same
+    // scaled dimensions reuses it.
+    const PhysicsBodyHandle wide = physics.addStaticCollider(makeEntity(20), at(0.0f, 0.0f, 10.0f), box(2.0f, 1.0f, 1.0f));
+    Transform scaled = at(10.0f, 0.0f, 10.0f);
+    scaled.localScale[0] = 2.0f;
+    const PhysicsBodyHandle stretched = physics.addStaticCollider(makeEntity(21), scaled, box(1.0f, 1.0f, 1.0f));
+    physics.step(1.0f / 60.0f);
+    SC_CHECK(physics.stats().cachedShapes == 2u);
+
+    const RaycastHit hit = castDown(physics, 11.8f, 10.0f);
+    SC_CHECK(hit.hit && hit.entity.value == 21u);
+
+    // The shared shape lives until its last user goes.
+    for (size_t i = 0; i + 1 < same.size(); ++i)
+      physics.removeStaticCollider(same[i]);
+    physics.step(1.0f / 60.0f);
+    SC_CHECK(physics.stats().cachedShapes == 2u);
+    physics.removeStaticCollider(same.back());
+    physics.step(1.0f / 60.0f);
+    SC_CHECK(physics.stats().cachedShapes == 1u);
+
+    physics.removeStaticCollider(wide);
+    physics.step(1.0f / 60.0f);
+    SC_CHECK(physics.stats().cachedShapes == 1u);
+    physics.removeStaticCollider(stretched);
+    physics.step(1.0f / 60.0f);
+    SC_CHECK(physics.stats().cachedShapes == 0u);
+    SC_CHECK(physics.stats().staticColliders == 0u);
+    physics.shutdown();
+  }
+
+  void testCompoundChildTransforms()
+  {
+    PhysicsWorld physics;
+    SC_CHECK(physics.init());
+
+    std::vector<StaticColliderDesc> children(3);
+    children[0] = { makeEntity(1), at(0.0f, 1.0f, 0.0f), box(1.0f, 1.0f, 1.0f) };
+    children[1] = { makeEntity(2), at(10.0f, 2.0f, 0.0f), box(1.0f, 1.0f, 1.0f) };
+    // Long along X, turned a quarter about Y so it runs along Z.
+    children[2] = { makeEntity(3), at(20.0f, 0.5f, 0.0f), box(3.0f, 0.5f, 0.5f) };
+    children[2].transform.localRot[1] = 1.5707964f;
+
+    RigidBody material{};
+    material.type = RigidBodyType::Static;
+    const PhysicsBodyHandle handle = physics.addStaticCompound(children, material);
+    SC_CHECK(handle.valid());
+    physics.step(1.0f / 60.0f);
+    SC_CHECK(physics.stats().staticColliders == 1u);
+    // Children 0 and 1 share a shape.
+    SC_CHECK(physics.stats().cachedShapes == 2u);
+
+    RaycastHit hit = castDown(physics, 0.0f, 0.0f);
+    SC_CHECK(hit.hit && hit.entity.value == 1u && near(hit.position[1], 2.0f));
+    hit = castDown(physics, 10.0f, 0.0f);
+    SC_CHECK(hit.hit && hit.entity.value == 2u && near(hit.position[1], 3.0f));
+    hit = castDown(physics, 20.0f, 2.5f);
+    SC_CHECK(hit.hit && hit.entity.value == 3u && near(hit.position[1], 1.0f));
+    hit = castDown(physics, 22.5f, 0.0f);
+    SC_CHECK(!hit.hit);
+
+    // Removing a child keeps the others, and their entities, resolvable.
+    const Entity first = makeEntity(1);
+    physics.removeStaticCompoundChildren(handle, { &first, 1 });
+    SC_CHECK(physics.isBodyInWorld(handle));
+    SC_CHECK(!castDown(physics, 0.0f, 0.0f).hit);
+    hit = castDown(physics, 20.0f, -2.5f);
+    SC_CHECK(hit.hit && hit.entity.value == 3u);
+    hit = castDown(physics, 10.0f, 0.0f);
+    SC_CHECK(hit.hit && hit.entity.value == 2u);
+
+    const Entity rest[2] = { makeEntity(2), makeEntity(3) };
+    physics.removeStaticCompoundChildren(handle, rest);
+    physics.step(1.0f / 60.0f);
+    SC_CHECK(!physics.isBodyInWorld(handle));
+    SC_CHECK(physics.stats().staticColliders == 0u);
+    SC_CHECK(physics.stats().cachedShapes == 0u);
+    physics.shutdown();
+  }
+
+  Entity spawnStatic(World& world, SectorCoord sector, const Transform& tr, const Collider& col)
+  {
+    const Entity e = world.create();
+    world.add<Transform>(e) = tr;
+    RigidBody& rb = world.add<RigidBody>(e);
+    rb.type = RigidBodyType::Static;
+    rb.mass = 0.0f;
+    world.add<Collider>(e) = col;
+    world.add<WorldSector>(e).coord = sector;
+    return e;
+  }
+
+  void testSectorUnloadRemovesCompound()
+  {
+    World world;
+    PhysicsWorld physics;
+    SC_CHECK(physics.init());
+    PhysicsSyncState sync{};
+    sync.world = &physics;
+    sync.mergeSectorStatics = true;
+
+    std::vector<Entity> sectorA;
+    std::vector<Entity> sectorB;
+    for (uint32_t i = 0; i < 8; ++i)
+    {
+      sectorA.push_back(spawnStatic(world, SectorCoord{ 0, 0 }, at(i * 4.0f, 0.0f, 0.0f), box(1.0f, 1.0f, 1.0f)));
+      sectorB.push_back(spawnStatic(world, SectorCoord{ 1, 0 }, at(i * 4.0f, 0.0f, 50.0f), box(1.0f, 2.0f, 1.0f)));
+    }
+    PhysicsSyncSystem(world, 1.0f / 60.0f, &sync);
+
+    // One body per sector, shared by all of its entities.
+    const PhysicsBodyHandle* handleA = world.get<PhysicsBodyHandle>(sectorA[0]);
+    const PhysicsBodyHandle* handleB = world.get<PhysicsBodyHandle>(sectorB[0]);
+    SC_CHECK(handleA && handleB && handleA->id != handleB->id);
+    const PhysicsBodyHandle bodyA = *handleA;
+    const PhysicsBodyHandle bodyB = *handleB;
+    for (Entity e : sectorA)
+      SC_CHECK(world.get<PhysicsBodyHandle>(e) && world.get<PhysicsBodyHandle>(e)->id == bodyA.id);
+    SC_CHECK(physics.stats().staticColliders == 2u);
+    SC_CHECK(physics.stats().cachedShapes == 2u);
+
+    RaycastHit hit = castDown(physics, 12.0f, 0.0f);
+    SC_CHECK(hit.hit && hit.entity.value == sectorA[3].value);
+
+    // A single prop going away leaves the rest of the sector in place.
+    world.destroy(sectorA[3]);
+    PhysicsSyncSystem(world, 1.0f / 60.0f, &sync);
+    SC_CHECK(!castDown(physics, 12.0f, 0.0f).hit);
+    hit = castDown(physics, 16.0f, 0.0f);
+    SC_CHECK(hit.hit && hit.entity.value == sectorA[4].value);
+    SC_CHECK(physics.isBodyInWorld(bodyA));
+
+    // Unloading the sector drops its whole compound in one frame.
+    for (Entity e : sectorA)
+      world.destroy(e);
+    PhysicsSyncSystem(world, 1.0f / 60.0f, &sync);
+    SC_CHECK(!physics.isBodyInWorld(bodyA));
+    SC_CHECK(physics.isBodyInWorld(bodyB));
+    SC_CHECK(physics.stats().staticColliders == 1u);
+    SC_CHECK(physics.stats().cachedShapes == 1u);
+    SC_CHECK(!castDown(physics, 16.0f, 0.0f).hit);
+    hit = castDown(physics, 16.0f, 50.0f);
+    SC_CHECK(hit.hit && hit.entity.value == sectorB[4].value);
+
+    for (Entity e : sectorB)
+      world.destroy(e);
+    PhysicsSyncSystem(world, 1.0f / 60.0f, &sync);
+    SC_CHECK(!physics.isBodyInWorld(bodyB));
+    SC_CHECK(physics.stats().cachedShapes == 0u);
+    SC_CHECK(sync.tracked.empty());
+    physics.shutdown();
+  }
+}
+
+int main()
+{
+  testShapeCacheSharesAndRefcounts();
+  testCompoundChildTransforms();
+  testSectorUnloadRemovesCompound();
+  return SC_TEST_RESULT();
+}
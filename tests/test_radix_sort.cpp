@@ -0,0 +1,113 @@
+#include "sc_jobs.h"
+#include "sc_radix_sort.h"
+#include "sc_test.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace sc;
+
+namespace
+{
+  // index records the input position, so comparing indices checks stability too.
+  std::vector<SortKeyIndex> makeItems(uint32_t count, uint64_t keyMask, uint32_t seed)
+  {
+    std::mt19937_64 rng(seed);
+    std::vector<SortKeyIndex> items(count);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      items[i].key = rng() & keyMask;
+      items[i].index = i;
+    }
+    return items;
+  }
+
+  bool sortsLikeStableSort(std::vector<SortKeyIndex> items, uint32_t parallelThreshold, RadixSortStats* outStats = nullptr)
+  {
+    std::vector<SortKeyIndex> expected = items;
+    std::stable_sort(expected.begin(), expected.end(), [](const SortKeyIndex& a, const SortKeyIndex& b)
+    {
+      return a.key < b.key;
+    });
+
+    std::vector<SortKeyIndex> scratch;
+    const RadixSortStats stats = radixSort(items, scratch, parallelThreshold);
+    if (outStats)
+      *outStats = stats;
+    if (items.size() != expected.size())
+      return false;
+    for (size_t i = 0; i < items.size(); ++i)
+    {
+      if (items[i].key != expected[i].key || items[i].index != expected[i].index)
+        return false;
+    }
+    return true;
+  }
+
+  void testMatchesStableSort()
+  {
+    const uint32_t sizes[] = { 0u, 1u, 2u, 3u, 255u, 4095u, 4096u, 4097u, 20000u, 300000u };
+    for (uint32_t size : sizes)
+    {
+      // Full keys, then narrow ones where most keys repeat.
+      SC_CHECK(sortsLikeStableSort(makeItems(size, ~0ull, size), 4096u));
+      SC_CHECK(sortsLikeStableSort(makeItems(size, 0x3Full, size + 1u), 4096u));
+      // Only the top byte varies: every lower pass is skipped.
+      SC_CHECK(sortsLikeStableSort(makeItems(size, 0xFF00000000000000ull, size + 2u), 4096u));
+    }
+  }
+
+  void testBlockSplitting()
+  {
+    RadixSortStats serial{};
+    RadixSortStats parallel{};
+    SC_CHECK(sortsLikeStableSort(makeItems(20000u, ~0ull, 7u), 4096u, &parallel));
+    SC_CHECK(sortsLikeStableSort(makeItems(20000u, ~0ull, 7u), 0xFFFFFFFFu, &serial));
+    SC_CHECK(parallel.blocks > 1u);
+    SC_CHECK(serial.blocks == 1u);
+    SC_CHECK(parallel.passes == serial.passes);
+  }
+
+  void testAllEqualKeysKeepOrder()
+  {
+    for (uint32_t size : { 10u, 5000u, 100000u })
+    {
+      std::vector<SortKeyIndex> items(size);
+      for (uint32_t i = 0; i < size; ++i)
+      {
+        items[i].key = 0x0123456789ABCDEFull;
+        items[i].index = i;
+      }
+      RadixSortStats stats{};
+      SC_CHECK(sortsLikeStableSort(items, 4096u, &stats));
+      SC_CHECK(stats.passes == 0u);
+      SC_CHECK(stats.passesSkipped == 8u);
+    }
+  }
+
+  // The renderer sorts from whichever thread records; two sorts on workers at
+  // once each dispatch their own block jobs.
+  void testSortsFromWorkers()
+  {
+    bool ok[2] = { false, false };
+    JobHandle handle = jobs().Dispatch(2, 1, [&](const JobContext& ctx)
+    {
+      ok[ctx.groupIndex] = sortsLikeStableSort(makeItems(50000u, 0xFFFFFull, 11u + ctx.groupIndex), 4096u);
+    });
+    jobs().Wait(handle);
+    jobs().publishFrameTelemetry();
+    SC_CHECK(ok[0] && ok[1]);
+  }
+}
+
+int main()
+{
+  SC_CHECK(jobs().init(3));
+  testMatchesStableSort();
+  testBlockSplitting();
+  testAllEqualKeysKeepOrder();
+  testSortsFromWorkers();
+  jobs().shutdown();
+  return SC_TEST_RESULT();
+}
@@ -0,0 +1,165 @@
+#include "sc_range_allocator.h"
+#include "sc_test.h"
+
+#include <random>
+#include <vector>
+
+using namespace sc;
+
+namespace
+{
+  void testBestFitPicksSmallestHole()
+  {
+    RangeAllocator ranges;
+    ranges.init(1000);
+    SC_CHECK(ranges.allocate(100, 1) == 0u);
+    SC_CHECK(ranges.allocate(50, 1) == 100u);
+    SC_CHECK(ranges.allocate(200, 1) == 150u);
+    SC_CHECK(ranges.allocate(30, 1) == 350u);
+
+    // Holes of 100 at 0, 200 at 150 and 620 at the tail.
+    ranges.free(0);
+    ranges.free(150);
+    SC_CHECK(ranges.stats().freeRanges == 3u);
+
+    SC_CHECK(ranges.allocate(90, 1) == 0u);
+    SC_CHECK(ranges.allocate(150, 1) == 150u);
+    SC_CHECK(ranges.allocate(300, 1) == 380u);
+    SC_CHECK(ranges.stats().largestFreeRange == 320u);
+  }
+
+  void testAlignmentPaddingStaysFree()
+  {
+    RangeAllocator ranges;
+    ranges.init(256);
+    SC_CHECK(ranges.allocate(10, 1) == 0u);
+    SC_CHECK(ranges.allocate(16, 64) == 64u);
+
+    // The 54 bytes skipped for alignment are still usable.
+    const RangeAllocatorStats s = ranges.stats();
+    SC_CHECK(s.freeRanges == 2u);
+    SC_CHECK(s.usedBytes == 26u);
+    SC_CHECK(ranges.allocate(54, 1) == 10u);
+  }
+
+  void testFreeCoalescesBothNeighbours()
+  {
+    RangeAllocator ranges;
+    ranges.init(400);
+    SC_CHECK(ranges.allocate(100, 1) == 0u);
+    SC_CHECK(ranges.allocate(100, 1) == 100u);
+    SC_CHECK(ranges.allocate(100, 1) == 200u);
+    SC_CHECK(ranges.allocate(100, 1) == 300u);
+    SC_CHECK(ranges.stats().freeRanges == 0u);
+
+    ranges.free(0);
+    ranges.free(200);
+    SC_CHECK(ranges.stats().freeRanges == 2u);
+    SC_CHECK(ranges.stats().largestFreeRange == 100u);
+
+    // The middle range joins the hole before and after it.
+    ranges.free(100);
+    RangeAllocatorStats s = ranges.stats();
+    SC_CHECK(s.freeRanges == 1u);
+    SC_CHECK(s.largestFreeRange == 300u);
+    SC_CHECK(ranges.allocate(300, 1) == 0u);
+
+    ranges.free(0);
+    ranges.free(300);
+    s = ranges.stats();
+    SC_CHECK(s.freeRanges == 1u);
+    SC_CHECK(s.largestFreeRange == 400u);
+    SC_CHECK(s.usedBytes == 0u);
+    SC_CHECK(s.allocations == 0u);
+  }
+
+  void testFreeThenReallocate()
+  {
+    RangeAllocator ranges;
+    ranges.init(512);
+    const uint64_t a = ranges.allocate(128, 16);
+    const uint64_t b = ranges.allocate(128, 16);
+    SC_CHECK(a == 0u && b == 128u);
+
+    ranges.free(a);
+    SC_CHECK(ranges.allocate(128, 16) == a);
+
+    // Freeing an unknown or already freed offset changes nothing.
+    ranges.free(b);
+    ranges.free(b);
+    ranges.free(7);
+    const RangeAllocatorStats s = ranges.stats();
+    SC_CHECK(s.usedBytes == 128u);
+    SC_CHECK(s.allocations == 1u);
+    SC_CHECK(s.largestFreeRange == 384u);
+  }
+
+  void testOutOfSpace()
+  {
+    RangeAllocator ranges;
+    ranges.init(256);
+    SC_CHECK(ranges.allocate(257, 1) == RangeAllocator::kInvalidOffset);
+    SC_CHECK(ranges.allocate(0, 1) == RangeAllocator::kInvalidOffset);
+    SC_CHECK(ranges.allocate(256, 1) == 0u);
+    SC_CHECK(ranges.allocate(1, 1) == RangeAllocator::kInvalidOffset);
+    SC_CHECK(ranges.stats().failedAllocations == 2u);
+
+    // Enough bytes in total but no single hole fits.
+    ranges.reset();
+    SC_CHECK(ranges.allocate(100, 1) == 0u);
+    SC_CHECK(ranges.allocate(56, 1) == 100u);
+    SC_CHECK(ranges.allocate(100, 1) == 156u);
+    ranges.free(0);
+    ranges.free(156);
+    SC_CHECK(ranges.stats().usedBytes == 56u);
+    SC_CHECK(ranges.allocate(150, 1) == RangeAllocator::kInvalidOffset);
+    SC_CHECK(ranges.stats().failedAllocations == 1u);
+  }
+
+  // The cached largest range must stay exact through splits and merges: a
+  // range of that size fits and one byte more does not.
+  void testLargestFreeRangeStaysExact()
+  {
+    RangeAllocator ranges;
+    ranges.init(1u << 16);
+    std::mt19937 rng(1234);
+    std::vector<uint64_t> live;
+    for (int i = 0; i < 2000; ++i)
+    {
+      if (live.empty() || rng() % 3 != 0)
+      {
+        const uint64_t offset = ranges.allocate(1 + rng() % 2048, 1ull << (rng() % 5));
+        if (offset != RangeAllocator::kInvalidOffset)
+          live.push_back(offset);
+      }
+      else
+      {
+        const size_t pick = rng() % live.size();
+        ranges.free(live[pick]);
+        live[pick] = live.back();
+        live.pop_back();
+      }
+
+      const uint64_t largest = ranges.largestFreeRange();
+      SC_CHECK(ranges.allocate(largest + 1, 1) == RangeAllocator::kInvalidOffset);
+      if (largest > 0)
+      {
+        const uint64_t probe = ranges.allocate(largest, 1);
+        SC_CHECK(probe != RangeAllocator::kInvalidOffset);
+        ranges.free(probe);
+        SC_CHECK(ranges.largestFreeRange() == largest);
+      }
+    }
+  }
+}
+
+int main()
+{
+  testBestFitPicksSmallestHole();
+  testAlignmentPaddingStaysFree();
+  testFreeCoalescesBothNeighbours();
+  testFreeThenReallocate();
+  testOutOfSpace();
+  testLargestFreeRangeStaysExact();
+  return SC_TEST_RESULT();
+}
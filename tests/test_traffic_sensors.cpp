@@ -0,0 +1,155 @@
+#include "sc_jobs.h"
+#include "sc_physics.h"
+#include "sc_test.h"
+#include "sc_traffic_ai.h"
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+using namespace sc;
+
+namespace
+{
+  bool sameHit(const RaycastHit& a, const RaycastHit& b)
+  {
+    return a.hit == b.hit && a.entity.value == b.entity.value && a.distance == b.distance &&
+           std::memcmp(a.position, b.position, sizeof(a.position)) == 0 &&
+           std::memcmp(a.normal, b.normal, sizeof(a.normal)) == 0;
+  }
+
+  struct SensorScene
+  {
+    TrafficLaneGraph lanes;
+    PhysicsWorld physics;
+    std::vector<TrafficAgent> agents;
+    std::vector<Transform> transforms;
+    std::vector<uint32_t> filteredOut; // agents that must not get a ray
+  };
+
+  void buildScene(SensorScene& scene)
+  {
+    AABB active{};
+    active.max = Vec3{ 100.0f, 10.0f, 100.0f };
+    AABB unloaded{};
+    unloaded.min = Vec3{ 100.0f, 0.0f, 0.0f };
+    unloaded.max = Vec3{ 200.0f, 10.0f, 100.0f };
+    scene.lanes.buildProceduralForSector(SectorCoord{ 0, 0 }, active, 1u);
+    scene.lanes.buildProceduralForSector(SectorCoord{ 1, 0 }, unloaded, 2u);
+    scene.lanes.removeSector(SectorCoord{ 1, 0 });
+    const std::vector<uint32_t>* inactiveLanes = scene.lanes.lanesForSector(SectorCoord{ 1, 0 });
+    SC_CHECK(inactiveLanes && !inactiveLanes->empty());
+
+    SC_CHECK(scene.physics.init());
+
+    // A grid of agents facing different ways, with a box in front of every other one.
+    constexpr uint32_t kAgents = 240;
+    for (uint32_t i = 0; i < kAgents; ++i)
+    {
+      Transform tr{};
+      tr.localPos[0] = 4.0f + static_cast<float>(i % 20) * 9.5f;
+      tr.localPos[2] = 4.0f + static_cast<float>(i / 20) * 7.5f;
+      tr.localRot[1] = static_cast<float>(i) * 0.7f;
+
+      TrafficAgent agent{};
+      if (i % 7 == 3)
+      {
+        agent.laneId = (*inactiveLanes)[i % inactiveLanes->size()];
+        scene.filteredOut.push_back(i);
+      }
+      else if (i % 11 == 5)
+      {
+        agent.laneId = 0x00FFFFFFu; // no such lane
+        scene.filteredOut.push_back(i);
+      }
+
+      if (i % 2 == 0)
+      {
+        Transform box{};
+        box.localPos[0] = tr.localPos[0] + std::sin(tr.localRot[1]) * 8.0f;
+        box.localPos[1] = 1.0f;
+        box.localPos[2] = tr.localPos[2] + std::cos(tr.localRot[1]) * 8.0f;
+        Collider collider{};
+        collider.halfExtents[0] = collider.halfExtents[1] = collider.halfExtents[2] = 1.0f;
+        scene.physics.addStaticCollider(Entity{ 10000u + i }, box, collider);
+      }
+
+      scene.agents.push_back(agent);
+      scene.transforms.push_back(tr);
+    }
+  }
+
+  void testSensorFilterMatchesSteering(SensorScene& scene, std::vector<RayQuery>& rays)
+  {
+    std::vector<bool> hasRay(scene.agents.size(), false);
+    for (size_t i = 0; i < scene.agents.size(); ++i)
+    {
+      RayQuery q{};
+      if (buildTrafficSensorRay(scene.lanes, scene.agents[i], scene.transforms[i], 20.0f, q))
+      {
+        rays.push_back(q);
+        hasRay[i] = true;
+
+        // Only agents on an active lane steer, and so only they sense.
+        const LaneSegment* seg = scene.lanes.getLane(scene.agents[i].laneId);
+        SC_CHECK(seg && seg->active);
+      }
+    }
+
+    for (uint32_t i : scene.filteredOut)
+      SC_CHECK(!hasRay[i]);
+    SC_CHECK(!rays.empty());
+  }
+
+  void testBatchMatchesSerial(const PhysicsWorld& physics, const std::vector<RayQuery>& rays)
+  {
+    std::vector<RaycastHit> serial(rays.size());
+    uint32_t hits = 0;
+    for (size_t i = 0; i < rays.size(); ++i)
+    {
+      serial[i] = physics.raycast(rays[i].origin, rays[i].dir, rays[i].maxDist, rays[i].mask);
+      hits += serial[i].hit ? 1u : 0u;
+    }
+    SC_CHECK(hits > 0u && hits < rays.size());
+
+    std::vector<RaycastHit> batched(rays.size());
+    physics.raycastBatch(rays, batched);
+    uint32_t matches = 0;
+    for (size_t i = 0; i < rays.size(); ++i)
+      matches += sameHit(serial[i], batched[i]) ? 1u : 0u;
+    SC_CHECK(matches == rays.size());
+
+    // Systems that run on workers batch too; two at once must not disturb each other.
+    std::vector<RaycastHit> fromWorkers[2];
+    fromWorkers[0].resize(rays.size());
+    fromWorkers[1].resize(rays.size());
+    JobHandle handle = jobs().Dispatch(2, 1, [&](const JobContext& ctx)
+    {
+      physics.raycastBatch(rays, fromWorkers[ctx.groupIndex]);
+    });
+    jobs().Wait(handle);
+    jobs().publishFrameTelemetry();
+    for (const std::vector<RaycastHit>& out : fromWorkers)
+    {
+      matches = 0;
+      for (size_t i = 0; i < rays.size(); ++i)
+        matches += sameHit(serial[i], out[i]) ? 1u : 0u;
+      SC_CHECK(matches == rays.size());
+    }
+  }
+}
+
+int main()
+{
+  SC_CHECK(jobs().init(3));
+  {
+    SensorScene scene;
+    buildScene(scene);
+    std::vector<RayQuery> rays;
+    testSensorFilterMatchesSteering(scene, rays);
+    testBatchMatchesSerial(scene.physics, rays);
+    scene.physics.shutdown();
+  }
+  jobs().shutdown();
+  return SC_TEST_RESULT();
+}
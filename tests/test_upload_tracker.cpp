@@ -0,0 +1,199 @@
+#include "sc_upload_tracker.h"
+#include "sc_test.h"
+
+#include <vector>
+
+using namespace sc;
+
+namespace
+{
+  // Completes tickets only when told to, like fences that have not signalled yet.
+  struct ManualQueue : IUploadQueue
+  {
+    uint64_t submitted = 0;
+    uint64_t completed = 0;
+    bool failNext = false;
+
+    bool submit(uint64_t ticket) override
+    {
+      if (failNext)
+      {
+        failNext = false;
+        return false;
+      }
+      submitted = ticket;
+      return true;
+    }
+    uint64_t completedTicket() override { return completed; }
+  };
+
+  void testBatchesRetireInOrder()
+  {
+    UploadTracker tracker;
+    ManualQueue queue;
+    SC_CHECK(tracker.init(1024));
+
+    SC_CHECK(tracker.reserve(100, 16) == 0u);
+    tracker.track(7);
+    const uint64_t first = tracker.openTicket();
+    SC_CHECK(tracker.flush(queue));
+
+    SC_CHECK(tracker.reserve(100, 16) == 112u);
+    tracker.track(8);
+    SC_CHECK(tracker.flush(queue));
+    SC_CHECK(tracker.stats().batchesInFlight == 2u);
+
+    std::vector<uint32_t> done;
+    auto collect = [&](uint32_t id, bool ok)
+    {
+      SC_CHECK(ok);
+      done.push_back(id);
+    };
+    SC_CHECK(tracker.update(queue, collect) == 0u);
+
+    queue.completed = first;
+    SC_CHECK(tracker.update(queue, collect) == 1u);
+    SC_CHECK(done.size() == 1u && done[0] == 7u);
+
+    queue.completed = queue.submitted;
+    SC_CHECK(tracker.update(queue, collect) == 1u);
+    SC_CHECK(done.size() == 2u && done[1] == 8u);
+    SC_CHECK(tracker.stats().stagingInFlight == 0u);
+    SC_CHECK(tracker.stats().completedUploads == 2u);
+  }
+
+  void testResourcesReportOnceAfterTheirTicket()
+  {
+    // Textures flip resident only from update(), so nothing may be reported
+    // before the batch ticket completes, and nothing twice after.
+    UploadTracker tracker;
+    ManualQueue queue;
+    SC_CHECK(tracker.init(1024));
+    for (uint32_t id = 1; id <= 3; ++id)
+    {
+      SC_CHECK(tracker.reserve(64, 16) != UploadTracker::kInvalidOffset);
+      tracker.track(id);
+    }
+    SC_CHECK(tracker.flush(queue));
+    SC_CHECK(tracker.stats().pendingUploads == 3u);
+
+    uint32_t reported = 0;
+    uint32_t idSum = 0;
+    auto collect = [&](uint32_t id, bool ok)
+    {
+      SC_CHECK(ok);
+      reported++;
+      idSum += id;
+    };
+    SC_CHECK(tracker.update(queue, collect) == 0u);
+    SC_CHECK(reported == 0u);
+
+    queue.completed = queue.submitted;
+    SC_CHECK(tracker.update(queue, collect) == 3u);
+    SC_CHECK(tracker.update(queue, collect) == 0u);
+    SC_CHECK(reported == 3u && idSum == 6u);
+    SC_CHECK(tracker.stats().pendingUploads == 0u);
+  }
+
+  void testWrapNeverOverlapsInFlightBatch()
+  {
+    UploadTracker tracker;
+    ManualQueue queue;
+    SC_CHECK(tracker.init(256));
+    SC_CHECK(tracker.reserve(96, 16) == 0u);
+    SC_CHECK(tracker.flush(queue));
+    const uint64_t first = queue.submitted;
+    SC_CHECK(tracker.reserve(96, 16) == 96u);
+    SC_CHECK(tracker.flush(queue));
+
+    // Only the first batch retired: [0, 96) is free again, [96, 192) is not.
+    queue.completed = first;
+    tracker.update(queue, [](uint32_t, bool) {});
+    SC_CHECK(!tracker.fits(100, 16));
+    SC_CHECK(tracker.reserve(64, 16) == 192u);
+    SC_CHECK(tracker.reserve(96, 16) == 0u);
+    SC_CHECK(tracker.reserve(16, 16) == UploadTracker::kInvalidOffset);
+    SC_CHECK(tracker.stats().stagingInFlight == 256u);
+  }
+
+  void testUntrackedCopiesStillFlush()
+  {
+    // Buffer copies reserve staging without tracking a resource; the batch must still submit.
+    UploadTracker tracker;
+    ManualQueue queue;
+    SC_CHECK(tracker.init(256));
+    SC_CHECK(tracker.reserve(64, 16) != UploadTracker::kInvalidOffset);
+    SC_CHECK(tracker.hasOpenBatch());
+    const uint64_t ticket = tracker.openTicket();
+    SC_CHECK(tracker.flush(queue));
+    SC_CHECK(queue.submitted == ticket);
+    SC_CHECK(!tracker.hasOpenBatch());
+  }
+
+  void testFullRingWaitsForRetire()
+  {
+    UploadTracker tracker;
+    ManualQueue queue;
+    SC_CHECK(tracker.init(256));
+    SC_CHECK(tracker.reserve(200, 16) == 0u);
+    SC_CHECK(tracker.flush(queue));
+    SC_CHECK(!tracker.fits(100, 16));
+    SC_CHECK(tracker.reserve(100, 16) == UploadTracker::kInvalidOffset);
+    SC_CHECK(tracker.stats().stagingFull == 1u);
+
+    queue.completed = queue.submitted;
+    tracker.update(queue, [](uint32_t, bool) {});
+    SC_CHECK(tracker.fits(100, 16));
+  }
+
+  void testEmptyRingFitsFullCapacityAfterWrap()
+  {
+    // Once everything retired, a request larger than the space left before the
+    // wrap point must still fit: the skipped bytes belong to nobody.
+    UploadTracker tracker;
+    ManualQueue queue;
+    SC_CHECK(tracker.init(256));
+    SC_CHECK(tracker.reserve(96, 16) == 0u);
+    SC_CHECK(tracker.flush(queue));
+    queue.completed = queue.submitted;
+    tracker.update(queue, [](uint32_t, bool) {});
+
+    SC_CHECK(tracker.fits(256, 16));
+    SC_CHECK(tracker.reserve(200, 16) == 0u);
+    SC_CHECK(tracker.stats().stagingInFlight == 200u);
+    SC_CHECK(tracker.flush(queue));
+    SC_CHECK(!tracker.fits(100, 16));
+  }
+
+  void testFailedSubmitReportsResources()
+  {
+    UploadTracker tracker;
+    ManualQueue queue;
+    SC_CHECK(tracker.init(256));
+    SC_CHECK(tracker.reserve(32, 16) != UploadTracker::kInvalidOffset);
+    tracker.track(3);
+    queue.failNext = true;
+    SC_CHECK(!tracker.flush(queue));
+
+    bool reported = false;
+    tracker.update(queue, [&](uint32_t id, bool ok)
+    {
+      reported = (id == 3u && !ok);
+    });
+    SC_CHECK(reported);
+    SC_CHECK(tracker.stats().failedUploads == 1u);
+    SC_CHECK(tracker.fits(256, 16));
+  }
+}
+
+int main()
+{
+  testBatchesRetireInOrder();
+  testResourcesReportOnceAfterTheirTicket();
+  testWrapNeverOverlapsInFlightBatch();
+  testUntrackedCopiesStillFlush();
+  testFullRingWaitsForRetire();
+  testEmptyRingFitsFullCapacityAfterWrap();
+  testFailedSubmitReportsResources();
+  return SC_TEST_RESULT();
+}
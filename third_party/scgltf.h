@@ -80,9 +80,16 @@ namespace scgltf
     int baseColorTexture = -1;
   };
 
+  // Points into the bytes passed to parseGlb; they must outlive the Document.
+  struct Buffer
+  {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+  };
+
   struct Document
   {
-    std::vector<std::vector<uint8_t>> buffers;
+    std::vector<Buffer> buffers;
     std::vector<BufferView> bufferViews;
     std::vector<Accessor> accessors;
     std::vector<Mesh> meshes;
@@ -582,7 +589,7 @@ namespace scgltf
 
     Document doc{};
     if (bin && binSize > 0)
-      doc.buffers.push_back(std::vector<uint8_t>(bin, bin + binSize));
+      doc.buffers.push_back(Buffer{ bin, binSize });
 
     if (const JsonValue* buffers = findMember(root, "buffers"); isArray(buffers))
     {
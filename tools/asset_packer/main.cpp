@@ -0,0 +1,131 @@
+#include "sc_vfs.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace
+{
+  void printUsage()
+  {
+    std::printf("usage: sc_asset_packer <output.scpak> <root>[=<prefix>] [...] [options]\n"
+                "  every file under each root is stored under prefix/root-relative path\n"
+                "  --compress          LZ-compress entries that shrink by at least 10%%\n"
+                "  --align <bytes>     entry alignment, power of two (default 65536)\n"
+                "  --skip <ext>        leave files with this extension out (repeatable)\n");
+  }
+
+  bool hasSkippedExtension(const std::filesystem::path& path, const std::vector<std::string>& skip)
+  {
+    std::string ext = path.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c)
+    {
+      return static_cast<char>(std::tolower(c));
+    });
+    return std::find(skip.begin(), skip.end(), ext) != skip.end();
+  }
+}
+
+int main(int argc, char** argv)
+{
+  if (argc < 3)
+  {
+    printUsage();
+    return 1;
+  }
+
+  const std::filesystem::path outputPath = argv[1];
+  struct PackRoot
+  {
+    std::filesystem::path dir;
+    std::string prefix;
+  };
+  std::vector<PackRoot> roots;
+  std::vector<std::string> skip;
+  sc::PackBuildOptions options{};
+  for (int i = 2; i < argc; ++i)
+  {
+    const std::string arg = argv[i];
+    if (arg == "--compress")
+    {
+      options.compress = true;
+    }
+    else if (arg == "--align" && i + 1 < argc)
+    {
+      options.alignment = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    }
+    else if (arg == "--skip" && i + 1 < argc)
+    {
+      std::string ext = argv[++i];
+      if (!ext.empty() && ext[0] != '.')
+        ext.insert(ext.begin(), '.');
+      skip.push_back(ext);
+    }
+    else if (!arg.empty() && arg[0] == '-')
+    {
+      printUsage();
+      return 1;
+    }
+    else
+    {
+      PackRoot root{};
+      const size_t eq = arg.rfind('=');
+      root.dir = arg.substr(0, eq);
+      if (eq != std::string::npos && eq + 1 < arg.size())
+        root.prefix = arg.substr(eq + 1) + "/";
+      roots.push_back(std::move(root));
+    }
+  }
+
+  std::vector<sc::PackSource> sources;
+  for (const PackRoot& root : roots)
+  {
+    std::error_code ec;
+    if (!std::filesystem::is_directory(root.dir, ec))
+    {
+      std::printf("[AssetPacker] '%s' is not a directory\n", root.dir.string().c_str());
+      return 1;
+    }
+
+    for (const auto& item : std::filesystem::recursive_directory_iterator(root.dir, ec))
+    {
+      if (!item.is_regular_file() || hasSkippedExtension(item.path(), skip))
+        continue;
+      if (std::filesystem::equivalent(item.path(), outputPath, ec))
+        continue;
+
+      sc::PackSource source{};
+      source.relativePath = root.prefix + std::filesystem::relative(item.path(), root.dir).generic_string();
+      source.sourcePath = item.path();
+      sources.push_back(std::move(source));
+    }
+  }
+
+  // Stable input order keeps blob layout reproducible between runs.
+  std::sort(sources.begin(), sources.end(), [](const sc::PackSource& a, const sc::PackSource& b)
+  {
+    return a.relativePath < b.relativePath;
+  });
+
+  sc::PackBuildStats stats{};
+  std::string error;
+  if (!sc::buildPack(outputPath, sources, options, &stats, &error))
+  {
+    std::printf("[AssetPacker] %s\n", error.c_str());
+    return 1;
+  }
+
+  std::printf("[AssetPacker] %s: %u entries, %u unique blobs (%u compressed), %llu -> %llu bytes (file %llu)\n",
+              outputPath.string().c_str(),
+              stats.entries,
+              stats.uniqueBlobs,
+              stats.compressedBlobs,
+              static_cast<unsigned long long>(stats.sourceBytes),
+              static_cast<unsigned long long>(stats.storedBytes),
+              static_cast<unsigned long long>(stats.fileBytes));
+  return 0;
+}
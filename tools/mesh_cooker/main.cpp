@@ -0,0 +1,179 @@
+#include "mesh_cooker.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace
+{
+  void printUsage()
+  {
+    std::printf("usage: sc_mesh_cooker <input dir|file.glb> <output dir> [options]\n"
+                "  every .glb under the input is cooked to <output dir>/<relative path>.scmesh\n"
+                "  --jobs <n>     worker threads (default: one per hardware thread)\n"
+                "  --force        cook even when the output matches the source hash\n"
+                "  --no-lods      store LOD 0 only\n"
+                "  --no-optimize  keep glTF vertex and triangle order\n"
+                "  --no-pack      store 32-byte float vertices instead of 16-byte packed ones\n"
+                "  --verbose      print up-to-date files as well\n");
+  }
+
+  bool isGlb(const std::filesystem::path& path)
+  {
+    std::string ext = path.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c)
+    {
+      return static_cast<char>(std::tolower(c));
+    });
+    return ext == ".glb";
+  }
+}
+
+int main(int argc, char** argv)
+{
+  if (argc < 3)
+  {
+    printUsage();
+    return 1;
+  }
+
+  const std::filesystem::path inputPath = argv[1];
+  const std::filesystem::path outputRoot = argv[2];
+  sc_import::MeshCookOptions options{};
+  uint32_t threadCount = 0;
+  bool verbose = false;
+  for (int i = 3; i < argc; ++i)
+  {
+    const std::string arg = argv[i];
+    if (arg == "--jobs" && i + 1 < argc)
+    {
+      threadCount = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    }
+    else if (arg == "--force")
+    {
+      options.force = true;
+    }
+    else if (arg == "--no-lods")
+    {
+      options.generateLods = false;
+    }
+    else if (arg == "--no-optimize")
+    {
+      options.optimize = false;
+    }
+    else if (arg == "--no-pack")
+    {
+      options.packVertices = false;
+    }
+    else if (arg == "--verbose")
+    {
+      verbose = true;
+    }
+    else
+    {
+      printUsage();
+      return 1;
+    }
+  }
+
+  std::vector<sc_import::MeshCookJob> jobs;
+  std::vector<std::string> labels;
+  auto addJob = [&](const std::filesystem::path& source, const std::filesystem::path& rel)
+  {
+    sc_import::MeshCookJob job{};
+    job.sourcePath = source.string();
+    job.outputPath = (outputRoot / rel).string() + sc_import::kCookedMeshExtension;
+    jobs.push_back(std::move(job));
+    labels.push_back(rel.generic_string());
+  };
+
+  std::error_code ec;
+  if (std::filesystem::is_directory(inputPath, ec))
+  {
+    for (const auto& item : std::filesystem::recursive_directory_iterator(inputPath, ec))
+    {
+      if (item.is_regular_file() && isGlb(item.path()))
+        addJob(item.path(), std::filesystem::relative(item.path(), inputPath));
+    }
+  }
+  else if (std::filesystem::is_regular_file(inputPath, ec) && isGlb(inputPath))
+  {
+    addJob(inputPath, inputPath.filename());
+  }
+  else
+  {
+    std::printf("[MeshCooker] '%s' is neither a directory nor a .glb file\n", inputPath.string().c_str());
+    return 1;
+  }
+
+  if (jobs.empty())
+  {
+    std::printf("[MeshCooker] no .glb files under '%s'\n", inputPath.string().c_str());
+    return 0;
+  }
+
+  sc_import::ImporterRegistry registry;
+  sc_import::RegisterGlbImporter(&registry);
+
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<sc_import::MeshCookResult> results;
+  sc_import::CookMeshBatch(registry, jobs, options, threadCount, &results,
+                           [&](size_t index, const sc_import::MeshCookResult& result)
+  {
+    if (result.status == sc_import::MeshCookStatus::Failed)
+    {
+      std::printf("[MeshCooker] %s: FAILED: %s\n", labels[index].c_str(), result.error.c_str());
+    }
+    else if (result.status == sc_import::MeshCookStatus::UpToDate)
+    {
+      if (verbose)
+        std::printf("[MeshCooker] %s: up to date\n", labels[index].c_str());
+    }
+    else
+    {
+      const sc_import::MeshOptimizeStats& opt = result.optimization;
+      std::printf("[MeshCooker] %s: %u verts, %u tris, %u LODs (%.2fs)\n",
+                  labels[index].c_str(),
+                  result.vertexCount,
+                  result.triangleCount,
+                  result.lodCount,
+                  result.seconds);
+      if (options.optimize)
+      {
+        std::printf("  verts %u -> %u, ACMR %.3f -> %.3f, ATVR %.3f -> %.3f\n",
+                    opt.verticesBefore, opt.verticesAfter,
+                    opt.before.acmr, opt.after.acmr,
+                    opt.before.atvr, opt.after.atvr);
+      }
+      if (options.packVertices)
+      {
+        const sc_import::MeshQuantizationError& q = result.quantization;
+        std::printf("  packed vertices: max error pos %.5f, normal %.3f deg, uv %.6f\n",
+                    q.position, q.normalDegrees, q.uv);
+      }
+    }
+  });
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  uint32_t cooked = 0;
+  uint32_t upToDate = 0;
+  uint32_t failed = 0;
+  for (const sc_import::MeshCookResult& result : results)
+  {
+    if (result.status == sc_import::MeshCookStatus::Cooked)
+      ++cooked;
+    else if (result.status == sc_import::MeshCookStatus::UpToDate)
+      ++upToDate;
+    else
+      ++failed;
+  }
+
+  std::printf("[MeshCooker] %zu models: %u cooked, %u up to date, %u failed in %.2fs\n",
+              jobs.size(), cooked, upToDate, failed, seconds);
+  return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,170 @@
+#include "sc_jobs.h"
+#include "sc_physics.h"
+#include "sc_time.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Measures PhysicsWorld::step against body count and thread count. Bodies are
+// boxes dropped in 5-high stacks onto a ground slab, so the timed steps cover
+// broadphase, contacts and island solving rather than free fall alone.
+namespace
+{
+  void printUsage()
+  {
+    std::printf("usage: sc_physics_bench [options]\n"
+                "  --bodies <n,n,...>   dynamic body counts (default 500,2000,8000)\n"
+                "  --threads <n,n,...>  threads including the caller; 1 steps the\n"
+                "                       sequential world (default 1,2,4,8)\n"
+                "  --steps <n>          timed steps per run (default 300)\n"
+                "  --warmup <n>         untimed steps before timing (default 60)\n");
+  }
+
+  std::vector<uint32_t> parseList(const char* text)
+  {
+    std::vector<uint32_t> out;
+    const std::string list = text;
+    size_t pos = 0;
+    while (pos < list.size())
+    {
+      const size_t comma = std::min(list.find(',', pos), list.size());
+      const uint32_t value = static_cast<uint32_t>(std::strtoul(list.substr(pos, comma - pos).c_str(), nullptr, 10));
+      if (value > 0)
+        out.push_back(value);
+      pos = comma + 1;
+    }
+    return out;
+  }
+
+  struct RunResult
+  {
+    bool ok = false;
+    uint32_t threads = 1;
+    double avgMs = 0.0;
+    double maxMs = 0.0;
+  };
+
+  RunResult runOnce(uint32_t bodyCount, uint32_t threads, uint32_t steps, uint32_t warmup)
+  {
+    RunResult result{};
+    sc::PhysicsWorldConfig config{};
+    config.multithreaded = threads > 1;
+    if (config.multithreaded && !sc::jobs().init(threads - 1))
+      return result;
+
+    sc::PhysicsWorld world;
+    if (!world.init(config))
+    {
+      if (config.multithreaded)
+        sc::jobs().shutdown();
+      return result;
+    }
+    result.threads = world.stats().threads;
+
+    const uint32_t stacksPerRow = std::max(1u, static_cast<uint32_t>(std::sqrt(static_cast<float>(bodyCount) / 5.0f)));
+    const float spacing = 1.5f;
+    const float extent = spacing * static_cast<float>(stacksPerRow) * 0.5f + 10.0f;
+
+    sc::Transform groundTransform{};
+    groundTransform.localPos[1] = -0.5f;
+    sc::Collider ground{};
+    ground.halfExtents[0] = extent;
+    ground.halfExtents[1] = 0.5f;
+    ground.halfExtents[2] = extent;
+    world.addStaticCollider(sc::Entity{ 0 }, groundTransform, ground);
+
+    std::vector<sc::PhysicsBodyDesc> descs(bodyCount);
+    for (uint32_t i = 0; i < bodyCount; ++i)
+    {
+      const uint32_t stack = i / 5u;
+      sc::PhysicsBodyDesc& desc = descs[i];
+      desc.entity = sc::Entity{ i + 1u };
+      desc.transform.localPos[0] = (static_cast<float>(stack % stacksPerRow) - stacksPerRow * 0.5f) * spacing;
+      desc.transform.localPos[1] = 0.5f + static_cast<float>(i % 5u) * 1.01f;
+      desc.transform.localPos[2] = (static_cast<float>(stack / stacksPerRow) - stacksPerRow * 0.5f) * spacing;
+    }
+    std::vector<sc::PhysicsBodyHandle> handles(bodyCount);
+    world.addBodies(descs, handles);
+
+    const float dt = 1.0f / 60.0f;
+    for (uint32_t i = 0; i < warmup; ++i)
+    {
+      world.step(dt);
+      sc::jobs().publishFrameTelemetry();
+    }
+
+    double totalMs = 0.0;
+    for (uint32_t i = 0; i < steps; ++i)
+    {
+      const sc::Tick start = sc::nowTicks();
+      world.step(dt);
+      const double ms = sc::ticksToSeconds(sc::nowTicks() - start) * 1000.0;
+      totalMs += ms;
+      result.maxMs = std::max(result.maxMs, ms);
+      // Releases this step's job payloads, as the frame loop does.
+      sc::jobs().publishFrameTelemetry();
+    }
+    result.avgMs = steps > 0 ? totalMs / static_cast<double>(steps) : 0.0;
+    result.ok = true;
+
+    world.shutdown();
+    if (config.multithreaded)
+      sc::jobs().shutdown();
+    return result;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  std::vector<uint32_t> bodies = { 500, 2000, 8000 };
+  std::vector<uint32_t> threads = { 1, 2, 4, 8 };
+  uint32_t steps = 300;
+  uint32_t warmup = 60;
+  for (int i = 1; i < argc; ++i)
+  {
+    const std::string arg = argv[i];
+    if (arg == "--bodies" && i + 1 < argc)
+      bodies = parseList(argv[++i]);
+    else if (arg == "--threads" && i + 1 < argc)
+      threads = parseList(argv[++i]);
+    else if (arg == "--steps" && i + 1 < argc)
+      steps = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    else if (arg == "--warmup" && i + 1 < argc)
+      warmup = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    else
+    {
+      printUsage();
+      return 1;
+    }
+  }
+  if (bodies.empty() || threads.empty() || steps == 0)
+  {
+    printUsage();
+    return 1;
+  }
+
+  std::printf("%8s %8s %10s %10s %9s\n", "bodies", "threads", "avg ms", "max ms", "speedup");
+  for (uint32_t bodyCount : bodies)
+  {
+    double baseMs = 0.0;
+    for (uint32_t threadCount : threads)
+    {
+      const RunResult r = runOnce(bodyCount, threadCount, steps, warmup);
+      if (!r.ok)
+      {
+        std::printf("%8u %8u %10s\n", bodyCount, threadCount, "failed");
+        continue;
+      }
+      if (baseMs == 0.0)
+        baseMs = r.avgMs;
+      // r.threads can be lower than asked when the world fell back to sequential.
+      std::printf("%8u %8u %10.3f %10.3f %8.2fx\n", bodyCount, r.threads, r.avgMs, r.maxMs,
+                  r.avgMs > 0.0 ? baseMs / r.avgMs : 0.0);
+    }
+  }
+  return 0;
+}
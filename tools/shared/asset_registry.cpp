@@ -1,49 +1,361 @@
 #include "asset_registry.h"
 
+#include <cctype>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
-#include <sstream>
 
 namespace sc_world
 {
-  bool LoadAssetRegistry(const char* path, std::vector<AssetRegistryEntry>& out_entries)
+  namespace
   {
-    out_entries.clear();
+    static constexpr uint32_t kEmptySlot = UINT32_MAX;
+
+    struct RegistryHeader
+    {
+      uint32_t magic = kCookedRegistryMagic;
+      uint32_t version = kCookedRegistryVersion;
+      uint32_t entryCount = 0;
+      uint32_t reserved = 0;
+      uint64_t stringBytes = 0;
+    };
+
+    struct RegistryRecord
+    {
+      AssetId mesh_id = 0;
+      AssetId material_id = 0;
+      uint32_t labelOffset = 0;
+      uint32_t labelSize = 0;
+      uint32_t meshOffset = 0;
+      uint32_t meshSize = 0;
+      uint32_t materialOffset = 0;
+      uint32_t materialSize = 0;
+    };
+
+    // Ids are FNV-1a of short paths; finalize them so the low bits probe well.
+    static uint64_t MixId(uint64_t x)
+    {
+      x ^= x >> 30;
+      x *= 0xbf58476d1ce4e5b9ull;
+      x ^= x >> 27;
+      x *= 0x94d049bb133111ebull;
+      x ^= x >> 31;
+      return x;
+    }
+
+    static AssetId PairKey(AssetId mesh_id, AssetId material_id)
+    {
+      return mesh_id ^ MixId(material_id + 0x9e3779b97f4a7c15ull);
+    }
+
+    static bool SplitField(const std::string& line, size_t& pos, std::string& out_field)
+    {
+      if (pos >= line.size())
+        return false;
+      const size_t bar = line.find('|', pos);
+      if (bar == std::string::npos)
+      {
+        out_field.assign(line, pos, std::string::npos);
+        pos = line.size() + 1;
+        return true;
+      }
+      out_field.assign(line, pos, bar - pos);
+      pos = bar + 1;
+      return true;
+    }
+
+    static bool ParseRegistryText(const char* path, std::vector<AssetRegistryEntry>& out_entries)
+    {
+      std::ifstream in(path);
+      if (!in.is_open())
+        return false;
+
+      std::string line;
+      while (std::getline(in, line))
+      {
+        if (line.empty())
+          continue;
+        if (line[0] == '#')
+          continue;
+
+        size_t pos = 0;
+        AssetRegistryEntry entry{};
+        if (!SplitField(line, pos, entry.label))
+          continue;
+        if (!SplitField(line, pos, entry.mesh_path))
+          continue;
+        if (!SplitField(line, pos, entry.material_path))
+          continue;
+
+        entry.mesh_id = HashAssetPath(entry.mesh_path.c_str());
+        entry.material_id = HashAssetPath(entry.material_path.c_str());
+        out_entries.push_back(std::move(entry));
+      }
+      return true;
+    }
+
+    static bool AppendString(std::vector<char>& blob, const std::string& text, uint32_t& out_offset, uint32_t& out_size)
+    {
+      if (blob.size() + text.size() > UINT32_MAX)
+        return false;
+      out_offset = static_cast<uint32_t>(blob.size());
+      out_size = static_cast<uint32_t>(text.size());
+      blob.insert(blob.end(), text.begin(), text.end());
+      return true;
+    }
+  }
+
+  bool AssetRegistry::load(const char* path)
+  {
+    if (IsCookedRegistryPath(path))
+      return loadCooked(path);
+    return loadText(path);
+  }
+
+  bool AssetRegistry::loadText(const char* path)
+  {
+    clear();
+    if (!path)
+      return false;
+
+    std::vector<AssetRegistryEntry> entries;
+    if (!ParseRegistryText(path, entries))
+      return false;
+    assign(std::move(entries));
+    return !m_entries.empty();
+  }
+
+  bool AssetRegistry::loadCooked(const char* path)
+  {
+    clear();
     if (!path)
       return false;
 
-    std::ifstream in(path);
+    // One read for the whole file; records and strings are parsed from memory.
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
     if (!in.is_open())
       return false;
+    const std::streamoff fileSize = in.tellg();
+    if (fileSize < static_cast<std::streamoff>(sizeof(RegistryHeader)))
+      return false;
+    std::vector<uint8_t> bytes(static_cast<size_t>(fileSize));
+    in.seekg(0, std::ios::beg);
+    in.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    if (static_cast<size_t>(in.gcount()) != bytes.size())
+      return false;
+    return loadCookedMemory(bytes.data(), bytes.size());
+  }
+
+  bool AssetRegistry::loadCookedMemory(const uint8_t* data, size_t size)
+  {
+    clear();
+    if (!data || size < sizeof(RegistryHeader))
+      return false;
 
-    std::string line;
-    while (std::getline(in, line))
-    {
-      if (line.empty())
-        continue;
-      if (line[0] == '#')
-        continue;
-
-      std::stringstream ss(line);
-      std::string label;
-      std::string mesh;
-      std::string material;
-
-      if (!std::getline(ss, label, '|'))
-        continue;
-      if (!std::getline(ss, mesh, '|'))
-        continue;
-      if (!std::getline(ss, material, '|'))
-        continue;
-
-      AssetRegistryEntry entry{};
-      entry.label = label;
-      entry.mesh_path = mesh;
-      entry.material_path = material;
-      entry.mesh_id = HashAssetPath(mesh.c_str());
-      entry.material_id = HashAssetPath(material.c_str());
-      out_entries.push_back(std::move(entry));
+    RegistryHeader header{};
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != kCookedRegistryMagic || header.version != kCookedRegistryVersion)
+      return false;
+
+    const uint64_t recordBytes = static_cast<uint64_t>(header.entryCount) * sizeof(RegistryRecord);
+    if (sizeof(RegistryHeader) + recordBytes + header.stringBytes != size)
+      return false;
+
+    const char* records = reinterpret_cast<const char*>(data) + sizeof(RegistryHeader);
+    const char* strings = records + recordBytes;
+    auto inStrings = [&](uint32_t offset, uint32_t len)
+    {
+      return offset <= header.stringBytes && len <= header.stringBytes - offset;
+    };
+
+    std::vector<AssetRegistryEntry> entries(header.entryCount);
+    for (uint32_t i = 0; i < header.entryCount; ++i)
+    {
+      RegistryRecord record{};
+      std::memcpy(&record, records + static_cast<size_t>(i) * sizeof(RegistryRecord), sizeof(record));
+      if (!inStrings(record.labelOffset, record.labelSize) ||
+          !inStrings(record.meshOffset, record.meshSize) ||
+          !inStrings(record.materialOffset, record.materialSize))
+        return false;
+
+      AssetRegistryEntry& entry = entries[i];
+      entry.label.assign(strings + record.labelOffset, record.labelSize);
+      entry.mesh_path.assign(strings + record.meshOffset, record.meshSize);
+      entry.material_path.assign(strings + record.materialOffset, record.materialSize);
+      entry.mesh_id = record.mesh_id;
+      entry.material_id = record.material_id;
     }
 
+    assign(std::move(entries));
+    return !m_entries.empty();
+  }
+
+  bool AssetRegistry::saveCooked(const char* path) const
+  {
+    if (!path || m_entries.size() > UINT32_MAX)
+      return false;
+
+    std::vector<RegistryRecord> records(m_entries.size());
+    std::vector<char> strings;
+    for (size_t i = 0; i < m_entries.size(); ++i)
+    {
+      const AssetRegistryEntry& entry = m_entries[i];
+      RegistryRecord& record = records[i];
+      record.mesh_id = entry.mesh_id;
+      record.material_id = entry.material_id;
+      if (!AppendString(strings, entry.label, record.labelOffset, record.labelSize) ||
+          !AppendString(strings, entry.mesh_path, record.meshOffset, record.meshSize) ||
+          !AppendString(strings, entry.material_path, record.materialOffset, record.materialSize))
+        return false;
+    }
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out.is_open())
+      return false;
+
+    RegistryHeader header{};
+    header.entryCount = static_cast<uint32_t>(records.size());
+    header.stringBytes = static_cast<uint64_t>(strings.size());
+    out.write(reinterpret_cast<const char*>(&header), static_cast<std::streamsize>(sizeof(header)));
+    out.write(reinterpret_cast<const char*>(records.data()),
+              static_cast<std::streamsize>(records.size() * sizeof(RegistryRecord)));
+    out.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+    return out.good();
+  }
+
+  void AssetRegistry::assign(std::vector<AssetRegistryEntry> entries)
+  {
+    m_entries = std::move(entries);
+    rebuildIndices();
+  }
+
+  void AssetRegistry::clear()
+  {
+    m_entries.clear();
+    m_meshSlots.clear();
+    m_materialSlots.clear();
+    m_pairSlots.clear();
+    m_slotMask = 0;
+  }
+
+  void AssetRegistry::rebuildIndices()
+  {
+    // Power-of-two table at most half full keeps linear probes short.
+    size_t capacity = 16;
+    while (capacity < m_entries.size() * 2)
+      capacity <<= 1;
+    m_slotMask = static_cast<uint64_t>(capacity - 1);
+
+    m_meshSlots.assign(capacity, IndexSlot{});
+    m_materialSlots.assign(capacity, IndexSlot{});
+    m_pairSlots.assign(capacity, IndexSlot{});
+
+    for (uint32_t i = 0; i < static_cast<uint32_t>(m_entries.size()); ++i)
+    {
+      const AssetRegistryEntry& entry = m_entries[i];
+      insertSlot(m_meshSlots, entry.mesh_id, i, false);
+      insertSlot(m_materialSlots, entry.material_id, i, false);
+      insertSlot(m_pairSlots, PairKey(entry.mesh_id, entry.material_id), i, true);
+    }
+  }
+
+  void AssetRegistry::insertSlot(std::vector<IndexSlot>& slots, AssetId key, uint32_t entry, bool pair)
+  {
+    uint64_t slot = MixId(key) & m_slotMask;
+    for (;;)
+    {
+      IndexSlot& s = slots[static_cast<size_t>(slot)];
+      if (s.entry == kEmptySlot)
+      {
+        s.key = key;
+        s.entry = entry;
+        return;
+      }
+      if (s.key == key)
+      {
+        // Earlier entries win; a pair key collision with different ids keeps probing.
+        if (!pair)
+          return;
+        const AssetRegistryEntry& existing = m_entries[s.entry];
+        const AssetRegistryEntry& incoming = m_entries[entry];
+        if (existing.mesh_id == incoming.mesh_id && existing.material_id == incoming.material_id)
+          return;
+      }
+      slot = (slot + 1) & m_slotMask;
+    }
+  }
+
+  const AssetRegistryEntry* AssetRegistry::findSlot(const std::vector<IndexSlot>& slots,
+                                                    AssetId key,
+                                                    AssetId mesh_id,
+                                                    AssetId material_id,
+                                                    bool pair) const
+  {
+    if (slots.empty())
+      return nullptr;
+
+    uint64_t slot = MixId(key) & m_slotMask;
+    for (;;)
+    {
+      const IndexSlot& s = slots[static_cast<size_t>(slot)];
+      if (s.entry == kEmptySlot)
+        return nullptr;
+      if (s.key == key)
+      {
+        const AssetRegistryEntry& entry = m_entries[s.entry];
+        if (!pair || (entry.mesh_id == mesh_id && entry.material_id == material_id))
+          return &entry;
+      }
+      slot = (slot + 1) & m_slotMask;
+    }
+  }
+
+  const AssetRegistryEntry* AssetRegistry::findByIds(AssetId mesh_id, AssetId material_id) const
+  {
+    return findSlot(m_pairSlots, PairKey(mesh_id, material_id), mesh_id, material_id, true);
+  }
+
+  const AssetRegistryEntry* AssetRegistry::findByMeshId(AssetId mesh_id) const
+  {
+    return findSlot(m_meshSlots, mesh_id, 0, 0, false);
+  }
+
+  const AssetRegistryEntry* AssetRegistry::findByMaterialId(AssetId material_id) const
+  {
+    return findSlot(m_materialSlots, material_id, 0, 0, false);
+  }
+
+  bool IsCookedRegistryPath(const char* path)
+  {
+    if (!path)
+      return false;
+    const size_t len = std::strlen(path);
+    const size_t extLen = std::strlen(kCookedRegistryExtension);
+    if (len < extLen)
+      return false;
+    for (size_t i = 0; i < extLen; ++i)
+    {
+      const char a = static_cast<char>(std::tolower(static_cast<unsigned char>(path[len - extLen + i])));
+      if (a != kCookedRegistryExtension[i])
+        return false;
+    }
+    return true;
+  }
+
+  std::string CookedRegistryPathFor(const std::string& text_path)
+  {
+    std::filesystem::path cooked(text_path);
+    cooked.replace_extension(kCookedRegistryExtension);
+    return cooked.string();
+  }
+
+  bool LoadAssetRegistry(const char* path, std::vector<AssetRegistryEntry>& out_entries)
+  {
+    out_entries.clear();
+    if (!path)
+      return false;
+    if (!ParseRegistryText(path, out_entries))
+      return false;
     return !out_entries.empty();
   }
 
@@ -6,6 +6,10 @@
 
 namespace sc_world
 {
+  static constexpr uint32_t kCookedRegistryMagic = 0x47455253; // "SREG"
+  static constexpr uint32_t kCookedRegistryVersion = 1;
+  static constexpr const char* kCookedRegistryExtension = ".screg";
+
   struct AssetRegistryEntry
   {
     std::string label;
@@ -15,7 +19,57 @@ namespace sc_world
     AssetId material_id = 0;
   };
 
+  // Entries plus open-addressing indices by mesh id, material id and the pair.
+  // Lookups return the first entry in file order, matching the linear helpers below.
+  class AssetRegistry
+  {
+  public:
+    // Loads a cooked registry when path is one, otherwise the text format.
+    bool load(const char* path);
+    bool loadText(const char* path);
+    bool loadCooked(const char* path);
+    bool loadCookedMemory(const uint8_t* data, size_t size);
+    bool saveCooked(const char* path) const;
+
+    void assign(std::vector<AssetRegistryEntry> entries);
+    void clear();
+
+    const std::vector<AssetRegistryEntry>& entries() const { return m_entries; }
+    bool empty() const { return m_entries.empty(); }
+    size_t size() const { return m_entries.size(); }
+
+    const AssetRegistryEntry* findByIds(AssetId mesh_id, AssetId material_id) const;
+    const AssetRegistryEntry* findByMeshId(AssetId mesh_id) const;
+    const AssetRegistryEntry* findByMaterialId(AssetId material_id) const;
+
+  private:
+    struct IndexSlot
+    {
+      AssetId key = 0;
+      uint32_t entry = UINT32_MAX;
+    };
+
+    void rebuildIndices();
+    void insertSlot(std::vector<IndexSlot>& slots, AssetId key, uint32_t entry, bool pair);
+    const AssetRegistryEntry* findSlot(const std::vector<IndexSlot>& slots,
+                                       AssetId key,
+                                       AssetId mesh_id,
+                                       AssetId material_id,
+                                       bool pair) const;
+
+    std::vector<AssetRegistryEntry> m_entries;
+    std::vector<IndexSlot> m_meshSlots;
+    std::vector<IndexSlot> m_materialSlots;
+    std::vector<IndexSlot> m_pairSlots;
+    uint64_t m_slotMask = 0;
+  };
+
+  bool IsCookedRegistryPath(const char* path);
+  // "<dir>/<stem>.screg" next to a text registry.
+  std::string CookedRegistryPathFor(const std::string& text_path);
+
   bool LoadAssetRegistry(const char* path, std::vector<AssetRegistryEntry>& out_entries);
+  // Linear scans; prefer AssetRegistry for anything larger than a handful of entries.
   const AssetRegistryEntry* FindByIds(const std::vector<AssetRegistryEntry>& entries,
                                       AssetId mesh_id,
                                       AssetId material_id);
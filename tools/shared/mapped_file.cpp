@@ -0,0 +1,107 @@
+#include "mapped_file.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#include <string>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace sc_import
+{
+  MappedFile::~MappedFile()
+  {
+    close();
+  }
+
+  bool MappedFile::open(const char* path)
+  {
+    close();
+    if (!path)
+      return false;
+
+#if defined(_WIN32)
+    const int wideLen = MultiByteToWideChar(CP_UTF8, 0, path, -1, nullptr, 0);
+    if (wideLen <= 0)
+      return false;
+    std::wstring widePath(static_cast<size_t>(wideLen), L'\0');
+    MultiByteToWideChar(CP_UTF8, 0, path, -1, widePath.data(), wideLen);
+
+    HANDLE file = CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+      return false;
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0)
+    {
+      CloseHandle(file);
+      return false;
+    }
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping)
+    {
+      CloseHandle(file);
+      return false;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view)
+    {
+      CloseHandle(mapping);
+      CloseHandle(file);
+      return false;
+    }
+    m_file = file;
+    m_mapping = mapping;
+    m_base = static_cast<const uint8_t*>(view);
+    m_size = static_cast<size_t>(size.QuadPart);
+#else
+    const int fd = ::open(path, O_RDONLY);
+    if (fd < 0)
+      return false;
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+      ::close(fd);
+      return false;
+    }
+    void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    if (view == MAP_FAILED)
+    {
+      ::close(fd);
+      return false;
+    }
+    // Importers touch nearly every page; start reading them all in now.
+    madvise(view, static_cast<size_t>(st.st_size), MADV_WILLNEED);
+    m_fd = fd;
+    m_base = static_cast<const uint8_t*>(view);
+    m_size = static_cast<size_t>(st.st_size);
+#endif
+    return true;
+  }
+
+  void MappedFile::close()
+  {
+#if defined(_WIN32)
+    if (m_base)
+      UnmapViewOfFile(m_base);
+    if (m_mapping)
+      CloseHandle(static_cast<HANDLE>(m_mapping));
+    if (m_file)
+      CloseHandle(static_cast<HANDLE>(m_file));
+    m_file = nullptr;
+    m_mapping = nullptr;
+#else
+    if (m_base)
+      munmap(const_cast<uint8_t*>(m_base), m_size);
+    if (m_fd >= 0)
+      ::close(m_fd);
+    m_fd = -1;
+#endif
+    m_base = nullptr;
+    m_size = 0;
+  }
+}
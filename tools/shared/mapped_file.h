@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace sc_import
+{
+  // Read-only view of a whole file. Pages are faulted in as they are touched,
+  // so importers can hand out pointers into the file instead of copying it.
+  class MappedFile
+  {
+  public:
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Fails for missing and empty files.
+    bool open(const char* path);
+    void close();
+
+    const uint8_t* data() const { return m_base; }
+    size_t size() const { return m_size; }
+
+  private:
+    const uint8_t* m_base = nullptr;
+    size_t m_size = 0;
+#if defined(_WIN32)
+    void* m_file = nullptr;
+    void* m_mapping = nullptr;
+#else
+    int m_fd = -1;
+#endif
+  };
+}
@@ -0,0 +1,314 @@
+#include "mesh_cooker.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+namespace sc_import
+{
+  namespace
+  {
+    static constexpr uint64_t kFnvOffset = 1469598103934665603ull;
+    static constexpr uint64_t kFnvPrime = 1099511628211ull;
+
+    static uint64_t HashBytes(uint64_t hash, const void* data, size_t size)
+    {
+      const uint8_t* bytes = static_cast<const uint8_t*>(data);
+      for (size_t i = 0; i < size; ++i)
+      {
+        hash ^= static_cast<uint64_t>(bytes[i]);
+        hash *= kFnvPrime;
+      }
+      return hash;
+    }
+
+    template<typename T>
+    static uint64_t HashValue(uint64_t hash, const T& value)
+    {
+      return HashBytes(hash, &value, sizeof(T));
+    }
+
+    static void FillStats(const CookedMesh& mesh, MeshCookResult* out_result)
+    {
+      if (!out_result || mesh.lods.empty())
+        return;
+      out_result->vertexCount = static_cast<uint32_t>(mesh.lods[0].vertices.size());
+      out_result->triangleCount = static_cast<uint32_t>(mesh.lods[0].indices.size() / 3);
+      out_result->lodCount = static_cast<uint32_t>(mesh.lods.size());
+    }
+
+    // A fresh cook hands out exactly the vertices a later load will decode.
+    static void ApplyVertexPacking(MeshData* mesh)
+    {
+      std::vector<PackedMeshVertex> packed;
+      PackMeshVertices(*mesh, &packed);
+      UnpackMeshVertices(packed.data(), packed.size(), mesh->bounds, mesh->vertices.data());
+    }
+
+    // Write next to the target and rename over it, so a reader never sees a
+    // half-written file and a failed cook leaves the previous one in place.
+    static bool WriteCookedMeshReplacing(const std::string& path, const CookedMesh& mesh)
+    {
+      std::error_code ec;
+      const std::filesystem::path target(path);
+      if (target.has_parent_path())
+        std::filesystem::create_directories(target.parent_path(), ec);
+
+      char suffix[32];
+      std::snprintf(suffix, sizeof(suffix), ".%zx.tmp", std::hash<std::thread::id>{}(std::this_thread::get_id()));
+      const std::string tempPath = path + suffix;
+      if (!WriteCookedMesh(tempPath.c_str(), mesh))
+      {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+      }
+
+      std::filesystem::rename(tempPath, target, ec);
+      if (ec)
+      {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+      }
+      return true;
+    }
+  }
+
+  uint64_t MeshCookSettingsHash(const MeshCookOptions& options)
+  {
+    uint64_t hash = kFnvOffset;
+    hash = HashValue(hash, kCookedMeshVersion);
+    hash = HashValue(hash, static_cast<uint8_t>(options.import.bakeNodeTransforms ? 1 : 0));
+    hash = HashValue(hash, static_cast<uint8_t>(options.optimize ? 1 : 0));
+    if (options.optimize)
+    {
+      const MeshOptimizeOptions& opt = options.optimization;
+      const uint8_t passes = static_cast<uint8_t>((opt.weldVertices ? 1 : 0) |
+                                                  (opt.optimizeVertexCache ? 2 : 0) |
+                                                  (opt.optimizeOverdraw ? 4 : 0) |
+                                                  (opt.optimizeVertexFetch ? 8 : 0));
+      hash = HashValue(hash, passes);
+      hash = HashValue(hash, opt.cacheSize);
+    }
+    hash = HashValue(hash, static_cast<uint8_t>(options.packVertices ? 1 : 0));
+    hash = HashValue(hash, static_cast<uint8_t>(options.generateLods ? 1 : 0));
+    if (options.generateLods)
+    {
+      hash = HashValue(hash, options.lods.lodCount);
+      hash = HashValue(hash, static_cast<uint32_t>(options.lods.method));
+      hash = HashBytes(hash, options.lods.triangleRatios, sizeof(options.lods.triangleRatios));
+      hash = HashValue(hash, options.lods.minTriangles);
+      hash = HashBytes(hash, options.lods.screenSizes, sizeof(options.lods.screenSizes));
+      if (options.lods.method == MeshLodMethod::Quadric)
+      {
+        const MeshSimplifyOptions& simplify = options.lods.simplify;
+        hash = HashValue(hash, simplify.normalWeight);
+        hash = HashValue(hash, simplify.uvWeight);
+        hash = HashValue(hash, static_cast<uint8_t>(simplify.lockSubmeshBorders ? 1 : 0));
+        hash = HashValue(hash, simplify.maxError);
+      }
+    }
+    return hash;
+  }
+
+  bool HashFileContents(const char* path, uint64_t* out_hash, uint64_t* out_size)
+  {
+    if (!path || !out_hash)
+      return false;
+
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open())
+      return false;
+
+    std::vector<char> chunk(1u << 20);
+    uint64_t hash = kFnvOffset;
+    uint64_t size = 0;
+    while (in)
+    {
+      in.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+      const std::streamsize got = in.gcount();
+      if (got <= 0)
+        break;
+      hash = HashBytes(hash, chunk.data(), static_cast<size_t>(got));
+      size += static_cast<uint64_t>(got);
+    }
+    if (in.bad())
+      return false;
+
+    *out_hash = hash;
+    if (out_size)
+      *out_size = size;
+    return true;
+  }
+
+  bool CookMesh(const ImporterRegistry& registry,
+                const char* sourcePath,
+                const MeshCookOptions& options,
+                CookedMesh* out_mesh,
+                std::string* out_error,
+                MeshOptimizeStats* out_stats)
+  {
+    if (!sourcePath || !out_mesh)
+      return false;
+
+    ImportedModel model{};
+    if (!registry.importModel(sourcePath, options.import, &model, out_error))
+      return false;
+
+    MeshData merged{};
+    if (!FlattenModelToMesh(model, &merged, out_error))
+      return false;
+    // Optimizing first means LOD generation starts from welded vertices.
+    if (options.optimize)
+      OptimizeMesh(&merged, options.optimization, out_stats);
+
+    out_mesh->lods.clear();
+    out_mesh->lodScreenSizes.clear();
+    MeshLodChain chain{};
+    if (options.generateLods && GenerateMeshLods(merged, options.lods, &chain, nullptr))
+    {
+      out_mesh->lods = std::move(chain.lods);
+      out_mesh->lodScreenSizes = std::move(chain.screenSizes);
+      if (options.optimize)
+      {
+        for (size_t i = 1; i < out_mesh->lods.size(); ++i)
+          OptimizeMesh(&out_mesh->lods[i], options.optimization, nullptr);
+      }
+    }
+    else
+    {
+      out_mesh->lods.push_back(std::move(merged));
+      out_mesh->lodScreenSizes.push_back(options.lods.screenSizes[0]);
+    }
+    out_mesh->materials = std::move(model.materials);
+    out_mesh->packedVertices = options.packVertices;
+    out_mesh->key.settingsHash = MeshCookSettingsHash(options);
+    return true;
+  }
+
+  MeshCookStatus LoadOrCookMesh(const ImporterRegistry& registry,
+                                const MeshCookJob& job,
+                                const MeshCookOptions& options,
+                                CookedMesh* out_mesh,
+                                MeshCookResult* out_result)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    MeshCookResult result{};
+    auto finish = [&](MeshCookStatus status)
+    {
+      result.status = status;
+      result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      if (out_result)
+        *out_result = std::move(result);
+      return status;
+    };
+
+    CookedMeshKey key{};
+    key.settingsHash = MeshCookSettingsHash(options);
+    if (!HashFileContents(job.sourcePath.c_str(), &key.sourceHash, &key.sourceSize))
+    {
+      result.error = "Failed to read " + job.sourcePath;
+      return finish(MeshCookStatus::Failed);
+    }
+
+    if (!options.force && !job.outputPath.empty())
+    {
+      CookedMeshKey existing{};
+      if (ReadCookedMeshKey(job.outputPath.c_str(), &existing) &&
+          existing.sourceHash == key.sourceHash &&
+          existing.sourceSize == key.sourceSize &&
+          existing.settingsHash == key.settingsHash)
+      {
+        if (!out_mesh)
+          return finish(MeshCookStatus::UpToDate);
+        // A damaged file with a valid header falls through to a fresh cook.
+        if (ReadCookedMesh(job.outputPath.c_str(), out_mesh))
+        {
+          FillStats(*out_mesh, &result);
+          return finish(MeshCookStatus::UpToDate);
+        }
+      }
+    }
+
+    CookedMesh local{};
+    CookedMesh& mesh = out_mesh ? *out_mesh : local;
+    if (!CookMesh(registry, job.sourcePath.c_str(), options, &mesh, &result.error, &result.optimization))
+    {
+      if (result.error.empty())
+        result.error = "Import failed.";
+      return finish(MeshCookStatus::Failed);
+    }
+    mesh.key = key;
+    FillStats(mesh, &result);
+    if (options.packVertices && !mesh.lods.empty())
+    {
+      result.quantization = MeasureMeshQuantization(mesh.lods[0]);
+      for (MeshData& lod : mesh.lods)
+        ApplyVertexPacking(&lod);
+    }
+
+    if (!job.outputPath.empty() && !WriteCookedMeshReplacing(job.outputPath, mesh))
+    {
+      result.error = "Failed to write " + job.outputPath;
+      return finish(MeshCookStatus::Failed);
+    }
+    return finish(MeshCookStatus::Cooked);
+  }
+
+  void CookMeshBatch(const ImporterRegistry& registry,
+                     const std::vector<MeshCookJob>& jobs,
+                     const MeshCookOptions& options,
+                     uint32_t threadCount,
+                     std::vector<MeshCookResult>* out_results,
+                     const MeshCookProgressFn& progress)
+  {
+    std::vector<MeshCookResult> localResults;
+    std::vector<MeshCookResult>& results = out_results ? *out_results : localResults;
+    results.clear();
+    results.resize(jobs.size());
+    if (jobs.empty())
+      return;
+
+    if (threadCount == 0)
+      threadCount = std::max(1u, std::thread::hardware_concurrency());
+    threadCount = static_cast<uint32_t>(std::min<size_t>(threadCount, jobs.size()));
+
+    // Files already run one per worker; importers spawning their own threads
+    // on top would only oversubscribe.
+    MeshCookOptions jobOptions = options;
+    if (threadCount > 1)
+      jobOptions.import.maxThreads = 1;
+
+    // Jobs are claimed one at a time so a few large vehicles do not hold up a
+    // worker's whole share of small props.
+    std::atomic<size_t> next{ 0 };
+    std::mutex progressMutex;
+    auto worker = [&]()
+    {
+      for (;;)
+      {
+        const size_t index = next.fetch_add(1, std::memory_order_relaxed);
+        if (index >= jobs.size())
+          return;
+        LoadOrCookMesh(registry, jobs[index], jobOptions, nullptr, &results[index]);
+        if (progress)
+        {
+          std::lock_guard<std::mutex> lock(progressMutex);
+          progress(index, results[index]);
+        }
+      }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+    for (uint32_t i = 1; i < threadCount; ++i)
+      threads.emplace_back(worker);
+    worker();
+    for (std::thread& thread : threads)
+      thread.join();
+  }
+}
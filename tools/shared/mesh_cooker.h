@@ -0,0 +1,84 @@
+#pragma once
+
+#include "mesh_format.h"
+#include "mesh_lod.h"
+#include "mesh_optimize.h"
+#include "mesh_quantize.h"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace sc_import
+{
+  struct MeshCookOptions
+  {
+    MeshImportOptions import{};
+    bool optimize = true;         // weld and reorder every LOD, see OptimizeMesh()
+    MeshOptimizeOptions optimization{};
+    bool generateLods = true;
+    MeshLodOptions lods{};
+    bool packVertices = true;     // store PackedMeshVertex on disk (expanded on load), see mesh_quantize.h
+    bool force = false;           // cook even when the output is up to date
+  };
+
+  enum class MeshCookStatus : uint32_t
+  {
+    Cooked = 0,
+    UpToDate = 1,
+    Failed = 2
+  };
+
+  struct MeshCookJob
+  {
+    std::string sourcePath;
+    std::string outputPath;       // empty: cook in memory only
+  };
+
+  struct MeshCookResult
+  {
+    MeshCookStatus status = MeshCookStatus::Failed;
+    std::string error;
+    uint32_t vertexCount = 0;     // LOD 0
+    uint32_t triangleCount = 0;   // LOD 0
+    uint32_t lodCount = 0;
+    MeshOptimizeStats optimization{};   // LOD 0; filled only when the mesh was cooked
+    MeshQuantizationError quantization{}; // LOD 0; filled only when cooked with packVertices
+    double seconds = 0.0;
+  };
+
+  // Covers every option that changes cooked output, plus the format version.
+  uint64_t MeshCookSettingsHash(const MeshCookOptions& options);
+  bool HashFileContents(const char* path, uint64_t* out_hash, uint64_t* out_size);
+
+  // Import, flatten, optimization and LOD generation; reads the source, writes nothing.
+  bool CookMesh(const ImporterRegistry& registry,
+                const char* sourcePath,
+                const MeshCookOptions& options,
+                CookedMesh* out_mesh,
+                std::string* out_error,
+                MeshOptimizeStats* out_stats = nullptr);
+
+  // Reuses job.outputPath when its key matches the source contents and
+  // settings, otherwise cooks and replaces it. out_mesh may be null when the
+  // caller only wants the file on disk. Safe to call from several threads as
+  // long as the registry is no longer being modified.
+  MeshCookStatus LoadOrCookMesh(const ImporterRegistry& registry,
+                                const MeshCookJob& job,
+                                const MeshCookOptions& options,
+                                CookedMesh* out_mesh,
+                                MeshCookResult* out_result);
+
+  using MeshCookProgressFn = std::function<void(size_t jobIndex, const MeshCookResult& result)>;
+
+  // Runs LoadOrCookMesh over jobs on threadCount workers (0 picks one per
+  // hardware thread). out_results is indexed like jobs. progress is called
+  // from the workers, one call at a time.
+  void CookMeshBatch(const ImporterRegistry& registry,
+                     const std::vector<MeshCookJob>& jobs,
+                     const MeshCookOptions& options,
+                     uint32_t threadCount,
+                     std::vector<MeshCookResult>* out_results,
+                     const MeshCookProgressFn& progress = MeshCookProgressFn());
+}
@@ -0,0 +1,351 @@
+#include "mesh_format.h"
+#include "mesh_optimize.h"
+#include "mesh_quantize.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <utility>
+
+namespace sc_import
+{
+  namespace
+  {
+    static constexpr uint32_t kMaterialFlagEmbedded = 1u;
+    static constexpr uint32_t kLodFlagIndex16 = 1u;
+    static constexpr uint32_t kLodFlagPackedVertices = 2u;
+    static constexpr uint32_t kMaxCookedMeshString = 4096;
+
+    struct FileHeader
+    {
+      uint32_t magic = kCookedMeshMagic;
+      uint32_t version = kCookedMeshVersion;
+      uint32_t lodCount = 0;
+      uint32_t materialCount = 0;
+      uint64_t sourceHash = 0;
+      uint64_t sourceSize = 0;
+      uint64_t settingsHash = 0;
+    };
+
+    struct LodHeader
+    {
+      uint32_t vertexCount = 0;
+      uint32_t indexCount = 0;
+      uint32_t submeshCount = 0;
+      uint32_t vertexLayoutFlags = 0;
+      float screenSize = 0.0f;
+      uint32_t flags = 0;
+      MeshBounds bounds{};
+    };
+
+    struct SubmeshRecord
+    {
+      uint32_t indexOffset = 0;
+      uint32_t indexCount = 0;
+      int32_t materialIndex = -1;
+      uint32_t reserved = 0;
+    };
+
+    // Unpacked vertices are stored as the in-memory struct; a layout change is a version bump.
+    static_assert(sizeof(MeshVertex) == 32, "MeshVertex layout changed; bump kCookedMeshVersion");
+
+    template<typename T>
+    static void WriteValue(std::ofstream& out, const T& value)
+    {
+      out.write(reinterpret_cast<const char*>(&value), static_cast<std::streamsize>(sizeof(T)));
+    }
+
+    static void WriteString(std::ofstream& out, const std::string& value)
+    {
+      const uint32_t len = static_cast<uint32_t>(value.size());
+      WriteValue(out, len);
+      out.write(value.data(), static_cast<std::streamsize>(len));
+    }
+
+    static bool ValidHeader(const FileHeader& header)
+    {
+      if (header.magic != kCookedMeshMagic || header.version != kCookedMeshVersion)
+        return false;
+      return header.lodCount > 0 && header.lodCount <= kMaxCookedMeshLods;
+    }
+
+    class Reader
+    {
+    public:
+      Reader(const uint8_t* data, size_t size) : m_data(data), m_size(size) {}
+
+      bool take(void* dst, size_t bytes)
+      {
+        if (bytes > m_size - m_cursor)
+          return false;
+        std::memcpy(dst, m_data + m_cursor, bytes);
+        m_cursor += bytes;
+        return true;
+      }
+
+      bool takeString(std::string& out)
+      {
+        uint32_t len = 0;
+        if (!take(&len, sizeof(len)) || len > kMaxCookedMeshString || len > m_size - m_cursor)
+          return false;
+        out.assign(reinterpret_cast<const char*>(m_data + m_cursor), len);
+        m_cursor += len;
+        return true;
+      }
+
+      size_t remaining() const { return m_size - m_cursor; }
+
+    private:
+      const uint8_t* m_data = nullptr;
+      size_t m_size = 0;
+      size_t m_cursor = 0;
+    };
+
+    static bool ReadLod(Reader& reader, uint32_t materialCount, MeshData& out_mesh, float& out_screenSize, bool& out_packed)
+    {
+      LodHeader lod{};
+      if (!reader.take(&lod, sizeof(lod)))
+        return false;
+
+      // Reject counts the remaining payload cannot hold before allocating for them.
+      const bool index16 = (lod.flags & kLodFlagIndex16) != 0;
+      const bool packed = (lod.flags & kLodFlagPackedVertices) != 0;
+      const uint64_t indexSize = index16 ? sizeof(uint16_t) : sizeof(uint32_t);
+      const uint64_t vertexSize = packed ? sizeof(PackedMeshVertex) : sizeof(MeshVertex);
+      const uint64_t needed = static_cast<uint64_t>(lod.submeshCount) * sizeof(SubmeshRecord) +
+                              static_cast<uint64_t>(lod.vertexCount) * vertexSize +
+                              static_cast<uint64_t>(lod.indexCount) * indexSize;
+      if (needed > reader.remaining() || lod.indexCount % 3 != 0)
+        return false;
+
+      out_mesh.vertexLayoutFlags = lod.vertexLayoutFlags;
+      out_mesh.bounds = lod.bounds;
+      out_screenSize = lod.screenSize;
+      out_packed = packed;
+
+      out_mesh.submeshes.resize(lod.submeshCount);
+      for (Submesh& sm : out_mesh.submeshes)
+      {
+        SubmeshRecord record{};
+        reader.take(&record, sizeof(record));
+        if (record.indexOffset > lod.indexCount || record.indexCount > lod.indexCount - record.indexOffset)
+          return false;
+        if (record.materialIndex < -1 || record.materialIndex >= static_cast<int32_t>(materialCount))
+          return false;
+        sm.indexOffset = record.indexOffset;
+        sm.indexCount = record.indexCount;
+        sm.materialIndex = record.materialIndex;
+      }
+
+      out_mesh.vertices.resize(lod.vertexCount);
+      if (packed)
+      {
+        std::vector<PackedMeshVertex> packedVertices(lod.vertexCount);
+        reader.take(packedVertices.data(), packedVertices.size() * sizeof(PackedMeshVertex));
+        UnpackMeshVertices(packedVertices.data(), packedVertices.size(), lod.bounds, out_mesh.vertices.data());
+      }
+      else
+      {
+        reader.take(out_mesh.vertices.data(), out_mesh.vertices.size() * sizeof(MeshVertex));
+      }
+      out_mesh.indices.resize(lod.indexCount);
+      if (index16)
+      {
+        std::vector<uint16_t> narrow(lod.indexCount);
+        reader.take(narrow.data(), narrow.size() * sizeof(uint16_t));
+        std::copy(narrow.begin(), narrow.end(), out_mesh.indices.begin());
+      }
+      else
+      {
+        reader.take(out_mesh.indices.data(), out_mesh.indices.size() * sizeof(uint32_t));
+      }
+      for (uint32_t index : out_mesh.indices)
+      {
+        if (index >= lod.vertexCount)
+          return false;
+      }
+      return true;
+    }
+  }
+
+  bool IsCookedMeshPath(const char* path)
+  {
+    if (!path)
+      return false;
+    const size_t len = std::strlen(path);
+    const size_t extLen = std::strlen(kCookedMeshExtension);
+    if (len < extLen)
+      return false;
+    for (size_t i = 0; i < extLen; ++i)
+    {
+      const char a = static_cast<char>(std::tolower(static_cast<unsigned char>(path[len - extLen + i])));
+      if (a != kCookedMeshExtension[i])
+        return false;
+    }
+    return true;
+  }
+
+  bool WriteCookedMesh(const char* path, const CookedMesh& mesh)
+  {
+    if (!path || mesh.lods.empty() || mesh.lods.size() > kMaxCookedMeshLods)
+      return false;
+    if (mesh.lodScreenSizes.size() != mesh.lods.size())
+      return false;
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out.is_open())
+      return false;
+
+    FileHeader header{};
+    header.lodCount = static_cast<uint32_t>(mesh.lods.size());
+    header.materialCount = static_cast<uint32_t>(mesh.materials.size());
+    header.sourceHash = mesh.key.sourceHash;
+    header.sourceSize = mesh.key.sourceSize;
+    header.settingsHash = mesh.key.settingsHash;
+    WriteValue(out, header);
+
+    for (const ImportedMaterial& material : mesh.materials)
+    {
+      WriteString(out, material.name);
+      WriteString(out, material.baseColorTexture);
+      const uint32_t flags = material.baseColorTextureEmbedded ? kMaterialFlagEmbedded : 0u;
+      WriteValue(out, flags);
+    }
+
+    for (size_t i = 0; i < mesh.lods.size(); ++i)
+    {
+      const MeshData& data = mesh.lods[i];
+      LodHeader lod{};
+      lod.vertexCount = static_cast<uint32_t>(data.vertices.size());
+      lod.indexCount = static_cast<uint32_t>(data.indices.size());
+      lod.submeshCount = static_cast<uint32_t>(data.submeshes.size());
+      lod.vertexLayoutFlags = data.vertexLayoutFlags;
+      lod.screenSize = mesh.lodScreenSizes[i];
+      lod.flags = CanUse16BitIndices(data) ? kLodFlagIndex16 : 0u;
+      if (mesh.packedVertices)
+        lod.flags |= kLodFlagPackedVertices;
+      lod.bounds = data.bounds;
+      WriteValue(out, lod);
+
+      for (const Submesh& sm : data.submeshes)
+      {
+        SubmeshRecord record{};
+        record.indexOffset = sm.indexOffset;
+        record.indexCount = sm.indexCount;
+        record.materialIndex = sm.materialIndex;
+        WriteValue(out, record);
+      }
+      if (mesh.packedVertices)
+      {
+        std::vector<PackedMeshVertex> packed;
+        PackMeshVertices(data, &packed);
+        out.write(reinterpret_cast<const char*>(packed.data()),
+                  static_cast<std::streamsize>(packed.size() * sizeof(PackedMeshVertex)));
+      }
+      else
+      {
+        out.write(reinterpret_cast<const char*>(data.vertices.data()),
+                  static_cast<std::streamsize>(data.vertices.size() * sizeof(MeshVertex)));
+      }
+      if ((lod.flags & kLodFlagIndex16) != 0)
+      {
+        const std::vector<uint16_t> narrow(data.indices.begin(), data.indices.end());
+        out.write(reinterpret_cast<const char*>(narrow.data()),
+                  static_cast<std::streamsize>(narrow.size() * sizeof(uint16_t)));
+      }
+      else
+      {
+        out.write(reinterpret_cast<const char*>(data.indices.data()),
+                  static_cast<std::streamsize>(data.indices.size() * sizeof(uint32_t)));
+      }
+    }
+    return out.good();
+  }
+
+  bool ReadCookedMesh(const char* path, CookedMesh* out_mesh)
+  {
+    if (!path || !out_mesh)
+      return false;
+
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in.is_open())
+      return false;
+    const std::streamoff size = in.tellg();
+    if (size <= 0)
+      return false;
+    in.seekg(0, std::ios::beg);
+
+    std::vector<uint8_t> bytes(static_cast<size_t>(size));
+    in.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(size));
+    if (in.gcount() != size)
+      return false;
+    return ParseCookedMesh(bytes.data(), bytes.size(), out_mesh);
+  }
+
+  bool ParseCookedMesh(const uint8_t* data, size_t size, CookedMesh* out_mesh)
+  {
+    if (!data || !out_mesh)
+      return false;
+
+    Reader reader(data, size);
+    FileHeader header{};
+    if (!reader.take(&header, sizeof(header)) || !ValidHeader(header))
+      return false;
+
+    CookedMesh mesh{};
+    mesh.key.sourceHash = header.sourceHash;
+    mesh.key.sourceSize = header.sourceSize;
+    mesh.key.settingsHash = header.settingsHash;
+
+    // Each material needs at least its two lengths and flags.
+    if (static_cast<uint64_t>(header.materialCount) * 12u > reader.remaining())
+      return false;
+    mesh.materials.resize(header.materialCount);
+    for (ImportedMaterial& material : mesh.materials)
+    {
+      uint32_t flags = 0;
+      if (!reader.takeString(material.name) ||
+          !reader.takeString(material.baseColorTexture) ||
+          !reader.take(&flags, sizeof(flags)))
+        return false;
+      material.baseColorTextureEmbedded = (flags & kMaterialFlagEmbedded) != 0;
+    }
+
+    mesh.lods.resize(header.lodCount);
+    mesh.lodScreenSizes.resize(header.lodCount);
+    for (uint32_t i = 0; i < header.lodCount; ++i)
+    {
+      bool packed = false;
+      if (!ReadLod(reader, header.materialCount, mesh.lods[i], mesh.lodScreenSizes[i], packed))
+        return false;
+      mesh.packedVertices = mesh.packedVertices || packed;
+    }
+    if (reader.remaining() != 0)
+      return false;
+
+    *out_mesh = std::move(mesh);
+    return true;
+  }
+
+  bool ReadCookedMeshKey(const char* path, CookedMeshKey* out_key)
+  {
+    if (!path || !out_key)
+      return false;
+
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open())
+      return false;
+
+    FileHeader header{};
+    in.read(reinterpret_cast<char*>(&header), static_cast<std::streamsize>(sizeof(header)));
+    if (!in.good() || !ValidHeader(header))
+      return false;
+
+    out_key->sourceHash = header.sourceHash;
+    out_key->sourceSize = header.sourceSize;
+    out_key->settingsHash = header.settingsHash;
+    return true;
+  }
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "mesh_importer.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sc_import
+{
+  static constexpr uint32_t kCookedMeshMagic = 0x48534D53; // "SMSH"
+  static constexpr uint32_t kCookedMeshVersion = 3;
+  static constexpr uint32_t kMaxCookedMeshLods = 8;
+  static constexpr const char* kCookedMeshExtension = ".scmesh";
+
+  // Identifies what a cooked mesh was built from. A cook is reusable only when
+  // all three match the current source and settings.
+  struct CookedMeshKey
+  {
+    uint64_t sourceHash = 0;     // fnv1a64 of the source file bytes
+    uint64_t sourceSize = 0;
+    uint64_t settingsHash = 0;   // MeshCookSettingsHash()
+  };
+
+  // LODs with fewer than 65536 vertices store 16-bit indices on disk; they are
+  // widened on load because the renderer keeps one shared 32-bit index buffer.
+  // Packed vertices (PackedMeshVertex, 16 bytes) are likewise expanded to
+  // MeshVertex on load: packing saves disk and read bandwidth only.
+  struct CookedMesh
+  {
+    CookedMeshKey key{};
+    bool packedVertices = false;          // write PackedMeshVertex; set on read when the file has them
+    std::vector<MeshData> lods;           // lods[0] is the flattened source mesh
+    std::vector<float> lodScreenSizes;    // one per LOD
+    std::vector<ImportedMaterial> materials;
+  };
+
+  bool IsCookedMeshPath(const char* path);
+
+  bool WriteCookedMesh(const char* path, const CookedMesh& mesh);
+  bool ReadCookedMesh(const char* path, CookedMesh* out_mesh);
+  bool ParseCookedMesh(const uint8_t* data, size_t size, CookedMesh* out_mesh);
+  // Reads the header only; cheap enough to call for every job of a batch.
+  bool ReadCookedMeshKey(const char* path, CookedMeshKey* out_key);
+}
@@ -78,6 +78,9 @@ namespace sc_import
   struct MeshImportOptions
   {
     bool bakeNodeTransforms = true;
+    // Threads for decoding the meshes of one file; 0 picks one per hardware
+    // thread. Batch cooks that already run a file per thread pass 1.
+    uint32_t maxThreads = 0;
   };
 
   class IMeshImporter
@@ -1,21 +1,27 @@
 #define SCGLTF_IMPLEMENTATION
 #include "scgltf.h"
 
+#include "mapped_file.h"
 #include "mesh_importer.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
-#include <fstream>
+#include <limits>
 #include <memory>
 #include <string>
+#include <thread>
+#include <type_traits>
 #include <vector>
 
 namespace sc_import
 {
   namespace
   {
+    static constexpr size_t kParallelImportMinVertices = 65536;
+
     struct AccessorView
     {
       const uint8_t* data = nullptr;
@@ -71,7 +77,7 @@ namespace sc_import
         return false;
       }
 
-      const std::vector<uint8_t>& buffer = doc.buffers[bv.buffer];
+      const scgltf::Buffer& buffer = doc.buffers[bv.buffer];
       const size_t compSize = componentSize(acc.componentType);
       if (compSize == 0 || acc.components == 0)
       {
@@ -82,13 +88,13 @@ namespace sc_import
       const size_t stride = (bv.byteStride != 0) ? bv.byteStride : compSize * static_cast<size_t>(acc.components);
       const size_t start = bv.byteOffset + acc.byteOffset;
       const size_t required = start + stride * (acc.count > 0 ? (acc.count - 1) : 0) + compSize * acc.components;
-      if (required > buffer.size())
+      if (required > buffer.size)
       {
         if (out_error) *out_error = "Accessor data out of buffer bounds.";
         return false;
       }
 
-      out->data = buffer.data() + start;
+      out->data = buffer.data + start;
       out->stride = stride;
       out->count = acc.count;
       out->componentType = acc.componentType;
@@ -97,72 +103,137 @@ namespace sc_import
       return true;
     }
 
-    static float readComponentAsFloat(const uint8_t* ptr, int componentType, bool normalized)
+    template<typename T>
+    static T loadUnaligned(const uint8_t* ptr)
     {
-      switch (componentType)
+      T v{};
+      std::memcpy(&v, ptr, sizeof(T));
+      return v;
+    }
+
+    // glTF normalization: unsigned maps to [0, 1], signed to [-1, 1] with the
+    // most negative value clamped.
+    template<typename T, bool Normalized>
+    static float componentToFloat(T v)
+    {
+      if constexpr (!Normalized || std::is_same_v<T, float>)
+        return static_cast<float>(v);
+      else if constexpr (std::is_signed_v<T>)
+        return std::max(-1.0f, static_cast<float>(v) / static_cast<float>(std::numeric_limits<T>::max()));
+      else
+        return static_cast<float>(v) / static_cast<float>(std::numeric_limits<T>::max());
+    }
+
+    // Converts count elements into dst, dstStride floats apart (a MeshVertex
+    // field). FixedStride is the source stride when known at compile time,
+    // which lets tightly packed accessors vectorize; 0 uses srcStride.
+    template<typename T, bool Normalized, int Components, size_t FixedStride>
+    static void decodeStrided(const uint8_t* src, size_t srcStride, size_t count, float* dst, size_t dstStride)
+    {
+      const size_t step = FixedStride != 0 ? FixedStride : srcStride;
+      for (size_t i = 0; i < count; ++i)
       {
-        case 5126: // FLOAT
-        {
-          float v = 0.0f;
-          std::memcpy(&v, ptr, sizeof(float));
-          return v;
-        }
-        case 5121: // UNSIGNED_BYTE
-        {
-          const uint8_t v = *ptr;
-          return normalized ? (static_cast<float>(v) / 255.0f) : static_cast<float>(v);
-        }
-        case 5123: // UNSIGNED_SHORT
-        {
-          uint16_t v = 0;
-          std::memcpy(&v, ptr, sizeof(uint16_t));
-          return normalized ? (static_cast<float>(v) / 65535.0f) : static_cast<float>(v);
-        }
-        case 5125: // UNSIGNED_INT
-        {
-          uint32_t v = 0;
-          std::memcpy(&v, ptr, sizeof(uint32_t));
-          return normalized ? (static_cast<float>(v) / 4294967295.0f) : static_cast<float>(v);
-        }
-        case 5120: // BYTE
-        {
-          int8_t v = 0;
-          std::memcpy(&v, ptr, sizeof(int8_t));
-          return normalized ? (std::max(-1.0f, static_cast<float>(v) / 127.0f)) : static_cast<float>(v);
-        }
-        case 5122: // SHORT
-        {
-          int16_t v = 0;
-          std::memcpy(&v, ptr, sizeof(int16_t));
-          return normalized ? (std::max(-1.0f, static_cast<float>(v) / 32767.0f)) : static_cast<float>(v);
-        }
-        default:
-          return 0.0f;
+        const uint8_t* s = src + step * i;
+        float* d = dst + dstStride * i;
+        for (int c = 0; c < Components; ++c)
+          d[c] = componentToFloat<T, Normalized>(loadUnaligned<T>(s + sizeof(T) * c));
       }
     }
 
-    static uint32_t readIndex(const uint8_t* ptr, int componentType)
+    template<typename T, bool Normalized, int Components>
+    static void decodeTyped(const AccessorView& view, size_t count, float* dst, size_t dstStride)
     {
-      switch (componentType)
+      if (view.stride == sizeof(T) * Components)
+        decodeStrided<T, Normalized, Components, sizeof(T) * Components>(view.data, view.stride, count, dst, dstStride);
+      else
+        decodeStrided<T, Normalized, Components, 0>(view.data, view.stride, count, dst, dstStride);
+    }
+
+    // One switch per accessor instead of one per component.
+    template<int Components>
+    static bool decodeAccessor(const AccessorView& view, size_t count, float* dst, size_t dstStride)
+    {
+      if (view.components < Components || view.count < count)
+        return false;
+      switch (view.componentType)
       {
-        case 5121: return *ptr;
+        case 5126: decodeTyped<float, false, Components>(view, count, dst, dstStride); return true;
+        case 5120:
+          view.normalized ? decodeTyped<int8_t, true, Components>(view, count, dst, dstStride)
+                          : decodeTyped<int8_t, false, Components>(view, count, dst, dstStride);
+          return true;
+        case 5121:
+          view.normalized ? decodeTyped<uint8_t, true, Components>(view, count, dst, dstStride)
+                          : decodeTyped<uint8_t, false, Components>(view, count, dst, dstStride);
+          return true;
+        case 5122:
+          view.normalized ? decodeTyped<int16_t, true, Components>(view, count, dst, dstStride)
+                          : decodeTyped<int16_t, false, Components>(view, count, dst, dstStride);
+          return true;
         case 5123:
-        {
-          uint16_t v = 0;
-          std::memcpy(&v, ptr, sizeof(uint16_t));
-          return static_cast<uint32_t>(v);
-        }
+          view.normalized ? decodeTyped<uint16_t, true, Components>(view, count, dst, dstStride)
+                          : decodeTyped<uint16_t, false, Components>(view, count, dst, dstStride);
+          return true;
         case 5125:
-        {
-          uint32_t v = 0;
-          std::memcpy(&v, ptr, sizeof(uint32_t));
-          return v;
-        }
+          view.normalized ? decodeTyped<uint32_t, true, Components>(view, count, dst, dstStride)
+                          : decodeTyped<uint32_t, false, Components>(view, count, dst, dstStride);
+          return true;
         default:
-          return 0;
+          return false;
+      }
+    }
+
+    // Range checking is one max reduction after the loop, so the loop itself
+    // stays branch-free.
+    template<typename T, size_t FixedStride>
+    static bool decodeIndicesStrided(const uint8_t* src, size_t srcStride, size_t count,
+                                     uint32_t baseVertex, uint32_t vertexCount, uint32_t* dst)
+    {
+      const size_t step = FixedStride != 0 ? FixedStride : srcStride;
+      uint32_t maxIndex = 0;
+      for (size_t i = 0; i < count; ++i)
+      {
+        const uint32_t index = static_cast<uint32_t>(loadUnaligned<T>(src + step * i));
+        maxIndex = std::max(maxIndex, index);
+        dst[i] = baseVertex + index;
+      }
+      return count == 0 || maxIndex < vertexCount;
+    }
+
+    template<typename T>
+    static bool decodeIndicesTyped(const AccessorView& view, uint32_t baseVertex, uint32_t vertexCount, uint32_t* dst)
+    {
+      if (view.stride == sizeof(T))
+        return decodeIndicesStrided<T, sizeof(T)>(view.data, view.stride, view.count, baseVertex, vertexCount, dst);
+      return decodeIndicesStrided<T, 0>(view.data, view.stride, view.count, baseVertex, vertexCount, dst);
+    }
+
+    static bool decodeIndices(const AccessorView& view, uint32_t baseVertex, uint32_t vertexCount, uint32_t* dst)
+    {
+      switch (view.componentType)
+      {
+        case 5121: return decodeIndicesTyped<uint8_t>(view, baseVertex, vertexCount, dst);
+        case 5123: return decodeIndicesTyped<uint16_t>(view, baseVertex, vertexCount, dst);
+        case 5125: return decodeIndicesTyped<uint32_t>(view, baseVertex, vertexCount, dst);
+        default: return false;
       }
     }
 
+    static_assert(sizeof(MeshVertex) % sizeof(float) == 0, "MeshVertex must be made of floats");
+    static constexpr size_t kVertexStrideFloats = sizeof(MeshVertex) / sizeof(float);
+
+    struct PrimitiveViews
+    {
+      AccessorView pos{};
+      AccessorView norm{};
+      AccessorView uv{};
+      AccessorView idx{};
+      bool hasNorm = false;
+      bool hasUv = false;
+      bool hasIndices = false;
+      int material = -1;
+    };
+
     static bool buildMeshData(const scgltf::Document& doc,
                               const scgltf::Mesh& src,
                               MeshData* out_mesh,
@@ -176,75 +247,93 @@ namespace sc_import
       out_mesh->submeshes.clear();
       out_mesh->vertexLayoutFlags = VertexLayout_Position;
 
+      // Resolve every accessor first so the output is sized once and each
+      // primitive decodes straight into its slice.
+      std::vector<PrimitiveViews> prims;
+      prims.reserve(src.primitives.size());
+      size_t vertexTotal = 0;
+      size_t indexTotal = 0;
       for (const scgltf::Primitive& prim : src.primitives)
       {
         if (prim.position < 0)
           continue;
 
-        AccessorView pos{};
-        if (!resolveAccessor(doc, prim.position, &pos, out_error))
+        PrimitiveViews views{};
+        if (!resolveAccessor(doc, prim.position, &views.pos, out_error))
           return false;
-        AccessorView norm{};
-        AccessorView uv{};
-        const bool hasNorm = (prim.normal >= 0) && resolveAccessor(doc, prim.normal, &norm, nullptr);
-        const bool hasUv = (prim.texcoord0 >= 0) && resolveAccessor(doc, prim.texcoord0, &uv, nullptr);
-
-        const size_t baseVertex = out_mesh->vertices.size();
-        out_mesh->vertices.reserve(out_mesh->vertices.size() + pos.count);
-        for (size_t i = 0; i < pos.count; ++i)
+        if (views.pos.components < 3)
         {
-          const uint8_t* p = pos.data + pos.stride * i;
-          MeshVertex v{};
-          for (int c = 0; c < 3; ++c)
-            v.pos[c] = readComponentAsFloat(p + componentSize(pos.componentType) * c,
-                                            pos.componentType, pos.normalized);
-
-          if (hasNorm && norm.count > 0)
-          {
-            const uint8_t* n = norm.data + norm.stride * i;
-            for (int c = 0; c < 3; ++c)
-              v.normal[c] = readComponentAsFloat(n + componentSize(norm.componentType) * c,
-                                                 norm.componentType, norm.normalized);
-            out_mesh->vertexLayoutFlags |= VertexLayout_Normal;
-          }
-
-          if (hasUv && uv.count > 0)
-          {
-            const uint8_t* t = uv.data + uv.stride * i;
-            for (int c = 0; c < 2; ++c)
-              v.uv0[c] = readComponentAsFloat(t + componentSize(uv.componentType) * c,
-                                              uv.componentType, uv.normalized);
-            out_mesh->vertexLayoutFlags |= VertexLayout_UV0;
-          }
-          out_mesh->vertices.push_back(v);
+          if (out_error) *out_error = "POSITION accessor needs 3 components.";
+          return false;
         }
-
-        const uint32_t indexOffset = static_cast<uint32_t>(out_mesh->indices.size());
+        // Attributes shorter than POSITION are ignored rather than read past.
+        views.hasNorm = prim.normal >= 0 && resolveAccessor(doc, prim.normal, &views.norm, nullptr) &&
+                        views.norm.components >= 3 && views.norm.count >= views.pos.count;
+        views.hasUv = prim.texcoord0 >= 0 && resolveAccessor(doc, prim.texcoord0, &views.uv, nullptr) &&
+                      views.uv.components >= 2 && views.uv.count >= views.pos.count;
         if (prim.indices >= 0)
         {
-          AccessorView idx{};
-          if (!resolveAccessor(doc, prim.indices, &idx, out_error))
+          if (!resolveAccessor(doc, prim.indices, &views.idx, out_error))
             return false;
-          out_mesh->indices.reserve(out_mesh->indices.size() + idx.count);
-          for (size_t i = 0; i < idx.count; ++i)
+          views.hasIndices = true;
+        }
+        views.material = prim.material;
+
+        vertexTotal += views.pos.count;
+        indexTotal += views.hasIndices ? views.idx.count : views.pos.count;
+        prims.push_back(views);
+      }
+      if (vertexTotal > UINT32_MAX || indexTotal > UINT32_MAX)
+      {
+        if (out_error) *out_error = "Mesh too large.";
+        return false;
+      }
+
+      out_mesh->vertices.resize(vertexTotal);
+      out_mesh->indices.resize(indexTotal);
+      out_mesh->submeshes.reserve(prims.size());
+
+      size_t baseVertex = 0;
+      size_t indexOffset = 0;
+      for (const PrimitiveViews& views : prims)
+      {
+        MeshVertex* vertices = out_mesh->vertices.data() + baseVertex;
+        const size_t count = views.pos.count;
+        if (!decodeAccessor<3>(views.pos, count, vertices->pos, kVertexStrideFloats))
+        {
+          if (out_error) *out_error = "Unsupported POSITION accessor.";
+          return false;
+        }
+        if (views.hasNorm && decodeAccessor<3>(views.norm, count, vertices->normal, kVertexStrideFloats))
+          out_mesh->vertexLayoutFlags |= VertexLayout_Normal;
+        if (views.hasUv && decodeAccessor<2>(views.uv, count, vertices->uv0, kVertexStrideFloats))
+          out_mesh->vertexLayoutFlags |= VertexLayout_UV0;
+
+        uint32_t* indices = out_mesh->indices.data() + indexOffset;
+        size_t indexCount = count;
+        if (views.hasIndices)
+        {
+          indexCount = views.idx.count;
+          if (!decodeIndices(views.idx, static_cast<uint32_t>(baseVertex), static_cast<uint32_t>(count), indices))
           {
-            const uint8_t* ip = idx.data + idx.stride * i;
-            const uint32_t index = readIndex(ip, idx.componentType);
-            out_mesh->indices.push_back(static_cast<uint32_t>(baseVertex) + index);
+            if (out_error) *out_error = "Index out of range.";
+            return false;
           }
         }
         else
         {
-          out_mesh->indices.reserve(out_mesh->indices.size() + pos.count);
-          for (uint32_t i = 0; i < pos.count; ++i)
-            out_mesh->indices.push_back(static_cast<uint32_t>(baseVertex) + i);
+          for (size_t i = 0; i < count; ++i)
+            indices[i] = static_cast<uint32_t>(baseVertex + i);
         }
 
         Submesh sm{};
-        sm.indexOffset = indexOffset;
-        sm.indexCount = static_cast<uint32_t>(out_mesh->indices.size() - indexOffset);
-        sm.materialIndex = prim.material;
+        sm.indexOffset = static_cast<uint32_t>(indexOffset);
+        sm.indexCount = static_cast<uint32_t>(indexCount);
+        sm.materialIndex = views.material;
         out_mesh->submeshes.push_back(sm);
+
+        baseVertex += count;
+        indexOffset += indexCount;
       }
 
       if (!out_mesh->vertices.empty())
@@ -338,18 +427,66 @@ namespace sc_import
       mat4_from_trs(node.translation, node.rotation, node.scale, out);
     }
 
-    static bool readFileBytes(const char* path, std::vector<uint8_t>& out)
+    static size_t pickMeshThreads(const scgltf::Document& doc, const MeshImportOptions& options)
     {
-      std::ifstream file(path, std::ios::binary | std::ios::ate);
-      if (!file.is_open())
-        return false;
-      const std::streamsize size = file.tellg();
-      if (size <= 0)
-        return false;
-      out.resize(static_cast<size_t>(size));
-      file.seekg(0, std::ios::beg);
-      if (!file.read(reinterpret_cast<char*>(out.data()), size))
-        return false;
+      if (doc.meshes.size() < 2)
+        return 1;
+      size_t vertexCount = 0;
+      for (const scgltf::Mesh& m : doc.meshes)
+      {
+        for (const scgltf::Primitive& prim : m.primitives)
+        {
+          if (prim.position >= 0 && prim.position < static_cast<int>(doc.accessors.size()))
+            vertexCount += doc.accessors[prim.position].count;
+        }
+      }
+      // Small files finish before a thread would start.
+      if (vertexCount < kParallelImportMinVertices)
+        return 1;
+      size_t threads = options.maxThreads != 0 ? options.maxThreads : std::thread::hardware_concurrency();
+      return std::max<size_t>(1, std::min(threads, doc.meshes.size()));
+    }
+
+    // Meshes are independent, so multi-mesh files (city blocks) decode in
+    // parallel. Errors are reported for the first failing mesh in file order.
+    static bool buildMeshes(const scgltf::Document& doc,
+                            const MeshImportOptions& options,
+                            std::vector<ImportedMesh>& out_meshes,
+                            std::string* out_error)
+    {
+      const size_t meshCount = doc.meshes.size();
+      std::vector<std::string> errors(meshCount);
+      std::vector<uint8_t> ok(meshCount, 0);
+      std::atomic<size_t> next{ 0 };
+      auto worker = [&]()
+      {
+        for (;;)
+        {
+          const size_t i = next.fetch_add(1, std::memory_order_relaxed);
+          if (i >= meshCount)
+            return;
+          out_meshes[i].name = doc.meshes[i].name;
+          ok[i] = buildMeshData(doc, doc.meshes[i], &out_meshes[i].mesh, &errors[i]) ? 1 : 0;
+        }
+      };
+
+      const size_t threadCount = pickMeshThreads(doc, options);
+      std::vector<std::thread> threads;
+      threads.reserve(threadCount - 1);
+      for (size_t i = 1; i < threadCount; ++i)
+        threads.emplace_back(worker);
+      worker();
+      for (std::thread& thread : threads)
+        thread.join();
+
+      for (size_t i = 0; i < meshCount; ++i)
+      {
+        if (!ok[i])
+        {
+          if (out_error) *out_error = errors[i];
+          return false;
+        }
+      }
       return true;
     }
   }
@@ -371,29 +508,24 @@ namespace sc_import
     {
       if (!absPath || !out_model)
         return false;
-      (void)options;
 
-      std::vector<uint8_t> bytes;
-      if (!readFileBytes(absPath, bytes))
+      // The document's buffers point into the mapping, so it stays open
+      // until the model is built.
+      MappedFile file;
+      if (!file.open(absPath))
       {
         if (out_error) *out_error = "Failed to read GLB file.";
         return false;
       }
 
       scgltf::Document doc{};
-      if (!scgltf::parseGlb(bytes.data(), bytes.size(), &doc, out_error))
+      if (!scgltf::parseGlb(file.data(), file.size(), &doc, out_error))
         return false;
 
       ImportedModel model{};
-      model.meshes.reserve(doc.meshes.size());
-      for (const scgltf::Mesh& m : doc.meshes)
-      {
-        ImportedMesh mesh{};
-        mesh.name = m.name;
-        if (!buildMeshData(doc, m, &mesh.mesh, out_error))
-          return false;
-        model.meshes.push_back(std::move(mesh));
-      }
+      model.meshes.resize(doc.meshes.size());
+      if (!buildMeshes(doc, options, model.meshes, out_error))
+        return false;
 
       model.materials.reserve(doc.materials.size());
       for (const scgltf::Material& mat : doc.materials)
@@ -0,0 +1,215 @@
+#include "mesh_lod.h"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+namespace sc_import
+{
+  namespace
+  {
+    struct Cluster
+    {
+      float pos[3] = { 0.0f, 0.0f, 0.0f };
+      float normal[3] = { 0.0f, 0.0f, 0.0f };
+      float uv0[2] = { 0.0f, 0.0f };
+      uint32_t count = 0;
+      uint32_t outIndex = UINT32_MAX;
+    };
+
+    static uint64_t cellKey(const MeshData& mesh, const MeshVertex& v, uint32_t resolution, float cellSize)
+    {
+      uint64_t key = 0;
+      for (int axis = 0; axis < 3; ++axis)
+      {
+        const float rel = (v.pos[axis] - mesh.bounds.min[axis]) / cellSize;
+        uint64_t cell = rel > 0.0f ? static_cast<uint64_t>(rel) : 0u;
+        if (cell >= resolution)
+          cell = resolution - 1u;
+        key = (key << 21) | (cell & 0x1FFFFFu);
+      }
+      return key;
+    }
+
+    // Collapses every vertex inside a grid cell into one averaged vertex and
+    // drops triangles that become degenerate.
+    static void clusterMesh(const MeshData& src, uint32_t resolution, MeshData* out)
+    {
+      out->vertices.clear();
+      out->indices.clear();
+      out->submeshes.clear();
+      out->vertexLayoutFlags = src.vertexLayoutFlags;
+
+      float extent = 0.0f;
+      for (int axis = 0; axis < 3; ++axis)
+        extent = std::max(extent, src.bounds.max[axis] - src.bounds.min[axis]);
+      const float cellSize = std::max(extent, 1e-6f) / static_cast<float>(resolution);
+
+      std::unordered_map<uint64_t, uint32_t> cellToCluster;
+      cellToCluster.reserve(src.vertices.size());
+      std::vector<Cluster> clusters;
+      std::vector<uint32_t> vertexCluster(src.vertices.size());
+      for (size_t i = 0; i < src.vertices.size(); ++i)
+      {
+        const MeshVertex& v = src.vertices[i];
+        const uint64_t key = cellKey(src, v, resolution, cellSize);
+        auto it = cellToCluster.find(key);
+        uint32_t id = 0;
+        if (it == cellToCluster.end())
+        {
+          id = static_cast<uint32_t>(clusters.size());
+          cellToCluster.emplace(key, id);
+          clusters.emplace_back();
+        }
+        else
+        {
+          id = it->second;
+        }
+
+        Cluster& c = clusters[id];
+        for (int k = 0; k < 3; ++k)
+        {
+          c.pos[k] += v.pos[k];
+          c.normal[k] += v.normal[k];
+        }
+        c.uv0[0] += v.uv0[0];
+        c.uv0[1] += v.uv0[1];
+        c.count++;
+        vertexCluster[i] = id;
+      }
+
+      auto emitVertex = [&](uint32_t clusterId)
+      {
+        Cluster& c = clusters[clusterId];
+        if (c.outIndex != UINT32_MAX)
+          return c.outIndex;
+
+        const float inv = 1.0f / static_cast<float>(c.count);
+        MeshVertex v{};
+        for (int k = 0; k < 3; ++k)
+          v.pos[k] = c.pos[k] * inv;
+        const float len = std::sqrt(c.normal[0] * c.normal[0] + c.normal[1] * c.normal[1] + c.normal[2] * c.normal[2]);
+        if (len > 1e-6f)
+        {
+          for (int k = 0; k < 3; ++k)
+            v.normal[k] = c.normal[k] / len;
+        }
+        v.uv0[0] = c.uv0[0] * inv;
+        v.uv0[1] = c.uv0[1] * inv;
+
+        c.outIndex = static_cast<uint32_t>(out->vertices.size());
+        out->vertices.push_back(v);
+        return c.outIndex;
+      };
+
+      auto emitRange = [&](uint32_t indexOffset, uint32_t indexCount)
+      {
+        const uint32_t end = std::min<uint32_t>(indexOffset + indexCount, static_cast<uint32_t>(src.indices.size()));
+        for (uint32_t i = indexOffset; i + 2 < end; i += 3)
+        {
+          const uint32_t a = vertexCluster[src.indices[i + 0]];
+          const uint32_t b = vertexCluster[src.indices[i + 1]];
+          const uint32_t c = vertexCluster[src.indices[i + 2]];
+          if (a == b || b == c || a == c)
+            continue;
+          out->indices.push_back(emitVertex(a));
+          out->indices.push_back(emitVertex(b));
+          out->indices.push_back(emitVertex(c));
+        }
+      };
+
+      if (src.submeshes.empty())
+      {
+        emitRange(0, static_cast<uint32_t>(src.indices.size()));
+      }
+      else
+      {
+        for (const Submesh& sm : src.submeshes)
+        {
+          Submesh outSm = sm;
+          outSm.indexOffset = static_cast<uint32_t>(out->indices.size());
+          emitRange(sm.indexOffset, sm.indexCount);
+          outSm.indexCount = static_cast<uint32_t>(out->indices.size()) - outSm.indexOffset;
+          if (outSm.indexCount > 0)
+            out->submeshes.push_back(outSm);
+        }
+      }
+
+      ComputeMeshBounds(out);
+    }
+  }
+
+  bool GenerateMeshLods(const MeshData& source,
+                        const MeshLodOptions& options,
+                        MeshLodChain* out_chain,
+                        std::string* out_error)
+  {
+    if (!out_chain)
+      return false;
+    out_chain->lods.clear();
+    out_chain->screenSizes.clear();
+
+    if (source.vertices.empty() || source.indices.size() < 3)
+    {
+      if (out_error) *out_error = "Mesh has no triangles to reduce.";
+      return false;
+    }
+
+    out_chain->lods.push_back(source);
+    out_chain->screenSizes.push_back(options.screenSizes[0]);
+
+    const uint32_t lodCount = std::min(std::max(options.lodCount, 1u), kMaxGeneratedLods);
+    const uint32_t sourceTriangles = static_cast<uint32_t>(source.indices.size() / 3);
+
+    for (uint32_t lod = 1; lod < lodCount; ++lod)
+    {
+      const MeshData& prev = out_chain->lods.back();
+      const uint32_t prevTriangles = static_cast<uint32_t>(prev.indices.size() / 3);
+      const float ratio = std::min(std::max(options.triangleRatios[lod], 0.0f), 1.0f);
+      const uint32_t target = static_cast<uint32_t>(static_cast<float>(sourceTriangles) * ratio);
+      if (target < options.minTriangles || target >= prevTriangles)
+        break;
+
+      MeshData best{};
+      if (options.method == MeshLodMethod::Quadric)
+      {
+        if (!SimplifyMesh(prev, target, options.simplify, &best, nullptr))
+          break;
+        // Locked borders or the error limit can stall well short of the
+        // target; a level that barely differs is not worth a draw switch.
+        if (static_cast<float>(best.indices.size() / 3) > static_cast<float>(prevTriangles) * 0.9f)
+          break;
+      }
+      else
+      {
+        // Finest grid that still meets the target; triangle count grows with resolution.
+        uint32_t lo = 1;
+        uint32_t hi = 1024;
+        while (lo <= hi)
+        {
+          const uint32_t mid = lo + (hi - lo) / 2;
+          MeshData candidate{};
+          clusterMesh(source, mid, &candidate);
+          const uint32_t triangles = static_cast<uint32_t>(candidate.indices.size() / 3);
+          if (triangles <= target)
+          {
+            best = std::move(candidate);
+            lo = mid + 1;
+          }
+          else
+          {
+            hi = mid - 1;
+          }
+        }
+      }
+
+      const uint32_t bestTriangles = static_cast<uint32_t>(best.indices.size() / 3);
+      if (bestTriangles < options.minTriangles || bestTriangles >= prevTriangles)
+        break;
+
+      out_chain->lods.push_back(std::move(best));
+      out_chain->screenSizes.push_back(options.screenSizes[lod]);
+    }
+    return true;
+  }
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "mesh_importer.h"
+#include "mesh_simplify.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sc_import
+{
+  static constexpr uint32_t kMaxGeneratedLods = 4;
+
+  enum class MeshLodMethod : uint32_t
+  {
+    Quadric = 0,      // edge collapse, see SimplifyMesh()
+    Clustering = 1    // uniform grid; cheaper, much lower quality
+  };
+
+  struct MeshLodOptions
+  {
+    uint32_t lodCount = kMaxGeneratedLods;              // including LOD 0
+    MeshLodMethod method = MeshLodMethod::Quadric;
+    // Target triangles relative to LOD 0; [0] is unused.
+    float triangleRatios[kMaxGeneratedLods] = { 1.0f, 0.5f, 0.25f, 0.1f };
+    uint32_t minTriangles = 16;                         // stop once a LOD would drop below this
+    float screenSizes[kMaxGeneratedLods] = { 1.0f, 0.25f, 0.1f, 0.04f };
+    MeshSimplifyOptions simplify{};                     // Quadric only
+  };
+
+  struct MeshLodChain
+  {
+    std::vector<MeshData> lods;  // lods[0] is the source mesh
+    std::vector<float> screenSizes;
+  };
+
+  // Builds progressively coarser meshes, each simplified from the one before
+  // it. Submesh ranges are kept; levels that cannot reduce the mesh
+  // meaningfully (locked borders, error limit) end the chain early.
+  bool GenerateMeshLods(const MeshData& source,
+                        const MeshLodOptions& options,
+                        MeshLodChain* out_chain,
+                        std::string* out_error);
+}
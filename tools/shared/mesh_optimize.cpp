@@ -0,0 +1,476 @@
+#include "mesh_optimize.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace sc_import
+{
+  namespace
+  {
+    struct IndexRange
+    {
+      uint32_t offset = 0;
+      uint32_t count = 0;   // whole triangles only
+    };
+
+    // Passes reorder triangles inside a submesh, never across, so material ranges stay valid.
+    static std::vector<IndexRange> TriangleRanges(const MeshData& mesh)
+    {
+      std::vector<IndexRange> ranges;
+      const uint32_t total = static_cast<uint32_t>(mesh.indices.size());
+      if (mesh.submeshes.empty())
+      {
+        ranges.push_back({ 0u, total - total % 3u });
+        return ranges;
+      }
+      for (const Submesh& sm : mesh.submeshes)
+      {
+        if (sm.indexOffset >= total)
+          continue;
+        const uint32_t count = std::min(sm.indexCount, total - sm.indexOffset);
+        ranges.push_back({ sm.indexOffset, count - count % 3u });
+      }
+      return ranges;
+    }
+
+    static uint32_t HashVertex(const MeshVertex& v)
+    {
+      uint32_t words[sizeof(MeshVertex) / 4];
+      std::memcpy(words, &v, sizeof(words));
+      uint32_t h = 2166136261u;
+      for (uint32_t w : words)
+      {
+        h ^= w;
+        h *= 16777619u;
+        h ^= h >> 15;
+      }
+      return h;
+    }
+
+    // Maps each index range onto dense local vertex ids so per-submesh work
+    // scales with the submesh, not the whole mesh.
+    class LocalVertices
+    {
+    public:
+      explicit LocalVertices(size_t vertexCount) : m_localOf(vertexCount, UINT32_MAX) {}
+
+      void build(const uint32_t* indices, uint32_t count, std::vector<uint32_t>& out_local)
+      {
+        out_local.resize(count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+          uint32_t& local = m_localOf[indices[i]];
+          if (local == UINT32_MAX)
+          {
+            local = static_cast<uint32_t>(m_globalOf.size());
+            m_globalOf.push_back(indices[i]);
+          }
+          out_local[i] = local;
+        }
+      }
+
+      void reset()
+      {
+        for (uint32_t global : m_globalOf)
+          m_localOf[global] = UINT32_MAX;
+        m_globalOf.clear();
+      }
+
+      uint32_t count() const { return static_cast<uint32_t>(m_globalOf.size()); }
+      uint32_t global(uint32_t local) const { return m_globalOf[local]; }
+
+    private:
+      std::vector<uint32_t> m_localOf;
+      std::vector<uint32_t> m_globalOf;
+    };
+
+    static void Tipsify(const std::vector<uint32_t>& indices,
+                        uint32_t vertexCount,
+                        uint32_t cacheSize,
+                        std::vector<uint32_t>& out_indices)
+    {
+      const uint32_t triCount = static_cast<uint32_t>(indices.size() / 3);
+
+      // Vertex -> triangle adjacency in CSR form; live counts triangles not yet emitted.
+      std::vector<uint32_t> live(vertexCount, 0);
+      for (uint32_t index : indices)
+        ++live[index];
+      std::vector<uint32_t> adjOffset(vertexCount + 1, 0);
+      for (uint32_t v = 0; v < vertexCount; ++v)
+        adjOffset[v + 1] = adjOffset[v] + live[v];
+      std::vector<uint32_t> adjacency(indices.size());
+      {
+        std::vector<uint32_t> fill(adjOffset.begin(), adjOffset.end() - 1);
+        for (uint32_t t = 0; t < triCount; ++t)
+        {
+          for (uint32_t c = 0; c < 3; ++c)
+            adjacency[fill[indices[t * 3 + c]]++] = t;
+        }
+      }
+
+      std::vector<uint32_t> cacheTime(vertexCount, 0);
+      std::vector<uint8_t> emitted(triCount, 0);
+      std::vector<uint32_t> deadEnd;
+      std::vector<uint32_t> candidates;
+      deadEnd.reserve(indices.size());
+      candidates.reserve(64);
+      out_indices.clear();
+      out_indices.reserve(indices.size());
+
+      uint32_t time = cacheSize + 1;
+      uint32_t cursor = 0;
+      int64_t fan = 0;
+      while (fan >= 0)
+      {
+        const uint32_t f = static_cast<uint32_t>(fan);
+        candidates.clear();
+        for (uint32_t a = adjOffset[f]; a < adjOffset[f + 1]; ++a)
+        {
+          const uint32_t t = adjacency[a];
+          if (emitted[t])
+            continue;
+          emitted[t] = 1;
+          for (uint32_t c = 0; c < 3; ++c)
+          {
+            const uint32_t v = indices[t * 3 + c];
+            out_indices.push_back(v);
+            deadEnd.push_back(v);
+            candidates.push_back(v);
+            --live[v];
+            if (time - cacheTime[v] > cacheSize)
+              cacheTime[v] = time++;
+          }
+        }
+
+        // Prefer the candidate that stays in cache longest while its remaining
+        // triangles are emitted; otherwise fall back to recent dead ends.
+        int64_t next = -1;
+        int64_t best = -1;
+        for (uint32_t v : candidates)
+        {
+          if (live[v] == 0)
+            continue;
+          int64_t priority = 0;
+          if (time - cacheTime[v] + 2u * live[v] <= cacheSize)
+            priority = time - cacheTime[v];
+          if (priority > best)
+          {
+            best = priority;
+            next = v;
+          }
+        }
+
+        if (next < 0)
+        {
+          while (!deadEnd.empty() && next < 0)
+          {
+            const uint32_t d = deadEnd.back();
+            deadEnd.pop_back();
+            if (live[d] > 0)
+              next = d;
+          }
+          while (next < 0 && cursor < vertexCount)
+          {
+            if (live[cursor] > 0)
+              next = cursor;
+            ++cursor;
+          }
+        }
+        fan = next;
+      }
+    }
+
+    static void SortClusters(const MeshData& mesh,
+                             uint32_t* indices,
+                             uint32_t count,
+                             uint32_t cacheSize,
+                             std::vector<uint32_t>& scratchTime)
+    {
+      const uint32_t triCount = count / 3;
+      if (triCount < 2)
+        return;
+
+      struct Cluster
+      {
+        uint32_t firstTri = 0;
+        uint32_t triCount = 0;
+        float sortKey = 0.0f;
+      };
+
+      // Cluster boundaries: triangles whose three vertices all miss the cache.
+      std::vector<Cluster> clusters;
+      uint32_t time = cacheSize + 1;
+      std::vector<uint32_t> touched;
+      touched.reserve(count);
+      for (uint32_t t = 0; t < triCount; ++t)
+      {
+        uint32_t misses = 0;
+        for (uint32_t c = 0; c < 3; ++c)
+        {
+          const uint32_t v = indices[t * 3 + c];
+          if (time - scratchTime[v] > cacheSize)
+          {
+            if (scratchTime[v] == 0)
+              touched.push_back(v);
+            scratchTime[v] = time++;
+            ++misses;
+          }
+        }
+        if (clusters.empty() || misses == 3)
+          clusters.push_back({ t, 0u, 0.0f });
+        ++clusters.back().triCount;
+      }
+      for (uint32_t v : touched)
+        scratchTime[v] = 0;
+      if (clusters.size() < 2)
+        return;
+
+      auto triangleGeometry = [&](uint32_t t, float out_centroid[3], float out_normal[3])
+      {
+        const float* p0 = mesh.vertices[indices[t * 3 + 0]].pos;
+        const float* p1 = mesh.vertices[indices[t * 3 + 1]].pos;
+        const float* p2 = mesh.vertices[indices[t * 3 + 2]].pos;
+        const float e1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+        const float e2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+        // Cross product length is twice the area, so these sums are area weighted.
+        out_normal[0] = e1[1] * e2[2] - e1[2] * e2[1];
+        out_normal[1] = e1[2] * e2[0] - e1[0] * e2[2];
+        out_normal[2] = e1[0] * e2[1] - e1[1] * e2[0];
+        for (int a = 0; a < 3; ++a)
+          out_centroid[a] = (p0[a] + p1[a] + p2[a]) / 3.0f;
+      };
+
+      float meshCenter[3] = { 0.0f, 0.0f, 0.0f };
+      float meshArea = 0.0f;
+      for (uint32_t t = 0; t < triCount; ++t)
+      {
+        float centroid[3];
+        float normal[3];
+        triangleGeometry(t, centroid, normal);
+        const float area = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+        for (int a = 0; a < 3; ++a)
+          meshCenter[a] += centroid[a] * area;
+        meshArea += area;
+      }
+      if (meshArea <= 0.0f)
+        return;
+      for (float& c : meshCenter)
+        c /= meshArea;
+
+      for (Cluster& cluster : clusters)
+      {
+        float center[3] = { 0.0f, 0.0f, 0.0f };
+        float normal[3] = { 0.0f, 0.0f, 0.0f };
+        float area = 0.0f;
+        for (uint32_t t = cluster.firstTri; t < cluster.firstTri + cluster.triCount; ++t)
+        {
+          float triCentroid[3];
+          float triNormal[3];
+          triangleGeometry(t, triCentroid, triNormal);
+          const float triArea = std::sqrt(triNormal[0] * triNormal[0] + triNormal[1] * triNormal[1] + triNormal[2] * triNormal[2]);
+          for (int a = 0; a < 3; ++a)
+          {
+            center[a] += triCentroid[a] * triArea;
+            normal[a] += triNormal[a];
+          }
+          area += triArea;
+        }
+        const float normalLen = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+        if (area <= 0.0f || normalLen <= 0.0f)
+          continue;
+        // Clusters facing away from the centre occlude the rest from most views.
+        for (int a = 0; a < 3; ++a)
+          cluster.sortKey += (center[a] / area - meshCenter[a]) * (normal[a] / normalLen);
+      }
+
+      std::stable_sort(clusters.begin(), clusters.end(), [](const Cluster& a, const Cluster& b)
+      {
+        return a.sortKey > b.sortKey;
+      });
+
+      std::vector<uint32_t> sorted;
+      sorted.reserve(count);
+      for (const Cluster& cluster : clusters)
+        sorted.insert(sorted.end(), indices + cluster.firstTri * 3, indices + (cluster.firstTri + cluster.triCount) * 3);
+      std::copy(sorted.begin(), sorted.end(), indices);
+    }
+  }
+
+  VertexCacheStats AnalyzeVertexCache(const MeshData& mesh, uint32_t cacheSize)
+  {
+    VertexCacheStats stats{};
+    if (mesh.indices.size() < 3 || cacheSize == 0)
+      return stats;
+
+    std::vector<uint32_t> insertedAt(mesh.vertices.size(), 0);
+    std::vector<uint8_t> referenced(mesh.vertices.size(), 0);
+    uint32_t time = cacheSize + 1;
+    uint32_t uniqueVertices = 0;
+    const size_t count = mesh.indices.size() - mesh.indices.size() % 3;
+    for (size_t i = 0; i < count; ++i)
+    {
+      const uint32_t v = mesh.indices[i];
+      if (v >= mesh.vertices.size())
+        continue;
+      if (!referenced[v])
+      {
+        referenced[v] = 1;
+        ++uniqueVertices;
+      }
+      // FIFO: hits do not refresh an entry.
+      if (time - insertedAt[v] > cacheSize)
+      {
+        insertedAt[v] = time++;
+        ++stats.misses;
+      }
+    }
+
+    stats.acmr = static_cast<float>(stats.misses) / static_cast<float>(count / 3);
+    if (uniqueVertices > 0)
+      stats.atvr = static_cast<float>(stats.misses) / static_cast<float>(uniqueVertices);
+    return stats;
+  }
+
+  uint32_t WeldMeshVertices(MeshData* mesh)
+  {
+    if (!mesh || mesh->vertices.empty())
+      return 0;
+
+    const size_t vertexCount = mesh->vertices.size();
+    size_t tableSize = 1;
+    while (tableSize < vertexCount * 2)
+      tableSize <<= 1;
+    const size_t mask = tableSize - 1;
+
+    std::vector<uint32_t> table(tableSize, UINT32_MAX);   // welded vertex ids
+    std::vector<uint32_t> remap(vertexCount, UINT32_MAX);
+    std::vector<MeshVertex> welded;
+    welded.reserve(vertexCount);
+
+    for (uint32_t& index : mesh->indices)
+    {
+      if (index >= vertexCount)
+        continue;
+      uint32_t& mapped = remap[index];
+      if (mapped == UINT32_MAX)
+      {
+        const MeshVertex& v = mesh->vertices[index];
+        size_t slot = HashVertex(v) & mask;
+        for (;;)
+        {
+          const uint32_t candidate = table[slot];
+          if (candidate == UINT32_MAX)
+          {
+            mapped = static_cast<uint32_t>(welded.size());
+            table[slot] = mapped;
+            welded.push_back(v);
+            break;
+          }
+          if (std::memcmp(&welded[candidate], &v, sizeof(MeshVertex)) == 0)
+          {
+            mapped = candidate;
+            break;
+          }
+          slot = (slot + 1) & mask;
+        }
+      }
+      index = mapped;
+    }
+
+    mesh->vertices = std::move(welded);
+    return static_cast<uint32_t>(mesh->vertices.size());
+  }
+
+  void OptimizeVertexCache(MeshData* mesh, uint32_t cacheSize)
+  {
+    if (!mesh || mesh->indices.size() < 3 || cacheSize < 3)
+      return;
+
+    LocalVertices local(mesh->vertices.size());
+    std::vector<uint32_t> localIndices;
+    std::vector<uint32_t> ordered;
+    for (const IndexRange& range : TriangleRanges(*mesh))
+    {
+      if (range.count < 6)
+        continue;
+      uint32_t* indices = mesh->indices.data() + range.offset;
+      local.build(indices, range.count, localIndices);
+      Tipsify(localIndices, local.count(), cacheSize, ordered);
+      for (uint32_t i = 0; i < range.count; ++i)
+        indices[i] = local.global(ordered[i]);
+      local.reset();
+    }
+  }
+
+  void OptimizeOverdraw(MeshData* mesh, uint32_t cacheSize)
+  {
+    if (!mesh || mesh->indices.size() < 6 || cacheSize < 3)
+      return;
+
+    std::vector<uint32_t> scratchTime(mesh->vertices.size(), 0);
+    for (const IndexRange& range : TriangleRanges(*mesh))
+      SortClusters(*mesh, mesh->indices.data() + range.offset, range.count, cacheSize, scratchTime);
+  }
+
+  void OptimizeVertexFetch(MeshData* mesh)
+  {
+    if (!mesh || mesh->vertices.empty())
+      return;
+
+    const size_t vertexCount = mesh->vertices.size();
+    std::vector<uint32_t> remap(vertexCount, UINT32_MAX);
+    std::vector<MeshVertex> ordered;
+    ordered.reserve(vertexCount);
+    for (uint32_t& index : mesh->indices)
+    {
+      if (index >= vertexCount)
+        continue;
+      if (remap[index] == UINT32_MAX)
+      {
+        remap[index] = static_cast<uint32_t>(ordered.size());
+        ordered.push_back(mesh->vertices[index]);
+      }
+      index = remap[index];
+    }
+    mesh->vertices = std::move(ordered);
+  }
+
+  void OptimizeMesh(MeshData* mesh, const MeshOptimizeOptions& options, MeshOptimizeStats* out_stats)
+  {
+    if (!mesh)
+      return;
+
+    const size_t verticesBefore = mesh->vertices.size();
+    if (out_stats)
+    {
+      out_stats->verticesBefore = static_cast<uint32_t>(verticesBefore);
+      out_stats->before = AnalyzeVertexCache(*mesh, options.cacheSize);
+    }
+
+    if (options.weldVertices)
+      WeldMeshVertices(mesh);
+    if (options.optimizeVertexCache)
+      OptimizeVertexCache(mesh, options.cacheSize);
+    if (options.optimizeOverdraw)
+      OptimizeOverdraw(mesh, options.cacheSize);
+    if (options.optimizeVertexFetch)
+      OptimizeVertexFetch(mesh);
+
+    // Welding and fetch remapping drop unreferenced vertices, which can shrink the bounds.
+    if (mesh->vertices.size() != verticesBefore)
+      ComputeMeshBounds(mesh);
+
+    if (out_stats)
+    {
+      out_stats->verticesAfter = static_cast<uint32_t>(mesh->vertices.size());
+      out_stats->after = AnalyzeVertexCache(*mesh, options.cacheSize);
+    }
+  }
+
+  bool CanUse16BitIndices(const MeshData& mesh)
+  {
+    return mesh.vertices.size() < 65536u;
+  }
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "mesh_importer.h"
+
+#include <cstdint>
+
+namespace sc_import
+{
+  static constexpr uint32_t kDefaultVertexCacheSize = 16;
+
+  struct MeshOptimizeOptions
+  {
+    bool weldVertices = true;
+    bool optimizeVertexCache = true;
+    bool optimizeOverdraw = true;
+    bool optimizeVertexFetch = true;
+    uint32_t cacheSize = kDefaultVertexCacheSize;   // FIFO entries assumed by the cache passes
+  };
+
+  // Post-transform cache behaviour of an index buffer under a FIFO cache.
+  struct VertexCacheStats
+  {
+    uint32_t misses = 0;
+    float acmr = 0.0f;   // misses per triangle; 0.5 is the floor for large regular grids
+    float atvr = 0.0f;   // misses per referenced vertex; 1.0 is ideal
+  };
+
+  struct MeshOptimizeStats
+  {
+    uint32_t verticesBefore = 0;
+    uint32_t verticesAfter = 0;
+    VertexCacheStats before{};
+    VertexCacheStats after{};
+  };
+
+  VertexCacheStats AnalyzeVertexCache(const MeshData& mesh, uint32_t cacheSize);
+
+  // Merges bit-identical vertices and drops unreferenced ones. Returns the new vertex count.
+  uint32_t WeldMeshVertices(MeshData* mesh);
+  // Tipsify (Sander et al. 2007) triangle order within each submesh.
+  void OptimizeVertexCache(MeshData* mesh, uint32_t cacheSize);
+  // Splits each submesh at cache-cold points and draws outward-facing clusters first;
+  // costs little cache efficiency since each cluster starts cold anyway.
+  void OptimizeOverdraw(MeshData* mesh, uint32_t cacheSize);
+  // Renumbers vertices in first-use order so vertex fetch walks memory linearly.
+  void OptimizeVertexFetch(MeshData* mesh);
+
+  // Runs the enabled passes in order: weld, cache, overdraw, fetch.
+  void OptimizeMesh(MeshData* mesh, const MeshOptimizeOptions& options, MeshOptimizeStats* out_stats);
+
+  // True when every index fits in 16 bits, i.e. fewer than 65536 vertices.
+  bool CanUse16BitIndices(const MeshData& mesh);
+}
@@ -0,0 +1,205 @@
+#include "mesh_quantize.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace sc_import
+{
+  namespace
+  {
+    static constexpr double kPi = 3.14159265358979323846;
+
+    static float signNotZero(float v)
+    {
+      return v >= 0.0f ? 1.0f : -1.0f;
+    }
+
+    static int16_t quantizeSnorm16(float v)
+    {
+      const float clamped = std::min(std::max(v, -1.0f), 1.0f);
+      return static_cast<int16_t>(std::lround(clamped * 32767.0f));
+    }
+
+    static float dequantizeSnorm16(int16_t v)
+    {
+      return std::max(static_cast<float>(v) / 32767.0f, -1.0f);
+    }
+
+    static uint16_t quantizeUnorm16(float v, float lo, float hi)
+    {
+      const float range = hi - lo;
+      if (!(range > 0.0f))
+        return 0;
+      const float t = std::min(std::max((v - lo) / range, 0.0f), 1.0f);
+      return static_cast<uint16_t>(std::lround(t * 65535.0f));
+    }
+
+    static float dequantizeUnorm16(uint16_t v, float lo, float hi)
+    {
+      return lo + (hi - lo) * (static_cast<float>(v) / 65535.0f);
+    }
+  }
+
+  uint16_t FloatToHalf(float value)
+  {
+    uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const uint16_t sign = static_cast<uint16_t>((bits >> 16) & 0x8000u);
+    const uint32_t magnitude = bits & 0x7FFFFFFFu;
+
+    if (magnitude >= 0x7F800000u)
+      return static_cast<uint16_t>(sign | 0x7C00u | (magnitude > 0x7F800000u ? 0x0200u : 0u));
+    // 65520 and above rounds past the largest half (65504).
+    if (magnitude >= 0x477FF000u)
+      return static_cast<uint16_t>(sign | 0x7C00u);
+    // Below 2^-14 the result is subnormal: a plain multiple of 2^-24.
+    if (magnitude < 0x38800000u)
+    {
+      float abs = 0.0f;
+      std::memcpy(&abs, &magnitude, sizeof(abs));
+      return static_cast<uint16_t>(sign | static_cast<uint16_t>(std::nearbyint(abs * 16777216.0f)));
+    }
+
+    // Rebias the exponent from 127 to 15 and round the mantissa to nearest even.
+    const uint32_t rebased = magnitude - 0x38000000u;
+    return static_cast<uint16_t>(sign | ((rebased + 0x0FFFu + ((rebased >> 13) & 1u)) >> 13));
+  }
+
+  float HalfToFloat(uint16_t value)
+  {
+    const uint32_t sign = static_cast<uint32_t>(value & 0x8000u) << 16;
+    const uint32_t exponent = (value >> 10) & 0x1Fu;
+    const uint32_t mantissa = value & 0x03FFu;
+
+    uint32_t bits = 0;
+    if (exponent == 0)
+    {
+      const float subnormal = static_cast<float>(mantissa) / 16777216.0f;
+      std::memcpy(&bits, &subnormal, sizeof(bits));
+      bits |= sign;
+    }
+    else if (exponent == 31)
+    {
+      bits = sign | 0x7F800000u | (mantissa << 13);
+    }
+    else
+    {
+      bits = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+    }
+
+    float result = 0.0f;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+  }
+
+  void EncodeOctahedralNormal(const float normal[3], int16_t out[2])
+  {
+    const float l1 = std::fabs(normal[0]) + std::fabs(normal[1]) + std::fabs(normal[2]);
+    if (!(l1 > 0.0f))
+    {
+      out[0] = 0;
+      out[1] = 0;
+      return;
+    }
+
+    float u = normal[0] / l1;
+    float v = normal[1] / l1;
+    // The lower hemisphere folds over the diagonals onto the outer triangles.
+    if (normal[2] < 0.0f)
+    {
+      const float fu = (1.0f - std::fabs(v)) * signNotZero(u);
+      const float fv = (1.0f - std::fabs(u)) * signNotZero(v);
+      u = fu;
+      v = fv;
+    }
+    out[0] = quantizeSnorm16(u);
+    out[1] = quantizeSnorm16(v);
+  }
+
+  void DecodeOctahedralNormal(const int16_t encoded[2], float out[3])
+  {
+    float x = dequantizeSnorm16(encoded[0]);
+    float y = dequantizeSnorm16(encoded[1]);
+    const float z = 1.0f - std::fabs(x) - std::fabs(y);
+    if (z < 0.0f)
+    {
+      const float fx = (1.0f - std::fabs(y)) * signNotZero(x);
+      const float fy = (1.0f - std::fabs(x)) * signNotZero(y);
+      x = fx;
+      y = fy;
+    }
+
+    const float len = std::sqrt(x * x + y * y + z * z);
+    out[0] = x / len;
+    out[1] = y / len;
+    out[2] = z / len;
+  }
+
+  PackedMeshVertex PackMeshVertex(const MeshVertex& vertex, const MeshBounds& bounds)
+  {
+    PackedMeshVertex packed{};
+    for (int axis = 0; axis < 3; ++axis)
+      packed.pos[axis] = quantizeUnorm16(vertex.pos[axis], bounds.min[axis], bounds.max[axis]);
+    EncodeOctahedralNormal(vertex.normal, packed.normal);
+    packed.uv0[0] = FloatToHalf(vertex.uv0[0]);
+    packed.uv0[1] = FloatToHalf(vertex.uv0[1]);
+    return packed;
+  }
+
+  MeshVertex UnpackMeshVertex(const PackedMeshVertex& packed, const MeshBounds& bounds)
+  {
+    MeshVertex vertex{};
+    for (int axis = 0; axis < 3; ++axis)
+      vertex.pos[axis] = dequantizeUnorm16(packed.pos[axis], bounds.min[axis], bounds.max[axis]);
+    DecodeOctahedralNormal(packed.normal, vertex.normal);
+    vertex.uv0[0] = HalfToFloat(packed.uv0[0]);
+    vertex.uv0[1] = HalfToFloat(packed.uv0[1]);
+    return vertex;
+  }
+
+  void PackMeshVertices(const MeshData& mesh, std::vector<PackedMeshVertex>* out_vertices)
+  {
+    if (!out_vertices)
+      return;
+    out_vertices->resize(mesh.vertices.size());
+    for (size_t i = 0; i < mesh.vertices.size(); ++i)
+      (*out_vertices)[i] = PackMeshVertex(mesh.vertices[i], mesh.bounds);
+  }
+
+  void UnpackMeshVertices(const PackedMeshVertex* packed, size_t count, const MeshBounds& bounds, MeshVertex* out_vertices)
+  {
+    if (!packed || !out_vertices)
+      return;
+    for (size_t i = 0; i < count; ++i)
+      out_vertices[i] = UnpackMeshVertex(packed[i], bounds);
+  }
+
+  MeshQuantizationError MeasureMeshQuantization(const MeshData& mesh)
+  {
+    MeshQuantizationError error{};
+    double maxNormalAngle = 0.0;
+    for (const MeshVertex& vertex : mesh.vertices)
+    {
+      const MeshVertex decoded = UnpackMeshVertex(PackMeshVertex(vertex, mesh.bounds), mesh.bounds);
+      for (int axis = 0; axis < 3; ++axis)
+        error.position = std::max(error.position, std::fabs(decoded.pos[axis] - vertex.pos[axis]));
+      for (int k = 0; k < 2; ++k)
+        error.uv = std::max(error.uv, std::fabs(decoded.uv0[k] - vertex.uv0[k]));
+
+      // atan2(|a x b|, a . b) keeps precision at the tiny angles packing produces;
+      // acos of a dot product near 1 is swamped by float rounding of the inputs.
+      const float* a = vertex.normal;
+      const float* b = decoded.normal;
+      const double cx = double(a[1]) * b[2] - double(a[2]) * b[1];
+      const double cy = double(a[2]) * b[0] - double(a[0]) * b[2];
+      const double cz = double(a[0]) * b[1] - double(a[1]) * b[0];
+      const double cross = std::sqrt(cx * cx + cy * cy + cz * cz);
+      const double dot = double(a[0]) * b[0] + double(a[1]) * b[1] + double(a[2]) * b[2];
+      if (cross > 0.0 || dot > 0.0)
+        maxNormalAngle = std::max(maxNormalAngle, std::atan2(cross, dot));
+    }
+    error.normalDegrees = static_cast<float>(maxNormalAngle * (180.0 / kPi));
+    return error;
+  }
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "mesh_importer.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sc_import
+{
+  // 16 bytes instead of MeshVertex's 32. Positions are only meaningful
+  // together with the bounds they were packed against. This is a storage
+  // format: readers expand it back to MeshVertex, so it shrinks .scmesh files
+  // and load I/O but not vertex memory once uploaded.
+  struct PackedMeshVertex
+  {
+    uint16_t pos[4] = { 0, 0, 0, 0 };   // xyz unorm16 across the mesh bounds, w unused
+    int16_t normal[2] = { 0, 0 };       // octahedral, snorm16
+    uint16_t uv0[2] = { 0, 0 };         // IEEE 754 half
+  };
+  static_assert(sizeof(PackedMeshVertex) == 16, "PackedMeshVertex must stay 16 bytes");
+
+  // Round to nearest even; out-of-range values become infinity, NaN stays NaN.
+  uint16_t FloatToHalf(float value);
+  float HalfToFloat(uint16_t value);
+
+  // Octahedral mapping of a unit vector onto [-1, 1]^2. A zero vector encodes as +Z.
+  void EncodeOctahedralNormal(const float normal[3], int16_t out[2]);
+  void DecodeOctahedralNormal(const int16_t encoded[2], float out[3]);
+
+  PackedMeshVertex PackMeshVertex(const MeshVertex& vertex, const MeshBounds& bounds);
+  MeshVertex UnpackMeshVertex(const PackedMeshVertex& packed, const MeshBounds& bounds);
+
+  // Packs against mesh.bounds, which must enclose every vertex (ComputeMeshBounds()).
+  void PackMeshVertices(const MeshData& mesh, std::vector<PackedMeshVertex>* out_vertices);
+  void UnpackMeshVertices(const PackedMeshVertex* packed, size_t count, const MeshBounds& bounds, MeshVertex* out_vertices);
+
+  // Largest round-trip error over all vertices: position in mesh units,
+  // normal as an angle, UV in texture coordinates.
+  struct MeshQuantizationError
+  {
+    float position = 0.0f;
+    float normalDegrees = 0.0f;
+    float uv = 0.0f;
+  };
+
+  MeshQuantizationError MeasureMeshQuantization(const MeshData& mesh);
+}
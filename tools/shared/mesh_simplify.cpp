@@ -0,0 +1,695 @@
+#include "mesh_simplify.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace sc_import
+{
+  namespace
+  {
+    static constexpr uint32_t kNone = UINT32_MAX;
+    // Open borders get an extra plane through the edge, perpendicular to the
+    // triangle, so silhouettes of holes and cut-offs are not eaten away.
+    static constexpr double kBorderWeight = 4.0;
+    static constexpr int kMaxAttributes = 5;   // normal xyz, uv0
+
+    enum VertexKind : uint8_t
+    {
+      Kind_Manifold = 0,   // unique position, fully surrounded
+      Kind_Border = 1,     // unique position on one open border loop
+      Kind_Seam = 2,       // two vertices at one position, split by a UV/normal seam
+      Kind_Locked = 3      // anything else; never removed
+    };
+
+    // Rows are the vertex being removed, columns the vertex it collapses onto.
+    static const bool kCanCollapse[4][4] = {
+      { true, true, true, true },
+      { false, true, false, true },
+      { false, false, true, true },
+      { false, false, false, false },
+    };
+
+    struct Quadric
+    {
+      double a00 = 0.0, a11 = 0.0, a22 = 0.0;
+      double a10 = 0.0, a20 = 0.0, a21 = 0.0;
+      double b0 = 0.0, b1 = 0.0, b2 = 0.0;
+      double c = 0.0;
+      double w = 0.0;
+    };
+
+    static void quadricAdd(Quadric& q, const Quadric& r)
+    {
+      q.a00 += r.a00; q.a11 += r.a11; q.a22 += r.a22;
+      q.a10 += r.a10; q.a20 += r.a20; q.a21 += r.a21;
+      q.b0 += r.b0; q.b1 += r.b1; q.b2 += r.b2;
+      q.c += r.c;
+      q.w += r.w;
+    }
+
+    // Squared distance to the plane ax + by + cz + d = 0, scaled by w.
+    static void quadricAddPlane(Quadric& q, double a, double b, double c, double d, double w)
+    {
+      q.a00 += a * a * w; q.a11 += b * b * w; q.a22 += c * c * w;
+      q.a10 += a * b * w; q.a20 += a * c * w; q.a21 += b * c * w;
+      q.b0 += a * d * w; q.b1 += b * d * w; q.b2 += c * d * w;
+      q.c += d * d * w;
+      q.w += w;
+    }
+
+    // Squared deviation from an attribute that varies linearly as g.p + gw
+    // across a triangle. Only the position part goes into q; the caller keeps
+    // w * (g, gw) per attribute and adds w to q.w once per triangle.
+    static void quadricAddGradient(Quadric& q, const double* g, double gw, double w)
+    {
+      q.a00 += g[0] * g[0] * w; q.a11 += g[1] * g[1] * w; q.a22 += g[2] * g[2] * w;
+      q.a10 += g[0] * g[1] * w; q.a20 += g[0] * g[2] * w; q.a21 += g[1] * g[2] * w;
+      q.b0 += g[0] * gw * w; q.b1 += g[1] * gw * w; q.b2 += g[2] * gw * w;
+      q.c += gw * gw * w;
+    }
+
+    static double quadricValue(const Quadric& q, const float* p)
+    {
+      const double x = p[0], y = p[1], z = p[2];
+      return q.a00 * x * x + q.a11 * y * y + q.a22 * z * z +
+             2.0 * (q.a10 * x * y + q.a20 * x * z + q.a21 * y * z) +
+             2.0 * (q.b0 * x + q.b1 * y + q.b2 * z) + q.c;
+    }
+
+    static double quadricError(const Quadric& q, const float* p)
+    {
+      return std::fabs(quadricValue(q, p));
+    }
+
+    static void triangleNormal(const float* a, const float* b, const float* c, double* out)
+    {
+      const double e1[3] = { double(b[0]) - a[0], double(b[1]) - a[1], double(b[2]) - a[2] };
+      const double e2[3] = { double(c[0]) - a[0], double(c[1]) - a[1], double(c[2]) - a[2] };
+      out[0] = e1[1] * e2[2] - e1[2] * e2[1];
+      out[1] = e1[2] * e2[0] - e1[0] * e2[2];
+      out[2] = e1[0] * e2[1] - e1[1] * e2[0];
+    }
+
+    static uint64_t edgeKey(uint32_t a, uint32_t b)
+    {
+      return (static_cast<uint64_t>(a) << 32) | b;
+    }
+
+    static bool hasEdge(const std::vector<uint64_t>& sortedEdges, uint32_t a, uint32_t b)
+    {
+      return std::binary_search(sortedEdges.begin(), sortedEdges.end(), edgeKey(a, b));
+    }
+
+    struct Collapse
+    {
+      uint32_t v0 = 0;   // removed
+      uint32_t v1 = 0;   // kept
+      float error = 0.0f;
+    };
+  }
+
+  bool SimplifyMesh(const MeshData& source,
+                    uint32_t targetTriangles,
+                    const MeshSimplifyOptions& options,
+                    MeshData* out_mesh,
+                    float* out_error)
+  {
+    if (!out_mesh)
+      return false;
+    if (out_error)
+      *out_error = 0.0f;
+
+    const uint32_t vertexCount = static_cast<uint32_t>(source.vertices.size());
+    if (vertexCount == 0 || source.indices.size() < 3)
+      return false;
+    for (uint32_t index : source.indices)
+    {
+      if (index >= vertexCount)
+        return false;
+    }
+
+    // Triangles carry their submesh so the ranges can be rebuilt afterwards.
+    std::vector<uint32_t> indices;
+    std::vector<uint32_t> triSubmesh;
+    indices.reserve(source.indices.size());
+    triSubmesh.reserve(source.indices.size() / 3);
+    auto addRange = [&](uint32_t offset, uint32_t count, uint32_t submesh)
+    {
+      const size_t end = std::min<size_t>(static_cast<size_t>(offset) + count, source.indices.size());
+      for (size_t i = offset; i + 2 < end; i += 3)
+      {
+        indices.insert(indices.end(), source.indices.begin() + i, source.indices.begin() + i + 3);
+        triSubmesh.push_back(submesh);
+      }
+    };
+    if (source.submeshes.empty())
+    {
+      addRange(0, static_cast<uint32_t>(source.indices.size()), 0);
+    }
+    else
+    {
+      for (size_t s = 0; s < source.submeshes.size(); ++s)
+        addRange(source.submeshes[s].indexOffset, source.submeshes[s].indexCount, static_cast<uint32_t>(s));
+    }
+
+    // Work in a unit box so errors and weights do not depend on model scale.
+    float minPos[3] = { source.vertices[0].pos[0], source.vertices[0].pos[1], source.vertices[0].pos[2] };
+    float maxPos[3] = { minPos[0], minPos[1], minPos[2] };
+    for (const MeshVertex& v : source.vertices)
+    {
+      for (int k = 0; k < 3; ++k)
+      {
+        minPos[k] = std::min(minPos[k], v.pos[k]);
+        maxPos[k] = std::max(maxPos[k], v.pos[k]);
+      }
+    }
+    const float extent = std::max(maxPos[0] - minPos[0], std::max(maxPos[1] - minPos[1], maxPos[2] - minPos[2]));
+    const float scale = extent > 0.0f ? 1.0f / extent : 1.0f;
+    std::vector<float> pos(static_cast<size_t>(vertexCount) * 3);
+    for (uint32_t i = 0; i < vertexCount; ++i)
+    {
+      for (int k = 0; k < 3; ++k)
+        pos[i * 3 + k] = (source.vertices[i].pos[k] - minPos[k]) * scale;
+    }
+
+    // remap: first vertex sharing this exact position. wedge: circular list
+    // through all vertices at that position.
+    std::vector<uint32_t> remap(vertexCount);
+    std::vector<uint32_t> wedge(vertexCount);
+    {
+      std::vector<uint32_t> order(vertexCount);
+      std::iota(order.begin(), order.end(), 0u);
+      auto samePos = [&](uint32_t a, uint32_t b)
+      {
+        const float* pa = source.vertices[a].pos;
+        const float* pb = source.vertices[b].pos;
+        return pa[0] == pb[0] && pa[1] == pb[1] && pa[2] == pb[2];
+      };
+      std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b)
+      {
+        const float* pa = source.vertices[a].pos;
+        const float* pb = source.vertices[b].pos;
+        if (pa[0] != pb[0]) return pa[0] < pb[0];
+        if (pa[1] != pb[1]) return pa[1] < pb[1];
+        if (pa[2] != pb[2]) return pa[2] < pb[2];
+        return a < b;
+      });
+      size_t begin = 0;
+      while (begin < order.size())
+      {
+        size_t end = begin + 1;
+        while (end < order.size() && samePos(order[begin], order[end]))
+          ++end;
+        for (size_t i = begin; i < end; ++i)
+        {
+          remap[order[i]] = order[begin];
+          wedge[order[i]] = order[i + 1 < end ? i + 1 : begin];
+        }
+        begin = end;
+      }
+    }
+
+    // Drop triangles that are already degenerate in position space.
+    {
+      size_t write = 0;
+      for (size_t t = 0; t < triSubmesh.size(); ++t)
+      {
+        const uint32_t a = indices[t * 3 + 0], b = indices[t * 3 + 1], c = indices[t * 3 + 2];
+        if (remap[a] == remap[b] || remap[b] == remap[c] || remap[a] == remap[c])
+          continue;
+        indices[write * 3 + 0] = a;
+        indices[write * 3 + 1] = b;
+        indices[write * 3 + 2] = c;
+        triSubmesh[write] = triSubmesh[t];
+        ++write;
+      }
+      indices.resize(write * 3);
+      triSubmesh.resize(write);
+    }
+
+    std::vector<uint64_t> vertexEdges;
+    std::vector<uint64_t> positionEdges;
+    vertexEdges.reserve(indices.size());
+    positionEdges.reserve(indices.size());
+    for (size_t i = 0; i < indices.size(); i += 3)
+    {
+      for (int k = 0; k < 3; ++k)
+      {
+        const uint32_t a = indices[i + k];
+        const uint32_t b = indices[i + (k + 1) % 3];
+        vertexEdges.push_back(edgeKey(a, b));
+        positionEdges.push_back(edgeKey(remap[a], remap[b]));
+      }
+    }
+    std::sort(vertexEdges.begin(), vertexEdges.end());
+    std::sort(positionEdges.begin(), positionEdges.end());
+
+    // Half-edges without a twin. A vertex with exactly one open edge in and one
+    // out sits on a single loop; several are marked by pointing at itself.
+    std::vector<uint32_t> openInc(vertexCount, kNone);
+    std::vector<uint32_t> openOut(vertexCount, kNone);
+    for (size_t i = 0; i < indices.size(); i += 3)
+    {
+      for (int k = 0; k < 3; ++k)
+      {
+        const uint32_t a = indices[i + k];
+        const uint32_t b = indices[i + (k + 1) % 3];
+        if (hasEdge(vertexEdges, b, a))
+          continue;
+        openInc[b] = openInc[b] == kNone ? a : b;
+        openOut[a] = openOut[a] == kNone ? b : a;
+      }
+    }
+
+    std::vector<uint8_t> kind(vertexCount, Kind_Locked);
+    for (uint32_t i = 0; i < vertexCount; ++i)
+    {
+      if (remap[i] != i)
+        continue;
+      if (wedge[i] == i)
+      {
+        const uint32_t inc = openInc[i];
+        const uint32_t out = openOut[i];
+        if (inc == kNone && out == kNone)
+          kind[i] = Kind_Manifold;
+        else if (inc != kNone && out != kNone && inc != i && out != i)
+          kind[i] = Kind_Border;
+      }
+      else if (wedge[wedge[i]] == i)
+      {
+        // Each side has one open edge in and out, and the two sides' edges
+        // must meet at the same positions or this is not a clean seam.
+        const uint32_t w = wedge[i];
+        const uint32_t incV = openInc[i], outV = openOut[i];
+        const uint32_t incW = openInc[w], outW = openOut[w];
+        if (incV != kNone && incV != i && outV != kNone && outV != i &&
+            incW != kNone && incW != w && outW != kNone && outW != w &&
+            remap[incV] == remap[outW] && remap[outV] == remap[incW] && remap[incV] != remap[outV])
+        {
+          kind[i] = Kind_Seam;
+        }
+      }
+    }
+
+    if (options.lockSubmeshBorders && source.submeshes.size() > 1)
+    {
+      std::vector<uint32_t> positionSubmesh(vertexCount, kNone);
+      for (size_t t = 0; t < triSubmesh.size(); ++t)
+      {
+        for (int k = 0; k < 3; ++k)
+        {
+          const uint32_t r = remap[indices[t * 3 + k]];
+          if (positionSubmesh[r] == kNone)
+            positionSubmesh[r] = triSubmesh[t];
+          else if (positionSubmesh[r] != triSubmesh[t])
+            kind[r] = Kind_Locked;
+        }
+      }
+    }
+
+    for (uint32_t i = 0; i < vertexCount; ++i)
+      kind[i] = kind[remap[i]];
+
+    std::vector<uint32_t> loop(vertexCount, kNone);
+    std::vector<uint32_t> loopBack(vertexCount, kNone);
+    for (uint32_t i = 0; i < vertexCount; ++i)
+    {
+      if (openOut[i] != kNone && openOut[i] != i)
+        loop[i] = openOut[i];
+      if (openInc[i] != kNone && openInc[i] != i)
+        loopBack[i] = openInc[i];
+    }
+
+    const bool useNormals = (source.vertexLayoutFlags & VertexLayout_Normal) != 0 && options.normalWeight > 0.0f;
+    const bool useUvs = (source.vertexLayoutFlags & VertexLayout_UV0) != 0 && options.uvWeight > 0.0f;
+    const int attributeCount = (useNormals ? 3 : 0) + (useUvs ? 2 : 0);
+    auto attributes = [&](uint32_t v, double* out)
+    {
+      const MeshVertex& vertex = source.vertices[v];
+      int k = 0;
+      if (useNormals)
+      {
+        for (int c = 0; c < 3; ++c)
+          out[k++] = vertex.normal[c] * options.normalWeight;
+      }
+      if (useUvs)
+      {
+        for (int c = 0; c < 2; ++c)
+          out[k++] = vertex.uv0[c] * options.uvWeight;
+      }
+    };
+
+    // Plane quadrics are kept per position. Attribute quadrics are per vertex,
+    // so the two sides of a seam are measured against their own attributes.
+    std::vector<Quadric> quadrics(vertexCount);
+    std::vector<Quadric> attributeQuadrics(attributeCount > 0 ? vertexCount : 0);
+    std::vector<double> attributeGradients(static_cast<size_t>(vertexCount) * attributeCount * 4, 0.0);
+    for (size_t i = 0; i < indices.size(); i += 3)
+    {
+      const uint32_t v[3] = { indices[i + 0], indices[i + 1], indices[i + 2] };
+      double n[3];
+      triangleNormal(&pos[v[0] * 3], &pos[v[1] * 3], &pos[v[2] * 3], n);
+      const double len = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+      if (len <= 0.0)
+        continue;
+      n[0] /= len; n[1] /= len; n[2] /= len;
+      const double area = len * 0.5;
+      const float* p0 = &pos[v[0] * 3];
+      const double d = -(n[0] * p0[0] + n[1] * p0[1] + n[2] * p0[2]);
+      for (int k = 0; k < 3; ++k)
+        quadricAddPlane(quadrics[remap[v[k]]], n[0], n[1], n[2], d, area);
+
+      if (attributeCount > 0)
+      {
+        // Gradient of each attribute in the triangle plane, from the Gram
+        // matrix of the two edges leaving p0.
+        const float* p1 = &pos[v[1] * 3];
+        const float* p2 = &pos[v[2] * 3];
+        const double e1[3] = { double(p1[0]) - p0[0], double(p1[1]) - p0[1], double(p1[2]) - p0[2] };
+        const double e2[3] = { double(p2[0]) - p0[0], double(p2[1]) - p0[1], double(p2[2]) - p0[2] };
+        const double d00 = e1[0] * e1[0] + e1[1] * e1[1] + e1[2] * e1[2];
+        const double d01 = e1[0] * e2[0] + e1[1] * e2[1] + e1[2] * e2[2];
+        const double d11 = e2[0] * e2[0] + e2[1] * e2[1] + e2[2] * e2[2];
+        const double denom = d00 * d11 - d01 * d01;
+        const double inv = denom != 0.0 ? 1.0 / denom : 0.0;
+        double g1[3], g2[3];
+        for (int c = 0; c < 3; ++c)
+        {
+          g1[c] = (d11 * e1[c] - d01 * e2[c]) * inv;
+          g2[c] = (d00 * e2[c] - d01 * e1[c]) * inv;
+        }
+
+        double a[3][kMaxAttributes];
+        for (int k = 0; k < 3; ++k)
+          attributes(v[k], a[k]);
+        for (int k = 0; k < 3; ++k)
+          attributeQuadrics[v[k]].w += area;
+        for (int attr = 0; attr < attributeCount; ++attr)
+        {
+          const double da1 = a[1][attr] - a[0][attr];
+          const double da2 = a[2][attr] - a[0][attr];
+          const double g[3] = { g1[0] * da1 + g2[0] * da2, g1[1] * da1 + g2[1] * da2, g1[2] * da1 + g2[2] * da2 };
+          const double gw = a[0][attr] - (g[0] * p0[0] + g[1] * p0[1] + g[2] * p0[2]);
+          for (int k = 0; k < 3; ++k)
+          {
+            quadricAddGradient(attributeQuadrics[v[k]], g, gw, area);
+            double* grad = &attributeGradients[(static_cast<size_t>(v[k]) * attributeCount + attr) * 4];
+            grad[0] += g[0] * area;
+            grad[1] += g[1] * area;
+            grad[2] += g[2] * area;
+            grad[3] += gw * area;
+          }
+        }
+      }
+
+      for (int k = 0; k < 3; ++k)
+      {
+        const uint32_t a = v[k];
+        const uint32_t b = v[(k + 1) % 3];
+        if (hasEdge(positionEdges, remap[b], remap[a]))
+          continue;
+        const float* pa = &pos[a * 3];
+        const float* pb = &pos[b * 3];
+        const double e[3] = { double(pb[0]) - pa[0], double(pb[1]) - pa[1], double(pb[2]) - pa[2] };
+        const double elen = std::sqrt(e[0] * e[0] + e[1] * e[1] + e[2] * e[2]);
+        if (elen <= 0.0)
+          continue;
+        double en[3] = { e[1] * n[2] - e[2] * n[1], e[2] * n[0] - e[0] * n[2], e[0] * n[1] - e[1] * n[0] };
+        const double enLen = std::sqrt(en[0] * en[0] + en[1] * en[1] + en[2] * en[2]);
+        if (enLen <= 0.0)
+          continue;
+        en[0] /= enLen; en[1] /= enLen; en[2] /= enLen;
+        const double ed = -(en[0] * pa[0] + en[1] * pa[1] + en[2] * pa[2]);
+        const double w = elen * elen * kBorderWeight;
+        quadricAddPlane(quadrics[remap[a]], en[0], en[1], en[2], ed, w);
+        quadricAddPlane(quadrics[remap[b]], en[0], en[1], en[2], ed, w);
+      }
+    }
+
+    // How far v1's attributes at v1's position stray from what v0's
+    // triangles interpolated; zero wherever attributes vary linearly.
+    auto attributeError = [&](uint32_t v0, uint32_t v1)
+    {
+      if (attributeCount == 0)
+        return 0.0;
+      const Quadric& q = attributeQuadrics[v0];
+      const float* p = &pos[v1 * 3];
+      double a[kMaxAttributes];
+      attributes(v1, a);
+      double r = quadricValue(q, p);
+      for (int attr = 0; attr < attributeCount; ++attr)
+      {
+        const double* grad = &attributeGradients[(static_cast<size_t>(v0) * attributeCount + attr) * 4];
+        r += a[attr] * a[attr] * q.w - 2.0 * a[attr] * (grad[0] * p[0] + grad[1] * p[1] + grad[2] * p[2] + grad[3]);
+      }
+      return std::fabs(r);
+    };
+
+    auto mergeAttributes = [&](uint32_t from, uint32_t into)
+    {
+      if (attributeCount == 0)
+        return;
+      quadricAdd(attributeQuadrics[into], attributeQuadrics[from]);
+      for (int i = 0; i < attributeCount * 4; ++i)
+        attributeGradients[static_cast<size_t>(into) * attributeCount * 4 + i] += attributeGradients[static_cast<size_t>(from) * attributeCount * 4 + i];
+    };
+
+    // The other side of a seam collapsing along with v0 -> v1.
+    auto seamPartner = [&](uint32_t v0, uint32_t v1)
+    {
+      const uint32_t s0 = wedge[v0];
+      if (loop[s0] != kNone && remap[loop[s0]] == remap[v1])
+        return loop[s0];
+      if (loopBack[s0] != kNone && remap[loopBack[s0]] == remap[v1])
+        return loopBack[s0];
+      return kNone;
+    };
+
+    auto collapseCost = [&](uint32_t v0, uint32_t v1, float* out_cost)
+    {
+      const uint8_t k0 = kind[v0];
+      const uint8_t k1 = kind[v1];
+      if (!kCanCollapse[k0][k1])
+        return false;
+      // Borders and seams only slide along their own loop.
+      if ((k0 == Kind_Border || k0 == Kind_Seam) && loop[v0] != v1 && loopBack[v0] != v1)
+        return false;
+
+      const Quadric& q = quadrics[remap[v0]];
+      double e = quadricError(q, &pos[v1 * 3]) + attributeError(v0, v1);
+      if (k0 == Kind_Seam)
+      {
+        const uint32_t s1 = seamPartner(v0, v1);
+        if (s1 == kNone)
+          return false;
+        e += attributeError(wedge[v0], s1);
+      }
+      *out_cost = static_cast<float>(e / std::max(q.w, 1e-12));
+      return true;
+    };
+
+    std::vector<uint32_t> adjacencyOffsets(static_cast<size_t>(vertexCount) + 1);
+    std::vector<uint32_t> adjacency;
+    auto buildAdjacency = [&]()
+    {
+      std::fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0u);
+      for (uint32_t index : indices)
+        adjacencyOffsets[index + 1]++;
+      for (uint32_t i = 0; i < vertexCount; ++i)
+        adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+      adjacency.resize(indices.size());
+      std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+      for (size_t i = 0; i < indices.size(); ++i)
+        adjacency[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+    };
+
+    std::vector<uint32_t> collapseRemap(vertexCount);
+    // Moving v0 onto v1 must not turn any surviving triangle over.
+    auto flipsTriangle = [&](uint32_t v0, uint32_t v1)
+    {
+      const float* target = &pos[v1 * 3];
+      for (uint32_t a = adjacencyOffsets[v0]; a < adjacencyOffsets[v0 + 1]; ++a)
+      {
+        const uint32_t t = adjacency[a];
+        // Corners that already moved this pass are checked where they ended up.
+        const uint32_t tri[3] = { collapseRemap[indices[static_cast<size_t>(t) * 3 + 0]],
+                                  collapseRemap[indices[static_cast<size_t>(t) * 3 + 1]],
+                                  collapseRemap[indices[static_cast<size_t>(t) * 3 + 2]] };
+        if (remap[tri[0]] == remap[v1] || remap[tri[1]] == remap[v1] || remap[tri[2]] == remap[v1])
+          continue;
+        const float* p[3] = { &pos[tri[0] * 3], &pos[tri[1] * 3], &pos[tri[2] * 3] };
+        double before[3];
+        triangleNormal(p[0], p[1], p[2], before);
+        for (int k = 0; k < 3; ++k)
+        {
+          if (tri[k] == v0)
+            p[k] = target;
+        }
+        double after[3];
+        triangleNormal(p[0], p[1], p[2], after);
+        // Folding past ~75 degrees counts too; it leaves slivers that flip
+        // on the next collapse.
+        const double dot = before[0] * after[0] + before[1] * after[1] + before[2] * after[2];
+        const double lenBefore = std::sqrt(before[0] * before[0] + before[1] * before[1] + before[2] * before[2]);
+        const double lenAfter = std::sqrt(after[0] * after[0] + after[1] * after[1] + after[2] * after[2]);
+        if (dot <= 0.25 * lenBefore * lenAfter)
+          return true;
+      }
+      return false;
+    };
+
+    const float errorLimit = options.maxError * options.maxError;
+    float maxErrorUsed = 0.0f;
+    std::vector<Collapse> candidates;
+    std::vector<uint8_t> collapseLocked(vertexCount);
+
+    // Each pass collapses a batch of the cheapest independent edges, then
+    // rewrites the index buffer. Positions touched in a pass are locked until
+    // the next one so every cost in the batch stays valid.
+    while (indices.size() / 3 > targetTriangles)
+    {
+      const size_t triangleCount = indices.size() / 3;
+      candidates.clear();
+      for (size_t i = 0; i < indices.size(); i += 3)
+      {
+        for (int k = 0; k < 3; ++k)
+        {
+          const uint32_t a = indices[i + k];
+          const uint32_t b = indices[i + (k + 1) % 3];
+          float costAB = 0.0f;
+          float costBA = 0.0f;
+          const bool canAB = collapseCost(a, b, &costAB);
+          const bool canBA = collapseCost(b, a, &costBA);
+          if (canAB && (!canBA || costAB <= costBA))
+            candidates.push_back({ a, b, costAB });
+          else if (canBA)
+            candidates.push_back({ b, a, costBA });
+        }
+      }
+      if (candidates.empty())
+        break;
+      std::sort(candidates.begin(), candidates.end(), [](const Collapse& l, const Collapse& r)
+      {
+        return l.error < r.error;
+      });
+
+      buildAdjacency();
+      std::iota(collapseRemap.begin(), collapseRemap.end(), 0u);
+      std::fill(collapseLocked.begin(), collapseLocked.end(), uint8_t(0));
+
+      // Interior collapses remove two triangles. Past the goal, only take
+      // edges not much worse than the goal edge; the rest wait for fresh costs.
+      const size_t goalTriangles = triangleCount - targetTriangles;
+      const size_t goalIndex = std::min(candidates.size() - 1, goalTriangles / 2);
+      const float passLimit = std::max(candidates[goalIndex].error * 1.5f, candidates[0].error);
+
+      size_t removed = 0;
+      size_t collapses = 0;
+      for (const Collapse& c : candidates)
+      {
+        if (removed >= goalTriangles || c.error > errorLimit || c.error > passLimit)
+          break;
+        const uint32_t r0 = remap[c.v0];
+        const uint32_t r1 = remap[c.v1];
+        if (collapseLocked[r0] || collapseLocked[r1])
+          continue;
+
+        const bool seam = kind[c.v0] == Kind_Seam;
+        const uint32_t s0 = seam ? wedge[c.v0] : kNone;
+        const uint32_t s1 = seam ? seamPartner(c.v0, c.v1) : kNone;
+        if (seam && s1 == kNone)
+          continue;
+        if (flipsTriangle(c.v0, c.v1) || (seam && flipsTriangle(s0, s1)))
+          continue;
+
+        collapseRemap[c.v0] = c.v1;
+        mergeAttributes(c.v0, c.v1);
+        if (seam)
+        {
+          collapseRemap[s0] = s1;
+          mergeAttributes(s0, s1);
+        }
+        quadricAdd(quadrics[r1], quadrics[r0]);
+        collapseLocked[r0] = 1;
+        collapseLocked[r1] = 1;
+
+        removed += kind[c.v0] == Kind_Border ? 1u : 2u;
+        maxErrorUsed = std::max(maxErrorUsed, c.error);
+        ++collapses;
+      }
+      if (collapses == 0)
+        break;
+
+      size_t write = 0;
+      for (size_t t = 0; t < triangleCount; ++t)
+      {
+        const uint32_t a = collapseRemap[indices[t * 3 + 0]];
+        const uint32_t b = collapseRemap[indices[t * 3 + 1]];
+        const uint32_t c = collapseRemap[indices[t * 3 + 2]];
+        if (remap[a] == remap[b] || remap[b] == remap[c] || remap[a] == remap[c])
+          continue;
+        indices[write * 3 + 0] = a;
+        indices[write * 3 + 1] = b;
+        indices[write * 3 + 2] = c;
+        triSubmesh[write] = triSubmesh[t];
+        ++write;
+      }
+      indices.resize(write * 3);
+      triSubmesh.resize(write);
+
+      // A loop edge whose far end collapsed onto this vertex now skips ahead.
+      auto remapLoop = [&](std::vector<uint32_t>& links)
+      {
+        for (uint32_t i = 0; i < vertexCount; ++i)
+        {
+          const uint32_t l = links[i];
+          if (l == kNone)
+            continue;
+          const uint32_t r = collapseRemap[l];
+          uint32_t next = r;
+          if (r == i)
+            next = links[l] != kNone ? collapseRemap[links[l]] : kNone;
+          links[i] = next == i ? kNone : next;
+        }
+      };
+      remapLoop(loop);
+      remapLoop(loopBack);
+    }
+
+    MeshData out{};
+    out.vertexLayoutFlags = source.vertexLayoutFlags;
+    out.indices.reserve(indices.size());
+    std::vector<uint32_t> outIndex(vertexCount, kNone);
+    uint32_t currentSubmesh = kNone;
+    for (size_t t = 0; t < triSubmesh.size(); ++t)
+    {
+      if (!source.submeshes.empty() && triSubmesh[t] != currentSubmesh)
+      {
+        currentSubmesh = triSubmesh[t];
+        Submesh sm = source.submeshes[currentSubmesh];
+        sm.indexOffset = static_cast<uint32_t>(out.indices.size());
+        sm.indexCount = 0;
+        out.submeshes.push_back(sm);
+      }
+      for (int k = 0; k < 3; ++k)
+      {
+        const uint32_t v = indices[t * 3 + k];
+        if (outIndex[v] == kNone)
+        {
+          outIndex[v] = static_cast<uint32_t>(out.vertices.size());
+          out.vertices.push_back(source.vertices[v]);
+        }
+        out.indices.push_back(outIndex[v]);
+      }
+      if (!out.submeshes.empty())
+        out.submeshes.back().indexCount += 3;
+    }
+    ComputeMeshBounds(&out);
+
+    *out_mesh = std::move(out);
+    if (out_error)
+      *out_error = std::sqrt(maxErrorUsed);
+    return true;
+  }
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "mesh_importer.h"
+
+#include <cstdint>
+
+namespace sc_import
+{
+  struct MeshSimplifyOptions
+  {
+    // Attribute error is added to the position quadric, so vertices whose
+    // normals or UVs differ are collapsed last. Positions are measured in
+    // units of the mesh's largest extent.
+    float normalWeight = 0.5f;
+    float uvWeight = 1.0f;
+    // Vertices shared by triangles of different submeshes never move, so
+    // material boundaries keep their shape at every LOD.
+    bool lockSubmeshBorders = true;
+    // Stop early once the cheapest collapse would exceed this error, in units
+    // of the mesh's largest extent.
+    float maxError = 0.05f;
+  };
+
+  // Half-edge collapse driven by quadric error metrics (Garland-Heckbert).
+  // Vertices are only ever removed, never moved, so every output vertex is a
+  // source vertex with its attributes intact. UV/normal seams collapse along
+  // the seam on both sides together; open borders only slide along themselves.
+  // Submesh ranges are kept in order. out_error receives the largest collapse
+  // error used, in the same units as maxError.
+  bool SimplifyMesh(const MeshData& source,
+                    uint32_t targetTriangles,
+                    const MeshSimplifyOptions& options,
+                    MeshData* out_mesh,
+                    float* out_error);
+}
@@ -0,0 +1,669 @@
+#include "texture_cooker.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SC_COOKER_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace sc_import
+{
+  namespace
+  {
+    // One RGBA texel in linear float. The filters only need add and scale, so
+    // with SSE2 a texel is a single register.
+    struct Vec4
+    {
+#if defined(SC_COOKER_SSE2)
+      __m128 v;
+      static Vec4 zero() { return { _mm_setzero_ps() }; }
+      static Vec4 load(const float* p) { return { _mm_loadu_ps(p) }; }
+      void store(float* p) const { _mm_storeu_ps(p, v); }
+      Vec4 operator+(const Vec4& o) const { return { _mm_add_ps(v, o.v) }; }
+      Vec4 operator*(float s) const { return { _mm_mul_ps(v, _mm_set1_ps(s)) }; }
+#else
+      float v[4];
+      static Vec4 zero() { return { { 0.0f, 0.0f, 0.0f, 0.0f } }; }
+      static Vec4 load(const float* p) { return { { p[0], p[1], p[2], p[3] } }; }
+      void store(float* p) const { std::memcpy(p, v, sizeof(v)); }
+      Vec4 operator+(const Vec4& o) const { return { { v[0] + o.v[0], v[1] + o.v[1], v[2] + o.v[2], v[3] + o.v[3] } }; }
+      Vec4 operator*(float s) const { return { { v[0] * s, v[1] * s, v[2] * s, v[3] * s } }; }
+#endif
+    };
+
+    struct ImageF
+    {
+      uint32_t width = 0;
+      uint32_t height = 0;
+      std::vector<float> texels;  // RGBA, linear
+
+      const float* at(uint32_t x, uint32_t y) const { return &texels[(static_cast<size_t>(y) * width + x) * 4u]; }
+      float* at(uint32_t x, uint32_t y) { return &texels[(static_cast<size_t>(y) * width + x) * 4u]; }
+    };
+
+    static float srgbToLinear(float c)
+    {
+      return (c <= 0.04045f) ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+    }
+
+    static float linearToSrgb(float c)
+    {
+      return (c <= 0.0031308f) ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+    }
+
+    static uint8_t toUnorm8(float c)
+    {
+      const float clamped = std::min(std::max(c, 0.0f), 1.0f);
+      return static_cast<uint8_t>(clamped * 255.0f + 0.5f);
+    }
+
+    static void toFloat(const uint8_t* rgba, uint32_t width, uint32_t height, bool srgb, ImageF* out)
+    {
+      float lut[256];
+      for (uint32_t i = 0; i < 256; ++i)
+      {
+        const float c = static_cast<float>(i) / 255.0f;
+        lut[i] = srgb ? srgbToLinear(c) : c;
+      }
+
+      out->width = width;
+      out->height = height;
+      out->texels.resize(static_cast<size_t>(width) * height * 4u);
+      const size_t count = static_cast<size_t>(width) * height;
+      for (size_t i = 0; i < count; ++i)
+      {
+        out->texels[i * 4 + 0] = lut[rgba[i * 4 + 0]];
+        out->texels[i * 4 + 1] = lut[rgba[i * 4 + 1]];
+        out->texels[i * 4 + 2] = lut[rgba[i * 4 + 2]];
+        out->texels[i * 4 + 3] = static_cast<float>(rgba[i * 4 + 3]) / 255.0f;
+      }
+    }
+
+    static void toUnorm(const ImageF& image, bool srgb, ImageRGBA8* out)
+    {
+      out->width = image.width;
+      out->height = image.height;
+      out->pixels.resize(static_cast<size_t>(image.width) * image.height * 4u);
+      const size_t count = static_cast<size_t>(image.width) * image.height;
+      for (size_t i = 0; i < count; ++i)
+      {
+        for (size_t c = 0; c < 3; ++c)
+        {
+          const float v = std::min(std::max(image.texels[i * 4 + c], 0.0f), 1.0f);
+          out->pixels[i * 4 + c] = toUnorm8(srgb ? linearToSrgb(v) : v);
+        }
+        out->pixels[i * 4 + 3] = toUnorm8(image.texels[i * 4 + 3]);
+      }
+    }
+
+    static void downsampleBox(const ImageF& src, ImageF* dst)
+    {
+      dst->width = std::max(1u, src.width / 2u);
+      dst->height = std::max(1u, src.height / 2u);
+      dst->texels.resize(static_cast<size_t>(dst->width) * dst->height * 4u);
+
+      for (uint32_t y = 0; y < dst->height; ++y)
+      {
+        const uint32_t y0 = std::min(y * 2u, src.height - 1u);
+        const uint32_t y1 = std::min(y * 2u + 1u, src.height - 1u);
+        for (uint32_t x = 0; x < dst->width; ++x)
+        {
+          const uint32_t x0 = std::min(x * 2u, src.width - 1u);
+          const uint32_t x1 = std::min(x * 2u + 1u, src.width - 1u);
+          const Vec4 sum = Vec4::load(src.at(x0, y0)) + Vec4::load(src.at(x1, y0)) +
+                           Vec4::load(src.at(x0, y1)) + Vec4::load(src.at(x1, y1));
+          (sum * 0.25f).store(dst->at(x, y));
+        }
+      }
+    }
+
+    // Zeroth-order modified Bessel function of the first kind (series form).
+    static double besselI0(double x)
+    {
+      double sum = 1.0;
+      double term = 1.0;
+      const double halfSq = (x * 0.5) * (x * 0.5);
+      for (int k = 1; k < 32; ++k)
+      {
+        term *= halfSq / (static_cast<double>(k) * static_cast<double>(k));
+        sum += term;
+        if (term < sum * 1e-12)
+          break;
+      }
+      return sum;
+    }
+
+    // Six taps of a Kaiser-windowed sinc for 2:1 decimation. Tap i samples
+    // source texel 2x - 2 + i, i.e. offsets of +-0.25, +-0.75 and +-1.25
+    // destination texels from the output centre.
+    static constexpr int kKaiserTaps = 6;
+
+    static void kaiserWeights(float out[kKaiserTaps])
+    {
+      const double alpha = 4.0;
+      const double radius = 1.5;
+      const double pi = 3.14159265358979323846;
+      double sum = 0.0;
+      double w[kKaiserTaps];
+      for (int i = 0; i < kKaiserTaps; ++i)
+      {
+        const double t = (static_cast<double>(i) - 2.5) * 0.5;
+        const double sinc = (t == 0.0) ? 1.0 : std::sin(pi * t) / (pi * t);
+        const double r = t / radius;
+        const double window = besselI0(alpha * std::sqrt(std::max(0.0, 1.0 - r * r))) / besselI0(alpha);
+        w[i] = sinc * window;
+        sum += w[i];
+      }
+      for (int i = 0; i < kKaiserTaps; ++i)
+        out[i] = static_cast<float>(w[i] / sum);
+    }
+
+    // Separable: horizontal pass into tmp, then vertical. An axis that is
+    // already 1 texel wide is copied rather than filtered.
+    static void downsampleKaiser(const ImageF& src, ImageF* tmp, ImageF* dst)
+    {
+      float weights[kKaiserTaps];
+      kaiserWeights(weights);
+
+      tmp->width = std::max(1u, src.width / 2u);
+      tmp->height = src.height;
+      tmp->texels.resize(static_cast<size_t>(tmp->width) * tmp->height * 4u);
+      for (uint32_t y = 0; y < src.height; ++y)
+      {
+        for (uint32_t x = 0; x < tmp->width; ++x)
+        {
+          if (src.width == 1)
+          {
+            Vec4::load(src.at(0, y)).store(tmp->at(x, y));
+            continue;
+          }
+          Vec4 sum = Vec4::zero();
+          for (int i = 0; i < kKaiserTaps; ++i)
+          {
+            const int64_t sx = std::min<int64_t>(std::max<int64_t>(static_cast<int64_t>(x) * 2 - 2 + i, 0), src.width - 1);
+            sum = sum + Vec4::load(src.at(static_cast<uint32_t>(sx), y)) * weights[i];
+          }
+          sum.store(tmp->at(x, y));
+        }
+      }
+
+      dst->width = tmp->width;
+      dst->height = std::max(1u, src.height / 2u);
+      dst->texels.resize(static_cast<size_t>(dst->width) * dst->height * 4u);
+      for (uint32_t y = 0; y < dst->height; ++y)
+      {
+        for (uint32_t x = 0; x < dst->width; ++x)
+        {
+          if (tmp->height == 1)
+          {
+            Vec4::load(tmp->at(x, 0)).store(dst->at(x, y));
+            continue;
+          }
+          Vec4 sum = Vec4::zero();
+          for (int i = 0; i < kKaiserTaps; ++i)
+          {
+            const int64_t sy = std::min<int64_t>(std::max<int64_t>(static_cast<int64_t>(y) * 2 - 2 + i, 0), tmp->height - 1);
+            sum = sum + Vec4::load(tmp->at(x, static_cast<uint32_t>(sy))) * weights[i];
+          }
+          sum.store(dst->at(x, y));
+        }
+      }
+    }
+
+    // Principal axis of the block by power iteration on the covariance.
+    // channels is 3 (RGB) or 4 (RGBA); returns the extreme points along it.
+    static void principalEndpoints(const uint8_t* block, int channels, float outLo[4], float outHi[4])
+    {
+      float mean[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+      for (int p = 0; p < 16; ++p)
+        for (int c = 0; c < channels; ++c)
+          mean[c] += static_cast<float>(block[p * 4 + c]);
+      for (int c = 0; c < channels; ++c)
+        mean[c] /= 16.0f;
+
+      float cov[4][4] = {};
+      for (int p = 0; p < 16; ++p)
+      {
+        float d[4] = {};
+        for (int c = 0; c < channels; ++c)
+          d[c] = static_cast<float>(block[p * 4 + c]) - mean[c];
+        for (int i = 0; i < channels; ++i)
+          for (int j = 0; j < channels; ++j)
+            cov[i][j] += d[i] * d[j];
+      }
+
+      float axis[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+      for (int iter = 0; iter < 8; ++iter)
+      {
+        float next[4] = {};
+        for (int i = 0; i < channels; ++i)
+          for (int j = 0; j < channels; ++j)
+            next[i] += cov[i][j] * axis[j];
+        float len = 0.0f;
+        for (int i = 0; i < channels; ++i)
+          len = std::max(len, std::fabs(next[i]));
+        if (len < 1e-6f)
+          break;
+        for (int i = 0; i < channels; ++i)
+          axis[i] = next[i] / len;
+      }
+
+      float axisLenSq = 0.0f;
+      for (int c = 0; c < channels; ++c)
+        axisLenSq += axis[c] * axis[c];
+
+      float tMin = 0.0f;
+      float tMax = 0.0f;
+      if (axisLenSq > 1e-12f)
+      {
+        tMin = 1e30f;
+        tMax = -1e30f;
+        for (int p = 0; p < 16; ++p)
+        {
+          float t = 0.0f;
+          for (int c = 0; c < channels; ++c)
+            t += (static_cast<float>(block[p * 4 + c]) - mean[c]) * axis[c];
+          t /= axisLenSq;
+          tMin = std::min(tMin, t);
+          tMax = std::max(tMax, t);
+        }
+      }
+
+      for (int c = 0; c < 4; ++c)
+      {
+        outLo[c] = (c < channels) ? std::min(std::max(mean[c] + axis[c] * tMin, 0.0f), 255.0f) : 255.0f;
+        outHi[c] = (c < channels) ? std::min(std::max(mean[c] + axis[c] * tMax, 0.0f), 255.0f) : 255.0f;
+      }
+    }
+
+    static uint16_t packRgb565(const float c[4])
+    {
+      const uint32_t r = static_cast<uint32_t>(c[0] * 31.0f / 255.0f + 0.5f);
+      const uint32_t g = static_cast<uint32_t>(c[1] * 63.0f / 255.0f + 0.5f);
+      const uint32_t b = static_cast<uint32_t>(c[2] * 31.0f / 255.0f + 0.5f);
+      return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+    }
+
+    static void unpackRgb565(uint16_t v, int out[3])
+    {
+      const int r = (v >> 11) & 31;
+      const int g = (v >> 5) & 63;
+      const int b = v & 31;
+      out[0] = (r << 3) | (r >> 2);
+      out[1] = (g << 2) | (g >> 4);
+      out[2] = (b << 3) | (b >> 2);
+    }
+
+    static void writeU16(uint8_t* out, uint16_t v)
+    {
+      out[0] = static_cast<uint8_t>(v & 0xFF);
+      out[1] = static_cast<uint8_t>(v >> 8);
+    }
+
+    // Four-colour BC1 block; BC3 reuses it for its colour half.
+    static void encodeColorBlock(const uint8_t* block, uint8_t* out)
+    {
+      float lo[4];
+      float hi[4];
+      principalEndpoints(block, 3, lo, hi);
+
+      uint16_t c0 = packRgb565(hi);
+      uint16_t c1 = packRgb565(lo);
+      if (c0 < c1)
+        std::swap(c0, c1);
+
+      writeU16(out + 0, c0);
+      writeU16(out + 2, c1);
+      if (c0 == c1)
+      {
+        std::memset(out + 4, 0, 4);
+        return;
+      }
+
+      int palette[4][3];
+      unpackRgb565(c0, palette[0]);
+      unpackRgb565(c1, palette[1]);
+      for (int c = 0; c < 3; ++c)
+      {
+        palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+        palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+      }
+
+      uint32_t indices = 0;
+      for (int p = 0; p < 16; ++p)
+      {
+        int best = 0;
+        int bestErr = INT32_MAX;
+        for (int i = 0; i < 4; ++i)
+        {
+          int err = 0;
+          for (int c = 0; c < 3; ++c)
+          {
+            const int d = static_cast<int>(block[p * 4 + c]) - palette[i][c];
+            err += d * d;
+          }
+          if (err < bestErr)
+          {
+            bestErr = err;
+            best = i;
+          }
+        }
+        indices |= static_cast<uint32_t>(best) << (p * 2);
+      }
+      for (int i = 0; i < 4; ++i)
+        out[4 + i] = static_cast<uint8_t>((indices >> (i * 8)) & 0xFF);
+    }
+
+    // BC4-style alpha in the eight-value mode (a0 > a1).
+    static void encodeAlphaBlock(const uint8_t* block, uint8_t* out)
+    {
+      uint8_t a0 = 0;
+      uint8_t a1 = 255;
+      for (int p = 0; p < 16; ++p)
+      {
+        a0 = std::max(a0, block[p * 4 + 3]);
+        a1 = std::min(a1, block[p * 4 + 3]);
+      }
+
+      out[0] = a0;
+      out[1] = a1;
+      if (a0 == a1)
+      {
+        std::memset(out + 2, 0, 6);
+        return;
+      }
+
+      int palette[8];
+      palette[0] = a0;
+      palette[1] = a1;
+      for (int i = 1; i < 7; ++i)
+        palette[i + 1] = ((7 - i) * a0 + i * a1) / 7;
+
+      uint64_t bits = 0;
+      for (int p = 0; p < 16; ++p)
+      {
+        int best = 0;
+        int bestErr = INT32_MAX;
+        for (int i = 0; i < 8; ++i)
+        {
+          const int d = static_cast<int>(block[p * 4 + 3]) - palette[i];
+          if (d * d < bestErr)
+          {
+            bestErr = d * d;
+            best = i;
+          }
+        }
+        bits |= static_cast<uint64_t>(best) << (p * 3);
+      }
+      for (int i = 0; i < 6; ++i)
+        out[2 + i] = static_cast<uint8_t>((bits >> (i * 8)) & 0xFF);
+    }
+
+    struct BitWriter128
+    {
+      uint8_t* out = nullptr;
+      uint32_t pos = 0;
+
+      void write(uint32_t value, uint32_t count)
+      {
+        for (uint32_t i = 0; i < count; ++i, ++pos)
+        {
+          if (value & (1u << i))
+            out[pos >> 3] |= static_cast<uint8_t>(1u << (pos & 7u));
+        }
+      }
+    };
+
+    static constexpr int kBC7Weights4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+    struct BC7Mode6Candidate
+    {
+      uint32_t q[2][4] = {};   // 7-bit endpoints
+      uint32_t pbit[2] = {};
+      uint8_t indices[16] = {};
+      uint64_t error = UINT64_MAX;
+    };
+
+    static void evaluateMode6(const uint8_t* block, BC7Mode6Candidate& cand)
+    {
+      int ep[2][4];
+      for (int e = 0; e < 2; ++e)
+        for (int c = 0; c < 4; ++c)
+          ep[e][c] = static_cast<int>((cand.q[e][c] << 1) | cand.pbit[e]);
+
+      int palette[16][4];
+      for (int i = 0; i < 16; ++i)
+        for (int c = 0; c < 4; ++c)
+          palette[i][c] = ((64 - kBC7Weights4[i]) * ep[0][c] + kBC7Weights4[i] * ep[1][c] + 32) >> 6;
+
+      cand.error = 0;
+      for (int p = 0; p < 16; ++p)
+      {
+        int best = 0;
+        int bestErr = INT32_MAX;
+        for (int i = 0; i < 16; ++i)
+        {
+          int err = 0;
+          for (int c = 0; c < 4; ++c)
+          {
+            const int d = static_cast<int>(block[p * 4 + c]) - palette[i][c];
+            err += d * d;
+          }
+          if (err < bestErr)
+          {
+            bestErr = err;
+            best = i;
+          }
+        }
+        cand.indices[p] = static_cast<uint8_t>(best);
+        cand.error += static_cast<uint64_t>(bestErr);
+      }
+    }
+  }
+
+  bool GenerateMipChain(const uint8_t* rgba,
+                        uint32_t width,
+                        uint32_t height,
+                        bool srgb,
+                        MipFilter filter,
+                        uint32_t maxMips,
+                        std::vector<ImageRGBA8>* out_levels)
+  {
+    if (!rgba || width == 0 || height == 0 || !out_levels)
+      return false;
+
+    out_levels->clear();
+    ImageRGBA8 base{};
+    base.width = width;
+    base.height = height;
+    base.pixels.assign(rgba, rgba + static_cast<size_t>(width) * height * 4u);
+    out_levels->push_back(std::move(base));
+
+    const uint32_t levelLimit = std::max(1u, std::min(maxMips, sc_world::kMaxCookedMips));
+    if (levelLimit == 1 || (width == 1 && height == 1))
+      return true;
+
+    // Each level is filtered from the previous float level, not from its
+    // 8-bit copy, so rounding does not accumulate down the chain.
+    ImageF current{};
+    ImageF next{};
+    ImageF scratch{};
+    toFloat(rgba, width, height, srgb, &current);
+
+    while (out_levels->size() < levelLimit && (current.width > 1 || current.height > 1))
+    {
+      if (filter == MipFilter::Kaiser)
+        downsampleKaiser(current, &scratch, &next);
+      else
+        downsampleBox(current, &next);
+
+      ImageRGBA8 level{};
+      toUnorm(next, srgb, &level);
+      out_levels->push_back(std::move(level));
+      std::swap(current, next);
+    }
+    return true;
+  }
+
+  void EncodeBC1Block(const uint8_t* block, uint8_t* out_8_bytes)
+  {
+    encodeColorBlock(block, out_8_bytes);
+  }
+
+  void EncodeBC3Block(const uint8_t* block, uint8_t* out_16_bytes)
+  {
+    encodeAlphaBlock(block, out_16_bytes);
+    encodeColorBlock(block, out_16_bytes + 8);
+  }
+
+  void EncodeBC7Block(const uint8_t* block, uint8_t* out_16_bytes)
+  {
+    float lo[4];
+    float hi[4];
+    principalEndpoints(block, 4, lo, hi);
+
+    // Try all four p-bit pairs; each shifts the 8-bit lattice the endpoints land on.
+    BC7Mode6Candidate best{};
+    for (uint32_t p0 = 0; p0 < 2; ++p0)
+    {
+      for (uint32_t p1 = 0; p1 < 2; ++p1)
+      {
+        BC7Mode6Candidate cand{};
+        cand.pbit[0] = p0;
+        cand.pbit[1] = p1;
+        for (int c = 0; c < 4; ++c)
+        {
+          const float v0 = (lo[c] - static_cast<float>(p0)) * 0.5f;
+          const float v1 = (hi[c] - static_cast<float>(p1)) * 0.5f;
+          cand.q[0][c] = static_cast<uint32_t>(std::min(std::max(v0 + 0.5f, 0.0f), 127.0f));
+          cand.q[1][c] = static_cast<uint32_t>(std::min(std::max(v1 + 0.5f, 0.0f), 127.0f));
+        }
+        evaluateMode6(block, cand);
+        if (cand.error < best.error)
+          best = cand;
+      }
+    }
+
+    // The first index is stored with an implied zero MSB.
+    if (best.indices[0] & 8u)
+    {
+      for (int c = 0; c < 4; ++c)
+        std::swap(best.q[0][c], best.q[1][c]);
+      std::swap(best.pbit[0], best.pbit[1]);
+      for (uint8_t& index : best.indices)
+        index = static_cast<uint8_t>(15u - index);
+    }
+
+    std::memset(out_16_bytes, 0, 16);
+    BitWriter128 bits{};
+    bits.out = out_16_bytes;
+    bits.write(1u << 6, 7);  // mode 6
+    for (int c = 0; c < 4; ++c)
+    {
+      bits.write(best.q[0][c], 7);
+      bits.write(best.q[1][c], 7);
+    }
+    bits.write(best.pbit[0], 1);
+    bits.write(best.pbit[1], 1);
+    bits.write(best.indices[0], 3);
+    for (int p = 1; p < 16; ++p)
+      bits.write(best.indices[p], 4);
+  }
+
+  void CompressImage(const ImageRGBA8& image,
+                     sc_world::CookedTextureFormat format,
+                     std::vector<uint8_t>* out_data)
+  {
+    if (!out_data || image.width == 0 || image.height == 0)
+      return;
+
+    if (format == sc_world::CookedTextureFormat::RGBA8)
+    {
+      out_data->insert(out_data->end(), image.pixels.begin(), image.pixels.end());
+      return;
+    }
+
+    const uint32_t blockBytes = (format == sc_world::CookedTextureFormat::BC1) ? 8u : 16u;
+    const uint32_t blocksX = (image.width + 3u) / 4u;
+    const uint32_t blocksY = (image.height + 3u) / 4u;
+    size_t cursor = out_data->size();
+    out_data->resize(cursor + static_cast<size_t>(blocksX) * blocksY * blockBytes);
+
+    uint8_t block[64];
+    for (uint32_t by = 0; by < blocksY; ++by)
+    {
+      for (uint32_t bx = 0; bx < blocksX; ++bx)
+      {
+        for (uint32_t y = 0; y < 4; ++y)
+        {
+          const uint32_t sy = std::min(by * 4u + y, image.height - 1u);
+          for (uint32_t x = 0; x < 4; ++x)
+          {
+            const uint32_t sx = std::min(bx * 4u + x, image.width - 1u);
+            std::memcpy(&block[(y * 4 + x) * 4], &image.pixels[(static_cast<size_t>(sy) * image.width + sx) * 4u], 4);
+          }
+        }
+
+        uint8_t* out = out_data->data() + cursor;
+        switch (format)
+        {
+          case sc_world::CookedTextureFormat::BC1: EncodeBC1Block(block, out); break;
+          case sc_world::CookedTextureFormat::BC3: EncodeBC3Block(block, out); break;
+          default: EncodeBC7Block(block, out); break;
+        }
+        cursor += blockBytes;
+      }
+    }
+  }
+
+  bool CookTexture(const uint8_t* rgba,
+                   uint32_t width,
+                   uint32_t height,
+                   const TextureCookOptions& options,
+                   sc_world::CookedTexture* out_texture,
+                   std::string* out_error)
+  {
+    if (!out_texture)
+      return false;
+    if (!rgba || width == 0 || height == 0)
+    {
+      if (out_error) *out_error = "Texture has no pixels to cook.";
+      return false;
+    }
+
+    const uint32_t maxMips = options.generateMips ? options.maxMips : 1u;
+    std::vector<ImageRGBA8> levels;
+    if (!GenerateMipChain(rgba, width, height, options.srgb, options.mipFilter, maxMips, &levels))
+    {
+      if (out_error) *out_error = "Failed to build mip chain.";
+      return false;
+    }
+
+    out_texture->format = options.format;
+    out_texture->srgb = options.srgb;
+    out_texture->width = width;
+    out_texture->height = height;
+    out_texture->mips.clear();
+    out_texture->data.clear();
+
+    uint64_t total = 0;
+    for (const ImageRGBA8& level : levels)
+      total += sc_world::CookedMipBytes(options.format, level.width, level.height);
+    out_texture->data.reserve(static_cast<size_t>(total));
+
+    for (const ImageRGBA8& level : levels)
+    {
+      sc_world::CookedMip mip{};
+      mip.width = level.width;
+      mip.height = level.height;
+      mip.offset = out_texture->data.size();
+      CompressImage(level, options.format, &out_texture->data);
+      mip.size = out_texture->data.size() - mip.offset;
+      out_texture->mips.push_back(mip);
+    }
+    return true;
+  }
+}
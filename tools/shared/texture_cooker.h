@@ -0,0 +1,60 @@
+#pragma once
+
+#include "texture_format.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sc_import
+{
+  enum class MipFilter : uint32_t
+  {
+    Box = 0,
+    Kaiser = 1
+  };
+
+  struct TextureCookOptions
+  {
+    sc_world::CookedTextureFormat format = sc_world::CookedTextureFormat::BC7;
+    bool srgb = true;                   // filter in linear space, store sRGB
+    bool generateMips = true;
+    MipFilter mipFilter = MipFilter::Kaiser;
+    uint32_t maxMips = sc_world::kMaxCookedMips;
+  };
+
+  struct ImageRGBA8
+  {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<uint8_t> pixels;
+  };
+
+  // levels[0] is a copy of the source; each following level halves both sides
+  // (never below 1) until 1x1 or maxMips levels.
+  bool GenerateMipChain(const uint8_t* rgba,
+                        uint32_t width,
+                        uint32_t height,
+                        bool srgb,
+                        MipFilter filter,
+                        uint32_t maxMips,
+                        std::vector<ImageRGBA8>* out_levels);
+
+  // block is 4x4 RGBA8 texels in row order (64 bytes).
+  void EncodeBC1Block(const uint8_t* block, uint8_t* out_8_bytes);
+  void EncodeBC3Block(const uint8_t* block, uint8_t* out_16_bytes);
+  // Mode 6 only: one RGBA subset, 7-bit endpoints with p-bits, 4-bit indices.
+  void EncodeBC7Block(const uint8_t* block, uint8_t* out_16_bytes);
+
+  // Appends the encoded level to out_data. Edge blocks replicate the last row/column.
+  void CompressImage(const ImageRGBA8& image,
+                     sc_world::CookedTextureFormat format,
+                     std::vector<uint8_t>* out_data);
+
+  bool CookTexture(const uint8_t* rgba,
+                   uint32_t width,
+                   uint32_t height,
+                   const TextureCookOptions& options,
+                   sc_world::CookedTexture* out_texture,
+                   std::string* out_error);
+}
@@ -0,0 +1,202 @@
+#include "texture_format.h"
+
+#include <cctype>
+#include <cstring>
+#include <fstream>
+
+namespace sc_world
+{
+  namespace
+  {
+    static constexpr uint32_t kFlagSrgb = 1u;
+
+    struct FileHeader
+    {
+      uint32_t magic = kCookedTextureMagic;
+      uint32_t version = kCookedTextureVersion;
+      uint32_t format = 0;
+      uint32_t flags = 0;
+      uint32_t width = 0;
+      uint32_t height = 0;
+      uint32_t mipCount = 0;
+      uint32_t reserved = 0;
+    };
+
+    template<typename T>
+    static void WriteValue(std::ofstream& out, const T& value)
+    {
+      out.write(reinterpret_cast<const char*>(&value), static_cast<std::streamsize>(sizeof(T)));
+    }
+
+    template<typename T>
+    static void ReadValue(std::ifstream& in, T& out_value)
+    {
+      in.read(reinterpret_cast<char*>(&out_value), static_cast<std::streamsize>(sizeof(T)));
+    }
+
+    static bool IsKnownFormat(uint32_t format)
+    {
+      return format <= static_cast<uint32_t>(CookedTextureFormat::BC7);
+    }
+
+    static bool ApplyHeader(const FileHeader& header, CookedTexture* out_texture)
+    {
+      if (header.magic != kCookedTextureMagic || header.version != kCookedTextureVersion)
+        return false;
+      if (!IsKnownFormat(header.format) || header.mipCount == 0 || header.mipCount > kMaxCookedMips)
+        return false;
+      if (header.width == 0 || header.height == 0)
+        return false;
+
+      out_texture->format = static_cast<CookedTextureFormat>(header.format);
+      out_texture->srgb = (header.flags & kFlagSrgb) != 0;
+      out_texture->width = header.width;
+      out_texture->height = header.height;
+      out_texture->mips.resize(header.mipCount);
+      return true;
+    }
+
+    // Every level must match its format's size and lie inside the payload.
+    static bool ValidateMips(const CookedTexture& texture, uint64_t dataSize)
+    {
+      for (const CookedMip& mip : texture.mips)
+      {
+        if (mip.width == 0 || mip.height == 0)
+          return false;
+        if (mip.size != CookedMipBytes(texture.format, mip.width, mip.height))
+          return false;
+        if (mip.offset > dataSize || mip.size > dataSize - mip.offset)
+          return false;
+      }
+      return true;
+    }
+  }
+
+  bool IsBlockCompressed(CookedTextureFormat format)
+  {
+    return format != CookedTextureFormat::RGBA8;
+  }
+
+  uint64_t CookedMipBytes(CookedTextureFormat format, uint32_t width, uint32_t height)
+  {
+    if (!IsBlockCompressed(format))
+      return static_cast<uint64_t>(width) * static_cast<uint64_t>(height) * 4ull;
+
+    const uint64_t blocksX = (static_cast<uint64_t>(width) + 3ull) / 4ull;
+    const uint64_t blocksY = (static_cast<uint64_t>(height) + 3ull) / 4ull;
+    const uint64_t blockBytes = (format == CookedTextureFormat::BC1) ? 8ull : 16ull;
+    return blocksX * blocksY * blockBytes;
+  }
+
+  bool IsCookedTexturePath(const char* path)
+  {
+    if (!path)
+      return false;
+    const size_t len = std::strlen(path);
+    const size_t extLen = std::strlen(kCookedTextureExtension);
+    if (len < extLen)
+      return false;
+    for (size_t i = 0; i < extLen; ++i)
+    {
+      const char a = static_cast<char>(std::tolower(static_cast<unsigned char>(path[len - extLen + i])));
+      if (a != kCookedTextureExtension[i])
+        return false;
+    }
+    return true;
+  }
+
+  bool WriteCookedTexture(const char* path, const CookedTexture& texture)
+  {
+    if (!path || texture.mips.empty() || texture.mips.size() > kMaxCookedMips)
+      return false;
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out.is_open())
+      return false;
+
+    FileHeader header{};
+    header.format = static_cast<uint32_t>(texture.format);
+    header.flags = texture.srgb ? kFlagSrgb : 0u;
+    header.width = texture.width;
+    header.height = texture.height;
+    header.mipCount = static_cast<uint32_t>(texture.mips.size());
+    WriteValue(out, header);
+
+    for (const CookedMip& mip : texture.mips)
+      WriteValue(out, mip);
+
+    const uint64_t dataSize = static_cast<uint64_t>(texture.data.size());
+    WriteValue(out, dataSize);
+    out.write(reinterpret_cast<const char*>(texture.data.data()), static_cast<std::streamsize>(dataSize));
+    return out.good();
+  }
+
+  bool IsCookedTextureData(const uint8_t* data, size_t size)
+  {
+    if (!data || size < sizeof(uint32_t))
+      return false;
+    uint32_t magic = 0;
+    std::memcpy(&magic, data, sizeof(magic));
+    return magic == kCookedTextureMagic;
+  }
+
+  bool ReadCookedTexture(const char* path, CookedTexture* out_texture)
+  {
+    if (!path || !out_texture)
+      return false;
+
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open())
+      return false;
+
+    FileHeader header{};
+    ReadValue(in, header);
+    if (!in.good() || !ApplyHeader(header, out_texture))
+      return false;
+    for (CookedMip& mip : out_texture->mips)
+      ReadValue(in, mip);
+
+    uint64_t dataSize = 0;
+    ReadValue(in, dataSize);
+    if (!in.good() || !ValidateMips(*out_texture, dataSize))
+      return false;
+
+    out_texture->data.resize(static_cast<size_t>(dataSize));
+    in.read(reinterpret_cast<char*>(out_texture->data.data()), static_cast<std::streamsize>(dataSize));
+    return static_cast<uint64_t>(in.gcount()) == dataSize;
+  }
+
+  bool ParseCookedTexture(const uint8_t* data, size_t size, CookedTexture* out_texture)
+  {
+    if (!data || !out_texture)
+      return false;
+
+    size_t cursor = 0;
+    auto take = [&](void* dst, size_t bytes)
+    {
+      if (bytes > size - cursor)
+        return false;
+      std::memcpy(dst, data + cursor, bytes);
+      cursor += bytes;
+      return true;
+    };
+
+    FileHeader header{};
+    if (!take(&header, sizeof(header)) || !ApplyHeader(header, out_texture))
+      return false;
+    for (CookedMip& mip : out_texture->mips)
+    {
+      if (!take(&mip, sizeof(mip)))
+        return false;
+    }
+
+    uint64_t dataSize = 0;
+    if (!take(&dataSize, sizeof(dataSize)) || !ValidateMips(*out_texture, dataSize))
+      return false;
+    if (dataSize != static_cast<uint64_t>(size - cursor))
+      return false;
+
+    out_texture->data.assign(data + cursor, data + size);
+    return true;
+  }
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sc_world
+{
+  static constexpr uint32_t kCookedTextureMagic = 0x58455453; // "STEX"
+  static constexpr uint32_t kCookedTextureVersion = 1;
+  static constexpr uint32_t kMaxCookedMips = 16;
+  static constexpr const char* kCookedTextureExtension = ".sctex";
+
+  enum class CookedTextureFormat : uint32_t
+  {
+    RGBA8 = 0,
+    BC1 = 1,   // RGB, 8 bytes per 4x4 block
+    BC3 = 2,   // RGBA, 16 bytes per 4x4 block
+    BC7 = 3    // RGBA, 16 bytes per 4x4 block
+  };
+
+  struct CookedMip
+  {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint64_t offset = 0;  // into CookedTexture::data
+    uint64_t size = 0;
+  };
+
+  struct CookedTexture
+  {
+    CookedTextureFormat format = CookedTextureFormat::RGBA8;
+    bool srgb = true;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<CookedMip> mips;   // mips[0] is full resolution
+    std::vector<uint8_t> data;     // every level, back to back
+  };
+
+  bool IsBlockCompressed(CookedTextureFormat format);
+  uint64_t CookedMipBytes(CookedTextureFormat format, uint32_t width, uint32_t height);
+  bool IsCookedTexturePath(const char* path);
+
+  bool IsCookedTextureData(const uint8_t* data, size_t size);
+
+  bool WriteCookedTexture(const char* path, const CookedTexture& texture);
+  // out_texture->data keeps its capacity, so callers can recycle the buffer.
+  bool ReadCookedTexture(const char* path, CookedTexture* out_texture);
+  // Same as ReadCookedTexture over a file already in memory (e.g. a pack view).
+  bool ParseCookedTexture(const uint8_t* data, size_t size, CookedTexture* out_texture);
+}
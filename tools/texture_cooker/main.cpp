@@ -0,0 +1,116 @@
+#include "texture_cooker.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+namespace
+{
+  void printUsage()
+  {
+    std::printf("usage: sc_texture_cooker <input image> <output.sctex> [options]\n"
+                "  --format bc1|bc3|bc7|rgba8   block format (default bc7)\n"
+                "  --linear                     data texture; no sRGB conversion\n"
+                "  --filter box|kaiser          mip filter (default kaiser)\n"
+                "  --no-mips                    store the top level only\n");
+  }
+
+  bool parseFormat(const char* text, sc_world::CookedTextureFormat& out)
+  {
+    if (std::strcmp(text, "bc1") == 0) { out = sc_world::CookedTextureFormat::BC1; return true; }
+    if (std::strcmp(text, "bc3") == 0) { out = sc_world::CookedTextureFormat::BC3; return true; }
+    if (std::strcmp(text, "bc7") == 0) { out = sc_world::CookedTextureFormat::BC7; return true; }
+    if (std::strcmp(text, "rgba8") == 0) { out = sc_world::CookedTextureFormat::RGBA8; return true; }
+    return false;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  if (argc < 3)
+  {
+    printUsage();
+    return 1;
+  }
+
+  const char* inputPath = argv[1];
+  const char* outputPath = argv[2];
+  sc_import::TextureCookOptions options{};
+  for (int i = 3; i < argc; ++i)
+  {
+    const std::string arg = argv[i];
+    if (arg == "--format" && i + 1 < argc)
+    {
+      if (!parseFormat(argv[++i], options.format))
+      {
+        std::printf("[TextureCooker] unknown format '%s'\n", argv[i]);
+        return 1;
+      }
+    }
+    else if (arg == "--filter" && i + 1 < argc)
+    {
+      const std::string filter = argv[++i];
+      options.mipFilter = (filter == "box") ? sc_import::MipFilter::Box : sc_import::MipFilter::Kaiser;
+    }
+    else if (arg == "--linear")
+    {
+      options.srgb = false;
+    }
+    else if (arg == "--no-mips")
+    {
+      options.generateMips = false;
+    }
+    else
+    {
+      printUsage();
+      return 1;
+    }
+  }
+
+  int width = 0;
+  int height = 0;
+  int channels = 0;
+  stbi_uc* pixels = stbi_load(inputPath, &width, &height, &channels, STBI_rgb_alpha);
+  if (!pixels || width <= 0 || height <= 0)
+  {
+    std::printf("[TextureCooker] failed to load '%s'\n", inputPath);
+    if (pixels)
+      stbi_image_free(pixels);
+    return 1;
+  }
+
+  sc_world::CookedTexture cooked{};
+  std::string error;
+  const bool ok = sc_import::CookTexture(pixels,
+                                         static_cast<uint32_t>(width),
+                                         static_cast<uint32_t>(height),
+                                         options,
+                                         &cooked,
+                                         &error);
+  stbi_image_free(pixels);
+  if (!ok)
+  {
+    std::printf("[TextureCooker] %s\n", error.c_str());
+    return 1;
+  }
+
+  if (!sc_world::WriteCookedTexture(outputPath, cooked))
+  {
+    std::printf("[TextureCooker] failed to write '%s'\n", outputPath);
+    return 1;
+  }
+
+  const uint64_t sourceBytes = static_cast<uint64_t>(width) * static_cast<uint64_t>(height) * 4ull;
+  std::printf("[TextureCooker] %s -> %s: %dx%d, %zu mips, %llu bytes (top level uncompressed: %llu)\n",
+              inputPath,
+              outputPath,
+              width,
+              height,
+              cooked.mips.size(),
+              static_cast<unsigned long long>(cooked.data.size()),
+              static_cast<unsigned long long>(sourceBytes));
+  return 0;
+}
@@ -93,14 +93,16 @@ namespace editor
 
   bool EditorAssetRegistry::loadFromFile(const char* path)
   {
-    entries.clear();
-    return sc_world::LoadAssetRegistry(path, entries);
+    if (!index.loadText(path))
+      return false;
+    index.saveCooked(sc_world::CookedRegistryPathFor(path).c_str());
+    return true;
   }
 
   const sc_world::AssetRegistryEntry* EditorAssetRegistry::findByIds(sc_world::AssetId meshId,
                                                                      sc_world::AssetId materialId) const
   {
-    return sc_world::FindByIds(entries, meshId, materialId);
+    return index.findByIds(meshId, materialId);
   }
 
   void InitDocument(EditorDocument* doc)
@@ -203,6 +205,20 @@ namespace editor
     if (e->modelAssetId != 0 && assetDb && modelCache)
     {
       e->meshHandle = modelCache->resolveMeshHandle(render, *assetDb, e->modelAssetId);
+      if (e->pendingDefaultTexture)
+      {
+        const ModelRecord* record = modelCache->find(e->modelAssetId);
+        if (record && !record->loading)
+        {
+          e->pendingDefaultTexture = false;
+          if (!e->useTexture && record->defaultAlbedoTextureId != 0)
+          {
+            e->useTexture = true;
+            e->albedoTextureAssetId = record->defaultAlbedoTextureId;
+          }
+        }
+      }
+
       ScRenderHandle resolvedMaterial = 0;
       if (e->useTexture && e->albedoTextureAssetId != 0 && assetDb && textureCache)
       {
@@ -33,6 +33,9 @@ namespace editor
     sc_world::AssetId materialAssetId = 0;
     sc_world::AssetId albedoTextureAssetId = 0;
     bool useTexture = false;
+    // Spawned while its model was still cooking: the model's default albedo is
+    // applied when it loads, unless a texture was picked in the meantime. Not saved.
+    bool pendingDefaultTexture = false;
     uint32_t tags = 0;
 
     ScRenderHandle meshHandle = 0;
@@ -42,8 +45,10 @@ namespace editor
 
   struct EditorAssetRegistry
   {
-    std::vector<sc_world::AssetRegistryEntry> entries;
+    sc_world::AssetRegistry index;
+    // Loads the text registry and refreshes its cooked sibling for the runtime.
     bool loadFromFile(const char* path);
+    const std::vector<sc_world::AssetRegistryEntry>& entries() const { return index.entries(); }
     const sc_world::AssetRegistryEntry* findByIds(sc_world::AssetId meshId, sc_world::AssetId materialId) const;
   };
 
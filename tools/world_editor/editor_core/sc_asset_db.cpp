@@ -5,6 +5,7 @@
 #include <chrono>
 #include <cstdio>
 #include <filesystem>
+#include <fstream>
 
 namespace sc
 {
@@ -21,6 +22,35 @@ namespace editor
       return text;
     }
 
+    static std::string folderOf(const std::string& relPath)
+    {
+      const size_t slash = relPath.find_last_of('/');
+      return slash == std::string::npos ? std::string() : relPath.substr(0, slash);
+    }
+
+    static uint32_t trigramAt(const std::string& lower, size_t c)
+    {
+      return static_cast<uint32_t>(static_cast<unsigned char>(lower[c])) |
+             (static_cast<uint32_t>(static_cast<unsigned char>(lower[c + 1])) << 8) |
+             (static_cast<uint32_t>(static_cast<unsigned char>(lower[c + 2])) << 16);
+    }
+
+    static void collectTrigrams(const std::string& lower, std::vector<uint32_t>& grams)
+    {
+      grams.clear();
+      for (size_t c = 0; c + 3 <= lower.size(); ++c)
+        grams.push_back(trigramAt(lower, c));
+      std::sort(grams.begin(), grams.end());
+      grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+    }
+
+    static void replaceIndex(std::vector<uint32_t>& list, uint32_t from, uint32_t to)
+    {
+      auto it = std::find(list.begin(), list.end(), from);
+      if (it != list.end())
+        *it = to;
+    }
+
     static bool isParentPathComponentValid(const std::filesystem::path& rel)
     {
       for (const auto& part : rel)
@@ -67,20 +97,13 @@ namespace editor
     m_indexById.clear();
     m_folders.clear();
     m_folderIndex.clear();
+    rebuildQueryIndices();
   }
 
-  void AssetDatabase::scanAll()
+  void AssetDatabase::resetFolders()
   {
-    clear();
-
-    if (m_root.empty())
-    {
-      m_rootValid = false;
-      return;
-    }
-
-    std::error_code ec;
-    m_rootValid = std::filesystem::exists(m_root, ec) && std::filesystem::is_directory(m_root, ec);
+    m_folders.clear();
+    m_folderIndex.clear();
 
     AssetFolder root_folder{};
     root_folder.relPath = "";
@@ -92,72 +115,492 @@ namespace editor
       root_folder.name = "assets";
     m_folders.push_back(root_folder);
     m_folderIndex[root_folder.relPath] = 0;
+  }
 
-    if (!m_rootValid)
+  void AssetDatabase::scanAll()
+  {
+    clear();
+
+    if (m_root.empty())
+    {
+      m_rootValid = false;
       return;
+    }
+
+    std::error_code ec;
+    m_rootValid = std::filesystem::exists(m_root, ec) && std::filesystem::is_directory(m_root, ec);
+
+    resetFolders();
+    if (m_rootValid)
+      addTree(m_root);
 
+    rebuildFolderOrder();
+    rebuildQueryIndices();
+  }
+
+  void AssetDatabase::addTree(const std::filesystem::path& absPath)
+  {
+    std::error_code ec;
     std::filesystem::directory_options options = std::filesystem::directory_options::skip_permission_denied;
-    std::filesystem::recursive_directory_iterator it(m_root, options, ec);
+    std::filesystem::recursive_directory_iterator it(absPath, options, ec);
     std::filesystem::recursive_directory_iterator end;
 
+    if (absPath != m_root)
+      addFolder(absPath);
+
     while (!ec && it != end)
     {
       const std::filesystem::directory_entry entry = *it;
       const std::filesystem::path path = entry.path();
 
       if (entry.is_directory(ec))
-      {
         addFolder(path);
-      }
       else if (entry.is_regular_file(ec))
+        indexFile(path);
+
+      it.increment(ec);
+    }
+  }
+
+  bool AssetDatabase::indexFile(const std::filesystem::path& absPath)
+  {
+    const AssetType type = detectType(absPath);
+    if (type == AssetType::Unknown)
+      return false;
+
+    std::filesystem::path rel = absPath.lexically_relative(m_root);
+    if (rel.empty() || rel == "." || !isParentPathComponentValid(rel))
+      return false;
+
+    const std::string rel_path = rel.generic_string();
+
+    AssetEntry asset{};
+    asset.type = type;
+    asset.relPath = rel_path;
+    asset.absPath = absPath.string();
+    asset.id = sc_world::HashAssetPath(rel_path.c_str());
+    asset.status = AssetStatus::Indexed;
+
+    std::error_code size_ec;
+    const uintmax_t size = std::filesystem::file_size(absPath, size_ec);
+    asset.fileSize = size_ec ? 0u : static_cast<uint64_t>(size);
+
+    std::error_code time_ec;
+    const std::filesystem::file_time_type write_time = std::filesystem::last_write_time(absPath, time_ec);
+    asset.lastWriteTime = time_ec ? 0u : toUnixTime(write_time);
+
+    auto it = m_indexById.find(asset.id);
+    if (it != m_indexById.end())
+    {
+      // Case-only duplicates share an id; the first path indexed keeps it.
+      AssetEntry& existing = m_entries[it->second];
+      if (existing.relPath != asset.relPath)
+        return false;
+      existing.fileSize = asset.fileSize;
+      existing.lastWriteTime = asset.lastWriteTime;
+      existing.status = AssetStatus::Indexed;
+      return true;
+    }
+
+    if (rel.has_parent_path())
+      addFolder(absPath.parent_path());
+    m_indexById[asset.id] = m_entries.size();
+    m_entries.push_back(std::move(asset));
+    return true;
+  }
+
+  void AssetDatabase::removePath(const std::string& relPath)
+  {
+    auto eraseAt = [&](size_t index)
+    {
+      removeQueryEntry(static_cast<uint32_t>(index));
+      m_indexById.erase(m_entries[index].id);
+      if (index + 1 != m_entries.size())
       {
-        const AssetType type = detectType(path);
-        if (type == AssetType::Unknown)
-        {
-          ++it;
-          continue;
-        }
-
-        std::filesystem::path rel = path.lexically_relative(m_root);
-        if (rel.empty() || rel == "." || !isParentPathComponentValid(rel))
-        {
-          ++it;
-          continue;
-        }
-
-        const std::string rel_path = rel.generic_string();
-
-        AssetEntry asset{};
-        asset.type = type;
-        asset.relPath = rel_path;
-        asset.absPath = path.string();
-        asset.id = sc_world::HashAssetPath(rel_path.c_str());
-        asset.status = AssetStatus::Indexed;
-
-        std::error_code size_ec;
-        const uintmax_t size = std::filesystem::file_size(path, size_ec);
-        asset.fileSize = size_ec ? 0u : static_cast<uint64_t>(size);
-
-        std::error_code time_ec;
-        const std::filesystem::file_time_type write_time = std::filesystem::last_write_time(path, time_ec);
-        asset.lastWriteTime = time_ec ? 0u : toUnixTime(write_time);
-
-        if (m_indexById.find(asset.id) == m_indexById.end())
-        {
-          m_indexById[asset.id] = m_entries.size();
-          m_entries.push_back(std::move(asset));
-        }
+        m_entries[index] = std::move(m_entries.back());
+        m_indexById[m_entries[index].id] = index;
       }
+      m_entries.pop_back();
+    };
 
-      ++it;
+    auto it = m_indexById.find(sc_world::HashAssetPath(relPath.c_str()));
+    if (it != m_indexById.end() && m_entries[it->second].relPath == relPath)
+    {
+      eraseAt(it->second);
+      return;
+    }
+
+    // Not a file we know: treat it as a directory and drop everything below it.
+    const std::string prefix = relPath + "/";
+    for (size_t i = m_entries.size(); i-- > 0;)
+    {
+      if (m_entries[i].relPath.compare(0, prefix.size(), prefix) == 0)
+        eraseAt(i);
+    }
+  }
+
+  void AssetDatabase::rebuildFolders()
+  {
+    std::vector<std::string> previous;
+    previous.reserve(m_folders.size());
+    for (const AssetFolder& folder : m_folders)
+    {
+      if (!folder.relPath.empty())
+        previous.push_back(folder.relPath);
     }
 
+    resetFolders();
+    for (const std::string& rel : previous)
+    {
+      std::error_code ec;
+      const std::filesystem::path abs = m_root / rel;
+      if (std::filesystem::is_directory(abs, ec))
+        addFolder(abs);
+    }
+    for (const AssetEntry& entry : m_entries)
+    {
+      const std::filesystem::path rel(entry.relPath);
+      if (rel.has_parent_path())
+        addFolder(m_root / rel.parent_path());
+    }
     rebuildFolderOrder();
   }
 
   void AssetDatabase::scanIncremental()
   {
-    scanAll();
+    if (!m_watcher.running())
+    {
+      scanAll();
+      return;
+    }
+
+    m_changes.clear();
+    if (m_watcher.drain(m_changes) == 0)
+      return;
+
+    for (const AssetChange& change : m_changes)
+    {
+      if (change.kind == AssetChangeKind::Rescan)
+      {
+        scanAll();
+        return;
+      }
+    }
+
+    // Patching costs a sorted insert per new entry, so a batch that adds a lot
+    // (a copied-in folder, say) is cheaper to index from scratch.
+    const size_t rebuild_threshold = std::max<size_t>(64, m_entries.size() / 8);
+    bool folders_removed = false;
+    const size_t folder_count = m_folders.size();
+    for (const AssetChange& change : m_changes)
+    {
+      const std::filesystem::path rel(change.relPath);
+      if (rel.empty() || !isParentPathComponentValid(rel))
+        continue;
+
+      const std::filesystem::path abs = m_root / rel;
+      std::error_code ec;
+      const size_t entry_count = m_entries.size();
+      if (change.kind == AssetChangeKind::Modified && std::filesystem::is_directory(abs, ec))
+        addTree(abs);
+      else if (change.kind == AssetChangeKind::Modified && std::filesystem::is_regular_file(abs, ec))
+        indexFile(abs);
+      else
+      {
+        // Polling only reports files, so also notice when their folder went away.
+        const std::string parent = rel.parent_path().generic_string();
+        folders_removed |= m_folderIndex.find(change.relPath) != m_folderIndex.end();
+        folders_removed |= !parent.empty() && !std::filesystem::is_directory(m_root / parent, ec);
+        removePath(change.relPath);
+      }
+
+      // Modified files keep their path, so only new entries need indexing.
+      if (m_entries.size() - entry_count > rebuild_threshold)
+        m_queryIndicesStale = true;
+      for (size_t i = entry_count; i < m_entries.size(); ++i)
+        addQueryEntry(static_cast<uint32_t>(i));
+    }
+
+    if (folders_removed)
+      rebuildFolders();
+    else if (m_folders.size() != folder_count)
+      rebuildFolderOrder();
+    if (m_queryIndicesStale)
+      rebuildQueryIndices();
+  }
+
+  bool AssetDatabase::startWatching(bool allowNative)
+  {
+    if (!m_rootValid)
+      return false;
+
+    std::unordered_map<std::string, AssetFileStamp> snapshot;
+    snapshot.reserve(m_entries.size());
+    for (const AssetEntry& entry : m_entries)
+      snapshot[entry.relPath] = AssetFileStamp{ entry.fileSize, entry.lastWriteTime };
+
+    return m_watcher.start(m_root, std::move(snapshot), [](const std::filesystem::path& path)
+    {
+      return detectType(path) != AssetType::Unknown;
+    }, allowNative);
+  }
+
+  void AssetDatabase::stopWatching()
+  {
+    m_watcher.stop();
+  }
+
+  namespace
+  {
+    static constexpr uint32_t kIndexCacheMagic = 0x42444153; // "SADB"
+    static constexpr uint32_t kIndexCacheVersion = 1;
+
+    template<typename T>
+    static void WriteValue(std::ofstream& out, const T& value)
+    {
+      out.write(reinterpret_cast<const char*>(&value), static_cast<std::streamsize>(sizeof(T)));
+    }
+
+    template<typename T>
+    static bool ReadValue(std::ifstream& in, T& out_value)
+    {
+      in.read(reinterpret_cast<char*>(&out_value), static_cast<std::streamsize>(sizeof(T)));
+      return in.good();
+    }
+
+    static void WriteString(std::ofstream& out, const std::string& text)
+    {
+      WriteValue(out, static_cast<uint32_t>(text.size()));
+      out.write(text.data(), static_cast<std::streamsize>(text.size()));
+    }
+
+    static bool ReadString(std::ifstream& in, std::string& out_text)
+    {
+      uint32_t size = 0;
+      if (!ReadValue(in, size) || size > 4096)
+        return false;
+      out_text.resize(size);
+      in.read(out_text.data(), static_cast<std::streamsize>(size));
+      return in.good();
+    }
+  }
+
+  bool AssetDatabase::saveIndexCache(const std::filesystem::path& path) const
+  {
+    if (!m_rootValid)
+      return false;
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open())
+      return false;
+
+    WriteValue(out, kIndexCacheMagic);
+    WriteValue(out, kIndexCacheVersion);
+    WriteString(out, m_root.generic_string());
+
+    WriteValue(out, static_cast<uint32_t>(m_folders.size()));
+    for (const AssetFolder& folder : m_folders)
+      WriteString(out, folder.relPath);
+
+    WriteValue(out, static_cast<uint32_t>(m_entries.size()));
+    for (const AssetEntry& entry : m_entries)
+    {
+      WriteValue(out, entry.id);
+      WriteValue(out, static_cast<uint32_t>(entry.type));
+      WriteValue(out, entry.fileSize);
+      WriteValue(out, entry.lastWriteTime);
+      WriteString(out, entry.relPath);
+    }
+    return out.good();
+  }
+
+  bool AssetDatabase::loadIndexCache(const std::filesystem::path& path)
+  {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open() || !m_rootValid)
+      return false;
+
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    std::string root;
+    if (!ReadValue(in, magic) || !ReadValue(in, version) || !ReadString(in, root))
+      return false;
+    // A cache written for another root (or by an older editor) is useless.
+    if (magic != kIndexCacheMagic || version != kIndexCacheVersion || root != m_root.generic_string())
+      return false;
+
+    clear();
+    resetFolders();
+
+    uint32_t folder_count = 0;
+    if (!ReadValue(in, folder_count))
+      return false;
+    std::string rel;
+    for (uint32_t i = 0; i < folder_count; ++i)
+    {
+      if (!ReadString(in, rel))
+      {
+        clear();
+        return false;
+      }
+      if (!rel.empty())
+        addFolder(m_root / rel);
+    }
+
+    uint32_t entry_count = 0;
+    if (!ReadValue(in, entry_count))
+    {
+      clear();
+      return false;
+    }
+    m_entries.reserve(entry_count);
+    for (uint32_t i = 0; i < entry_count; ++i)
+    {
+      AssetEntry entry{};
+      uint32_t type = 0;
+      if (!ReadValue(in, entry.id) || !ReadValue(in, type) || !ReadValue(in, entry.fileSize) ||
+          !ReadValue(in, entry.lastWriteTime) || !ReadString(in, entry.relPath) ||
+          type >= kAssetTypeCount)
+      {
+        clear();
+        return false;
+      }
+      entry.type = static_cast<AssetType>(type);
+      entry.absPath = (m_root / entry.relPath).string();
+      entry.status = AssetStatus::Indexed;
+      if (m_indexById.find(entry.id) != m_indexById.end())
+        continue;
+      m_indexById[entry.id] = m_entries.size();
+      m_entries.push_back(std::move(entry));
+    }
+
+    rebuildFolderOrder();
+    rebuildQueryIndices();
+    return true;
+  }
+
+  void AssetDatabase::rebuildQueryIndices()
+  {
+    const uint32_t count = static_cast<uint32_t>(m_entries.size());
+    m_lowerPaths.resize(count);
+    m_lowerNames.resize(count);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      m_lowerPaths[i] = toLower(m_entries[i].relPath);
+      const size_t slash = m_lowerPaths[i].find_last_of('/');
+      m_lowerNames[i] = (slash == std::string::npos) ? m_lowerPaths[i] : m_lowerPaths[i].substr(slash + 1);
+    }
+
+    std::vector<uint32_t> order(count);
+    for (uint32_t i = 0; i < count; ++i)
+      order[i] = i;
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b)
+    {
+      return queryNameLess(a, b);
+    });
+
+    for (auto& list : m_byType)
+      list.clear();
+    m_byFolder.clear();
+    for (uint32_t index : order)
+    {
+      m_byType[static_cast<size_t>(m_entries[index].type)].push_back(index);
+      m_byFolder[folderOf(m_entries[index].relPath)].push_back(index);
+    }
+
+    m_trigrams.clear();
+    std::vector<uint32_t> grams;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+      collectTrigrams(m_lowerPaths[i], grams);
+      for (uint32_t gram : grams)
+        m_trigrams[gram].push_back(i);
+    }
+    m_queryIndicesStale = false;
+  }
+
+  bool AssetDatabase::queryNameLess(uint32_t a, uint32_t b) const
+  {
+    if (m_lowerNames[a] != m_lowerNames[b])
+      return m_lowerNames[a] < m_lowerNames[b];
+    return m_lowerPaths[a] < m_lowerPaths[b];
+  }
+
+  // Indexes m_entries[index], which must be the newest entry.
+  void AssetDatabase::addQueryEntry(uint32_t index)
+  {
+    if (m_queryIndicesStale)
+      return;
+
+    m_lowerPaths.push_back(toLower(m_entries[index].relPath));
+    const size_t slash = m_lowerPaths[index].find_last_of('/');
+    m_lowerNames.push_back((slash == std::string::npos) ? m_lowerPaths[index] : m_lowerPaths[index].substr(slash + 1));
+
+    auto insertSorted = [&](std::vector<uint32_t>& list)
+    {
+      list.insert(std::lower_bound(list.begin(), list.end(), index, [&](uint32_t a, uint32_t b)
+      {
+        return queryNameLess(a, b);
+      }), index);
+    };
+    insertSorted(m_byType[static_cast<size_t>(m_entries[index].type)]);
+    insertSorted(m_byFolder[folderOf(m_entries[index].relPath)]);
+
+    std::vector<uint32_t> grams;
+    collectTrigrams(m_lowerPaths[index], grams);
+    for (uint32_t gram : grams)
+      m_trigrams[gram].push_back(index);
+  }
+
+  // Unindexes m_entries[index] ahead of removePath() moving the last entry
+  // into its slot, and renumbers that entry to match.
+  void AssetDatabase::removeQueryEntry(uint32_t index)
+  {
+    if (m_queryIndicesStale)
+      return;
+
+    const uint32_t last = static_cast<uint32_t>(m_entries.size() - 1);
+    std::vector<uint32_t> grams;
+    collectTrigrams(m_lowerPaths[index], grams);
+    for (uint32_t gram : grams)
+    {
+      auto it = m_trigrams.find(gram);
+      if (it == m_trigrams.end())
+        continue;
+      std::vector<uint32_t>& list = it->second;
+      auto pos = std::find(list.begin(), list.end(), index);
+      if (pos != list.end())
+      {
+        *pos = list.back();
+        list.pop_back();
+      }
+      if (list.empty())
+        m_trigrams.erase(it);
+    }
+
+    std::vector<uint32_t>& by_type = m_byType[static_cast<size_t>(m_entries[index].type)];
+    by_type.erase(std::find(by_type.begin(), by_type.end(), index));
+    auto folder = m_byFolder.find(folderOf(m_entries[index].relPath));
+    if (folder != m_byFolder.end())
+    {
+      folder->second.erase(std::find(folder->second.begin(), folder->second.end(), index));
+      if (folder->second.empty())
+        m_byFolder.erase(folder);
+    }
+
+    if (index != last)
+    {
+      // The moved entry keeps its name, so the sorted lists stay sorted.
+      collectTrigrams(m_lowerPaths[last], grams);
+      for (uint32_t gram : grams)
+        replaceIndex(m_trigrams[gram], last, index);
+      replaceIndex(m_byType[static_cast<size_t>(m_entries[last].type)], last, index);
+      replaceIndex(m_byFolder[folderOf(m_entries[last].relPath)], last, index);
+      m_lowerPaths[index] = std::move(m_lowerPaths[last]);
+      m_lowerNames[index] = std::move(m_lowerNames[last]);
+    }
+    m_lowerPaths.pop_back();
+    m_lowerNames.pop_back();
   }
 
   const std::vector<AssetEntry>& AssetDatabase::getAll() const
@@ -168,11 +611,24 @@ namespace editor
   std::vector<const AssetEntry*> AssetDatabase::getByType(AssetType type) const
   {
     std::vector<const AssetEntry*> out;
-    for (const auto& entry : m_entries)
-    {
-      if (entry.type == type)
-        out.push_back(&entry);
-    }
+    const size_t slot = static_cast<size_t>(type);
+    if (slot >= kAssetTypeCount)
+      return out;
+    out.reserve(m_byType[slot].size());
+    for (uint32_t index : m_byType[slot])
+      out.push_back(&m_entries[index]);
+    return out;
+  }
+
+  std::vector<const AssetEntry*> AssetDatabase::getByFolder(const std::string& relPath) const
+  {
+    std::vector<const AssetEntry*> out;
+    auto it = m_byFolder.find(relPath);
+    if (it == m_byFolder.end())
+      return out;
+    out.reserve(it->second.size());
+    for (uint32_t index : it->second)
+      out.push_back(&m_entries[index]);
     return out;
   }
 
@@ -190,12 +646,43 @@ namespace editor
     if (substr.empty())
       return out;
     const std::string needle = toLower(substr);
-    for (const auto& entry : m_entries)
+
+    // Candidates come from the rarest trigram of the needle; short needles scan.
+    const std::vector<uint32_t>* candidates = nullptr;
+    std::vector<uint32_t> all;
+    if (needle.size() >= 3)
+    {
+      for (size_t c = 0; c + 3 <= needle.size(); ++c)
+      {
+        auto it = m_trigrams.find(trigramAt(needle, c));
+        if (it == m_trigrams.end())
+          return out;
+        if (!candidates || it->second.size() < candidates->size())
+          candidates = &it->second;
+      }
+    }
+    else
+    {
+      all.resize(m_entries.size());
+      for (uint32_t i = 0; i < static_cast<uint32_t>(all.size()); ++i)
+        all[i] = i;
+      candidates = &all;
+    }
+
+    std::vector<uint32_t> matches;
+    for (uint32_t index : *candidates)
     {
-      const std::string hay = toLower(entry.relPath);
-      if (hay.find(needle) != std::string::npos)
-        out.push_back(&entry);
+      if (m_lowerPaths[index].find(needle) != std::string::npos)
+        matches.push_back(index);
     }
+    std::sort(matches.begin(), matches.end(), [&](uint32_t a, uint32_t b)
+    {
+      return queryNameLess(a, b);
+    });
+
+    out.reserve(matches.size());
+    for (uint32_t index : matches)
+      out.push_back(&m_entries[index]);
     return out;
   }
 
@@ -317,11 +804,41 @@ namespace editor
     return record ? record->handle : 0;
   }
 
+  EditorModelCache::~EditorModelCache()
+  {
+    shutdown();
+  }
+
+  void EditorModelCache::setCookRoot(const std::filesystem::path& dir)
+  {
+    m_cookRoot = dir;
+  }
+
   void EditorModelCache::clear()
   {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_queue.clear();
+      m_finished.clear();
+    }
     m_records.clear();
   }
 
+  void EditorModelCache::shutdown()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stopping = true;
+      m_queue.clear();
+    }
+    m_wake.notify_all();
+    for (std::thread& worker : m_workers)
+      worker.join();
+    m_workers.clear();
+    m_finished.clear();
+    m_stopping = false;
+  }
+
   const ModelRecord* EditorModelCache::find(sc_world::AssetId id) const
   {
     auto it = m_records.find(id);
@@ -338,15 +855,6 @@ namespace editor
     return &it->second;
   }
 
-  bool EditorModelCache::ensureRegistry()
-  {
-    if (m_registryReady)
-      return true;
-    sc_import::RegisterGlbImporter(&m_registry);
-    m_registryReady = true;
-    return true;
-  }
-
   sc_world::AssetId EditorModelCache::resolveTextureAssetId(const AssetDatabase& db,
                                                             const AssetEntry& modelEntry,
                                                             const std::string& uri) const
@@ -377,39 +885,109 @@ namespace editor
     return id;
   }
 
-  bool EditorModelCache::loadRecord(ScRenderContext* render,
-                                    const AssetDatabase& db,
-                                    const AssetEntry& entry,
-                                    ModelRecord& record)
+  void EditorModelCache::queueLoad(const AssetEntry& entry, ModelRecord& record, bool force)
   {
-    if (!render)
-      return false;
-    if (!ensureRegistry())
-      return false;
+    if (m_workers.empty())
+    {
+      sc_import::RegisterGlbImporter(&m_registry);
+      // Leave a core for the UI thread; more than a few workers only fight over disk.
+      const uint32_t hw = std::max(2u, std::thread::hardware_concurrency());
+      const uint32_t count = std::min(hw - 1u, 4u);
+      for (uint32_t i = 0; i < count; ++i)
+        m_workers.emplace_back([this]() { workerMain(); });
+    }
+
+    LoadRequest request{};
+    request.id = entry.id;
+    request.job.sourcePath = entry.absPath;
+    if (!m_cookRoot.empty())
+      request.job.outputPath = (m_cookRoot / entry.relPath).string() + sc_import::kCookedMeshExtension;
+    request.force = force;
 
+    record.loading = true;
     record.fileModifiedTime = entry.lastWriteTime;
-    record.loadFailed = false;
-    record.error.clear();
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_queue.push_back(std::move(request));
+    }
+    m_wake.notify_one();
+  }
 
-    sc_import::ImportedModel model{};
-    sc_import::MeshImportOptions options{};
-    options.bakeNodeTransforms = true;
-    std::string error;
-    if (!m_registry.importModel(entry.absPath.c_str(), options, &model, &error))
+  void EditorModelCache::workerMain()
+  {
+    for (;;)
     {
-      record.loadFailed = true;
-      record.error = error;
-      return false;
+      LoadRequest request{};
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_wake.wait(lock, [this]() { return m_stopping || !m_queue.empty(); });
+        if (m_stopping)
+          return;
+        request = std::move(m_queue.front());
+        m_queue.pop_front();
+      }
+
+      LoadResult done{};
+      done.id = request.id;
+      sc_import::MeshCookOptions options = m_cookOptions;
+      options.force = request.force;
+      sc_import::LoadOrCookMesh(m_registry, request.job, options, &done.mesh, &done.result);
+
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (!m_stopping)
+        m_finished.push_back(std::move(done));
     }
+  }
 
-    sc_import::MeshData merged{};
-    if (!sc_import::FlattenModelToMesh(model, &merged, &error))
+  size_t EditorModelCache::pump(ScRenderContext* render,
+                                const AssetDatabase& db,
+                                std::vector<sc_world::AssetId>* out_loaded)
+  {
+    std::vector<LoadResult> finished;
     {
-      record.loadFailed = true;
-      record.error = error;
-      return false;
+      std::lock_guard<std::mutex> lock(m_mutex);
+      finished.swap(m_finished);
     }
 
+    size_t uploaded = 0;
+    for (LoadResult& done : finished)
+    {
+      ModelRecord* record = findMutable(done.id);
+      if (!record || !record->loading)
+        continue;
+      record->loading = false;
+
+      const AssetEntry* entry = db.findById(done.id);
+      if (!entry || entry->type != AssetType::Model)
+        continue;
+
+      // A write failure still produced a usable mesh; only import errors leave nothing to show.
+      if (done.mesh.lods.empty())
+      {
+        record->loadFailed = true;
+        record->error = done.result.error;
+        continue;
+      }
+      if (!render || !uploadRecord(render, db, *entry, done.mesh, *record))
+        continue;
+
+      ++uploaded;
+      if (out_loaded)
+        out_loaded->push_back(done.id);
+    }
+    return uploaded;
+  }
+
+  bool EditorModelCache::uploadRecord(ScRenderContext* render,
+                                      const AssetDatabase& db,
+                                      const AssetEntry& entry,
+                                      const sc_import::CookedMesh& cooked,
+                                      ModelRecord& record)
+  {
+    record.loadFailed = false;
+    record.error.clear();
+
+    const sc_import::MeshData& merged = cooked.lods[0];
     std::vector<ScRenderMeshVertex> verts;
     verts.resize(merged.vertices.size());
     for (size_t i = 0; i < merged.vertices.size(); ++i)
@@ -457,18 +1035,25 @@ namespace editor
 
     scRenderGetMeshInfo(render, record.handle, &record.meshInfo);
 
+    record.lodTriangleCounts.clear();
+    record.lodScreenSizes.clear();
+    for (size_t i = 0; i < cooked.lods.size(); ++i)
+    {
+      record.lodTriangleCounts.push_back(static_cast<uint32_t>(cooked.lods[i].indices.size() / 3));
+      record.lodScreenSizes.push_back(cooked.lodScreenSizes[i]);
+    }
+
     int materialIndex = -1;
     if (!merged.submeshes.empty())
       materialIndex = merged.submeshes[0].materialIndex;
-    if (materialIndex < 0 && !model.materials.empty())
+    if (materialIndex < 0 && !cooked.materials.empty())
       materialIndex = 0;
-    if (materialIndex >= 0 && materialIndex < static_cast<int>(model.materials.size()))
-      record.defaultAlbedoTextureId = resolveTextureAssetId(db, entry, model.materials[materialIndex].baseColorTexture);
+    if (materialIndex >= 0 && materialIndex < static_cast<int>(cooked.materials.size()))
+      record.defaultAlbedoTextureId = resolveTextureAssetId(db, entry, cooked.materials[materialIndex].baseColorTexture);
     else
       record.defaultAlbedoTextureId = 0;
 
-    record.previewMesh = std::move(merged);
-    record.model = std::move(model);
+    record.previewMesh = merged;
     return true;
   }
 
@@ -487,14 +1072,16 @@ namespace editor
     if (record.id == 0)
       record.id = id;
 
+    if (record.loading)
+      return &record;
     if (record.loadFailed && record.fileModifiedTime == entry->lastWriteTime)
       return &record;
 
     const bool needsLoad = (record.handle == 0) || (record.fileModifiedTime != entry->lastWriteTime);
     if (needsLoad)
-      loadRecord(render, db, *entry, record);
+      queueLoad(*entry, record, false);
 
-    return record.handle != 0 ? &record : nullptr;
+    return &record;
   }
 
   bool EditorModelCache::reload(ScRenderContext* render,
@@ -511,7 +1098,9 @@ namespace editor
     if (record.id == 0)
       record.id = id;
 
-    return loadRecord(render, db, *entry, record);
+    if (!record.loading)
+      queueLoad(*entry, record, true);
+    return true;
   }
 
   ScRenderHandle EditorModelCache::resolveMeshHandle(ScRenderContext* render,
@@ -583,7 +1172,7 @@ namespace editor
 
     if (ext == ".glb" || ext == ".gltf")
       return AssetType::Model;
-    if (ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".tga" || ext == ".dds" || ext == ".ktx2")
+    if (ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".tga" || ext == ".dds" || ext == ".ktx2" || ext == ".sctex")
       return AssetType::Texture;
     if (ext == ".vert" || ext == ".frag" || ext == ".comp")
       return AssetType::Shader;
@@ -594,9 +1183,7 @@ namespace editor
 
   uint64_t AssetDatabase::toUnixTime(const std::filesystem::file_time_type& ft)
   {
-    using namespace std::chrono;
-    auto sctp = time_point_cast<system_clock::duration>(ft - std::filesystem::file_time_type::clock::now() + system_clock::now());
-    return static_cast<uint64_t>(duration_cast<seconds>(sctp.time_since_epoch()).count());
+    return AssetFileTimeToUnix(ft);
   }
 
   const char* AssetTypeLabel(AssetType type)
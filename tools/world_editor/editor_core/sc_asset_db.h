@@ -1,14 +1,19 @@
 #pragma once
 
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
 #include <filesystem>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
+#include "sc_asset_watcher.h"
 #include "sc_engine_render.h"
 #include "world_format.h"
-#include "mesh_importer.h"
+#include "mesh_cooker.h"
 
 namespace sc
 {
@@ -23,6 +28,8 @@ namespace editor
     World
   };
 
+  static constexpr size_t kAssetTypeCount = 5;
+
   enum class AssetStatus
   {
     Discovered,
@@ -57,10 +64,23 @@ namespace editor
     bool hasValidRoot() const;
 
     void scanAll();
+    // Applies changes reported by the watcher. Without a watcher this is a
+    // full scanAll().
     void scanIncremental();
 
+    // Index cache: entries load without touching the tree; the watcher's
+    // first pass then corrects anything that changed while the editor was closed.
+    bool loadIndexCache(const std::filesystem::path& path);
+    bool saveIndexCache(const std::filesystem::path& path) const;
+
+    bool startWatching(bool allowNative = true);
+    void stopWatching();
+    AssetWatchMode watchMode() const { return m_watcher.mode(); }
+
+    // Query results are in file-name order.
     const std::vector<AssetEntry>& getAll() const;
     std::vector<const AssetEntry*> getByType(AssetType type) const;
+    std::vector<const AssetEntry*> getByFolder(const std::string& relPath) const;
     const AssetEntry* findById(sc_world::AssetId id) const;
     std::vector<const AssetEntry*> searchByName(const std::string& substr) const;
 
@@ -69,8 +89,17 @@ namespace editor
 
   private:
     void clear();
+    void resetFolders();
     void addFolder(const std::filesystem::path& absPath);
+    void addTree(const std::filesystem::path& absPath);
+    bool indexFile(const std::filesystem::path& absPath);
+    void removePath(const std::string& relPath);
+    void rebuildFolders();
     void rebuildFolderOrder();
+    void rebuildQueryIndices();
+    void addQueryEntry(uint32_t index);
+    void removeQueryEntry(uint32_t index);
+    bool queryNameLess(uint32_t a, uint32_t b) const;
     static AssetType detectType(const std::filesystem::path& path);
     static uint64_t toUnixTime(const std::filesystem::file_time_type& ft);
 
@@ -80,6 +109,18 @@ namespace editor
     std::unordered_map<sc_world::AssetId, size_t> m_indexById;
     std::vector<AssetFolder> m_folders;
     std::unordered_map<std::string, int> m_folderIndex;
+
+    // Query indices over m_entries. Full scans rebuild them; watcher batches
+    // patch only the entries that changed unless the batch is large.
+    std::vector<std::string> m_lowerPaths;
+    std::vector<std::string> m_lowerNames;
+    std::vector<uint32_t> m_byType[kAssetTypeCount];
+    std::unordered_map<std::string, std::vector<uint32_t>> m_byFolder;
+    std::unordered_map<uint32_t, std::vector<uint32_t>> m_trigrams;  // 3 lowercase bytes -> entries
+    bool m_queryIndicesStale = false;
+
+    AssetWatcher m_watcher;
+    std::vector<AssetChange> m_changes;
   };
 
   struct TextureRecord
@@ -124,35 +165,73 @@ namespace editor
     uint32_t submeshCount = 0;
     uint32_t vertexLayoutFlags = 0;
     sc_world::AssetId defaultAlbedoTextureId = 0;
+    bool loading = false;       // queued on the cook workers; handle still holds the previous mesh
     bool loadFailed = false;
     std::string error;
     sc_import::MeshData previewMesh;
-    sc_import::ImportedModel model;
+    std::vector<uint32_t> lodTriangleCounts; // from the cooked LOD chain, LOD 0 first
+    std::vector<float> lodScreenSizes;
   };
 
+  // Models are cooked, or read back from the cook cache when the source hash
+  // still matches, on worker threads. pump() uploads finished ones on the
+  // render thread; until then request() returns the record without a handle.
   class EditorModelCache
   {
   public:
+    ~EditorModelCache();
+
+    // Cooked meshes are cached as <dir>/<asset relative path>.scmesh, the same
+    // layout sc_mesh_cooker writes. Empty keeps cooks in memory only.
+    void setCookRoot(const std::filesystem::path& dir);
     void clear();
+    void shutdown();
     const ModelRecord* find(sc_world::AssetId id) const;
     const ModelRecord* request(ScRenderContext* render, const AssetDatabase& db, sc_world::AssetId id);
+    // Queues a re-cook even if the source is unchanged on disk.
     bool reload(ScRenderContext* render, const AssetDatabase& db, sc_world::AssetId id);
     ScRenderHandle resolveMeshHandle(ScRenderContext* render, const AssetDatabase& db, sc_world::AssetId id);
+    // Uploads models finished since the last call and appends their ids to out_loaded.
+    size_t pump(ScRenderContext* render, const AssetDatabase& db, std::vector<sc_world::AssetId>* out_loaded);
 
   private:
+    struct LoadRequest
+    {
+      sc_world::AssetId id = 0;
+      sc_import::MeshCookJob job;
+      bool force = false;
+    };
+
+    struct LoadResult
+    {
+      sc_world::AssetId id = 0;
+      sc_import::MeshCookResult result;
+      sc_import::CookedMesh mesh;
+    };
+
     ModelRecord* findMutable(sc_world::AssetId id);
-    bool ensureRegistry();
-    bool loadRecord(ScRenderContext* render,
-                    const AssetDatabase& db,
-                    const AssetEntry& entry,
-                    ModelRecord& record);
+    void queueLoad(const AssetEntry& entry, ModelRecord& record, bool force);
+    void workerMain();
+    bool uploadRecord(ScRenderContext* render,
+                      const AssetDatabase& db,
+                      const AssetEntry& entry,
+                      const sc_import::CookedMesh& cooked,
+                      ModelRecord& record);
     sc_world::AssetId resolveTextureAssetId(const AssetDatabase& db,
                                             const AssetEntry& modelEntry,
                                             const std::string& uri) const;
 
-    sc_import::ImporterRegistry m_registry;
-    bool m_registryReady = false;
+    sc_import::ImporterRegistry m_registry;   // filled before the first worker starts
+    sc_import::MeshCookOptions m_cookOptions{};
+    std::filesystem::path m_cookRoot;
     std::unordered_map<sc_world::AssetId, ModelRecord> m_records;
+
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::deque<LoadRequest> m_queue;
+    std::vector<LoadResult> m_finished;
+    bool m_stopping = false;
   };
 
   const char* AssetTypeLabel(AssetType type);
@@ -0,0 +1,382 @@
+#include "sc_asset_watcher.h"
+
+#include <chrono>
+#include <unordered_set>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#elif defined(__linux__)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace sc
+{
+namespace editor
+{
+  uint64_t AssetFileTimeToUnix(const std::filesystem::file_time_type& ft)
+  {
+    using namespace std::chrono;
+    auto sctp = time_point_cast<system_clock::duration>(ft - std::filesystem::file_time_type::clock::now() + system_clock::now());
+    return static_cast<uint64_t>(duration_cast<seconds>(sctp.time_since_epoch()).count());
+  }
+
+  AssetWatcher::~AssetWatcher()
+  {
+    stop();
+  }
+
+  bool AssetWatcher::start(const std::filesystem::path& root,
+                           std::unordered_map<std::string, AssetFileStamp> snapshot,
+                           FileFilter filter,
+                           bool allowNative,
+                           uint32_t pollIntervalMs)
+  {
+    stop();
+
+    std::error_code ec;
+    if (root.empty() || !std::filesystem::is_directory(root, ec))
+      return false;
+
+    m_root = root;
+    m_snapshot = std::move(snapshot);
+    m_filter = std::move(filter);
+    m_pollIntervalMs = pollIntervalMs > 0 ? pollIntervalMs : 2000;
+    m_stop.store(false, std::memory_order_relaxed);
+    m_thread = std::thread([this, allowNative]() { threadMain(allowNative); });
+    return true;
+  }
+
+  void AssetWatcher::stop()
+  {
+    if (!m_thread.joinable())
+      return;
+    m_stop.store(true, std::memory_order_relaxed);
+    m_thread.join();
+    m_mode.store(AssetWatchMode::None, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pending.clear();
+  }
+
+  size_t AssetWatcher::drain(std::vector<AssetChange>& out)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const size_t count = m_pending.size();
+    if (count == 0)
+      return 0;
+    out.insert(out.end(),
+               std::make_move_iterator(m_pending.begin()),
+               std::make_move_iterator(m_pending.end()));
+    m_pending.clear();
+    return count;
+  }
+
+  void AssetWatcher::push(AssetChangeKind kind, std::string relPath)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    AssetChange change{};
+    change.kind = kind;
+    change.relPath = std::move(relPath);
+    m_pending.push_back(std::move(change));
+  }
+
+  void AssetWatcher::threadMain(bool allowNative)
+  {
+    if (allowNative)
+    {
+#if defined(_WIN32)
+      if (runWindows())
+        return;
+#elif defined(__linux__)
+      if (runInotify())
+        return;
+#endif
+    }
+
+    m_mode.store(AssetWatchMode::Polling, std::memory_order_relaxed);
+    while (!stopRequested())
+    {
+      reconcile();
+      for (uint32_t waited = 0; waited < m_pollIntervalMs && !stopRequested(); waited += 100)
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+  }
+
+  void AssetWatcher::reconcile()
+  {
+    std::unordered_set<std::string> seen;
+    seen.reserve(m_snapshot.size());
+
+    std::error_code ec;
+    const auto options = std::filesystem::directory_options::skip_permission_denied;
+    std::filesystem::recursive_directory_iterator it(m_root, options, ec);
+    const std::filesystem::recursive_directory_iterator end;
+    for (; !ec && it != end && !stopRequested(); it.increment(ec))
+    {
+      const std::filesystem::directory_entry& entry = *it;
+      std::error_code type_ec;
+      if (!entry.is_regular_file(type_ec) || (m_filter && !m_filter(entry.path())))
+        continue;
+
+      std::string rel = entry.path().lexically_relative(m_root).generic_string();
+      if (rel.empty())
+        continue;
+
+      AssetFileStamp stamp{};
+      std::error_code size_ec;
+      const uintmax_t size = entry.file_size(size_ec);
+      stamp.fileSize = size_ec ? 0u : static_cast<uint64_t>(size);
+      std::error_code time_ec;
+      const auto write_time = entry.last_write_time(time_ec);
+      stamp.lastWriteTime = time_ec ? 0u : AssetFileTimeToUnix(write_time);
+
+      auto found = m_snapshot.find(rel);
+      if (found == m_snapshot.end() ||
+          found->second.fileSize != stamp.fileSize ||
+          found->second.lastWriteTime != stamp.lastWriteTime)
+      {
+        m_snapshot[rel] = stamp;
+        push(AssetChangeKind::Modified, rel);
+      }
+      seen.insert(std::move(rel));
+    }
+
+    // An interrupted walk proves nothing about what is missing.
+    if (ec || stopRequested())
+      return;
+
+    for (auto snap = m_snapshot.begin(); snap != m_snapshot.end();)
+    {
+      if (seen.find(snap->first) == seen.end())
+      {
+        push(AssetChangeKind::Removed, snap->first);
+        snap = m_snapshot.erase(snap);
+      }
+      else
+      {
+        ++snap;
+      }
+    }
+  }
+
+#if defined(_WIN32)
+  bool AssetWatcher::runWindows()
+  {
+    HANDLE dir = CreateFileW(m_root.c_str(),
+                             FILE_LIST_DIRECTORY,
+                             FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                             nullptr,
+                             OPEN_EXISTING,
+                             FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED,
+                             nullptr);
+    if (dir == INVALID_HANDLE_VALUE)
+      return false;
+
+    OVERLAPPED overlapped{};
+    overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+    if (!overlapped.hEvent)
+    {
+      CloseHandle(dir);
+      return false;
+    }
+
+    std::vector<DWORD> buffer(16 * 1024);
+    const DWORD notify_filter = FILE_NOTIFY_CHANGE_FILE_NAME |
+                                FILE_NOTIFY_CHANGE_DIR_NAME |
+                                FILE_NOTIFY_CHANGE_SIZE |
+                                FILE_NOTIFY_CHANGE_LAST_WRITE;
+    auto issue = [&]()
+    {
+      ResetEvent(overlapped.hEvent);
+      return ReadDirectoryChangesW(dir, buffer.data(), static_cast<DWORD>(buffer.size() * sizeof(DWORD)), TRUE, notify_filter, nullptr, &overlapped, nullptr) != 0;
+    };
+
+    if (!issue())
+    {
+      CloseHandle(overlapped.hEvent);
+      CloseHandle(dir);
+      return false;
+    }
+
+    m_mode.store(AssetWatchMode::Native, std::memory_order_relaxed);
+    // Changes from here on are queued by the OS, so nothing slips past the walk.
+    reconcile();
+
+    while (!stopRequested())
+    {
+      if (WaitForSingleObject(overlapped.hEvent, 200) != WAIT_OBJECT_0)
+        continue;
+
+      DWORD bytes = 0;
+      if (!GetOverlappedResult(dir, &overlapped, &bytes, FALSE) || bytes == 0)
+      {
+        // Zero bytes means the kernel buffer overflowed and events were dropped.
+        push(AssetChangeKind::Rescan, std::string());
+      }
+      else
+      {
+        const uint8_t* cursor = reinterpret_cast<const uint8_t*>(buffer.data());
+        for (;;)
+        {
+          const auto* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(cursor);
+          const std::wstring name(info->FileName, info->FileNameLength / sizeof(WCHAR));
+          std::string rel = std::filesystem::path(name).generic_string();
+
+          switch (info->Action)
+          {
+            case FILE_ACTION_ADDED:
+            case FILE_ACTION_MODIFIED:
+            case FILE_ACTION_RENAMED_NEW_NAME:
+            {
+              std::error_code ec;
+              const std::filesystem::path abs = m_root / name;
+              if (std::filesystem::is_directory(abs, ec) || !m_filter || m_filter(abs))
+                push(AssetChangeKind::Modified, std::move(rel));
+              break;
+            }
+            case FILE_ACTION_REMOVED:
+            case FILE_ACTION_RENAMED_OLD_NAME:
+              push(AssetChangeKind::Removed, std::move(rel));
+              break;
+            default:
+              break;
+          }
+
+          if (info->NextEntryOffset == 0)
+            break;
+          cursor += info->NextEntryOffset;
+        }
+      }
+
+      if (!issue())
+      {
+        push(AssetChangeKind::Rescan, std::string());
+        break;
+      }
+    }
+
+    CancelIoEx(dir, &overlapped);
+    DWORD ignored = 0;
+    GetOverlappedResult(dir, &overlapped, &ignored, TRUE);
+    CloseHandle(overlapped.hEvent);
+    CloseHandle(dir);
+    return true;
+  }
+#elif defined(__linux__)
+  bool AssetWatcher::runInotify()
+  {
+    const int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0)
+      return false;
+
+    const uint32_t watch_mask = IN_CREATE | IN_CLOSE_WRITE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR;
+    std::unordered_map<int, std::string> dirs;  // watch descriptor -> relative dir
+
+    // inotify is not recursive: watch every directory, including ones created later.
+    auto watch_tree = [&](const std::string& rel) -> bool
+    {
+      const std::filesystem::path base = rel.empty() ? m_root : m_root / rel;
+      const int wd = inotify_add_watch(fd, base.c_str(), watch_mask);
+      if (wd < 0)
+        return false;
+      dirs[wd] = rel;
+
+      std::error_code ec;
+      const auto options = std::filesystem::directory_options::skip_permission_denied;
+      std::filesystem::recursive_directory_iterator it(base, options, ec);
+      const std::filesystem::recursive_directory_iterator end;
+      for (; !ec && it != end; it.increment(ec))
+      {
+        std::error_code type_ec;
+        if (!it->is_directory(type_ec))
+          continue;
+        const int child = inotify_add_watch(fd, it->path().c_str(), watch_mask);
+        if (child < 0)
+          return false;
+        dirs[child] = it->path().lexically_relative(m_root).generic_string();
+      }
+      return true;
+    };
+
+    if (!watch_tree(std::string()))
+    {
+      // Typically the per-user watch limit; polling still works.
+      close(fd);
+      return false;
+    }
+
+    m_mode.store(AssetWatchMode::Native, std::memory_order_relaxed);
+    reconcile();
+
+    alignas(inotify_event) char buffer[16 * 1024];
+    while (!stopRequested())
+    {
+      pollfd pfd{};
+      pfd.fd = fd;
+      pfd.events = POLLIN;
+      if (poll(&pfd, 1, 200) <= 0)
+        continue;
+
+      for (;;)
+      {
+        const ssize_t len = read(fd, buffer, sizeof(buffer));
+        if (len <= 0)
+          break;
+
+        for (const char* ptr = buffer; ptr < buffer + len;)
+        {
+          const auto* ev = reinterpret_cast<const inotify_event*>(ptr);
+          ptr += sizeof(inotify_event) + ev->len;
+
+          if (ev->mask & IN_Q_OVERFLOW)
+          {
+            push(AssetChangeKind::Rescan, std::string());
+            continue;
+          }
+
+          auto dir = dirs.find(ev->wd);
+          if (dir == dirs.end())
+            continue;
+          if (ev->mask & IN_IGNORED)
+          {
+            dirs.erase(dir);
+            continue;
+          }
+          if (ev->len == 0)
+            continue;
+
+          std::string rel = dir->second.empty() ? std::string(ev->name) : dir->second + "/" + ev->name;
+          if (ev->mask & IN_ISDIR)
+          {
+            if (ev->mask & (IN_CREATE | IN_MOVED_TO))
+            {
+              if (!watch_tree(rel))
+                push(AssetChangeKind::Rescan, std::string());
+              push(AssetChangeKind::Modified, std::move(rel));
+            }
+            else if (ev->mask & (IN_DELETE | IN_MOVED_FROM))
+            {
+              push(AssetChangeKind::Removed, std::move(rel));
+            }
+            continue;
+          }
+
+          if (m_filter && !m_filter(m_root / rel))
+            continue;
+          if (ev->mask & (IN_CREATE | IN_CLOSE_WRITE | IN_MOVED_TO))
+            push(AssetChangeKind::Modified, std::move(rel));
+          else if (ev->mask & (IN_DELETE | IN_MOVED_FROM))
+            push(AssetChangeKind::Removed, std::move(rel));
+        }
+      }
+    }
+
+    close(fd);
+    return true;
+  }
+#endif
+}
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace sc
+{
+namespace editor
+{
+  enum class AssetChangeKind
+  {
+    Modified,   // created, written or renamed into place; may be a directory
+    Removed,    // file or directory gone
+    Rescan      // events were lost; rescan everything
+  };
+
+  struct AssetChange
+  {
+    AssetChangeKind kind = AssetChangeKind::Modified;
+    std::string relPath;
+  };
+
+  struct AssetFileStamp
+  {
+    uint64_t fileSize = 0;
+    uint64_t lastWriteTime = 0;
+  };
+
+  enum class AssetWatchMode
+  {
+    None,
+    Native,     // inotify / ReadDirectoryChangesW
+    Polling
+  };
+
+  uint64_t AssetFileTimeToUnix(const std::filesystem::file_time_type& ft);
+
+  // Background thread that turns filesystem changes under a root into
+  // AssetChange events. It first reconciles the caller's snapshot against
+  // disk, so a stale index cache is corrected without blocking the UI, then
+  // follows native change notifications or, where those are unavailable,
+  // re-walks the tree every pollIntervalMs.
+  class AssetWatcher
+  {
+  public:
+    using FileFilter = std::function<bool(const std::filesystem::path&)>;
+
+    ~AssetWatcher();
+
+    bool start(const std::filesystem::path& root,
+               std::unordered_map<std::string, AssetFileStamp> snapshot,
+               FileFilter filter,
+               bool allowNative = true,
+               uint32_t pollIntervalMs = 2000);
+    void stop();
+
+    bool running() const { return m_thread.joinable(); }
+    AssetWatchMode mode() const { return m_mode.load(std::memory_order_relaxed); }
+
+    // Moves pending events into out (appending). Returns the number taken.
+    size_t drain(std::vector<AssetChange>& out);
+
+  private:
+    void threadMain(bool allowNative);
+    void reconcile();
+    void push(AssetChangeKind kind, std::string relPath);
+    bool stopRequested() const { return m_stop.load(std::memory_order_relaxed); }
+#if defined(_WIN32)
+    bool runWindows();
+#elif defined(__linux__)
+    bool runInotify();
+#endif
+
+    std::filesystem::path m_root;
+    FileFilter m_filter;
+    uint32_t m_pollIntervalMs = 2000;
+    std::unordered_map<std::string, AssetFileStamp> m_snapshot;  // watcher thread only
+
+    std::thread m_thread;
+    std::atomic<bool> m_stop{ false };
+    std::atomic<AssetWatchMode> m_mode{ AssetWatchMode::None };
+
+    std::mutex m_mutex;
+    std::vector<AssetChange> m_pending;
+  };
+}
+}
@@ -384,6 +384,11 @@ static bool BuildModelEntity(EditorDocument* doc,
       e.useTexture = true;
       e.albedoTextureAssetId = record->defaultAlbedoTextureId;
     }
+    else if (record && record->loading)
+    {
+      // The default texture is only known once the cook finishes; the pump rebind applies it.
+      e.pendingDefaultTexture = true;
+    }
   }
 
   *out_entity = e;
@@ -465,31 +470,15 @@ static void DrawProjectPanel(AssetDatabase* db, ProjectPanelState* state, AssetS
     ImGui::TableSetColumnIndex(1);
     ImGui::BeginChild("ProjectFiles", ImVec2(0.0f, 0.0f), true);
 
-    std::vector<const AssetEntry*> filtered;
-    filtered.reserve(db->getAll().size());
-
-    const std::string search_text = ToLower(state->search);
-    for (const auto& entry : db->getAll())
-    {
-      if (!AssetInFolder(entry, state->selectedFolder))
-        continue;
-      if (!AssetPassesFilter(entry.type, state->filterIndex))
-        continue;
-      if (!search_text.empty())
-      {
-        const std::string hay = ToLower(entry.relPath);
-        if (hay.find(search_text) == std::string::npos)
-          continue;
-      }
-      filtered.push_back(&entry);
-    }
-
-    std::sort(filtered.begin(), filtered.end(), [](const AssetEntry* a, const AssetEntry* b)
+    // Both queries come back in name order from the database's indices.
+    const std::string search_text = state->search;
+    std::vector<const AssetEntry*> filtered = search_text.empty()
+      ? db->getByFolder(state->selectedFolder)
+      : db->searchByName(search_text);
+    filtered.erase(std::remove_if(filtered.begin(), filtered.end(), [&](const AssetEntry* entry)
     {
-      const std::string an = ToLower(std::filesystem::path(a->relPath).filename().string());
-      const std::string bn = ToLower(std::filesystem::path(b->relPath).filename().string());
-      return an < bn;
-    });
+      return !AssetInFolder(*entry, state->selectedFolder) || !AssetPassesFilter(entry->type, state->filterIndex);
+    }), filtered.end());
 
     ImGuiTableFlags table_flags = ImGuiTableFlags_RowBg |
                                   ImGuiTableFlags_ScrollY |
@@ -671,7 +660,11 @@ static void DrawAssetInspector(const AssetDatabase& db,
       ImGui::Separator();
       ImGui::TextUnformatted("Model Preview");
       const ModelRecord* record = model_cache->request(render_ctx, db, entry->id);
-      if (!record || record->handle == 0)
+      if (record && record->loading && record->handle == 0)
+      {
+        ImGui::TextDisabled("Cooking...");
+      }
+      else if (!record || record->handle == 0)
       {
         ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.2f, 1.0f), "Model not loaded.");
         if (record && record->loadFailed && !record->error.empty())
@@ -682,6 +675,11 @@ static void DrawAssetInspector(const AssetDatabase& db,
         ImGui::Text("Vertices: %u", record->vertexCount);
         ImGui::Text("Indices: %u", record->indexCount);
         ImGui::Text("Submeshes: %u", record->submeshCount);
+        for (size_t lod = 0; lod < record->lodTriangleCounts.size(); ++lod)
+        {
+          ImGui::Text("LOD%zu: %u tris  (screen size >= %.2f)",
+                      lod, record->lodTriangleCounts[lod], record->lodScreenSizes[lod]);
+        }
         const float sx = record->meshInfo.bounds_max[0] - record->meshInfo.bounds_min[0];
         const float sy = record->meshInfo.bounds_max[1] - record->meshInfo.bounds_min[1];
         const float sz = record->meshInfo.bounds_max[2] - record->meshInfo.bounds_min[2];
@@ -1095,14 +1093,21 @@ int main(int argc, char** argv)
 
   AssetDatabase asset_db;
   asset_db.setRoot(asset_root_path);
-  asset_db.scanAll();
+  const std::filesystem::path asset_index_path = asset_root_path / ".sc_asset_index";
+  if (!asset_db.loadIndexCache(asset_index_path))
+    asset_db.scanAll();
+  if (!asset_db.startWatching())
+    std::fprintf(stderr, "Asset watcher unavailable; periodic refresh rescans the tree.\n");
   EditorTextureCache texture_cache;
   EditorModelCache model_cache;
+  // Shares sc_mesh_cooker's layout, so `sc_mesh_cooker assets .sc_cooked` prewarms it.
+  model_cache.setCookRoot(asset_root_path.parent_path() / ".sc_cooked");
+  std::vector<sc_world::AssetId> loaded_models;
   ProjectPanelState project_state;
   project_state.selectedFolder = "";
   AssetSelection asset_selection;
   uint64_t last_asset_scan_ms = static_cast<uint64_t>(SDL_GetTicks());
-  const uint64_t asset_scan_interval_ms = 5000;
+  const uint64_t asset_scan_interval_ms = 250;
 
   EditorCamera camera;
   CommandStack cmd_stack;
@@ -1122,16 +1127,16 @@ int main(int argc, char** argv)
   {
     sc::editor::DocumentFromSectorFile(&doc, initial_file, render_ctx, registry, &asset_db, &texture_cache, &model_cache);
   }
-  else if (!registry.entries.empty())
+  else if (!registry.entries().empty())
   {
-    const int count = std::min<int>(3, static_cast<int>(registry.entries.size()));
+    const int count = std::min<int>(3, static_cast<int>(registry.entries().size()));
     for (int i = 0; i < count; ++i)
     {
       EditorTransform t{};
       t.position[0] = static_cast<float>(i) * 2.0f;
       t.position[1] = 0.5f;
       t.position[2] = 0.0f;
-      EditorEntity* e = sc::editor::AddEntity(&doc, registry.entries[i], t);
+      EditorEntity* e = sc::editor::AddEntity(&doc, registry.entries()[i], t);
       if (e)
         sc::editor::ResolveEntityAssets(e, render_ctx, registry, &asset_db, &texture_cache, &model_cache);
     }
@@ -1170,6 +1175,18 @@ int main(int argc, char** argv)
       last_asset_scan_ms = scan_now;
     }
 
+    loaded_models.clear();
+    if (model_cache.pump(render_ctx, asset_db, &loaded_models) > 0)
+    {
+      // Entities whose model finished cooking (or was re-cooked) bind the new mesh.
+      for (EditorEntity& entity : doc.entities)
+      {
+        if (entity.modelAssetId != 0 &&
+            std::find(loaded_models.begin(), loaded_models.end(), entity.modelAssetId) != loaded_models.end())
+          sc::editor::ResolveEntityAssets(&entity, render_ctx, registry, &asset_db, &texture_cache, &model_cache);
+      }
+    }
+
     const Uint8* ks = SDL_GetKeyboardState(nullptr);
 
     int mx = 0;
@@ -1351,7 +1368,7 @@ int main(int argc, char** argv)
     DrawProjectPanel(&asset_db, &project_state, &asset_selection);
 
     ImGui::Begin("Palette");
-    for (const auto& entry : registry.entries)
+    for (const auto& entry : registry.entries())
     {
       if (ImGui::Button(entry.label.c_str()))
       {
@@ -1559,13 +1576,13 @@ int main(int argc, char** argv)
           ImGui::Text("Mesh: %s", current ? current->mesh_path.c_str() : "<missing>");
           ImGui::Text("Material: %s", current ? current->material_path.c_str() : "<missing>");
 
-          if (!asset_cache_ready || asset_entries.size() != registry.entries.size())
+          if (!asset_cache_ready || asset_entries.size() != registry.entries().size())
           {
             asset_entries.clear();
             asset_labels.clear();
-            asset_entries.reserve(registry.entries.size());
-            asset_labels.reserve(registry.entries.size());
-            for (const auto& entry : registry.entries)
+            asset_entries.reserve(registry.entries().size());
+            asset_labels.reserve(registry.entries().size());
+            for (const auto& entry : registry.entries())
             {
               asset_entries.push_back(&entry);
               asset_labels.push_back(entry.label.c_str());
@@ -1616,6 +1633,7 @@ int main(int argc, char** argv)
           {
             selected->useTexture = false;
             selected->albedoTextureAssetId = 0;
+            selected->pendingDefaultTexture = false;
             sc::editor::ResolveEntityAssets(selected, render_ctx, registry, &asset_db, &texture_cache, &model_cache);
           }
         }
@@ -1950,6 +1968,10 @@ int main(int argc, char** argv)
     scRenderEndFrame(render_ctx);
   }
 
+  asset_db.stopWatching();
+  asset_db.saveIndexCache(asset_index_path);
+  model_cache.shutdown();
+
   scRenderImGuiShutdown(render_ctx);
   ImGui_ImplSDL2_Shutdown();
   ImGui::DestroyContext();